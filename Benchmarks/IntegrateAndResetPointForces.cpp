@@ -0,0 +1,126 @@
+#include "Utils.h"
+
+#include <GameCore/Buffer.h>
+#include <GameCore/LibSimdPp.h>
+#include <GameCore/SysSpecifics.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+//
+// Integrates the points of the stock ships; needs to be run from the folder where
+// the game's "Data" and "Ships" folders are.
+//
+
+static Buffer<float> MakeBuffer(std::vector<vec2f> const & vectors)
+{
+    Buffer<float> buffer(vectors.size() * 2);
+    for (auto const & v : vectors)
+    {
+        buffer.emplace_back(v.x);
+        buffer.emplace_back(v.y);
+    }
+
+    return buffer;
+}
+
+static void IntegrateAndResetPointForces_Naive(benchmark::State& state)
+{
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<vec2f> pointsIntegrationFactor;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeStockShipsGraph(pointsPosition, pointsVelocity, pointsForce, pointsIntegrationFactor,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    size_t const size = pointsPosition.size() * 2; // Two components per vector
+
+    Buffer<float> position = MakeBuffer(pointsPosition);
+    Buffer<float> velocity = MakeBuffer(pointsVelocity);
+    Buffer<float> force = MakeBuffer(pointsForce);
+    Buffer<float> integrationFactor = MakeBuffer(pointsIntegrationFactor);
+
+    float * restrict positionBuffer = position.data();
+    float * restrict velocityBuffer = velocity.data();
+    float * restrict forceBuffer = force.data();
+    float * restrict integrationFactorBuffer = integrationFactor.data();
+
+    float const dt = 0.02f / 24.0f;
+    float const globalDampCoefficient = 0.9996f;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            float const deltaPos = velocityBuffer[i] * dt + forceBuffer[i] * integrationFactorBuffer[i];
+            positionBuffer[i] += deltaPos;
+            velocityBuffer[i] = deltaPos * globalDampCoefficient / dt;
+            forceBuffer[i] = 0.0f;
+        }
+    }
+
+    benchmark::DoNotOptimize(positionBuffer);
+    benchmark::DoNotOptimize(velocityBuffer);
+    benchmark::ClobberMemory();
+}
+BENCHMARK(IntegrateAndResetPointForces_Naive);
+
+static void IntegrateAndResetPointForces_LibSimdPp(benchmark::State& state)
+{
+    //
+    // This is the algorithm used by Ship::IntegrateAndResetPointForces
+    //
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<vec2f> pointsIntegrationFactor;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeStockShipsGraph(pointsPosition, pointsVelocity, pointsForce, pointsIntegrationFactor,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    size_t const size = pointsPosition.size() * 2; // Two components per vector
+
+    Buffer<float> position = MakeBuffer(pointsPosition);
+    Buffer<float> velocity = MakeBuffer(pointsVelocity);
+    Buffer<float> force = MakeBuffer(pointsForce);
+    Buffer<float> integrationFactor = MakeBuffer(pointsIntegrationFactor);
+
+    float * restrict positionBuffer = position.data();
+    float * restrict velocityBuffer = velocity.data();
+    float * restrict forceBuffer = force.data();
+    float * restrict integrationFactorBuffer = integrationFactor.data();
+
+    simdpp::float32<8> const dtPacket = simdpp::splat(0.02f / 24.0f);
+    simdpp::float32<8> const globalDampCoefficientPacket = simdpp::splat(0.9996f);
+    simdpp::float32<8> const zeroPacket = simdpp::make_zero();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < size; i += 8)
+        {
+            simdpp::float32<8> const deltaPos =
+                simdpp::load<simdpp::float32<8>>(velocityBuffer + i) * dtPacket
+                + simdpp::load<simdpp::float32<8>>(forceBuffer + i) * simdpp::load<simdpp::float32<8>>(integrationFactorBuffer + i);
+
+            simdpp::store(positionBuffer + i, simdpp::load<simdpp::float32<8>>(positionBuffer + i) + deltaPos);
+            simdpp::store(velocityBuffer + i, deltaPos * globalDampCoefficientPacket / dtPacket);
+            simdpp::store(forceBuffer + i, zeroPacket);
+        }
+    }
+
+    benchmark::DoNotOptimize(positionBuffer);
+    benchmark::DoNotOptimize(velocityBuffer);
+    benchmark::ClobberMemory();
+}
+BENCHMARK(IntegrateAndResetPointForces_LibSimdPp);
@@ -0,0 +1,105 @@
+#include <Game/MaterialDatabase.h>
+#include <Game/ResourceLoader.h>
+#include <Game/ShipDefinition.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <vector>
+
+//
+// Looks up the material of each pixel of the structural layers of the stock ships;
+// needs to be run from the folder where the game's "Data" and "Ships" folders are.
+//
+
+static std::vector<rgbColor> LoadStockShipsStructuralPixels()
+{
+    std::vector<rgbColor> pixels;
+
+    for (auto const & entry : std::filesystem::directory_iterator(ResourceLoader::GetInstalledShipFolderPath()))
+    {
+        if (entry.is_regular_file()
+            && (entry.path().extension() == ".png" || entry.path().extension() == ".shp"))
+        {
+            auto const shipDefinition = ShipDefinition::Load(entry.path());
+
+            auto const & image = shipDefinition.StructuralLayerImage;
+            pixels.insert(
+                pixels.end(),
+                image.Data.get(),
+                image.Data.get() + static_cast<size_t>(image.Size.Width) * static_cast<size_t>(image.Size.Height));
+        }
+    }
+
+    return pixels;
+}
+
+static void MaterialDatabase_FindStructuralMaterial_Map(benchmark::State& state)
+{
+    ResourceLoader resourceLoader;
+    auto const materialDatabase = MaterialDatabase::Load(resourceLoader);
+    auto const pixels = LoadStockShipsStructuralPixels();
+
+    auto const & materialMap = materialDatabase.GetStructuralMaterials();
+
+    // What FindStructuralMaterial used to do
+    auto const & ropeMaterial = materialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Rope);
+    MaterialDatabase::ColorKey ropeColorKey;
+    for (auto const & entry : materialMap)
+    {
+        if (&(entry.second) == &ropeMaterial)
+            ropeColorKey = entry.first;
+    }
+
+    for (auto _ : state)
+    {
+        size_t materialCount = 0;
+
+        for (auto const & colorKey : pixels)
+        {
+            StructuralMaterial const * material = nullptr;
+
+            auto srchIt = materialMap.find(colorKey);
+            if (srchIt != materialMap.end())
+            {
+                material = &(srchIt->second);
+            }
+            else if (colorKey.r == ropeColorKey.r
+                && (colorKey.g & 0xF0) == (ropeColorKey.g & 0xF0))
+            {
+                material = &ropeMaterial;
+            }
+
+            if (nullptr != material)
+                ++materialCount;
+        }
+
+        benchmark::DoNotOptimize(materialCount);
+    }
+
+    state.SetItemsProcessed(state.iterations() * pixels.size());
+}
+BENCHMARK(MaterialDatabase_FindStructuralMaterial_Map);
+
+static void MaterialDatabase_FindStructuralMaterial_LookupTable(benchmark::State& state)
+{
+    ResourceLoader resourceLoader;
+    auto const materialDatabase = MaterialDatabase::Load(resourceLoader);
+    auto const pixels = LoadStockShipsStructuralPixels();
+
+    for (auto _ : state)
+    {
+        size_t materialCount = 0;
+
+        for (auto const & colorKey : pixels)
+        {
+            if (nullptr != materialDatabase.FindStructuralMaterial(colorKey))
+                ++materialCount;
+        }
+
+        benchmark::DoNotOptimize(materialCount);
+    }
+
+    state.SetItemsProcessed(state.iterations() * pixels.size());
+}
+BENCHMARK(MaterialDatabase_FindStructuralMaterial_LookupTable);
@@ -1,36 +1,35 @@
 #include "Utils.h"
 
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/SysSpecifics.h>
 
-// TODO: move to GameLib's LibSimdPp.h
-#define SIMDPP_ARCH_X86_SSSE3
-#include "simdpp/simd.h"
-
 #include <benchmark/benchmark.h>
 
 #include <algorithm>
 #include <limits>
 
-static constexpr size_t SampleSize = 20000000;
+//
+// Calculates the spring forces of the stock ships; needs to be run from the folder
+// where the game's "Data" and "Ships" folders are.
+//
 
 static void UpdateSpringForces_Naive(benchmark::State& state)
 {
-    auto const size = MakeSize(SampleSize);
-
     std::vector<vec2f> pointsPosition;
     std::vector<vec2f> pointsVelocity;
     std::vector<vec2f> pointsForce;
+    std::vector<vec2f> pointsIntegrationFactor;
     std::vector<SpringEndpoints> springsEndpoints;
     std::vector<float> springsStiffnessCoefficient;
     std::vector<float> springsDamperCoefficient;
     std::vector<float> springsRestLength;
 
-    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+    MakeStockShipsGraph(pointsPosition, pointsVelocity, pointsForce, pointsIntegrationFactor,
         springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
 
     for (auto _ : state)
     {
-        for (size_t springIndex = 0; springIndex < size; ++springIndex)
+        for (size_t springIndex = 0; springIndex < springsEndpoints.size(); ++springIndex)
         {
             auto const pointAIndex = springsEndpoints[springIndex].PointAIndex;
             auto const pointBIndex = springsEndpoints[springIndex].PointBIndex;
@@ -80,17 +79,16 @@ BENCHMARK(UpdateSpringForces_Naive);
 
 static void UpdateSpringForces_LibSimdPpAndIntrinsics(benchmark::State& state)
 {
-    auto const size = MakeSize(SampleSize);
-
     std::vector<vec2f> pointsPosition;
     std::vector<vec2f> pointsVelocity;
     std::vector<vec2f> pointsForce;
+    std::vector<vec2f> pointsIntegrationFactor;
     std::vector<SpringEndpoints> springsEndpoints;
     std::vector<float> springsStiffnessCoefficient;
     std::vector<float> springsDamperCoefficient;
     std::vector<float> springsRestLength;
 
-    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+    MakeStockShipsGraph(pointsPosition, pointsVelocity, pointsForce, pointsIntegrationFactor,
         springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
 
     vec2f const * const restrict pointsPositionData = pointsPosition.data();
@@ -263,3 +261,136 @@ static void UpdateSpringForces_LibSimdPpAndIntrinsics(benchmark::State& state)
     benchmark::DoNotOptimize(pointsForce);
 }
 BENCHMARK(UpdateSpringForces_LibSimdPpAndIntrinsics);
+
+static void UpdateSpringForces_LibSimdPpGather(benchmark::State& state)
+{
+    //
+    // This is the algorithm used by Springs::UpdateGeometry and Ship::UpdateSpringForces_Vectorized,
+    // fused in a single pass
+    //
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<vec2f> pointsIntegrationFactor;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeStockShipsGraph(pointsPosition, pointsVelocity, pointsForce, pointsIntegrationFactor,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    vec2f const * const restrict pointsPositionData = pointsPosition.data();
+    vec2f const * const restrict pointsVelocityData = pointsVelocity.data();
+    vec2f * const restrict pointsForceData = pointsForce.data();
+    SpringEndpoints const * const restrict springsEndpointsData = springsEndpoints.data();
+    float const * const restrict springsStiffnessCoefficientData = springsStiffnessCoefficient.data();
+    float const * const restrict springsDamperCoefficientData = springsDamperCoefficient.data();
+    float const * const restrict springsRestLengthData = springsRestLength.data();
+
+    alignas(16) float fX[4];
+    alignas(16) float fY[4];
+
+    for (auto _ : state)
+    {
+        for (size_t s = 0; s < springsEndpoints.size(); s += 4)
+        {
+            SpringEndpoints const * restrict const endpoints = springsEndpointsData + s;
+
+            simdpp::float32<4> const displacementX =
+                simdpp::make_float(
+                    pointsPositionData[endpoints[0].PointBIndex].x,
+                    pointsPositionData[endpoints[1].PointBIndex].x,
+                    pointsPositionData[endpoints[2].PointBIndex].x,
+                    pointsPositionData[endpoints[3].PointBIndex].x)
+                - simdpp::make_float(
+                    pointsPositionData[endpoints[0].PointAIndex].x,
+                    pointsPositionData[endpoints[1].PointAIndex].x,
+                    pointsPositionData[endpoints[2].PointAIndex].x,
+                    pointsPositionData[endpoints[3].PointAIndex].x);
+
+            simdpp::float32<4> const displacementY =
+                simdpp::make_float(
+                    pointsPositionData[endpoints[0].PointBIndex].y,
+                    pointsPositionData[endpoints[1].PointBIndex].y,
+                    pointsPositionData[endpoints[2].PointBIndex].y,
+                    pointsPositionData[endpoints[3].PointBIndex].y)
+                - simdpp::make_float(
+                    pointsPositionData[endpoints[0].PointAIndex].y,
+                    pointsPositionData[endpoints[1].PointAIndex].y,
+                    pointsPositionData[endpoints[2].PointAIndex].y,
+                    pointsPositionData[endpoints[3].PointAIndex].y);
+
+            simdpp::float32<4> const displacementLength = simdpp::sqrt(displacementX * displacementX + displacementY * displacementY);
+            simdpp::float32<4> const springDirX = SafeDivide(displacementX, displacementLength);
+            simdpp::float32<4> const springDirY = SafeDivide(displacementY, displacementLength);
+
+            //
+            // 1. Hooke's law
+            //
+
+            simdpp::float32<4> const springDisplacement =
+                displacementLength
+                - simdpp::load_u<simdpp::float32<4>>(springsRestLengthData + s);
+
+            simdpp::float32<4> const stiffnessCoefficient = simdpp::load_u<simdpp::float32<4>>(springsStiffnessCoefficientData + s);
+
+            simdpp::float32<4> const fSpringAX = (springDirX * springDisplacement) * stiffnessCoefficient;
+            simdpp::float32<4> const fSpringAY = (springDirY * springDisplacement) * stiffnessCoefficient;
+
+            //
+            // 2. Damper forces
+            //
+
+            simdpp::float32<4> const relVelocityX =
+                simdpp::make_float(
+                    pointsVelocityData[endpoints[0].PointBIndex].x,
+                    pointsVelocityData[endpoints[1].PointBIndex].x,
+                    pointsVelocityData[endpoints[2].PointBIndex].x,
+                    pointsVelocityData[endpoints[3].PointBIndex].x)
+                - simdpp::make_float(
+                    pointsVelocityData[endpoints[0].PointAIndex].x,
+                    pointsVelocityData[endpoints[1].PointAIndex].x,
+                    pointsVelocityData[endpoints[2].PointAIndex].x,
+                    pointsVelocityData[endpoints[3].PointAIndex].x);
+
+            simdpp::float32<4> const relVelocityY =
+                simdpp::make_float(
+                    pointsVelocityData[endpoints[0].PointBIndex].y,
+                    pointsVelocityData[endpoints[1].PointBIndex].y,
+                    pointsVelocityData[endpoints[2].PointBIndex].y,
+                    pointsVelocityData[endpoints[3].PointBIndex].y)
+                - simdpp::make_float(
+                    pointsVelocityData[endpoints[0].PointAIndex].y,
+                    pointsVelocityData[endpoints[1].PointAIndex].y,
+                    pointsVelocityData[endpoints[2].PointAIndex].y,
+                    pointsVelocityData[endpoints[3].PointAIndex].y);
+
+            simdpp::float32<4> const relVelocityProjection = relVelocityX * springDirX + relVelocityY * springDirY;
+
+            simdpp::float32<4> const dampingCoefficient = simdpp::load_u<simdpp::float32<4>>(springsDamperCoefficientData + s);
+
+            simdpp::float32<4> const fDampAX = (springDirX * relVelocityProjection) * dampingCoefficient;
+            simdpp::float32<4> const fDampAY = (springDirY * relVelocityProjection) * dampingCoefficient;
+
+            //
+            // Apply forces - must do on each point alone as we might be adding to the same point
+            //
+
+            simdpp::store(fX, fSpringAX + fDampAX);
+            simdpp::store(fY, fSpringAY + fDampAY);
+
+            for (size_t i = 0; i < 4; ++i)
+            {
+                vec2f const fA(fX[i], fY[i]);
+
+                pointsForceData[endpoints[i].PointAIndex] += fA;
+                pointsForceData[endpoints[i].PointBIndex] -= fA;
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize(pointsForce);
+}
+BENCHMARK(UpdateSpringForces_LibSimdPpGather);
@@ -1,5 +1,17 @@
 #include "Utils.h"
 
+#include <Game/GameParameters.h>
+#include <Game/IGameEventHandler.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/ResourceLoader.h>
+#include <Game/Ship.h>
+#include <Game/ShipBuilder.h>
+#include <Game/ShipDefinition.h>
+#include <Game/World.h>
+
+#include <filesystem>
+#include <memory>
+
 size_t MakeSize(size_t count)
 {
     if (0 == (count % 16))
@@ -118,4 +130,100 @@ void MakeGraph2(
         springsDamperCoefficient.emplace_back(static_cast<float>(i) * 0.5f);
         springsRestLength.emplace_back(1.0f + static_cast<float>(i % 2));
     }
-}
\ No newline at end of file
+}
+
+void MakeStockShipsGraph(
+    std::vector<vec2f> & pointsPosition,
+    std::vector<vec2f> & pointsVelocity,
+    std::vector<vec2f> & pointsForce,
+    std::vector<vec2f> & pointsIntegrationFactor,
+    std::vector<SpringEndpoints> & springsEndpoints,
+    std::vector<float> & springsStiffnessCoefficient,
+    std::vector<float> & springsDamperCoefficient,
+    std::vector<float> & springsRestLength)
+{
+    pointsPosition.clear();
+    pointsVelocity.clear();
+    pointsForce.clear();
+    pointsIntegrationFactor.clear();
+
+    springsEndpoints.clear();
+    springsStiffnessCoefficient.clear();
+    springsDamperCoefficient.clear();
+    springsRestLength.clear();
+
+    ResourceLoader resourceLoader;
+    auto const materialDatabase = MaterialDatabase::Load(resourceLoader);
+    GameParameters const gameParameters;
+
+    // Ships are built one at a time in a world of their own, which we never update
+    auto gameEventHandler = std::make_shared<IGameEventHandler>();
+    Physics::World world(
+        gameEventHandler,
+        gameParameters,
+        resourceLoader);
+
+    for (auto const & entry : std::filesystem::directory_iterator(ResourceLoader::GetInstalledShipFolderPath()))
+    {
+        if (entry.is_regular_file()
+            && (entry.path().extension() == ".png" || entry.path().extension() == ".shp"))
+        {
+            auto const shipDefinition = ShipDefinition::Load(entry.path());
+
+            auto ship = ShipBuilder::Create(
+                1,
+                world,
+                gameEventHandler,
+                shipDefinition,
+                materialDatabase,
+                nullptr,
+                gameParameters,
+                1u);
+
+            auto & points = ship->GetPoints();
+            auto const & springs = ship->GetSprings();
+
+            ElementIndex const pointIndexOffset = static_cast<ElementIndex>(pointsPosition.size());
+
+            float const * const integrationFactorBuffer = points.GetIntegrationFactorBufferAsFloat();
+            for (ElementIndex p = 0; p < points.GetShipPointCount(); ++p)
+            {
+                pointsPosition.push_back(points.GetPosition(p));
+                pointsVelocity.push_back(points.GetVelocity(p));
+                pointsForce.push_back(points.GetForce(p));
+                pointsIntegrationFactor.emplace_back(integrationFactorBuffer[p * 2], integrationFactorBuffer[p * 2 + 1]);
+            }
+
+            for (auto springIndex : springs)
+            {
+                springsEndpoints.push_back({
+                    pointIndexOffset + springs.GetPointAIndex(springIndex),
+                    pointIndexOffset + springs.GetPointBIndex(springIndex)
+                    });
+
+                springsStiffnessCoefficient.push_back(springs.GetStiffnessCoefficient(springIndex));
+                springsDamperCoefficient.push_back(springs.GetDampingCoefficient(springIndex));
+                springsRestLength.push_back(springs.GetRestLength(springIndex));
+            }
+        }
+    }
+
+    // Pad
+
+    while (0 != (pointsPosition.size() % 4))
+    {
+        pointsPosition.push_back(vec2f::zero());
+        pointsVelocity.push_back(vec2f::zero());
+        pointsForce.push_back(vec2f::zero());
+        pointsIntegrationFactor.push_back(vec2f::zero());
+    }
+
+    // Padding springs join two distinct points, lest kernels divide by zero lengths
+    while (0 != (springsEndpoints.size() % 4))
+    {
+        springsEndpoints.push_back({ 0, 1 });
+        springsStiffnessCoefficient.push_back(0.0f);
+        springsDamperCoefficient.push_back(0.0f);
+        springsRestLength.push_back(0.0f);
+    }
+}
@@ -30,3 +30,21 @@ void MakeGraph2(
     std::vector<float> & springsStiffnessCoefficient,
     std::vector<float> & springsDamperCoefficient,
     std::vector<float> & springsRestLength);
+
+/*
+ * Makes a graph out of the points and springs of all the stock ships, as the ship builder
+ * lays them out, one ship after the other; points are padded to a whole number of eight-float
+ * packets, and springs to a whole number of four-spring packets, with points and springs
+ * that do nothing.
+ *
+ * Needs to be run from the folder where the game's "Data" and "Ships" folders are.
+ */
+void MakeStockShipsGraph(
+    std::vector<vec2f> & pointsPosition,
+    std::vector<vec2f> & pointsVelocity,
+    std::vector<vec2f> & pointsForce,
+    std::vector<vec2f> & pointsIntegrationFactor,
+    std::vector<SpringEndpoints> & springsEndpoints,
+    std::vector<float> & springsStiffnessCoefficient,
+    std::vector<float> & springsDamperCoefficient,
+    std::vector<float> & springsRestLength);
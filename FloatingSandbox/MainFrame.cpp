@@ -6,6 +6,7 @@
 #include "MainFrame.h"
 
 #include "SplashScreenDialog.h"
+#include "StandardSystemPaths.h"
 #include "Version.h"
 
 #include <Game/ImageFileTools.h>
@@ -513,6 +514,7 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
                 mMainGLCanvas->SwapBuffers();
             },
             mResourceLoader,
+            StandardSystemPaths::GetInstance().GetUserCacheGameFolderPath(),
             [&splash, this](float progress, std::string const & message)
             {
                 splash->UpdateProgress(progress / 2.0f, message);
@@ -1244,6 +1246,10 @@ void MainFrame::OnShowProbePanelMenuItemSelected(wxCommandEvent & /*event*/)
         mMainFrameSizer->Hide(mProbePanel.get());
     }
 
+    // Only pay for profiling while we're showing its results
+    assert(!!mGameController);
+    mGameController->SetDoProfileShipUpdates(mShowProbePanelMenuItem->IsChecked());
+
     mMainFrameSizer->Layout();
 }
 
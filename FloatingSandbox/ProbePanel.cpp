@@ -68,6 +68,12 @@ void ProbePanel::Update()
         {
             p.second->Update();
         }
+
+        for (auto const & p : mShipUpdatePhaseProbes)
+        {
+            if (!!p)
+                p->Update();
+        }
     }
 }
 
@@ -104,6 +110,12 @@ void ProbePanel::OnGameReset()
     {
         p.second->Reset();
     }
+
+    for (auto const & p : mShipUpdatePhaseProbes)
+    {
+        if (!!p)
+            p->Reset();
+    }
 }
 
 void ProbePanel::OnWaterTaken(float waterTaken)
@@ -151,4 +163,18 @@ void ProbePanel::OnUpdateToRenderRatioUpdated(
     float immediateURRatio)
 {
     mURRatioProbe->RegisterSample(immediateURRatio);
-}
\ No newline at end of file
+}
+
+void ProbePanel::OnShipUpdatePhaseDurationUpdated(
+    ShipUpdatePhase phase,
+    float averageDurationMs)
+{
+    auto & probe = mShipUpdatePhaseProbes[static_cast<size_t>(phase)];
+    if (!probe)
+    {
+        probe = AddScalarTimeSeriesProbe(ShipUpdatePhaseToStr(phase) + " (ms)", 100);
+        mProbesSizer->Layout();
+    }
+
+    probe->RegisterSample(averageDurationMs);
+}
@@ -12,6 +12,7 @@
 #include <wx/sizer.h>
 #include <wx/wx.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -56,6 +57,10 @@ public:
     virtual void OnUpdateToRenderRatioUpdated(
         float immediateURRatio) override;
 
+    virtual void OnShipUpdatePhaseDurationUpdated(
+        ShipUpdatePhase phase,
+        float averageDurationMs) override;
+
 private:
 
     bool IsActive() const
@@ -81,4 +86,7 @@ private:
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWaterSplashProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWindSpeedProbe;
     std::unordered_map<std::string, std::unique_ptr<ScalarTimeSeriesProbeControl>> mCustomProbes;
+
+    // Created the first time we get durations for the phase
+    std::array<std::unique_ptr<ScalarTimeSeriesProbeControl>, static_cast<size_t>(ShipUpdatePhase::_Last) + 1> mShipUpdatePhaseProbes;
 };
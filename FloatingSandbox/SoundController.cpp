@@ -9,6 +9,7 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <algorithm>
 #include <cassert>
@@ -48,7 +49,9 @@ SoundController::SoundController(
     , mDslUOneShotMultipleChoiceSounds()
     , mUOneShotMultipleChoiceSounds()
     , mOneShotMultipleChoiceSounds()
-    , mCurrentlyPlayingOneShotSounds()
+    , mVoices(MaxVoices)
+    , mFreeVoicesHead(NoneVoiceIndex)
+    , mTypeVoices()
     // Continuous sounds
     , mSawedMetalSound(SawedInertiaDuration)
     , mSawedWoodSound(SawedInertiaDuration)
@@ -67,6 +70,16 @@ SoundController::SoundController(
     // Music
     , mSinkingMusic(SinkingMusicVolume, mMasterMusicVolume, mMasterMusicMuted)
 {
+    //
+    // Initialize voices
+    //
+
+    for (VoiceIndex v = mVoices.size(); v > 0; --v)
+    {
+        mVoices[v - 1].Next = mFreeVoicesHead;
+        mFreeVoicesHead = v - 1;
+    }
+
     //
     // Initialize Music
     //
@@ -84,31 +97,14 @@ SoundController::SoundController(
     //
 
     auto soundNames = mResourceLoader->GetSoundNames();
-    for (size_t i = 0; i < soundNames.size(); ++i)
-    {
-        std::string const & soundName = soundNames[i];
-
-        // Notify progress
-        progressCallback(static_cast<float>(i + 1) / static_cast<float>(soundNames.size()), "Loading sounds...");
-
-
-        //
-        // Load sound buffer
-        //
-
-        std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
-        if (!soundBuffer->loadFromFile(mResourceLoader->GetSoundFilepath(soundName).string()))
-        {
-            throw GameException("Cannot load sound \"" + soundName + "\"");
-        }
-
 
-
-        //
-        // Parse filename
-        //
-
-        std::regex soundTypeRegex(R"(([^_]+)(?:_.+)?)");
+    // Parse the types of all sounds first, as the type tells
+    // whether we may defer the decoding of a sound
+    std::vector<SoundType> soundTypes;
+    soundTypes.reserve(soundNames.size());
+    for (std::string const & soundName : soundNames)
+    {
+        static std::regex const soundTypeRegex(R"(([^_]+)(?:_.+)?)");
         std::smatch soundTypeMatch;
         if (!std::regex_match(soundName, soundTypeMatch, soundTypeRegex))
         {
@@ -116,10 +112,28 @@ SoundController::SoundController(
         }
 
         assert(soundTypeMatch.size() == 1 + 1);
-        SoundType soundType = StrToSoundType(soundTypeMatch[1].str());
+        soundTypes.push_back(StrToSoundType(soundTypeMatch[1].str()));
+    }
+
+    // Decode all the sounds that are not decoded lazily
+    std::vector<std::unique_ptr<sf::SoundBuffer>> soundBuffers(soundNames.size());
+    LoadSoundBuffers(
+        soundNames,
+        soundTypes,
+        soundBuffers,
+        progressCallback);
+
+    for (size_t i = 0; i < soundNames.size(); ++i)
+    {
+        std::string const & soundName = soundNames[i];
+        SoundType const soundType = soundTypes[i];
+        std::unique_ptr<sf::SoundBuffer> soundBuffer = std::move(soundBuffers[i]);
+
+        assert(!!soundBuffer || IsLazilyLoadedSoundType(soundType));
+
         if (soundType == SoundType::Saw)
         {
-            std::regex sawRegex(R"(([^_]+)(?:_(underwater))?)");
+            static std::regex const sawRegex(R"(([^_]+)(?:_(underwater))?)");
             std::smatch uMatch;
             if (!std::regex_match(soundName, uMatch, sawRegex))
             {
@@ -154,7 +168,7 @@ SoundController::SoundController(
         }
         else if (soundType == SoundType::Sawed)
         {
-            std::regex mRegex(R"(([^_]+)_([^_]+))");
+            static std::regex const mRegex(R"(([^_]+)_([^_]+))");
             std::smatch mMatch;
             if (!std::regex_match(soundName, mMatch, mRegex))
             {
@@ -251,7 +265,7 @@ SoundController::SoundController(
             // MSU sound
             //
 
-            std::regex msuRegex(R"(([^_]+)_([^_]+)_([^_]+)_(?:(underwater)_)?\d+)");
+            static std::regex const msuRegex(R"(([^_]+)_([^_]+)_([^_]+)_(?:(underwater)_)?\d+)");
             std::smatch msuMatch;
             if (!std::regex_match(soundName, msuMatch, msuRegex))
             {
@@ -284,7 +298,9 @@ SoundController::SoundController(
             //
 
             mMSUOneShotMultipleChoiceSounds[std::make_tuple(soundType, materialSound, sizeType, isUnderwater)]
-                .SoundBuffers.emplace_back(std::move(soundBuffer));
+                .AddAlternative(
+                    std::move(soundBuffer),
+                    mResourceLoader->GetSoundFilepath(soundName));
         }
         else if (soundType == SoundType::LightFlicker)
         {
@@ -292,7 +308,7 @@ SoundController::SoundController(
             // DslU sound
             //
 
-            std::regex dsluRegex(R"(([^_]+)_([^_]+)_(?:(underwater)_)?\d+)");
+            static std::regex const dsluRegex(R"(([^_]+)_([^_]+)_(?:(underwater)_)?\d+)");
             std::smatch dsluMatch;
             if (!std::regex_match(soundName, dsluMatch, dsluRegex))
             {
@@ -322,7 +338,9 @@ SoundController::SoundController(
             //
 
             mDslUOneShotMultipleChoiceSounds[std::make_tuple(soundType, durationType, isUnderwater)]
-                .SoundBuffers.emplace_back(std::move(soundBuffer));
+                .AddAlternative(
+                    std::move(soundBuffer),
+                    mResourceLoader->GetSoundFilepath(soundName));
         }
         else if (soundType == SoundType::Wave
                 || soundType == SoundType::WindGust
@@ -335,7 +353,7 @@ SoundController::SoundController(
             // - one-shot sound
             //
 
-            std::regex sRegex(R"(([^_]+)_\d+)");
+            static std::regex const sRegex(R"(([^_]+)_\d+)");
             std::smatch sMatch;
             if (!std::regex_match(soundName, sMatch, sRegex))
             {
@@ -349,7 +367,9 @@ SoundController::SoundController(
             //
 
             mOneShotMultipleChoiceSounds[std::make_tuple(soundType)]
-                .SoundBuffers.emplace_back(std::move(soundBuffer));
+                .AddAlternative(
+                    std::move(soundBuffer),
+                    mResourceLoader->GetSoundFilepath(soundName));
         }
         else if (soundType == SoundType::AntiMatterBombContained)
         {
@@ -357,7 +377,7 @@ SoundController::SoundController(
             // - continuous sound
             //
 
-            std::regex sRegex(R"(([^_]+)_\d+)");
+            static std::regex const sRegex(R"(([^_]+)_\d+)");
             std::smatch sMatch;
             if (!std::regex_match(soundName, sMatch, sRegex))
             {
@@ -382,7 +402,7 @@ SoundController::SoundController(
             // U sound
             //
 
-            std::regex uRegex(R"(([^_]+)_(?:(underwater)_)?\d+)");
+            static std::regex const uRegex(R"(([^_]+)_(?:(underwater)_)?\d+)");
             std::smatch uMatch;
             if (!std::regex_match(soundName, uMatch, uRegex))
             {
@@ -409,7 +429,9 @@ SoundController::SoundController(
             //
 
             mUOneShotMultipleChoiceSounds[std::make_tuple(soundType, isUnderwater)]
-                .SoundBuffers.emplace_back(std::move(soundBuffer));
+                .AddAlternative(
+                    std::move(soundBuffer),
+                    mResourceLoader->GetSoundFilepath(soundName));
         }
     }
 }
@@ -421,19 +443,19 @@ SoundController::~SoundController()
 
 void SoundController::SetPaused(bool isPaused)
 {
-    for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    for (auto & voice : mVoices)
     {
-        for (auto & playingSound : playingSoundIt.second)
+        if (voice.IsInUse)
         {
             if (isPaused)
             {
-                if (sf::Sound::Status::Playing == playingSound.Sound->getStatus())
-                    playingSound.Sound->pause();
+                if (sf::Sound::Status::Playing == voice.Sound.getStatus())
+                    voice.Sound.pause();
             }
             else
             {
-                if (sf::Sound::Status::Paused == playingSound.Sound->getStatus())
-                    playingSound.Sound->play();
+                if (sf::Sound::Status::Paused == voice.Sound.getStatus())
+                    voice.Sound.play();
             }
         }
     }
@@ -470,18 +492,11 @@ void SoundController::SetMasterEffectsVolume(float volume)
 {
     mMasterEffectsVolume = volume;
 
-    for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    for (auto & voice : mVoices)
     {
-        if (playingSoundIt.first != SoundType::Draw
-            && playingSoundIt.first != SoundType::Saw
-            && playingSoundIt.first != SoundType::Swirl
-            && playingSoundIt.first != SoundType::AirBubbles
-            && playingSoundIt.first != SoundType::FloodHose)
+        if (voice.IsInUse && !IsToolSoundType(voice.Type))
         {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                playingSound.Sound->setMasterVolume(mMasterEffectsVolume);
-            }
+            voice.Sound.setMasterVolume(mMasterEffectsVolume);
         }
     }
 
@@ -500,18 +515,11 @@ void SoundController::SetMasterEffectsMuted(bool isMuted)
 {
     mMasterEffectsMuted = isMuted;
 
-    for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    for (auto & voice : mVoices)
     {
-        if (playingSoundIt.first != SoundType::Draw
-            && playingSoundIt.first != SoundType::Saw
-            && playingSoundIt.first != SoundType::Swirl
-            && playingSoundIt.first != SoundType::AirBubbles
-            && playingSoundIt.first != SoundType::FloodHose)
+        if (voice.IsInUse && !IsToolSoundType(voice.Type))
         {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                playingSound.Sound->setMuted(mMasterEffectsMuted);
-            }
+            voice.Sound.setMuted(mMasterEffectsMuted);
         }
     }
 
@@ -532,18 +540,11 @@ void SoundController::SetMasterToolsVolume(float volume)
 {
     mMasterToolsVolume = volume;
 
-    for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    for (auto & voice : mVoices)
     {
-        if (playingSoundIt.first == SoundType::Draw
-            || playingSoundIt.first == SoundType::Saw
-            || playingSoundIt.first == SoundType::Swirl
-            || playingSoundIt.first == SoundType::AirBubbles
-            || playingSoundIt.first == SoundType::FloodHose)
+        if (voice.IsInUse && IsToolSoundType(voice.Type))
         {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                playingSound.Sound->setMasterVolume(mMasterToolsVolume);
-            }
+            voice.Sound.setMasterVolume(mMasterToolsVolume);
         }
     }
 
@@ -559,18 +560,11 @@ void SoundController::SetMasterToolsMuted(bool isMuted)
 {
     mMasterToolsMuted = isMuted;
 
-    for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    for (auto & voice : mVoices)
     {
-        if (playingSoundIt.first == SoundType::Draw
-            || playingSoundIt.first == SoundType::Saw
-            || playingSoundIt.first == SoundType::Swirl
-            || playingSoundIt.first == SoundType::AirBubbles
-            || playingSoundIt.first == SoundType::FloodHose)
+        if (voice.IsInUse && IsToolSoundType(voice.Type))
         {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                playingSound.Sound->setMuted(mMasterToolsMuted);
-            }
+            voice.Sound.setMuted(mMasterToolsMuted);
         }
     }
 
@@ -604,16 +598,7 @@ void SoundController::SetPlayBreakSounds(bool playBreakSounds)
 
     if (!mPlayBreakSounds)
     {
-        for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
-        {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                if (SoundType::Break == playingSound.Type)
-                {
-                    playingSound.Sound->stop();
-                }
-            }
-        }
+        ReleaseVoices(SoundType::Break);
     }
 }
 
@@ -623,16 +608,7 @@ void SoundController::SetPlayStressSounds(bool playStressSounds)
 
     if (!mPlayStressSounds)
     {
-        for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
-        {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                if (SoundType::Stress == playingSound.Type)
-                {
-                    playingSound.Sound->stop();
-                }
-            }
-        }
+        ReleaseVoices(SoundType::Stress);
     }
 }
 
@@ -644,16 +620,7 @@ void SoundController::SetPlayWindSound(bool playWindSound)
     {
         mWindSound.SetMuted(true);
 
-        for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
-        {
-            for (auto & playingSound : playingSoundIt.second)
-            {
-                if (SoundType::WindGust == playingSound.Type)
-                {
-                    playingSound.Sound->stop();
-                }
-            }
-        }
+        ReleaseVoices(SoundType::WindGust);
     }
     else
     {
@@ -763,6 +730,17 @@ void SoundController::Update()
     // they've just been started or will be started really soon
     mSawedMetalSound.SetVolume(0.0f);
     mSawedWoodSound.SetVolume(0.0f);
+
+    // Give back the voices that have finished playing, so that
+    // they do not count against the budgets of their types
+    for (VoiceIndex v = 0; v < mVoices.size(); ++v)
+    {
+        if (mVoices[v].IsInUse
+            && sf::Sound::Status::Stopped == mVoices[v].Sound.getStatus())
+        {
+            ReleaseVoice(v);
+        }
+    }
 }
 
 void SoundController::LowFrequencyUpdate()
@@ -775,20 +753,14 @@ void SoundController::Reset()
     // Stop and clear all sounds
     //
 
-    for (auto const & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    for (VoiceIndex v = 0; v < mVoices.size(); ++v)
     {
-        for (auto & playingSound : playingSoundIt.second)
+        if (mVoices[v].IsInUse)
         {
-            assert(!!playingSound.Sound);
-            if (sf::Sound::Status::Playing == playingSound.Sound->getStatus())
-            {
-                playingSound.Sound->stop();
-            }
+            ReleaseVoice(v);
         }
     }
 
-    mCurrentlyPlayingOneShotSounds.clear();
-
     mSawedMetalSound.Reset();
     mSawedWoodSound.Reset();
     mSawAbovewaterSound.Reset();
@@ -1169,6 +1141,100 @@ void SoundController::OnAntiMatterBombImploding()
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+void SoundController::LoadSoundBuffers(
+    std::vector<std::string> const & soundNames,
+    std::vector<SoundType> const & soundTypes,
+    std::vector<std::unique_ptr<sf::SoundBuffer>> & soundBuffers,
+    ProgressCallback const & progressCallback)
+{
+    assert(soundTypes.size() == soundNames.size());
+    assert(soundBuffers.size() == soundNames.size());
+
+    std::vector<size_t> soundIndices;
+    for (size_t i = 0; i < soundNames.size(); ++i)
+    {
+        if (!IsLazilyLoadedSoundType(soundTypes[i]))
+            soundIndices.push_back(i);
+    }
+
+    //
+    // We decode sounds in batches, one sound per thread: files are opened on this
+    // thread - opening a file only reads its header, and SFML's registry of file
+    // readers is not thread-safe - and then their samples are decoded concurrently;
+    // finally, the samples are uploaded into buffers on this thread, as buffers
+    // are OpenAL resources.
+    //
+
+    struct DecodedSound
+    {
+        sf::InputSoundFile File;
+        std::vector<sf::Int16> Samples;
+        sf::Uint64 ReadSampleCount;
+
+        DecodedSound()
+            : File()
+            , Samples()
+            , ReadSampleCount(0)
+        {}
+    };
+
+    TaskThreadPool threadPool;
+
+    std::vector<DecodedSound> decodedSounds(threadPool.GetParallelism());
+    std::vector<TaskThreadPool::Task> tasks;
+    tasks.reserve(decodedSounds.size());
+
+    for (size_t batchStart = 0; batchStart < soundIndices.size(); batchStart += decodedSounds.size())
+    {
+        size_t const batchEnd = std::min(batchStart + decodedSounds.size(), soundIndices.size());
+
+        tasks.clear();
+        for (size_t b = batchStart; b < batchEnd; ++b)
+        {
+            std::string const & soundName = soundNames[soundIndices[b]];
+            DecodedSound & decodedSound = decodedSounds[b - batchStart];
+
+            if (!decodedSound.File.openFromFile(mResourceLoader->GetSoundFilepath(soundName).string()))
+            {
+                throw GameException("Cannot load sound \"" + soundName + "\"");
+            }
+
+            tasks.emplace_back(
+                [&decodedSound]()
+                {
+                    decodedSound.Samples.resize(static_cast<size_t>(decodedSound.File.getSampleCount()));
+                    decodedSound.ReadSampleCount = decodedSound.File.read(
+                        decodedSound.Samples.data(),
+                        decodedSound.Samples.size());
+                });
+        }
+
+        threadPool.Run(tasks);
+
+        for (size_t b = batchStart; b < batchEnd; ++b)
+        {
+            std::string const & soundName = soundNames[soundIndices[b]];
+            DecodedSound const & decodedSound = decodedSounds[b - batchStart];
+
+            std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
+            if (decodedSound.ReadSampleCount != decodedSound.Samples.size()
+                || !soundBuffer->loadFromSamples(
+                    decodedSound.Samples.data(),
+                    decodedSound.Samples.size(),
+                    decodedSound.File.getChannelCount(),
+                    decodedSound.File.getSampleRate()))
+            {
+                throw GameException("Cannot load sound \"" + soundName + "\"");
+            }
+
+            soundBuffers[soundIndices[b]] = std::move(soundBuffer);
+        }
+
+        // Notify progress
+        progressCallback(static_cast<float>(batchEnd) / static_cast<float>(soundIndices.size()), "Loading sounds...");
+    }
+}
+
 void SoundController::PlayMSUOneShotMultipleChoiceSound(
     SoundType soundType,
     StructuralMaterial::MaterialSoundType materialSound,
@@ -1366,28 +1432,44 @@ void SoundController::ChooseAndPlayOneShotMultipleChoiceSound(
     // Choose sound buffer
     //
 
-    sf::SoundBuffer * chosenSoundBuffer = nullptr;
+    size_t chosenSoundIndex = 0;
 
     assert(!sound.SoundBuffers.empty());
     if (1 == sound.SoundBuffers.size())
     {
         // Nothing to choose
-        chosenSoundBuffer = sound.SoundBuffers[0].get();
+        chosenSoundIndex = 0;
     }
     else
     {
         assert(sound.SoundBuffers.size() >= 2);
 
         // Choose randomly, but avoid choosing the last-chosen sound again
-        size_t chosenSoundIndex = GameRandomEngine::GetInstance().ChooseNew(
+        chosenSoundIndex = GameRandomEngine::GetInstance().ChooseNew(
             sound.SoundBuffers.size(),
             sound.LastPlayedSoundIndex);
 
-        chosenSoundBuffer = sound.SoundBuffers[chosenSoundIndex].get();
-
         sound.LastPlayedSoundIndex = chosenSoundIndex;
     }
 
+    if (!sound.SoundBuffers[chosenSoundIndex])
+    {
+        //
+        // Decode the sound now, on its first use
+        //
+
+        std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
+        if (!soundBuffer->loadFromFile(sound.SoundFilepaths[chosenSoundIndex].string()))
+        {
+            LogMessage("SoundController: cannot load sound \"", sound.SoundFilepaths[chosenSoundIndex].string(), "\"");
+            return;
+        }
+
+        sound.SoundBuffers[chosenSoundIndex] = std::move(soundBuffer);
+    }
+
+    sf::SoundBuffer * chosenSoundBuffer = sound.SoundBuffers[chosenSoundIndex].get();
+
     assert(nullptr != chosenSoundBuffer);
 
     PlayOneShotSound(
@@ -1411,123 +1493,254 @@ void SoundController::PlayOneShotSound(
     // if there is, adjust its volume
     //
 
-    auto & thisTypeCurrentlyPlayingSounds = mCurrentlyPlayingOneShotSounds[soundType];
-
     auto const now = std::chrono::steady_clock::now();
     auto const minDeltaTimeSoundForType = GetMinDeltaTimeSoundForType(soundType);
 
-    for (auto & playingSound : thisTypeCurrentlyPlayingSounds)
+    auto const & typeVoices = GetTypeVoices(soundType);
+    for (VoiceList const * list : { &typeVoices.InterruptibleVoices, &typeVoices.NonInterruptibleVoices })
     {
-        assert(!!playingSound.Sound);
-        if (playingSound.Sound->getBuffer() == soundBuffer
-            && std::chrono::duration_cast<std::chrono::milliseconds>(now - playingSound.StartedTimestamp) < minDeltaTimeSoundForType)
+        // Newest first, as those are the only ones that may have started too recently
+        for (VoiceIndex v = list->Tail; v != NoneVoiceIndex; v = mVoices[v].Previous)
         {
-            playingSound.Sound->addVolume(volume);
+            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - mVoices[v].StartedTimestamp) >= minDeltaTimeSoundForType)
+                break;
 
-            return;
+            if (mVoices[v].Sound.getBuffer() == soundBuffer)
+            {
+                mVoices[v].Sound.addVolume(volume);
+
+                return;
+            }
         }
     }
 
 
     //
-    // Make sure there's room for this sound
+    // Get a voice for this sound
     //
 
-    auto const maxPlayingSoundsForThisType = GetMaxPlayingSoundsForType(soundType);
-
-    if (thisTypeCurrentlyPlayingSounds.size() >= maxPlayingSoundsForThisType)
+    VoiceIndex const voiceIndex = AcquireVoice(soundType);
+    if (NoneVoiceIndex == voiceIndex)
     {
-        ScavengeStoppedSounds(thisTypeCurrentlyPlayingSounds);
-
-        if (thisTypeCurrentlyPlayingSounds.size() >= maxPlayingSoundsForThisType)
-        {
-            // Need to stop the (expendable) sound that's been playing for the longest
-            ScavengeOldestSound(thisTypeCurrentlyPlayingSounds);
-        }
+        // All voices are taken by more important sounds
+        return;
     }
 
-    assert(thisTypeCurrentlyPlayingSounds.size() < maxPlayingSoundsForThisType);
-
-
 
     //
-    // Create and play sound
+    // Play sound
     //
 
-    std::unique_ptr<GameSound> sound = std::make_unique<GameSound>(
-        *soundBuffer,
+    Voice & voice = mVoices[voiceIndex];
+
+    voice.Sound.setBuffer(*soundBuffer);
+    voice.Sound.setVolumes(
         volume,
         mMasterEffectsVolume,
         mMasterEffectsMuted);
 
-    sound->play();
+    voice.Sound.play();
 
-    thisTypeCurrentlyPlayingSounds.emplace_back(
-        soundType,
-        std::move(sound),
-        now,
-        isInterruptible);
+    voice.Type = soundType;
+    voice.StartedTimestamp = now;
+    voice.IsInterruptible = isInterruptible;
+    voice.IsInUse = true;
+
+    LinkVoice(
+        isInterruptible ? GetTypeVoices(soundType).InterruptibleVoices : GetTypeVoices(soundType).NonInterruptibleVoices,
+        voiceIndex);
 }
 
-void SoundController::ScavengeStoppedSounds(std::vector<PlayingSound> & playingSounds)
+SoundController::VoiceIndex SoundController::AcquireVoice(SoundType soundType)
 {
-    for (auto it = playingSounds.begin(); it != playingSounds.end(); /*incremented in loop*/)
+    if (GetTypeVoices(soundType).GetCount() >= GetMaxPlayingSoundsForType(soundType))
     {
-        assert(!!it->Sound);
-        if (sf::Sound::Status::Stopped == it->Sound->getStatus())
+        //
+        // This type has used up its budget, hence it has to give up one of its own voices
+        //
+
+        ReleaseVoice(ChooseVoiceToRecycle(soundType));
+    }
+    else if (NoneVoiceIndex == mFreeVoicesHead)
+    {
+        //
+        // The pool is exhausted, hence we take a voice from another type; in order of preference:
+        // 1) A voice that has stopped playing
+        // 2) The oldest voice of the least important type, as long as it's not more important than us
+        //
+
+        VoiceIndex bestVoiceIndex = NoneVoiceIndex;
+        bool bestIsStopped = false;
+        int bestPriority = GetPriorityForType(soundType);
+
+        for (size_t t = 0; t < SoundTypeCount; ++t)
         {
-            // Scavenge
-            it = playingSounds.erase(it);
+            SoundType const candidateSoundType = static_cast<SoundType>(t);
+            if (0 == GetTypeVoices(candidateSoundType).GetCount())
+                continue;
+
+            VoiceIndex const candidateVoiceIndex = ChooseVoiceToRecycle(candidateSoundType);
+            bool const candidateIsStopped = (sf::Sound::Status::Stopped == mVoices[candidateVoiceIndex].Sound.getStatus());
+            int const candidatePriority = GetPriorityForType(candidateSoundType);
+
+            if (candidateIsStopped)
+            {
+                if (!bestIsStopped
+                    || mVoices[candidateVoiceIndex].StartedTimestamp < mVoices[bestVoiceIndex].StartedTimestamp)
+                {
+                    bestVoiceIndex = candidateVoiceIndex;
+                    bestIsStopped = true;
+                }
+            }
+            else if (!bestIsStopped
+                && (candidatePriority < bestPriority
+                    || (candidatePriority == bestPriority
+                        && (NoneVoiceIndex == bestVoiceIndex
+                            || mVoices[candidateVoiceIndex].StartedTimestamp < mVoices[bestVoiceIndex].StartedTimestamp))))
+            {
+                bestVoiceIndex = candidateVoiceIndex;
+                bestPriority = candidatePriority;
+            }
         }
-        else
+
+        if (NoneVoiceIndex == bestVoiceIndex)
         {
-            ++it;
+            return NoneVoiceIndex;
         }
+
+        ReleaseVoice(bestVoiceIndex);
     }
+
+    assert(NoneVoiceIndex != mFreeVoicesHead);
+
+    VoiceIndex const voiceIndex = mFreeVoicesHead;
+    mFreeVoicesHead = mVoices[voiceIndex].Next;
+
+    return voiceIndex;
 }
 
-void SoundController::ScavengeOldestSound(std::vector<PlayingSound> & playingSounds)
+SoundController::VoiceIndex SoundController::ChooseVoiceToRecycle(SoundType soundType) const
 {
-    assert(!playingSounds.empty());
+    auto const & typeVoices = GetTypeVoices(soundType);
 
+    assert(typeVoices.GetCount() > 0);
+
+    //
+    // In order of preference:
+    // 1) The oldest voice that has stopped playing
+    // 2) The oldest interruptible voice
+    // 3) The oldest non-interruptible voice
     //
-    // Two choices, in order of priority:
-    // 1) Interruptible
-    // 2) Non interruptible
+    // Voices are reclaimed at each Update(), hence the stopped ones are the
+    // voices that have stopped since then; looking for them means visiting
+    // all the voices of the type, which are no more than its budget
     //
 
-    size_t iOldestInterruptibleSound = std::numeric_limits<size_t>::max();
-    auto oldestInterruptibleSoundStartTimestamp = std::chrono::steady_clock::time_point::max();
-    size_t iOldestNonInterruptibleSound = std::numeric_limits<size_t>::max();
-    auto oldestNonInterruptibleSoundStartTimestamp = std::chrono::steady_clock::time_point::max();
-    for (size_t i = 0; i < playingSounds.size(); ++i)
+    VoiceIndex oldestStoppedVoiceIndex = NoneVoiceIndex;
+
+    for (VoiceList const * list : { &typeVoices.InterruptibleVoices, &typeVoices.NonInterruptibleVoices })
     {
-        if (playingSounds[i].StartedTimestamp < oldestNonInterruptibleSoundStartTimestamp)
+        for (VoiceIndex v = list->Head; v != NoneVoiceIndex; v = mVoices[v].Next)
         {
-            iOldestNonInterruptibleSound = i;
-            oldestNonInterruptibleSoundStartTimestamp = playingSounds[i].StartedTimestamp;
-        }
+            if (sf::Sound::Status::Stopped == mVoices[v].Sound.getStatus())
+            {
+                if (NoneVoiceIndex == oldestStoppedVoiceIndex
+                    || mVoices[v].StartedTimestamp < mVoices[oldestStoppedVoiceIndex].StartedTimestamp)
+                {
+                    oldestStoppedVoiceIndex = v;
+                }
 
-        if (playingSounds[i].StartedTimestamp < oldestInterruptibleSoundStartTimestamp
-            && playingSounds[i].IsInterruptible)
-        {
-            iOldestInterruptibleSound = i;
-            oldestInterruptibleSoundStartTimestamp = playingSounds[i].StartedTimestamp;
+                // The remaining voices of this list are newer
+                break;
+            }
         }
     }
 
-    size_t iSoundToStop;
-    if (oldestInterruptibleSoundStartTimestamp != std::chrono::steady_clock::time_point::max())
+    if (NoneVoiceIndex != oldestStoppedVoiceIndex)
+        return oldestStoppedVoiceIndex;
+
+    VoiceIndex const oldestInterruptibleVoiceIndex = typeVoices.InterruptibleVoices.Head;
+    VoiceIndex const oldestNonInterruptibleVoiceIndex = typeVoices.NonInterruptibleVoices.Head;
+
+    if (NoneVoiceIndex != oldestInterruptibleVoiceIndex)
+        return oldestInterruptibleVoiceIndex;
+    else
+        return oldestNonInterruptibleVoiceIndex;
+}
+
+void SoundController::ReleaseVoice(VoiceIndex voiceIndex)
+{
+    Voice & voice = mVoices[voiceIndex];
+
+    assert(voice.IsInUse);
+
+    if (sf::Sound::Status::Stopped != voice.Sound.getStatus())
     {
-        iSoundToStop = iOldestInterruptibleSound;
+        voice.Sound.stop();
     }
-    else
+
+    UnlinkVoice(
+        voice.IsInterruptible ? GetTypeVoices(voice.Type).InterruptibleVoices : GetTypeVoices(voice.Type).NonInterruptibleVoices,
+        voiceIndex);
+
+    voice.IsInUse = false;
+
+    voice.Next = mFreeVoicesHead;
+    mFreeVoicesHead = voiceIndex;
+}
+
+void SoundController::ReleaseVoices(SoundType soundType)
+{
+    auto & typeVoices = GetTypeVoices(soundType);
+
+    while (NoneVoiceIndex != typeVoices.InterruptibleVoices.Head)
     {
-        assert((oldestNonInterruptibleSoundStartTimestamp != std::chrono::steady_clock::time_point::max()));
-        iSoundToStop = iOldestNonInterruptibleSound;
+        ReleaseVoice(typeVoices.InterruptibleVoices.Head);
     }
 
-    assert(!!playingSounds[iSoundToStop].Sound);
-    playingSounds[iSoundToStop].Sound->stop();
-    playingSounds.erase(playingSounds.begin() + iSoundToStop);
-}
\ No newline at end of file
+    while (NoneVoiceIndex != typeVoices.NonInterruptibleVoices.Head)
+    {
+        ReleaseVoice(typeVoices.NonInterruptibleVoices.Head);
+    }
+}
+
+void SoundController::LinkVoice(
+    VoiceList & list,
+    VoiceIndex voiceIndex)
+{
+    // At the tail, as this is the newest
+    mVoices[voiceIndex].Previous = list.Tail;
+    mVoices[voiceIndex].Next = NoneVoiceIndex;
+
+    if (NoneVoiceIndex != list.Tail)
+        mVoices[list.Tail].Next = voiceIndex;
+    else
+        list.Head = voiceIndex;
+
+    list.Tail = voiceIndex;
+    ++list.Count;
+}
+
+void SoundController::UnlinkVoice(
+    VoiceList & list,
+    VoiceIndex voiceIndex)
+{
+    assert(list.Count > 0);
+
+    VoiceIndex const previous = mVoices[voiceIndex].Previous;
+    VoiceIndex const next = mVoices[voiceIndex].Next;
+
+    if (NoneVoiceIndex != previous)
+        mVoices[previous].Next = next;
+    else
+        list.Head = next;
+
+    if (NoneVoiceIndex != next)
+        mVoices[next].Previous = previous;
+    else
+        list.Tail = previous;
+
+    mVoices[voiceIndex].Previous = NoneVoiceIndex;
+    mVoices[voiceIndex].Next = NoneVoiceIndex;
+    --list.Count;
+}
@@ -18,6 +18,7 @@
 
 #include <SFML/Audio.hpp>
 
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <memory>
@@ -236,28 +237,72 @@ public:
 
 private:
 
-    struct PlayingSound
+    using VoiceIndex = size_t;
+
+    static constexpr VoiceIndex NoneVoiceIndex = std::numeric_limits<VoiceIndex>::max();
+
+    /*
+     * One of the sounds of the pool we play one-shot sounds with.
+     *
+     * While in use, a voice is linked into the list of the voices of its type and
+     * interruptibility, in order of start time; otherwise, it's linked into the free list.
+     */
+    struct Voice
     {
+        GameSound Sound;
         SoundType Type;
-        std::unique_ptr<GameSound> Sound;
         std::chrono::steady_clock::time_point StartedTimestamp;
         bool IsInterruptible;
+        bool IsInUse;
+
+        VoiceIndex Previous;
+        VoiceIndex Next;
+
+        Voice()
+            : Sound()
+            , Type(SoundType::Break)
+            , StartedTimestamp()
+            , IsInterruptible(false)
+            , IsInUse(false)
+            , Previous(NoneVoiceIndex)
+            , Next(NoneVoiceIndex)
+        {
+        }
+    };
+
+    struct VoiceList
+    {
+        VoiceIndex Head; // Oldest
+        VoiceIndex Tail; // Newest
+        size_t Count;
+
+        VoiceList()
+            : Head(NoneVoiceIndex)
+            , Tail(NoneVoiceIndex)
+            , Count(0)
+        {
+        }
+    };
+
+    struct TypeVoices
+    {
+        VoiceList InterruptibleVoices;
+        VoiceList NonInterruptibleVoices;
 
-        PlayingSound(
-            SoundType type,
-            std::unique_ptr<GameSound> sound,
-            std::chrono::steady_clock::time_point startedTimestamp,
-            bool isInterruptible)
-            : Type(type)
-            , Sound(std::move(sound))
-            , StartedTimestamp(startedTimestamp)
-            , IsInterruptible(isInterruptible)
+        size_t GetCount() const
         {
+            return InterruptibleVoices.Count + NonInterruptibleVoices.Count;
         }
     };
 
 private:
 
+    void LoadSoundBuffers(
+        std::vector<std::string> const & soundNames,
+        std::vector<SoundType> const & soundTypes,
+        std::vector<std::unique_ptr<sf::SoundBuffer>> & soundBuffers,
+        ProgressCallback const & progressCallback);
+
     void PlayMSUOneShotMultipleChoiceSound(
         SoundType soundType,
         StructuralMaterial::MaterialSoundType materialSound,
@@ -296,9 +341,58 @@ private:
         float volume,
         bool isInterruptible);
 
-    void ScavengeStoppedSounds(std::vector<PlayingSound> & playingSounds);
+    VoiceIndex AcquireVoice(SoundType soundType);
+
+    VoiceIndex ChooseVoiceToRecycle(SoundType soundType) const;
+
+    void ReleaseVoice(VoiceIndex voiceIndex);
+
+    void ReleaseVoices(SoundType soundType);
+
+    void LinkVoice(
+        VoiceList & list,
+        VoiceIndex voiceIndex);
 
-    void ScavengeOldestSound(std::vector<PlayingSound> & playingSounds);
+    void UnlinkVoice(
+        VoiceList & list,
+        VoiceIndex voiceIndex);
+
+    TypeVoices & GetTypeVoices(SoundType soundType)
+    {
+        return mTypeVoices[static_cast<size_t>(soundType)];
+    }
+
+    TypeVoices const & GetTypeVoices(SoundType soundType) const
+    {
+        return mTypeVoices[static_cast<size_t>(soundType)];
+    }
+
+    static bool IsToolSoundType(SoundType soundType)
+    {
+        return soundType == SoundType::Draw
+            || soundType == SoundType::Saw
+            || soundType == SoundType::Swirl
+            || soundType == SoundType::AirBubbles
+            || soundType == SoundType::FloodHose;
+    }
+
+    /*
+     * Sounds of these types are seldom played - if at all - during a session,
+     * hence we only decode them the first time they are played.
+     */
+    static bool IsLazilyLoadedSoundType(SoundType soundType)
+    {
+        return soundType == SoundType::BombAttached
+            || soundType == SoundType::BombDetached
+            || soundType == SoundType::BombExplosion
+            || soundType == SoundType::RCBombPing
+            || soundType == SoundType::TimerBombDefused
+            || soundType == SoundType::AntiMatterBombPreImplosion
+            || soundType == SoundType::AntiMatterBombImplosion
+            || soundType == SoundType::AntiMatterBombExplosion
+            || soundType == SoundType::Snapshot
+            || soundType == SoundType::TerrainAdjust;
+    }
 
 private:
 
@@ -333,6 +427,41 @@ private:
     // One-Shot sounds
     //
 
+    static constexpr size_t SoundTypeCount = static_cast<size_t>(SoundType::_Last) + 1;
+
+    // The number of one-shot sounds that may play at any given moment, across all types
+    static constexpr size_t MaxVoices = 128;
+
+    /*
+     * When all voices are in use, a new sound may only take the voice of a sound
+     * of a type whose priority is not higher than the priority of its own type.
+     */
+    static constexpr int GetPriorityForType(SoundType soundType)
+    {
+        switch (soundType)
+        {
+            case SoundType::Break:
+            case SoundType::Stress:
+            case SoundType::LightFlicker:
+                return 0;
+            case SoundType::PinPoint:
+            case SoundType::UnpinPoint:
+            case SoundType::BombAttached:
+            case SoundType::BombDetached:
+            case SoundType::BombExplosion:
+            case SoundType::RCBombPing:
+            case SoundType::TimerBombDefused:
+            case SoundType::AntiMatterBombPreImplosion:
+            case SoundType::AntiMatterBombImplosion:
+            case SoundType::AntiMatterBombExplosion:
+            case SoundType::TerrainAdjust:
+            case SoundType::Snapshot:
+                return 2;
+            default:
+                return 1;
+        }
+    }
+
     static constexpr size_t GetMaxPlayingSoundsForType(SoundType soundType)
     {
         switch (soundType)
@@ -380,7 +509,12 @@ private:
         std::tuple<SoundType>,
         OneShotMultipleChoiceSound> mOneShotMultipleChoiceSounds;
 
-    std::unordered_map<SoundType, std::vector<PlayingSound>> mCurrentlyPlayingOneShotSounds;
+    // The pool of voices, allocated once and for all
+    std::vector<Voice> mVoices;
+    VoiceIndex mFreeVoicesHead;
+
+    // The voices in use, by type
+    std::array<TypeVoices, SoundTypeCount> mTypeVoices;
 
     //
     // Continuous sounds
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <filesystem>
 #include <memory>
 #include <limits>
 #include <optional>
@@ -53,7 +54,9 @@ enum class SoundType
     AntiMatterBombImplosion,
     AntiMatterBombExplosion,
     Snapshot,
-    TerrainAdjust
+    TerrainAdjust,
+
+    _Last = TerrainAdjust
 };
 
 SoundType StrToSoundType(std::string const & str);
@@ -81,6 +84,15 @@ class GameSound : public sf::Sound
 {
 public:
 
+    GameSound()
+        : sf::Sound()
+        , mVolume(0.0f)
+        , mMasterVolume(100.0f)
+        , mIsMuted(false)
+    {
+        InternalSetVolume();
+    }
+
     GameSound(
         sf::SoundBuffer const & soundBuffer,
         float volume,
@@ -482,14 +494,25 @@ private:
 
 struct OneShotMultipleChoiceSound
 {
+    // Null for sounds that are only decoded when first played
     std::vector<std::unique_ptr<sf::SoundBuffer>> SoundBuffers;
+    std::vector<std::filesystem::path> SoundFilepaths;
     size_t LastPlayedSoundIndex;
 
     OneShotMultipleChoiceSound()
         : SoundBuffers()
+        , SoundFilepaths()
         , LastPlayedSoundIndex(0u)
     {
     }
+
+    void AddAlternative(
+        std::unique_ptr<sf::SoundBuffer> soundBuffer,
+        std::filesystem::path soundFilepath)
+    {
+        SoundBuffers.emplace_back(std::move(soundBuffer));
+        SoundFilepaths.emplace_back(std::move(soundFilepath));
+    }
 };
 
 struct OneShotSingleChoiceSound
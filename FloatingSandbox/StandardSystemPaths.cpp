@@ -26,4 +26,13 @@ std::filesystem::path StandardSystemPaths::GetUserSettingsGameFolderPath() const
 
     return std::filesystem::path(settingsFolder.ToStdString())
         / ApplicationName; // Without version - we want this to be sticky across upgrades
+}
+
+std::filesystem::path StandardSystemPaths::GetUserCacheGameFolderPath() const
+{
+    auto configFolder = wxStandardPaths::Get().GetUserConfigDir();
+
+    return std::filesystem::path(configFolder.ToStdString())
+        / ApplicationName // Without version - the caches know when they're stale
+        / "Cache";
 }
\ No newline at end of file
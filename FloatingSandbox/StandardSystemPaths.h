@@ -26,6 +26,8 @@ public:
 
     std::filesystem::path GetUserSettingsGameFolderPath() const;
 
+    std::filesystem::path GetUserCacheGameFolderPath() const;
+
 private:
 
     StandardSystemPaths()
@@ -276,6 +276,7 @@ bool AntiMatterBomb::Update(
 
 void AntiMatterBomb::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     switch (mState)
@@ -288,10 +289,10 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombArmor, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             // Sphere
@@ -299,10 +300,10 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphere, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             // Rotating cloud
@@ -310,7 +311,7 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphereCloud, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mCurrentCloudRotationAngle,
                 1.0f);
@@ -325,10 +326,10 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombArmor, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             // Sphere
@@ -336,10 +337,10 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphere, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             // Rotating cloud
@@ -347,7 +348,7 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphereCloud, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mCurrentCloudRotationAngle,
                 1.0f);
@@ -362,10 +363,10 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombArmor, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             // Sphere
@@ -373,10 +374,10 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphere, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             // Rotating cloud
@@ -384,7 +385,7 @@ void AntiMatterBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphereCloud, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mCurrentCloudRotationAngle,
                 1.0f);
@@ -396,7 +397,7 @@ void AntiMatterBomb::Upload(
         {
             // Cross-of-light
             renderContext.UploadCrossOfLight(
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 mCurrentStateProgress);
 
             break;
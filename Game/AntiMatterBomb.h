@@ -67,6 +67,7 @@ public:
 
     virtual void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const override;
 
     void Detonate();
@@ -85,10 +85,12 @@ public:
     virtual void OnNeighborhoodDisturbed() = 0;
 
     /*
-     * Uploads rendering information to the render context.
+     * Uploads rendering information to the render context, at the positions
+     * interpolated by the specified factor.
      */
     virtual void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const = 0;
 
     /*
@@ -190,6 +192,42 @@ public:
         }
     }
 
+    /*
+     * Same as GetPosition(), for the positions of the spring's endpoints interpolated
+     * between the previous and the current simulation states by the specified factor.
+     */
+    vec2f const GetInterpolatedPosition(float interpolationFactor) const
+    {
+        if (!!mMidpointPosition)
+        {
+            return *mMidpointPosition;
+        }
+        else
+        {
+            assert(!!mSpringIndex);
+            return (mShipPoints.GetInterpolatedPosition(mShipSprings.GetPointAIndex(*mSpringIndex), interpolationFactor)
+                + mShipPoints.GetInterpolatedPosition(mShipSprings.GetPointBIndex(*mSpringIndex), interpolationFactor)) / 2.0f;
+        }
+    }
+
+    /*
+     * Same as GetRotationOffsetAxis(), for the positions of the spring's endpoints interpolated
+     * between the previous and the current simulation states by the specified factor.
+     */
+    vec2f const GetInterpolatedRotationOffsetAxis(float interpolationFactor) const
+    {
+        if (!!mRotationOffsetAxis)
+        {
+            return *mRotationOffsetAxis;
+        }
+        else
+        {
+            assert(!!mSpringIndex);
+            return mShipPoints.GetInterpolatedPosition(mShipSprings.GetPointBIndex(*mSpringIndex), interpolationFactor)
+                - mShipPoints.GetInterpolatedPosition(mShipSprings.GetPointAIndex(*mSpringIndex), interpolationFactor);
+        }
+    }
+
     /*
      * Returns the ID of the connected component of this bomb.
      */
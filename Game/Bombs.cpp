@@ -111,11 +111,12 @@ void Bombs::DetonateAntiMatterBombs()
 
 void Bombs::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     for (auto & bomb : mCurrentBombs)
     {
-        bomb->Upload(shipId, renderContext);
+        bomb->Upload(shipId, interpolationFactor, renderContext);
     }
 }
 
@@ -13,8 +13,10 @@
 #include <GameCore/CircularList.h>
 #include <GameCore/Vectors.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Physics
 {
@@ -36,13 +38,15 @@ public:
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         Bomb::IPhysicsHandler & physicsHandler,
         Points & shipPoints,
-        Springs & shipSprings)
+        Springs & shipSprings,
+        PointSpatialGrid const & shipPointSpatialGrid)
         : mParentWorld(parentWorld)
         , mShipId(shipId)
         , mGameEventHandler(std::move(gameEventHandler))
         , mPhysicsHandler(physicsHandler)
         , mShipPoints(shipPoints)
         , mShipSprings(shipSprings)
+        , mShipPointSpatialGrid(shipPointSpatialGrid)
         , mCurrentBombs()
         , mNextLocalObjectId(0)
     {
@@ -102,6 +106,7 @@ public:
 
     void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const;
 
 private:
@@ -147,10 +152,32 @@ private:
         // if found, attach bomb to it it
         //
 
+        // A spring's midpoint may only be within the search radius if at least one of
+        // its endpoints is within the search radius plus half a spring length; we collect
+        // the springs of those points, and visit them in index order
+
+        std::vector<ElementIndex> candidateSprings;
+
+        mShipPointSpatialGrid.VisitPointsInRadius(
+            targetPos,
+            gameParameters.ToolSearchRadius + mShipSprings.GetMaxLength() / 2.0f,
+            [&](ElementIndex pointIndex)
+            {
+                for (auto springIndex : mShipPoints.GetConnectedSprings(pointIndex))
+                {
+                    candidateSprings.push_back(springIndex);
+                }
+            });
+
+        std::sort(candidateSprings.begin(), candidateSprings.end());
+        candidateSprings.erase(
+            std::unique(candidateSprings.begin(), candidateSprings.end()),
+            candidateSprings.end());
+
         ElementIndex nearestUnarmedSpringIndex = NoneElementIndex;
         float nearestUnarmedSpringDistance = std::numeric_limits<float>::max();
 
-        for (auto springIndex : mShipSprings)
+        for (auto springIndex : candidateSprings)
         {
             if (!mShipSprings.IsDeleted(springIndex) && !mShipSprings.IsBombAttached(springIndex))
             {
@@ -234,6 +261,9 @@ private:
     // The container of all the ship's springs
     Springs & mShipSprings;
 
+    // The index of the positions of the ship's points
+    PointSpatialGrid const & mShipPointSpatialGrid;
+
     // The current set of bombs
     CircularList<std::unique_ptr<Bomb>, GameParameters::MaxBombs> mCurrentBombs;
 
@@ -48,9 +48,9 @@ void Clouds::Update(
 
 }
 
-void Clouds::Render(Render::RenderContext & renderContext) const
+void Clouds::Upload(Render::RenderContext & renderContext) const
 {
-    renderContext.RenderCloudsStart(mClouds.size());
+    renderContext.UploadCloudsStart(mClouds.size());
 
     for (auto const & cloud : mClouds)
     {
@@ -60,7 +60,7 @@ void Clouds::Render(Render::RenderContext & renderContext) const
             cloud->GetScale());
     }
 
-    renderContext.RenderCloudsEnd();
+    renderContext.UploadCloudsEnd();
 }
 
 }
\ No newline at end of file
@@ -27,7 +27,7 @@ public:
         float currentSimulationTime,
         GameParameters const & gameParameters);
 
-    void Render(Render::RenderContext & renderContext) const;
+    void Upload(Render::RenderContext & renderContext) const;
 
 private:
 
@@ -22,6 +22,7 @@ void ElectricalElements::Add(
     mLightSpreadBuffer.emplace_back(electricalMaterial.LightSpread);
     mConnectedElectricalElementsBuffer.emplace_back();
     mAvailableCurrentBuffer.emplace_back(0.f);
+    mIsPoweredBuffer.emplace_back(false);
 
     switch (electricalMaterial.ElectricalType)
     {
@@ -35,6 +36,9 @@ void ElectricalElements::Add(
         {
             mGenerators.emplace_back(static_cast<ElementIndex>(mElementStateBuffer.GetCurrentPopulatedSize()));
             mElementStateBuffer.emplace_back(ElementState::GeneratorState());
+
+            // Power the component of this generator at the first connectivity update
+            mConnectivitySeeds.emplace_back(mGenerators.back());
             break;
         }
 
@@ -50,6 +54,8 @@ void ElectricalElements::Add(
     }
 
     mCurrentConnectivityVisitSequenceNumberBuffer.emplace_back(NoneVisitSequenceNumber);
+
+    mIsAdjacencyDirty = true;
 }
 
 void ElectricalElements::Destroy(ElementIndex electricalElementIndex)
@@ -73,28 +79,134 @@ void ElectricalElements::Destroy(ElementIndex electricalElementIndex)
 
     // Flag ourselves as deleted
     mIsDeletedBuffer[electricalElementIndex] = true;
+
+    // Make sure we get unpowered - our former neighbors have been seeded
+    // already, when their connections to us were removed
+    mConnectivitySeeds.push_back(electricalElementIndex);
+}
+
+void ElectricalElements::UpdateConnectivity(
+    VisitSequenceNumber currentConnectivityVisitSequenceNumber,
+    Points const & points)
+{
+    //
+    // Seed the components of the generators that have become wet or dry
+    //
+
+    for (auto iGenerator : Generators())
+    {
+        if (!mIsDeletedBuffer[iGenerator])
+        {
+            auto & generator = mElementStateBuffer[iGenerator].Generator;
+
+            bool const isDry = !points.IsWet(GetPointIndex(iGenerator), 0.3f);
+            if (isDry != generator.IsDry)
+            {
+                generator.IsDry = isDry;
+                mConnectivitySeeds.push_back(iGenerator);
+            }
+        }
+    }
+
+    if (mConnectivitySeeds.empty())
+    {
+        // Nothing has changed
+        return;
+    }
+
+    if (mIsAdjacencyDirty)
+    {
+        RebuildAdjacency();
+    }
+
+    //
+    // Visit the whole component of each seed, and power it if it contains at least one
+    // dry generator. All the elements of a component that has been split are reachable
+    // from the seeds of the connections that have been removed, hence each visit is
+    // confined to the components that have changed.
+    //
+    // Wet generators do not power their component, but they do conduct like any other
+    // element; hence whether a component is powered depends only on its elements, and
+    // the components that have not changed keep their power.
+    //
+
+    for (auto const seedElementIndex : mConnectivitySeeds)
+    {
+        // Make sure we haven't visited it already, as part of the component of another seed
+        if (currentConnectivityVisitSequenceNumber == mCurrentConnectivityVisitSequenceNumberBuffer[seedElementIndex])
+            continue;
+
+        mCurrentConnectivityVisitSequenceNumberBuffer[seedElementIndex] = currentConnectivityVisitSequenceNumber;
+
+        if (mIsDeletedBuffer[seedElementIndex])
+        {
+            mIsPoweredBuffer[seedElementIndex] = false;
+            continue;
+        }
+
+        // Search, using the search elements themselves as the queue
+        mConnectivitySearchElements.clear();
+        mConnectivitySearchElements.push_back(seedElementIndex);
+
+        bool isComponentPowered = false;
+
+        for (size_t s = 0; s < mConnectivitySearchElements.size(); ++s)
+        {
+            ElementIndex const e = mConnectivitySearchElements[s];
+
+            assert(!mIsDeletedBuffer[e]);
+
+            if (ElectricalMaterial::ElectricalElementType::Generator == mTypeBuffer[e]
+                && mElementStateBuffer[e].Generator.IsDry)
+            {
+                isComponentPowered = true;
+            }
+
+            ElementIndex const * restrict const connectedElements = mAdjacency.data() + mAdjacencyOffsets[e];
+            for (ElementCount c = 0; c < mAdjacencyCounts[e]; ++c)
+            {
+                ElementIndex const connectedElementIndex = connectedElements[c];
+
+                // Make sure not visited already
+                if (currentConnectivityVisitSequenceNumber != mCurrentConnectivityVisitSequenceNumberBuffer[connectedElementIndex])
+                {
+                    mCurrentConnectivityVisitSequenceNumberBuffer[connectedElementIndex] = currentConnectivityVisitSequenceNumber;
+                    mConnectivitySearchElements.push_back(connectedElementIndex);
+                }
+            }
+        }
+
+        for (auto const e : mConnectivitySearchElements)
+        {
+            mIsPoweredBuffer[e] = isComponentPowered;
+        }
+    }
+
+    mConnectivitySeeds.clear();
 }
 
 void ElectricalElements::Update(
     GameWallClock::time_point currentWallclockTime,
-    VisitSequenceNumber currentConnectivityVisitSequenceNumber,
     Points const & points,
     GameParameters const & gameParameters)
 {
     //
-    // Visit all lamps and run their state machine
+    // Visit all lamps and run their state machine, unless it's sure
+    // to leave them where they are
     //
 
     for (auto iLamp : Lamps())
     {
         if (!mIsDeletedBuffer[iLamp])
         {
-            RunLampStateMachine(
-                iLamp,
-                currentWallclockTime,
-                currentConnectivityVisitSequenceNumber,
-                points,
-                gameParameters);
+            if (IsLampStateMachineToRun(iLamp, points))
+            {
+                RunLampStateMachine(
+                    iLamp,
+                    currentWallclockTime,
+                    points,
+                    gameParameters);
+            }
         }
         else
         {
@@ -103,10 +215,95 @@ void ElectricalElements::Update(
     }
 }
 
+void ElectricalElements::RebuildAdjacency()
+{
+    //
+    // Give each element a row as large as the maximum number of connected
+    // elements it may have, so that rows never need to move
+    //
+
+    mAdjacencyOffsets.resize(mElementCount + 1);
+    mAdjacencyCounts.resize(mElementCount);
+
+    ElementIndex offset = 0;
+    for (ElementIndex e = 0; e < mElementCount; ++e)
+    {
+        mAdjacencyOffsets[e] = offset;
+        mAdjacencyCounts[e] = static_cast<ElementCount>(mConnectedElectricalElementsBuffer[e].size());
+        offset += mAdjacencyCounts[e];
+    }
+
+    mAdjacencyOffsets[mElementCount] = offset;
+
+    mAdjacency.resize(offset);
+    for (ElementIndex e = 0; e < mElementCount; ++e)
+    {
+        ElementIndex a = mAdjacencyOffsets[e];
+        for (auto const connectedElementIndex : mConnectedElectricalElementsBuffer[e])
+        {
+            mAdjacency[a++] = connectedElementIndex;
+        }
+    }
+
+    mIsAdjacencyDirty = false;
+}
+
+void ElectricalElements::RemoveAdjacency(
+    ElementIndex electricalElementIndex,
+    ElementIndex connectedElectricalElementIndex)
+{
+    ElementIndex * const connectedElements = mAdjacency.data() + mAdjacencyOffsets[electricalElementIndex];
+    ElementCount & connectedElementsCount = mAdjacencyCounts[electricalElementIndex];
+
+    for (ElementCount c = 0; c < connectedElementsCount; ++c)
+    {
+        if (connectedElements[c] == connectedElectricalElementIndex)
+        {
+            // Order does not matter
+            connectedElements[c] = connectedElements[connectedElementsCount - 1];
+            --connectedElementsCount;
+            return;
+        }
+    }
+
+    assert(false);
+}
+
+bool ElectricalElements::IsLampStateMachineToRun(
+    ElementIndex elementLampIndex,
+    Points const & points) const
+{
+    auto const & lamp = mElementStateBuffer[elementLampIndex].Lamp;
+
+    bool const isPowered = mIsPoweredBuffer[elementLampIndex] || lamp.IsSelfPowered;
+
+    switch (lamp.State)
+    {
+        case ElementState::LampState::StateType::LightOn:
+        {
+            // May only go off if it has lost power, or if it's wet
+            return !isPowered
+                || points.IsWet(GetPointIndex(elementLampIndex), LampWetFailureWaterThreshold);
+        }
+
+        case ElementState::LampState::StateType::LightOff:
+        {
+            // May only go on if it has power, and it's dry
+            return isPowered
+                && !points.IsWet(GetPointIndex(elementLampIndex), LampWetFailureWaterThreshold);
+        }
+
+        default:
+        {
+            // Initial and flickering, which are timed
+            return true;
+        }
+    }
+}
+
 void ElectricalElements::RunLampStateMachine(
     ElementIndex elementLampIndex,
     GameWallClock::time_point currentWallclockTime,
-    VisitSequenceNumber currentConnectivityVisitSequenceNumber,
     Points const & points,
     GameParameters const & /*gameParameters*/)
 {
@@ -121,7 +318,7 @@ void ElectricalElements::RunLampStateMachine(
         case ElementState::LampState::StateType::Initial:
         {
             // Transition to ON - if we have current or if we're self-powered
-            if (currentConnectivityVisitSequenceNumber == mCurrentConnectivityVisitSequenceNumberBuffer[elementLampIndex]
+            if (mIsPoweredBuffer[elementLampIndex]
                 || lamp.IsSelfPowered)
             {
                 mAvailableCurrentBuffer[elementLampIndex] = 1.f;
@@ -141,7 +338,7 @@ void ElectricalElements::RunLampStateMachine(
         case ElementState::LampState::StateType::LightOn:
         {
             // Check whether we still have current, or we're wet and it's time to fail
-            if ((   currentConnectivityVisitSequenceNumber != mCurrentConnectivityVisitSequenceNumberBuffer[elementLampIndex]
+            if ((   !mIsPoweredBuffer[elementLampIndex]
                     && !lamp.IsSelfPowered
                 ) ||
                 (   points.IsWet(GetPointIndex(elementLampIndex), LampWetFailureWaterThreshold)
@@ -171,7 +368,7 @@ void ElectricalElements::RunLampStateMachine(
             // 0-1-0-1-Off
 
             // Check if we should become ON again
-            if ((currentConnectivityVisitSequenceNumber == mCurrentConnectivityVisitSequenceNumberBuffer[elementLampIndex]
+            if ((mIsPoweredBuffer[elementLampIndex]
                 || lamp.IsSelfPowered)
                 && !points.IsWet(GetPointIndex(elementLampIndex), LampWetFailureWaterThreshold))
             {
@@ -224,7 +421,7 @@ void ElectricalElements::RunLampStateMachine(
             // 0-1-0-1--0-1-Off
 
             // Check if we should become ON again
-            if ((currentConnectivityVisitSequenceNumber == mCurrentConnectivityVisitSequenceNumberBuffer[elementLampIndex]
+            if ((mIsPoweredBuffer[elementLampIndex]
                 || lamp.IsSelfPowered)
                 && !points.IsWet(GetPointIndex(elementLampIndex), LampWetFailureWaterThreshold))
             {
@@ -291,7 +488,7 @@ void ElectricalElements::RunLampStateMachine(
             assert(mAvailableCurrentBuffer[elementLampIndex] == 0.f);
 
             // Check if we should become ON again
-            if ((currentConnectivityVisitSequenceNumber == mCurrentConnectivityVisitSequenceNumberBuffer[elementLampIndex]
+            if ((mIsPoweredBuffer[elementLampIndex]
                 || lamp.IsSelfPowered)
                 && !points.IsWet(GetPointIndex(elementLampIndex), LampWetFailureWaterThreshold))
             {
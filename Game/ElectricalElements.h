@@ -46,6 +46,7 @@ public:
         , mConnectedElectricalElementsBuffer(mBufferElementCount, mElementCount, {})
         , mElementStateBuffer(mBufferElementCount, mElementCount, ElementState::CableState())
         , mAvailableCurrentBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mIsPoweredBuffer(mBufferElementCount, mElementCount, false)
         , mCurrentConnectivityVisitSequenceNumberBuffer(mBufferElementCount, mElementCount, NoneVisitSequenceNumber)
         //////////////////////////////////
         // Container
@@ -55,6 +56,12 @@ public:
         , mDestroyHandler()
         , mGenerators()
         , mLamps()
+        , mAdjacencyOffsets()
+        , mAdjacencyCounts()
+        , mAdjacency()
+        , mIsAdjacencyDirty(true)
+        , mConnectivitySeeds()
+        , mConnectivitySearchElements()
     {
     }
 
@@ -100,9 +107,18 @@ public:
 
     void Destroy(ElementIndex electricalElementIndex);
 
+    /*
+     * Re-calculates which elements are powered - i.e. connected to a dry generator - but
+     * only for the electrical components that have changed since the last invocation:
+     * those that have lost connections or elements, and those whose generators have
+     * become wet or dry.
+     */
+    void UpdateConnectivity(
+        VisitSequenceNumber currentConnectivityVisitSequenceNumber,
+        Points const & points);
+
     void Update(
         GameWallClock::time_point currentWallclockTime,
-        VisitSequenceNumber currentConnectivityVisitSequenceNumber,
         Points const & points,
         GameParameters const & gameParameters);
 
@@ -167,6 +183,8 @@ public:
         assert(connectedElectricalElementIndex < mElementCount);
 
         mConnectedElectricalElementsBuffer[electricalElementIndex].push_back(connectedElectricalElementIndex);
+
+        mIsAdjacencyDirty = true;
     }
 
     inline void RemoveConnectedElectricalElement(
@@ -179,6 +197,14 @@ public:
 
         assert(found);
         (void)found;
+
+        if (!mIsAdjacencyDirty)
+        {
+            RemoveAdjacency(electricalElementIndex, connectedElectricalElementIndex);
+        }
+
+        // The component of this element might have been split
+        mConnectivitySeeds.push_back(electricalElementIndex);
     }
 
     //
@@ -191,20 +217,12 @@ public:
     }
 
     //
-    // Connectivity detection step sequence number
+    // Power
     //
 
-    inline VisitSequenceNumber GetCurrentConnectivityVisitSequenceNumber(ElementIndex electricalElementIndex) const
-    {
-        return mCurrentConnectivityVisitSequenceNumberBuffer[electricalElementIndex];
-    }
-
-    inline void SetConnectivityVisitSequenceNumber(
-        ElementIndex electricalElementIndex,
-        VisitSequenceNumber connectivityVisitSequenceNumber)
+    inline bool IsPowered(ElementIndex electricalElementIndex) const
     {
-        mCurrentConnectivityVisitSequenceNumberBuffer[electricalElementIndex] =
-            connectivityVisitSequenceNumber;
+        return mIsPoweredBuffer[electricalElementIndex];
     }
 
 private:
@@ -217,6 +235,12 @@ private:
 
         struct GeneratorState
         {
+            // As of the last connectivity update
+            bool IsDry;
+
+            GeneratorState()
+                : IsDry(false)
+            {}
         };
 
         struct LampState
@@ -275,10 +299,19 @@ private:
 
 private:
 
+    void RebuildAdjacency();
+
+    void RemoveAdjacency(
+        ElementIndex electricalElementIndex,
+        ElementIndex connectedElectricalElementIndex);
+
+    bool IsLampStateMachineToRun(
+        ElementIndex elementLampIndex,
+        Points const & points) const;
+
     void RunLampStateMachine(
         ElementIndex elementLampIndex,
         GameWallClock::time_point currentWallclockTime,
-        VisitSequenceNumber currentConnectivityVisitSequenceNumber,
         Points const & points,
         GameParameters const & gameParameters);
 
@@ -321,6 +354,9 @@ private:
     // Available current (to lamps)
     Buffer<float> mAvailableCurrentBuffer;
 
+    // Whether the element is connected to a dry generator
+    Buffer<bool> mIsPoweredBuffer;
+
     // Connectivity detection step sequence number
     Buffer<VisitSequenceNumber> mCurrentConnectivityVisitSequenceNumberBuffer;
 
@@ -337,6 +373,20 @@ private:
     // Indices of specific types in this container - just a shortcut
     std::vector<ElementIndex> mGenerators;
     std::vector<ElementIndex> mLamps;
+
+    // The connected elements, in compressed sparse row form for visiting them; each element
+    // has its own fixed-size row, of which the first mAdjacencyCounts[e] entries are populated.
+    // Built once after the ship is built, and maintained in place as connections are removed
+    std::vector<ElementIndex> mAdjacencyOffsets;
+    std::vector<ElementCount> mAdjacencyCounts;
+    std::vector<ElementIndex> mAdjacency;
+    bool mIsAdjacencyDirty;
+
+    // The elements whose components have to be re-visited at the next connectivity update
+    std::vector<ElementIndex> mConnectivitySeeds;
+
+    // The elements of the component being visited; member so as to avoid re-allocating it
+    std::vector<ElementIndex> mConnectivitySearchElements;
 };
 
 }
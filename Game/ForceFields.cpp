@@ -5,45 +5,26 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/LibSimdPp.h>
+
 #include <algorithm>
+#include <cmath>
 
 namespace Physics {
 
-void DrawForceField::Apply(
-    Points & points,
-    float /*currentSimulationTime*/,
-    GameParameters const & /*gameParameters*/) const
+void DrawForceField::AddTo(ForceFieldBatch & batch) const
 {
-    //
-    // F = ForceStrength/sqrt(distance), along radius
-    //
-
-    for (auto pointIndex : points)
-    {
-        vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
-        float forceMagnitude = mStrength / sqrtf(0.1f + displacement.length());
-
-        points.GetForce(pointIndex) += displacement.normalise() * forceMagnitude;
-    }
+    batch.AddDraw(mCenterPosition, mStrength);
 }
 
-void SwirlForceField::Apply(
-    Points & points,
-    float /*currentSimulationTime*/,
-    GameParameters const & /*gameParameters*/) const
+void SwirlForceField::AddTo(ForceFieldBatch & batch) const
 {
-    //
-    // F = ForceStrength*radius/sqrt(distance), perpendicular to radius
-    //
-
-    for (auto pointIndex : points)
-    {
-        vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
-        float const displacementLength = displacement.length();
-        float forceMagnitude = mStrength / sqrtf(0.1f + displacementLength);
+    batch.AddSwirl(mCenterPosition, mStrength);
+}
 
-        points.GetForce(pointIndex) += vec2f(-displacement.y, displacement.x) * forceMagnitude;
-    }
+void BlastForceField::AddTo(ForceFieldBatch & batch) const
+{
+    batch.AddBlast(*this);
 }
 
 void BlastForceField::Apply(
@@ -52,7 +33,7 @@ void BlastForceField::Apply(
     GameParameters const & gameParameters) const
 {
     // 
-    // Go through all the connected component's points and, for each point in radius:
+    // Go through all the candidate points and, for each point in radius:
     // - Keep non-ephemeral point that is closest to blast position; we'll Destroy() it later 
     //   (if this is the fist frame of the blast sequence)
     // - Flip over the point outside of the radius
@@ -64,34 +45,30 @@ void BlastForceField::Apply(
     float closestPointSquareDistance = std::numeric_limits<float>::max();
     ElementIndex closestPointIndex = NoneElementIndex;
 
-    // Visit all (non-ephemeral) points (ephemerals would be blown immediately away otherwise)
-    for (auto pointIndex : points.NonEphemeralPoints())
+    // Visit all candidate points - all belonging to the required connected component
+    for (auto pointIndex : mCandidatePoints)
     {
-        // Make sure this point belongs to the required connected component
-        if (points.GetConnectedComponentId(pointIndex) == mConnectedComponentId)
+        vec2f pointRadius = points.GetPosition(pointIndex) - mCenterPosition;
+        float squarePointDistance = pointRadius.squareLength();
+        if (squarePointDistance < squareBlastRadius)
         {
-            vec2f pointRadius = points.GetPosition(pointIndex) - mCenterPosition;
-            float squarePointDistance = pointRadius.squareLength();
-            if (squarePointDistance < squareBlastRadius)
+            // Check whether this point is the closest, non-deleted point
+            //  Wee don't want to waste destroy's on already-deleted points
+            if (squarePointDistance < closestPointSquareDistance
+                && !points.IsDeleted(pointIndex))
             {
-                // Check whether this point is the closest, non-deleted point
-                //  Wee don't want to waste destroy's on already-deleted points
-                if (squarePointDistance < closestPointSquareDistance
-                    && !points.IsDeleted(pointIndex))
-                {
-                    closestPointSquareDistance = squarePointDistance;
-                    closestPointIndex = pointIndex;
-                }
-
-                // Create acceleration to flip the point
-                vec2f flippedRadius = pointRadius.normalise() * (mBlastRadius + (mBlastRadius - pointRadius.length()));
-                vec2f newPosition = mCenterPosition + flippedRadius;
-                points.GetForce(pointIndex) +=
-                    (newPosition - points.GetPosition(pointIndex)) 
-                    / DtSquared
-                    * mStrength
-                    * points.GetMass(pointIndex);
+                closestPointSquareDistance = squarePointDistance;
+                closestPointIndex = pointIndex;
             }
+
+            // Create acceleration to flip the point
+            vec2f flippedRadius = pointRadius.normalise() * (mBlastRadius + (mBlastRadius - pointRadius.length()));
+            vec2f newPosition = mCenterPosition + flippedRadius;
+            points.GetForce(pointIndex) +=
+                (newPosition - points.GetPosition(pointIndex)) 
+                / DtSquared
+                * mStrength
+                * points.GetMass(pointIndex);
         }
     }
 
@@ -111,12 +88,14 @@ void BlastForceField::Apply(
     }
 }
 
-void RadialSpaceWarpForceField::Apply(
-    Points & points,
-    float /*currentSimulationTime*/,
-    GameParameters const & /*gameParameters*/) const
+void RadialSpaceWarpForceField::AddTo(ForceFieldBatch & batch) const
 {
-    for (auto pointIndex : points)
+    batch.AddRadialSpaceWarp(*this);
+}
+
+void RadialSpaceWarpForceField::Apply(Points & points) const
+{
+    auto const applyToPoint = [&](ElementIndex pointIndex)
     {
         vec2f const pointRadius = points.GetPosition(pointIndex) - mCenterPosition;
         float const pointDistanceFromRadius = pointRadius.length() - mRadius;
@@ -132,55 +111,264 @@ void RadialSpaceWarpForceField::Apply(
                 * strength
                 * direction;
         }
+    };
+
+    // The ship's points that might be within the circle's thickness
+    for (auto pointIndex : mCandidatePoints)
+    {
+        applyToPoint(pointIndex);
+    }
+
+    // Ephemeral particles are not indexed by position, but they are few
+    for (auto pointIndex : points.EphemeralPoints())
+    {
+        applyToPoint(pointIndex);
     }
 }
 
-void ImplosionForceField::Apply(
+void ImplosionForceField::AddTo(ForceFieldBatch & batch) const
+{
+    batch.AddImplosion(mCenterPosition, mStrength);
+}
+
+void RadialExplosionForceField::AddTo(ForceFieldBatch & batch) const
+{
+    batch.AddRadialExplosion(mCenterPosition, mStrength);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+
+void ForceFieldBatch::Apply(
     Points & points,
-    float /*currentSimulationTime*/,
-    GameParameters const & /*gameParameters*/) const
+    float currentSimulationTime,
+    GameParameters const & gameParameters) const
 {
-    for (auto pointIndex : points)
+    if (!mDrawFields.empty()
+        || !mSwirlFields.empty()
+        || !mImplosionFields.empty()
+        || !mRadialExplosionFields.empty())
     {
-        vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
-        float const displacementLength = displacement.length();
-        vec2f normalizedDisplacement = displacement.normalise(displacementLength);
-
-        // Make final acceleration independent from mass
-        float const massNormalization = points.GetMass(pointIndex) / 50.0f;
-
-        // Angular - constant
-        points.GetForce(pointIndex) +=
-            vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
-            * mStrength
-            / 10.0f
-            * massNormalization;
-
-        // Radial - stronger when closer
-        points.GetForce(pointIndex) +=
-            normalizedDisplacement
-            * mStrength
-            / (0.2f + sqrt(displacementLength))
-            * 10.0f
-            * massNormalization;
+        ApplyCentralFields(points);
+    }
+
+    for (auto const * radialSpaceWarpField : mRadialSpaceWarpFields)
+    {
+        radialSpaceWarpField->Apply(points);
+    }
+
+    // Blasts last, as they might destroy points
+    for (auto const * blastField : mBlastFields)
+    {
+        blastField->Apply(points, currentSimulationTime, gameParameters);
     }
 }
 
-void RadialExplosionForceField::Apply(
-    Points & points,
-    float /*currentSimulationTime*/,
-    GameParameters const & /*gameParameters*/) const
+void ForceFieldBatch::ApplyCentralFields(Points & points) const
 {
     //
-    // F = ForceStrength/sqrt(distance), along radius
+    // All of these fields act on all points, hence we visit the points once,
+    // a packet at a time, and accumulate the forces of all fields in registers
     //
 
-    for (auto pointIndex : points)
-    {        
-        vec2f displacement = (points.GetPosition(pointIndex) - mCenterPosition);
-        float forceMagnitude = mStrength / sqrtf(0.1f + displacement.length());
+    using float_packet = simdpp::float32<4>;
+    static constexpr ElementIndex PacketSize = 4;
+
+    vec2f const * restrict const positionBuffer = points.GetPositionBufferAsVec2();
+    float const * restrict const massBuffer = points.GetMassBufferAsFloat();
+    vec2f * restrict const forceBuffer = points.GetForceBufferAsVec2();
+
+    float_packet const zero = simdpp::splat(0.0f);
+    float_packet const pointOne = simdpp::splat(0.1f);
+    float_packet const pointTwo = simdpp::splat(0.2f);
+    float_packet const massNormalizationFactor = simdpp::splat(1.0f / 50.0f);
+
+    alignas(16) float fX[PacketSize];
+    alignas(16) float fY[PacketSize];
+
+    ElementIndex const pointCount = points.GetElementCount();
+
+    ElementIndex p = 0;
+    for (; p + PacketSize <= pointCount; p += PacketSize)
+    {
+        float_packet const positionX = simdpp::make_float(
+            positionBuffer[p].x,
+            positionBuffer[p + 1].x,
+            positionBuffer[p + 2].x,
+            positionBuffer[p + 3].x);
+
+        float_packet const positionY = simdpp::make_float(
+            positionBuffer[p].y,
+            positionBuffer[p + 1].y,
+            positionBuffer[p + 2].y,
+            positionBuffer[p + 3].y);
+
+        float_packet forceX = zero;
+        float_packet forceY = zero;
+
+        //
+        // Draw and radial explosion: F = ForceStrength/sqrt(distance), along radius
+        //
+
+        auto const accumulateRadial = [&](CentralField const & field, float strengthSign)
+        {
+            float_packet const centerX = simdpp::splat(field.CenterPosition.x);
+            float_packet const centerY = simdpp::splat(field.CenterPosition.y);
+            float_packet const strength = simdpp::splat(field.Strength * strengthSign);
+
+            float_packet const displacementX = centerX - positionX;
+            float_packet const displacementY = centerY - positionY;
+            float_packet const displacementLength = simdpp::sqrt(displacementX * displacementX + displacementY * displacementY);
+
+            // Coincident points have a zero direction, and get no force
+            float_packet const forceMagnitude = SafeDivide(
+                strength,
+                simdpp::sqrt(pointOne + displacementLength) * displacementLength);
+
+            forceX = forceX + displacementX * forceMagnitude;
+            forceY = forceY + displacementY * forceMagnitude;
+        };
+
+        for (auto const & field : mDrawFields)
+        {
+            accumulateRadial(field, 1.0f);
+        }
+
+        // The displacement is reversed, which is the same as reversing the strength
+        for (auto const & field : mRadialExplosionFields)
+        {
+            accumulateRadial(field, -1.0f);
+        }
+
+        //
+        // Swirl: F = ForceStrength*radius/sqrt(distance), perpendicular to radius
+        //
+
+        for (auto const & field : mSwirlFields)
+        {
+            float_packet const centerX = simdpp::splat(field.CenterPosition.x);
+            float_packet const centerY = simdpp::splat(field.CenterPosition.y);
+            float_packet const strength = simdpp::splat(field.Strength);
+
+            float_packet const displacementX = centerX - positionX;
+            float_packet const displacementY = centerY - positionY;
+            float_packet const displacementLength = simdpp::sqrt(displacementX * displacementX + displacementY * displacementY);
+
+            float_packet const forceMagnitude = strength / simdpp::sqrt(pointOne + displacementLength);
+
+            forceX = forceX - displacementY * forceMagnitude;
+            forceY = forceY + displacementX * forceMagnitude;
+        }
+
+        //
+        // Implosion: constant angular, and radial stronger when closer; independent from mass
+        //
+
+        if (!mImplosionFields.empty())
+        {
+            float_packet const massNormalization = simdpp::load_u<float_packet>(massBuffer + p) * massNormalizationFactor;
+
+            for (auto const & field : mImplosionFields)
+            {
+                float_packet const centerX = simdpp::splat(field.CenterPosition.x);
+                float_packet const centerY = simdpp::splat(field.CenterPosition.y);
+                float_packet const angularStrength = simdpp::splat(field.Strength / 10.0f);
+                float_packet const radialStrength = simdpp::splat(field.Strength * 10.0f);
+
+                float_packet const displacementX = centerX - positionX;
+                float_packet const displacementY = centerY - positionY;
+                float_packet const displacementLength = simdpp::sqrt(displacementX * displacementX + displacementY * displacementY);
+
+                // Coincident points have a zero direction, as above
+                float_packet const normalizedDisplacementX = SafeDivide(displacementX, displacementLength);
+                float_packet const normalizedDisplacementY = SafeDivide(displacementY, displacementLength);
+
+                float_packet const angularMagnitude = angularStrength * massNormalization;
+                float_packet const radialMagnitude = radialStrength / (pointTwo + simdpp::sqrt(displacementLength)) * massNormalization;
+
+                forceX = forceX - normalizedDisplacementY * angularMagnitude + normalizedDisplacementX * radialMagnitude;
+                forceY = forceY + normalizedDisplacementX * angularMagnitude + normalizedDisplacementY * radialMagnitude;
+            }
+        }
+
+        simdpp::store(fX, forceX);
+        simdpp::store(fY, forceY);
+
+        for (ElementIndex i = 0; i < PacketSize; ++i)
+        {
+            forceBuffer[p + i] += vec2f(fX[i], fY[i]);
+        }
+    }
+
+    //
+    // Do the remaining points, with the same arithmetic as the packets, so that
+    // a point gets the same force whether or not it is left over by whole packets
+    //
+
+    for (; p < pointCount; ++p)
+    {
+        vec2f const position = positionBuffer[p];
+        vec2f force = vec2f::zero();
+
+        auto const accumulateRadial = [&](CentralField const & field, float strengthSign)
+        {
+            float const strength = field.Strength * strengthSign;
+
+            vec2f const displacement = field.CenterPosition - position;
+            float const displacementLength = std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+
+            float const forceMagnitude = SafeDivide(
+                strength,
+                std::sqrt(0.1f + displacementLength) * displacementLength);
+
+            force.x = force.x + displacement.x * forceMagnitude;
+            force.y = force.y + displacement.y * forceMagnitude;
+        };
+
+        for (auto const & field : mDrawFields)
+        {
+            accumulateRadial(field, 1.0f);
+        }
+
+        for (auto const & field : mRadialExplosionFields)
+        {
+            accumulateRadial(field, -1.0f);
+        }
+
+        for (auto const & field : mSwirlFields)
+        {
+            vec2f const displacement = field.CenterPosition - position;
+            float const displacementLength = std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+
+            float const forceMagnitude = field.Strength / std::sqrt(0.1f + displacementLength);
+
+            force.x = force.x - displacement.y * forceMagnitude;
+            force.y = force.y + displacement.x * forceMagnitude;
+        }
+
+        if (!mImplosionFields.empty())
+        {
+            float const massNormalization = massBuffer[p] * (1.0f / 50.0f);
+
+            for (auto const & field : mImplosionFields)
+            {
+                float const angularStrength = field.Strength / 10.0f;
+                float const radialStrength = field.Strength * 10.0f;
+
+                vec2f const displacement = field.CenterPosition - position;
+                float const displacementLength = std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+
+                float const normalizedDisplacementX = SafeDivide(displacement.x, displacementLength);
+                float const normalizedDisplacementY = SafeDivide(displacement.y, displacementLength);
+
+                float const angularMagnitude = angularStrength * massNormalization;
+                float const radialMagnitude = radialStrength / (0.2f + std::sqrt(displacementLength)) * massNormalization;
+
+                force.x = force.x - normalizedDisplacementY * angularMagnitude + normalizedDisplacementX * radialMagnitude;
+                force.y = force.y + normalizedDisplacementX * angularMagnitude + normalizedDisplacementY * radialMagnitude;
+            }
+        }
 
-        points.GetForce(pointIndex) += displacement.normalise() * forceMagnitude;
+        forceBuffer[p] += force;
     }
 }
 
@@ -8,13 +8,21 @@
 #include "GameParameters.h"
 #include "Physics.h"
 
+#include <GameCore/GameTypes.h>
 #include <GameCore/Vectors.h>
 
+#include <vector>
+
 namespace Physics
 {
 
+class ForceFieldBatch;
+
 /*
  * This class represents an abstract force field that works on points.
+ *
+ * Force fields are not applied one by one; rather, they add themselves to a batch,
+ * which applies all the fields of the same type at once.
  */
 class ForceField
 {
@@ -23,10 +31,7 @@ public:
     virtual ~ForceField()
     {}
 
-    virtual void Apply(
-        Points & points,
-        float currentSimulationTime,
-        GameParameters const & gameParameters) const = 0;
+    virtual void AddTo(ForceFieldBatch & batch) const = 0;
 };
 
 /*
@@ -43,10 +48,7 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(
-        Points & points,
-        float currentSimulationTime,
-        GameParameters const & gameParameters) const override;
+    virtual void AddTo(ForceFieldBatch & batch) const override;
 
 private:
 
@@ -68,10 +70,7 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(
-        Points & points,
-        float currentSimulationTime,
-        GameParameters const & gameParameters) const override;
+    virtual void AddTo(ForceFieldBatch & batch) const override;
 
 private:
 
@@ -81,6 +80,10 @@ private:
 
 /*
  * Force field that simulates a blast around a center point.
+ *
+ * The blast only affects the specified candidate points, which are expected to
+ * comprise all the (non-ephemeral) points of the blasted connected component that
+ * might be within the blast radius.
  */
 class BlastForceField final : public ForceField
 {
@@ -90,31 +93,37 @@ public:
         vec2f const & centerPosition,
         float blastRadius,
         float strength,
-        ConnectedComponentId connectedComponentId,
+        std::vector<ElementIndex> && candidatePoints,
         bool destroyPoint)
         : mCenterPosition(centerPosition)
         , mBlastRadius(blastRadius)
         , mStrength(strength)
-        , mConnectedComponentId(connectedComponentId)
+        , mCandidatePoints(std::move(candidatePoints))
         , mDestroyPoint(destroyPoint)
     {}
 
-    virtual void Apply(
+    virtual void AddTo(ForceFieldBatch & batch) const override;
+
+    void Apply(
         Points & points,
         float currentSimulationTime,
-        GameParameters const & gameParameters) const override;
+        GameParameters const & gameParameters) const;
 
 private:
 
     vec2f const mCenterPosition;
     float const mBlastRadius;
     float const mStrength;
-    ConnectedComponentId const mConnectedComponentId;
+    std::vector<ElementIndex> const mCandidatePoints;
     bool const mDestroyPoint;
 };
 
 /*
  * Force field that simulates a space warp along a circle around a center point.
+ *
+ * The warp only affects the specified candidate points, which are expected to comprise
+ * all the non-ephemeral points that might be within the thickness of the circle, and
+ * all the ephemeral particles.
  */
 class RadialSpaceWarpForceField final : public ForceField
 {
@@ -124,17 +133,18 @@ public:
         vec2f const & centerPosition,
         float radius,
         float radiusThickness,
-        float strength)
+        float strength,
+        std::vector<ElementIndex> && candidatePoints)
         : mCenterPosition(centerPosition)
         , mRadius(radius)
         , mRadiusThickness(radiusThickness)
         , mStrength(strength)
+        , mCandidatePoints(std::move(candidatePoints))
     {}
 
-    virtual void Apply(
-        Points & points,
-        float currentSimulationTime,
-        GameParameters const & gameParameters) const override;
+    virtual void AddTo(ForceFieldBatch & batch) const override;
+
+    void Apply(Points & points) const;
 
 private:
 
@@ -142,6 +152,7 @@ private:
     float const mRadius;
     float const mRadiusThickness;
     float const mStrength;
+    std::vector<ElementIndex> const mCandidatePoints;
 };
 
 /*
@@ -159,10 +170,7 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(
-        Points & points,
-        float currentSimulationTime,
-        GameParameters const & gameParameters) const override;
+    virtual void AddTo(ForceFieldBatch & batch) const override;
 
 private:
 
@@ -184,10 +192,7 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(
-        Points & points,
-        float currentSimulationTime,
-        GameParameters const & gameParameters) const override;
+    virtual void AddTo(ForceFieldBatch & batch) const override;
 
 private:
 
@@ -195,4 +200,123 @@ private:
     float const mStrength;
 };
 
+/*
+ * The force fields to apply at each mechanical iteration of a simulation step, grouped by type.
+ *
+ * The fields that act on all points are applied together, in a single vectorized pass over the
+ * points; space warps and blasts, which only act near their center, are applied one by one to
+ * their own candidate points.
+ */
+class ForceFieldBatch
+{
+public:
+
+    ForceFieldBatch()
+        : mDrawFields()
+        , mSwirlFields()
+        , mImplosionFields()
+        , mRadialExplosionFields()
+        , mRadialSpaceWarpFields()
+        , mBlastFields()
+    {}
+
+    bool IsEmpty() const
+    {
+        return mDrawFields.empty()
+            && mSwirlFields.empty()
+            && mImplosionFields.empty()
+            && mRadialExplosionFields.empty()
+            && mRadialSpaceWarpFields.empty()
+            && mBlastFields.empty();
+    }
+
+    void Clear()
+    {
+        mDrawFields.clear();
+        mSwirlFields.clear();
+        mImplosionFields.clear();
+        mRadialExplosionFields.clear();
+        mRadialSpaceWarpFields.clear();
+        mBlastFields.clear();
+    }
+
+    void AddDraw(
+        vec2f const & centerPosition,
+        float strength)
+    {
+        mDrawFields.emplace_back(centerPosition, strength);
+    }
+
+    void AddSwirl(
+        vec2f const & centerPosition,
+        float strength)
+    {
+        mSwirlFields.emplace_back(centerPosition, strength);
+    }
+
+    void AddImplosion(
+        vec2f const & centerPosition,
+        float strength)
+    {
+        mImplosionFields.emplace_back(centerPosition, strength);
+    }
+
+    void AddRadialExplosion(
+        vec2f const & centerPosition,
+        float strength)
+    {
+        mRadialExplosionFields.emplace_back(centerPosition, strength);
+    }
+
+    /*
+     * The space warp is referenced, hence it must outlive the batch's contents.
+     */
+    void AddRadialSpaceWarp(RadialSpaceWarpForceField const & radialSpaceWarpForceField)
+    {
+        mRadialSpaceWarpFields.push_back(&radialSpaceWarpForceField);
+    }
+
+    /*
+     * The blast is referenced, hence it must outlive the batch's contents.
+     */
+    void AddBlast(BlastForceField const & blastForceField)
+    {
+        mBlastFields.push_back(&blastForceField);
+    }
+
+    void Apply(
+        Points & points,
+        float currentSimulationTime,
+        GameParameters const & gameParameters) const;
+
+private:
+
+    void ApplyCentralFields(Points & points) const;
+
+private:
+
+    struct CentralField
+    {
+        vec2f CenterPosition;
+        float Strength;
+
+        CentralField(
+            vec2f const & centerPosition,
+            float strength)
+            : CenterPosition(centerPosition)
+            , Strength(strength)
+        {}
+    };
+
+    // Fields acting on all points
+    std::vector<CentralField> mDrawFields;
+    std::vector<CentralField> mSwirlFields;
+    std::vector<CentralField> mImplosionFields;
+    std::vector<CentralField> mRadialExplosionFields;
+
+    // Fields acting on their own points
+    std::vector<RadialSpaceWarpForceField const *> mRadialSpaceWarpFields;
+    std::vector<BlastForceField const *> mBlastFields;
+};
+
 }
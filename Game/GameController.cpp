@@ -5,14 +5,18 @@
 ***************************************************************************************/
 #include "GameController.h"
 
+#include <GameCore/FloatingPoint.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
 
+#include <algorithm>
+
 std::unique_ptr<GameController> GameController::Create(
     bool isStatusTextEnabled,
     bool isExtendedStatusTextEnabled,
     std::function<void()> swapRenderBuffersFunction,
     std::shared_ptr<ResourceLoader> resourceLoader,
+    std::filesystem::path const & userCacheFolderPath,
     ProgressCallback const & progressCallback)
 {
     // Load materials
@@ -24,6 +28,7 @@ std::unique_ptr<GameController> GameController::Create(
     // Create render context
     std::unique_ptr<Render::RenderContext> renderContext = std::make_unique<Render::RenderContext>(
         *resourceLoader,
+        userCacheFolderPath / "TextureAtlasCache",
         [&progressCallback](float progress, std::string const & message)
         {
             progressCallback(0.9f * progress, message);
@@ -45,7 +50,8 @@ std::unique_ptr<GameController> GameController::Create(
             std::move(gameEventDispatcher),
             std::move(textLayer),
             std::move(materialDatabase),
-            resourceLoader));
+            resourceLoader,
+            userCacheFolderPath));
 }
 
 void GameController::RegisterGameEventHandler(IGameEventHandler * gameEventHandler)
@@ -58,7 +64,7 @@ void GameController::ResetAndLoadShip(std::filesystem::path const & shipDefiniti
 {
     // Create a new world
     auto newWorld = std::make_unique<Physics::World>(
-        mGameEventDispatcher,
+        mWorldGameEventBuffer,
         mGameParameters,
         *mResourceLoader);
 
@@ -69,6 +75,7 @@ void GameController::ResetAndLoadShip(std::filesystem::path const & shipDefiniti
     ShipId shipId = newWorld->AddShip(
         shipDefinition,
         mMaterialDatabase,
+        &mShipCache,
         mGameParameters);
 
     //
@@ -92,6 +99,7 @@ void GameController::AddShip(std::filesystem::path const & shipDefinitionFilepat
     ShipId shipId = mWorld->AddShip(
         shipDefinition,
         mMaterialDatabase,
+        &mShipCache,
         mGameParameters);
 
     //
@@ -108,7 +116,7 @@ void GameController::ReloadLastShip()
 {
     // Create a new world
     auto newWorld = std::make_unique<Physics::World>(
-        mGameEventDispatcher,
+        mWorldGameEventBuffer,
         mGameParameters,
         *mResourceLoader);
 
@@ -125,6 +133,7 @@ void GameController::ReloadLastShip()
     ShipId shipId = newWorld->AddShip(
         shipDefinition,
         mMaterialDatabase,
+        &mShipCache,
         mGameParameters);
 
     //
@@ -146,26 +155,6 @@ RgbImageData GameController::TakeScreenshot()
 
 void GameController::RunGameIteration()
 {
-    ///////////////////////////////////////////////////////////
-    // Update simulation
-    ///////////////////////////////////////////////////////////
-
-    // Make sure we're not paused
-    if (!mIsPaused && !mIsMoveToolEngaged)
-    {
-        auto const startTime = std::chrono::steady_clock::now();
-
-        InternalUpdate();
-
-        auto const endTime = std::chrono::steady_clock::now();
-        mTotalUpdateDuration += endTime - startTime;
-    }
-
-
-    ///////////////////////////////////////////////////////////
-    // Render
-    ///////////////////////////////////////////////////////////
-
     //
     // Initialize render stats, if needed
     //
@@ -189,20 +178,100 @@ void GameController::RunGameIteration()
     }
 
 
-    //
-    // Render
-    //
+    ///////////////////////////////////////////////////////////
+    // Upload the current state of the world
+    ///////////////////////////////////////////////////////////
 
-    auto const startTime = std::chrono::steady_clock::now();
+    auto const uploadStartTime = std::chrono::steady_clock::now();
 
-    // Flip the (previous) back buffer onto the screen
-    mSwapRenderBuffersFunction();
+    InternalRenderUpload();
 
-    // Render
-    InternalRender();
+    mTotalRenderDuration += std::chrono::steady_clock::now() - uploadStartTime;
+
+
+    ///////////////////////////////////////////////////////////
+    // Draw the uploaded state, while updating the simulation
+    ///////////////////////////////////////////////////////////
+
+    auto const drawTask = [this]()
+    {
+        auto const startTime = std::chrono::steady_clock::now();
+
+        // Flip the (previous) back buffer onto the screen
+        mSwapRenderBuffersFunction();
+
+        // Draw
+        mRenderContext->Draw();
+
+        mTotalRenderDuration += std::chrono::steady_clock::now() - startTime;
+    };
+
+    // Make sure we're not paused
+    if (!mIsPaused && !mIsMoveToolEngaged)
+    {
+        VectorFieldRenderMode const vectorFieldRenderMode = mRenderContext->GetVectorFieldRenderMode();
+
+        int const simulationStepCount = ScheduleSimulationSteps(std::chrono::steady_clock::now());
+
+        auto const updateTask = [this, vectorFieldRenderMode, simulationStepCount]()
+        {
+            // This task may run on either thread of the pool, which must thus agree on
+            // the floating point mode - or else the simulation would change behavior
+            // from one frame to the next
+            assert(GetFloatingPointMode() == mUpdateAndDrawThreadPool.GetFloatingPointMode());
+
+            auto const startTime = std::chrono::steady_clock::now();
+
+            assert(!!mWorld);
+            for (int step = 0; step < simulationStepCount; ++step)
+            {
+                mWorld->Update(
+                    mGameParameters,
+                    vectorFieldRenderMode);
+            }
+
+            mTotalUpdateDuration += std::chrono::steady_clock::now() - startTime;
+        };
+
+        // Game event handlers expect to be invoked on our thread
+        mWorldGameEventBuffer->StartBuffering();
+
+        // The first task is run on our thread, which owns the OpenGL context;
+        // should either task throw, we stop buffering before letting the error
+        // reach our caller
+        try
+        {
+            mUpdateAndDrawThreadPool.Run({ drawTask, updateTask });
+        }
+        catch (...)
+        {
+            mWorldGameEventBuffer->PublishAndStopBuffering();
+            throw;
+        }
 
-    auto const endTime = std::chrono::steady_clock::now();
-    mTotalRenderDuration += endTime - startTime;
+        mWorldGameEventBuffer->PublishAndStopBuffering();
+
+        // The tools' force fields have now been applied at each step of this frame;
+        // when this frame has run no steps we keep them for the next frame instead,
+        // where the tools will replace - rather than add to - them
+        if (simulationStepCount > 0)
+        {
+            mWorld->ResetToolForceFields();
+        }
+
+        InternalPostUpdate();
+    }
+    else
+    {
+        // Start afresh once we're resumed, rather than catching up
+        // with the time we've been paused for
+        ResetSimulationSchedule();
+
+        // Don't let tools pile up force fields while we're not simulating
+        mWorld->ResetToolForceFields();
+
+        drawTask();
+    }
 
 
     //
@@ -509,8 +578,13 @@ void GameController::InternalUpdate()
     assert(!!mWorld);
     mWorld->Update(
         mGameParameters,
-        *mRenderContext);
+        mRenderContext->GetVectorFieldRenderMode());
+
+    InternalPostUpdate();
+}
 
+void GameController::InternalPostUpdate()
+{
     // Update text layer
     mTextLayer->Update();
 
@@ -519,6 +593,13 @@ void GameController::InternalUpdate()
 }
 
 void GameController::InternalRender()
+{
+    InternalRenderUpload();
+
+    mRenderContext->Draw();
+}
+
+void GameController::InternalRenderUpload()
 {
     //
     // Do zoom smoothing
@@ -559,22 +640,22 @@ void GameController::InternalRender()
 
 
     //
-    // Start rendering
+    // Start uploading
     //
 
-    mRenderContext->RenderStart();
+    mRenderContext->UploadStart();
 
 
     //
-    // Render world
+    // Upload world
     //
 
     assert(!!mWorld);
-    mWorld->Render(mGameParameters, *mRenderContext);
+    mWorld->RenderUpload(mGameParameters, mRenderInterpolationFactor, *mRenderContext);
 
 
     //
-    // Render text layer
+    // Upload text layer
     //
 
     assert(!!mTextLayer);
@@ -582,10 +663,10 @@ void GameController::InternalRender()
 
 
     //
-    // Finish rendering
+    // Finish uploading
     //
 
-    mRenderContext->RenderEnd();
+    mRenderContext->UploadEnd();
 }
 
 void GameController::SmoothToTarget(
@@ -615,12 +696,64 @@ void GameController::SmoothToTarget(
     }
 }
 
+int GameController::ScheduleSimulationSteps(std::chrono::steady_clock::time_point nowReal)
+{
+    static constexpr std::chrono::steady_clock::duration StepDuration =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::microseconds(
+                static_cast<std::chrono::microseconds::rep>(GameParameters::SimulationStepTimeDuration<double> * 1000000.0 + 0.5)));
+
+    int stepCount;
+
+    if (!mLastSimulationScheduleTimestamp)
+    {
+        // First frame: run one step, so that we start moving right away
+        stepCount = 1;
+        mSimulationTimeAccumulator = std::chrono::steady_clock::duration::zero();
+    }
+    else
+    {
+        mSimulationTimeAccumulator += nowReal - *mLastSimulationScheduleTimestamp;
+
+        // Drop the time we can't possibly catch up with
+        mSimulationTimeAccumulator = std::min(
+            mSimulationTimeAccumulator,
+            StepDuration * MaxSimulationStepsPerFrame);
+
+        stepCount = static_cast<int>(mSimulationTimeAccumulator / StepDuration);
+        mSimulationTimeAccumulator -= StepDuration * stepCount;
+    }
+
+    mLastSimulationScheduleTimestamp = nowReal;
+
+    mRenderInterpolationFactor =
+        std::chrono::duration<float>(mSimulationTimeAccumulator).count()
+        / std::chrono::duration<float>(StepDuration).count();
+
+    assert(stepCount >= 0 && stepCount <= MaxSimulationStepsPerFrame);
+    assert(mRenderInterpolationFactor >= 0.0f && mRenderInterpolationFactor < 1.0f);
+
+    return stepCount;
+}
+
+void GameController::ResetSimulationSchedule()
+{
+    mLastSimulationScheduleTimestamp.reset();
+    mSimulationTimeAccumulator = std::chrono::steady_clock::duration::zero();
+
+    // Render the current state as it is
+    mRenderInterpolationFactor = 1.0f;
+}
+
 void GameController::Reset(std::unique_ptr<Physics::World> newWorld)
 {
     // Reset world
     assert(!!mWorld);
     mWorld = std::move(newWorld);
 
+    // Reset simulation schedule
+    ResetSimulationSchedule();
+
     // Reset rendering engine
     assert(!!mRenderContext);
     mRenderContext->Reset();
@@ -692,6 +825,13 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
     assert(!!mGameEventDispatcher);
     mGameEventDispatcher->OnUpdateToRenderRatioUpdated(lastURRatio);
 
+    // Publish update phase durations
+    if (mGameParameters.DoProfileShipUpdates)
+    {
+        assert(!!mWorld);
+        mWorld->PublishShipUpdatePhaseDurations();
+    }
+
     // Update status text
     assert(!!mTextLayer);
     mTextLayer->SetStatusText(
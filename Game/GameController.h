@@ -5,18 +5,21 @@
 ***************************************************************************************/
 #pragma once
 
+#include "GameEventBuffer.h"
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
 #include "MaterialDatabase.h"
 #include "Physics.h"
 #include "RenderContext.h"
 #include "ResourceLoader.h"
+#include "ShipCache.h"
 #include "TextLayer.h"
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
 #include <GameCore/ImageData.h>
 #include <GameCore/ProgressCallback.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <cassert>
@@ -24,6 +27,7 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 /*
@@ -39,6 +43,7 @@ public:
         bool isExtendedStatusTextEnabled,
         std::function<void()> swapRenderBuffersFunction,
         std::shared_ptr<ResourceLoader> resourceLoader,
+        std::filesystem::path const & userCacheFolderPath,
         ProgressCallback const & progressCallback);
 
     std::shared_ptr<IGameEventHandler> GetGameEventHandler()
@@ -267,6 +272,9 @@ public:
     bool GetDoGenerateAirBubbles() const { return mGameParameters.DoGenerateAirBubbles; }
     void SetDoGenerateAirBubbles(bool value) { mGameParameters.DoGenerateAirBubbles = value; }
 
+    bool GetDoProfileShipUpdates() const { return mGameParameters.DoProfileShipUpdates; }
+    void SetDoProfileShipUpdates(bool value) { mGameParameters.DoProfileShipUpdates = value; }
+
     size_t GetNumberOfStars() const { return mGameParameters.NumberOfStars; }
     void SetNumberOfStars(size_t value) { mGameParameters.NumberOfStars = value; }
     size_t GetMinNumberOfStars() const { return GameParameters::MinNumberOfStars; }
@@ -318,22 +326,30 @@ private:
         std::unique_ptr<GameEventDispatcher> gameEventDispatcher,
         std::unique_ptr<TextLayer> textLayer,
         MaterialDatabase materialDatabase,
-        std::shared_ptr<ResourceLoader> resourceLoader)
+        std::shared_ptr<ResourceLoader> resourceLoader,
+        std::filesystem::path const & userCacheFolderPath)
         : mGameParameters()
         , mLastShipLoadedFilepath()
         , mIsPaused(false)
         , mIsMoveToolEngaged(false)
+        // Simulation schedule
+        , mLastSimulationScheduleTimestamp()
+        , mSimulationTimeAccumulator(std::chrono::steady_clock::duration::zero())
+        , mRenderInterpolationFactor(1.0f)
         // Doers
         , mRenderContext(std::move(renderContext))
         , mSwapRenderBuffersFunction(std::move(swapRenderBuffersFunction))
         , mGameEventDispatcher(std::move(gameEventDispatcher))
         , mResourceLoader(std::move(resourceLoader))
         , mTextLayer(std::move(textLayer))
+        , mWorldGameEventBuffer(std::make_shared<GameEventBuffer>(mGameEventDispatcher))
+        , mUpdateAndDrawThreadPool(2)
         , mWorld(new Physics::World(
-            mGameEventDispatcher,
+            mWorldGameEventBuffer,
             mGameParameters,
             *mResourceLoader))
         , mMaterialDatabase(std::move(materialDatabase))
+        , mShipCache(userCacheFolderPath / "ShipCache")
          // Smoothing
         , mCurrentZoom(mRenderContext->GetZoom())
         , mTargetZoom(mCurrentZoom)
@@ -359,8 +375,16 @@ private:
 
     void InternalUpdate();
 
+    void InternalPostUpdate();
+
     void InternalRender();
 
+    void InternalRenderUpload();
+
+    int ScheduleSimulationSteps(std::chrono::steady_clock::time_point nowReal);
+
+    void ResetSimulationSchedule();
+
     static void SmoothToTarget(
         float & currentValue,
         float startingValue,
@@ -388,6 +412,24 @@ private:
     bool mIsMoveToolEngaged;
 
 
+    //
+    // The simulation schedule: the world is always updated in steps of the same
+    // (simulated) duration, as many of them per frame as needed to keep up with
+    // the time that has actually elapsed
+    //
+
+    // The maximum number of steps run in a single frame; when the simulation
+    // cannot keep up, the time beyond this is dropped and the simulation slows down
+    static constexpr int MaxSimulationStepsPerFrame = 4;
+
+    std::optional<std::chrono::steady_clock::time_point> mLastSimulationScheduleTimestamp;
+    std::chrono::steady_clock::duration mSimulationTimeAccumulator;
+
+    // How far between the state before the last step and the current state
+    // the world should be rendered, given the time left in the accumulator
+    float mRenderInterpolationFactor;
+
+
     //
     // The doers
     //
@@ -398,12 +440,22 @@ private:
     std::shared_ptr<ResourceLoader> mResourceLoader;
     std::shared_ptr<TextLayer> mTextLayer;
 
+    // Sits between the world and the game event dispatcher, so that the events fired
+    // while the world is being updated concurrently with drawing are only dispatched
+    // - on our thread - once the update is complete
+    std::shared_ptr<GameEventBuffer> mWorldGameEventBuffer;
+
+    // Runs the drawing of a frame - on our thread - concurrently with the update that
+    // prepares the next frame
+    TaskThreadPool mUpdateAndDrawThreadPool;
+
     //
     // The world
     //
 
     std::unique_ptr<Physics::World> mWorld;
     MaterialDatabase mMaterialDatabase;
+    ShipCache mShipCache;
 
 
     //
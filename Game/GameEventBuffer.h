@@ -0,0 +1,517 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-01-10
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "IGameEventHandler.h"
+
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/*
+ * A game event handler that sits between a single ship and the world's game event handler.
+ *
+ * Outside of buffering, events are forwarded to the target handler as they come. While
+ * buffering - i.e. while the ship is being updated, possibly concurrently with other ships -
+ * events are recorded in the order in which they are fired, and they are only forwarded to
+ * the target handler when buffering stops; the world stops buffering ships one at a time,
+ * in ship order, so that the target handler sees exactly the same sequence of events it
+ * would see if ships were updated one after the other.
+ *
+ * The exception are the events that the target handler aggregates - stress, breaks, light
+ * flickers, bomb explosions, RC bomb pings, and timer bomb defusals - which are fired in
+ * large numbers and whose order is lost in the aggregation anyway: these are always forwarded
+ * as they come, hence the target handler must accept them concurrently, as GameEventDispatcher
+ * does.
+ *
+ * Not thread-safe: a buffer is only ever used by one ship at a time.
+ */
+class GameEventBuffer : public IGameEventHandler
+{
+public:
+
+    explicit GameEventBuffer(std::shared_ptr<IGameEventHandler> targetHandler)
+        : mTargetHandler(std::move(targetHandler))
+        , mIsBuffering(false)
+        , mBufferedEvents()
+    {
+    }
+
+    void StartBuffering()
+    {
+        assert(!mIsBuffering);
+        assert(mBufferedEvents.empty());
+
+        mIsBuffering = true;
+    }
+
+    /*
+     * Forwards all the events recorded so far to the target handler,
+     * and goes back to forwarding events as they come.
+     */
+    void PublishAndStopBuffering()
+    {
+        assert(mIsBuffering);
+
+        for (auto const & bufferedEvent : mBufferedEvents)
+        {
+            std::visit(
+                [this](auto const & event)
+                {
+                    event.PublishTo(*mTargetHandler);
+                },
+                bufferedEvent);
+        }
+
+        // Keep the capacity, it will most likely be needed again at the next step
+        mBufferedEvents.clear();
+
+        mIsBuffering = false;
+    }
+
+public:
+
+    virtual void OnGameReset() override
+    {
+        Dispatch(GameResetEvent{});
+    }
+
+    virtual void OnShipLoaded(
+        unsigned int id,
+        std::string const & name,
+        std::optional<std::string> const & author) override
+    {
+        Dispatch(ShipLoadedEvent{ id, name, author });
+    }
+
+    virtual void OnDestroy(
+        StructuralMaterial const & structuralMaterial,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        Dispatch(DestroyEvent{ &structuralMaterial, isUnderwater, size });
+    }
+
+    virtual void OnSawed(
+        bool isMetal,
+        unsigned int size) override
+    {
+        Dispatch(SawedEvent{ isMetal, size });
+    }
+
+    virtual void OnPinToggled(
+        bool isPinned,
+        bool isUnderwater) override
+    {
+        Dispatch(PinToggledEvent{ isPinned, isUnderwater });
+    }
+
+    virtual void OnStress(
+        StructuralMaterial const & structuralMaterial,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Aggregated by the target handler, no need to buffer this one
+        mTargetHandler->OnStress(structuralMaterial, isUnderwater, size);
+    }
+
+    virtual void OnBreak(
+        StructuralMaterial const & structuralMaterial,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Aggregated by the target handler, no need to buffer this one
+        mTargetHandler->OnBreak(structuralMaterial, isUnderwater, size);
+    }
+
+    virtual void OnSinkingBegin(ShipId shipId) override
+    {
+        Dispatch(SinkingBeginEvent{ shipId });
+    }
+
+    virtual void OnLightFlicker(
+        DurationShortLongType duration,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Aggregated by the target handler, no need to buffer this one
+        mTargetHandler->OnLightFlicker(duration, isUnderwater, size);
+    }
+
+    virtual void OnWaterTaken(float waterTaken) override
+    {
+        Dispatch(WaterTakenEvent{ waterTaken });
+    }
+
+    virtual void OnWaterSplashed(float waterSplashed) override
+    {
+        Dispatch(WaterSplashedEvent{ waterSplashed });
+    }
+
+    virtual void OnWindSpeedUpdated(
+        float const zeroSpeedMagnitude,
+        float const baseSpeedMagnitude,
+        float const preMaxSpeedMagnitude,
+        float const maxSpeedMagnitude,
+        vec2f const & windSpeed) override
+    {
+        Dispatch(WindSpeedUpdatedEvent{ zeroSpeedMagnitude, baseSpeedMagnitude, preMaxSpeedMagnitude, maxSpeedMagnitude, windSpeed });
+    }
+
+    virtual void OnCustomProbe(
+        std::string const & name,
+        float value) override
+    {
+        Dispatch(CustomProbeEvent{ name, value });
+    }
+
+    virtual void OnFrameRateUpdated(
+        float immediateFps,
+        float averageFps) override
+    {
+        Dispatch(FrameRateUpdatedEvent{ immediateFps, averageFps });
+    }
+
+    virtual void OnUpdateToRenderRatioUpdated(
+        float immediateURRatio) override
+    {
+        Dispatch(UpdateToRenderRatioUpdatedEvent{ immediateURRatio });
+    }
+
+    virtual void OnShipUpdatePhaseDurationUpdated(
+        ShipUpdatePhase phase,
+        float averageDurationMs) override
+    {
+        Dispatch(ShipUpdatePhaseDurationUpdatedEvent{ phase, averageDurationMs });
+    }
+
+    //
+    // Bombs
+    //
+
+    virtual void OnBombPlaced(
+        ObjectId bombId,
+        BombType bombType,
+        bool isUnderwater) override
+    {
+        Dispatch(BombPlacedEvent{ bombId, bombType, isUnderwater });
+    }
+
+    virtual void OnBombRemoved(
+        ObjectId bombId,
+        BombType bombType,
+        std::optional<bool> isUnderwater) override
+    {
+        Dispatch(BombRemovedEvent{ bombId, bombType, isUnderwater });
+    }
+
+    virtual void OnBombExplosion(
+        BombType bombType,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Aggregated by the target handler, no need to buffer this one
+        mTargetHandler->OnBombExplosion(bombType, isUnderwater, size);
+    }
+
+    virtual void OnRCBombPing(
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Aggregated by the target handler, no need to buffer this one
+        mTargetHandler->OnRCBombPing(isUnderwater, size);
+    }
+
+    virtual void OnTimerBombFuse(
+        ObjectId bombId,
+        std::optional<bool> isFast) override
+    {
+        Dispatch(TimerBombFuseEvent{ bombId, isFast });
+    }
+
+    virtual void OnTimerBombDefused(
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Aggregated by the target handler, no need to buffer this one
+        mTargetHandler->OnTimerBombDefused(isUnderwater, size);
+    }
+
+    virtual void OnAntiMatterBombContained(
+        ObjectId bombId,
+        bool isContained) override
+    {
+        Dispatch(AntiMatterBombContainedEvent{ bombId, isContained });
+    }
+
+    virtual void OnAntiMatterBombPreImploding() override
+    {
+        Dispatch(AntiMatterBombPreImplodingEvent{});
+    }
+
+    virtual void OnAntiMatterBombImploding() override
+    {
+        Dispatch(AntiMatterBombImplodingEvent{});
+    }
+
+private:
+
+    //
+    // The records of the events we buffer, each able to publish itself to a handler
+    //
+
+    struct GameResetEvent
+    {
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnGameReset();
+        }
+    };
+
+    struct ShipLoadedEvent
+    {
+        unsigned int Id;
+        std::string Name;
+        std::optional<std::string> Author;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnShipLoaded(Id, Name, Author);
+        }
+    };
+
+    struct DestroyEvent
+    {
+        // Materials live in the material database, hence we may hold on to them
+        StructuralMaterial const * Material;
+        bool IsUnderwater;
+        unsigned int Size;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnDestroy(*Material, IsUnderwater, Size);
+        }
+    };
+
+    struct SawedEvent
+    {
+        bool IsMetal;
+        unsigned int Size;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnSawed(IsMetal, Size);
+        }
+    };
+
+    struct PinToggledEvent
+    {
+        bool IsPinned;
+        bool IsUnderwater;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnPinToggled(IsPinned, IsUnderwater);
+        }
+    };
+
+    struct SinkingBeginEvent
+    {
+        ShipId Ship;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnSinkingBegin(Ship);
+        }
+    };
+
+    struct WaterTakenEvent
+    {
+        float WaterTaken;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnWaterTaken(WaterTaken);
+        }
+    };
+
+    struct WaterSplashedEvent
+    {
+        float WaterSplashed;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnWaterSplashed(WaterSplashed);
+        }
+    };
+
+    struct WindSpeedUpdatedEvent
+    {
+        float ZeroSpeedMagnitude;
+        float BaseSpeedMagnitude;
+        float PreMaxSpeedMagnitude;
+        float MaxSpeedMagnitude;
+        vec2f WindSpeed;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnWindSpeedUpdated(ZeroSpeedMagnitude, BaseSpeedMagnitude, PreMaxSpeedMagnitude, MaxSpeedMagnitude, WindSpeed);
+        }
+    };
+
+    struct CustomProbeEvent
+    {
+        std::string Name;
+        float Value;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnCustomProbe(Name, Value);
+        }
+    };
+
+    struct FrameRateUpdatedEvent
+    {
+        float ImmediateFps;
+        float AverageFps;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnFrameRateUpdated(ImmediateFps, AverageFps);
+        }
+    };
+
+    struct UpdateToRenderRatioUpdatedEvent
+    {
+        float ImmediateURRatio;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnUpdateToRenderRatioUpdated(ImmediateURRatio);
+        }
+    };
+
+    struct ShipUpdatePhaseDurationUpdatedEvent
+    {
+        ShipUpdatePhase Phase;
+        float AverageDurationMs;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnShipUpdatePhaseDurationUpdated(Phase, AverageDurationMs);
+        }
+    };
+
+    struct BombPlacedEvent
+    {
+        ObjectId BombId;
+        BombType Type;
+        bool IsUnderwater;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnBombPlaced(BombId, Type, IsUnderwater);
+        }
+    };
+
+    struct BombRemovedEvent
+    {
+        ObjectId BombId;
+        BombType Type;
+        std::optional<bool> IsUnderwater;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnBombRemoved(BombId, Type, IsUnderwater);
+        }
+    };
+
+    struct TimerBombFuseEvent
+    {
+        ObjectId BombId;
+        std::optional<bool> IsFast;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnTimerBombFuse(BombId, IsFast);
+        }
+    };
+
+    struct AntiMatterBombContainedEvent
+    {
+        ObjectId BombId;
+        bool IsContained;
+
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnAntiMatterBombContained(BombId, IsContained);
+        }
+    };
+
+    struct AntiMatterBombPreImplodingEvent
+    {
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnAntiMatterBombPreImploding();
+        }
+    };
+
+    struct AntiMatterBombImplodingEvent
+    {
+        void PublishTo(IGameEventHandler & handler) const
+        {
+            handler.OnAntiMatterBombImploding();
+        }
+    };
+
+    // Events are stored by value, hence - once the vector has grown to the
+    // number of events of a step - buffering an event does not allocate
+    using BufferedEvent = std::variant<
+        GameResetEvent,
+        ShipLoadedEvent,
+        DestroyEvent,
+        SawedEvent,
+        PinToggledEvent,
+        SinkingBeginEvent,
+        WaterTakenEvent,
+        WaterSplashedEvent,
+        WindSpeedUpdatedEvent,
+        CustomProbeEvent,
+        FrameRateUpdatedEvent,
+        UpdateToRenderRatioUpdatedEvent,
+        ShipUpdatePhaseDurationUpdatedEvent,
+        BombPlacedEvent,
+        BombRemovedEvent,
+        TimerBombFuseEvent,
+        AntiMatterBombContainedEvent,
+        AntiMatterBombPreImplodingEvent,
+        AntiMatterBombImplodingEvent>;
+
+    template<typename TEvent>
+    inline void Dispatch(TEvent && event)
+    {
+        if (mIsBuffering)
+        {
+            mBufferedEvents.emplace_back(std::forward<TEvent>(event));
+        }
+        else
+        {
+            event.PublishTo(*mTargetHandler);
+        }
+    }
+
+private:
+
+    std::shared_ptr<IGameEventHandler> const mTargetHandler;
+
+    bool mIsBuffering;
+
+    std::vector<BufferedEvent> mBufferedEvents;
+};
@@ -7,24 +7,41 @@
 
 #include "IGameEventHandler.h"
 
-#include <GameCore/TupleKeys.h>
-
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <tuple>
 #include <vector>
 
+/*
+ * Aggregates the events that may be fired in large numbers at each step - stress, breaks,
+ * light flickers, and bomb events - and publishes them to the sinks at Flush(); all other
+ * events are published to the sinks as they come.
+ *
+ * The aggregated events may be fired concurrently from multiple threads: each thread
+ * stages them in its own area, in counters indexed by enums and by material ordinals,
+ * and the areas are merged at Flush(), which must not run concurrently with them. A
+ * thread gives its areas back when it exits; threads that find all MaxStagingAreas
+ * areas taken by live threads stage their events in a shared area, under a lock.
+ */
 class GameEventDispatcher : public IGameEventHandler
 {
 public:
 
+    static constexpr size_t MaxStagingAreas = 64;
+
     GameEventDispatcher()
-        : mStressEvents()
-        , mBreakEvents()
+        : mId(MakeId())
+        , mStagingAreas()
+        , mStagingAreaClaims(std::make_shared<StagingAreaClaims>())
+        , mSharedStagingArea()
+        , mSharedStagingAreaLock()
+        , mMergedEvents()
         , mSinkingBeginEvents()
-        , mLightFlickerEvents()
-        , mBombExplosionEvents()
-        , mRCBombPingEvents()
-        , mTimerBombDefusedEvents()
         , mSinks()
     {
     }
@@ -91,7 +108,11 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mStressEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        StageEvent(
+            [&](EventStagingArea & stagingArea)
+            {
+                stagingArea.StressEvents.Add(structuralMaterial, isUnderwater, size);
+            });
     }
 
     virtual void OnBreak(
@@ -99,7 +120,11 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mBreakEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        StageEvent(
+            [&](EventStagingArea & stagingArea)
+            {
+                stagingArea.BreakEvents.Add(structuralMaterial, isUnderwater, size);
+            });
     }
 
     virtual void OnSinkingBegin(ShipId shipId) override
@@ -115,7 +140,11 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mLightFlickerEvents[std::make_tuple(duration, isUnderwater)] += size;
+        StageEvent(
+            [&](EventStagingArea & stagingArea)
+            {
+                stagingArea.LightFlickerEvents[static_cast<size_t>(duration)][isUnderwater ? 1 : 0] += size;
+            });
     }
 
     virtual void OnWaterTaken(float waterTaken) override
@@ -192,6 +221,19 @@ public:
         }
     }
 
+    virtual void OnShipUpdatePhaseDurationUpdated(
+        ShipUpdatePhase phase,
+        float averageDurationMs) override
+    {
+        // No need to aggregate this one
+        for (auto sink : mSinks)
+        {
+            sink->OnShipUpdatePhaseDurationUpdated(
+                phase,
+                averageDurationMs);
+        }
+    }
+
     //
     // Bombs
     //
@@ -231,14 +273,22 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mBombExplosionEvents[std::make_tuple(bombType, isUnderwater)] += size;
+        StageEvent(
+            [&](EventStagingArea & stagingArea)
+            {
+                stagingArea.BombExplosionEvents[static_cast<size_t>(bombType)][isUnderwater ? 1 : 0] += size;
+            });
     }
 
     virtual void OnRCBombPing(
         bool isUnderwater,
         unsigned int size) override
     {
-        mRCBombPingEvents[std::make_tuple(isUnderwater)] += size;
+        StageEvent(
+            [&](EventStagingArea & stagingArea)
+            {
+                stagingArea.RCBombPingEvents[isUnderwater ? 1 : 0] += size;
+            });
     }
 
     virtual void OnTimerBombFuse(
@@ -258,7 +308,11 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mTimerBombDefusedEvents[std::make_tuple(isUnderwater)] += size;
+        StageEvent(
+            [&](EventStagingArea & stagingArea)
+            {
+                stagingArea.TimerBombDefusedEvents[isUnderwater ? 1 : 0] += size;
+            });
     }
 
     virtual void OnAntiMatterBombContained(
@@ -299,53 +353,72 @@ public:
      */
     void Flush()
     {
+        // Merge the events staged by all threads - including the ones
+        // staged by threads that have since given their areas back
+        size_t const stagingAreaCount = mStagingAreaClaims->UsedCount.load(std::memory_order_acquire);
+        for (size_t s = 0; s < stagingAreaCount; ++s)
+        {
+            mStagingAreas[s].MergeInto(mMergedEvents);
+            mStagingAreas[s].Clear();
+        }
+
+        mSharedStagingArea.MergeInto(mMergedEvents);
+        mSharedStagingArea.Clear();
+
         // Publish aggregations
         for (IGameEventHandler * sink : mSinks)
         {
-            for (auto const & entry : mStressEvents)
-            {
-                sink->OnStress(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
-            }
-
-            for (auto const & entry : mBreakEvents)
-            {
-                sink->OnBreak(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
-            }
+            mMergedEvents.StressEvents.Visit(
+                [sink](StructuralMaterial const & structuralMaterial, bool isUnderwater, unsigned int size)
+                {
+                    sink->OnStress(structuralMaterial, isUnderwater, size);
+                });
+
+            mMergedEvents.BreakEvents.Visit(
+                [sink](StructuralMaterial const & structuralMaterial, bool isUnderwater, unsigned int size)
+                {
+                    sink->OnBreak(structuralMaterial, isUnderwater, size);
+                });
 
             for (auto const & shipId : mSinkingBeginEvents)
             {
                 sink->OnSinkingBegin(shipId);
             }
 
-            for (auto const & entry : mLightFlickerEvents)
+            for (size_t d = 0; d < DurationShortLongTypeCount; ++d)
             {
-                sink->OnLightFlicker(std::get<0>(entry.first), std::get<1>(entry.first), entry.second);
+                for (size_t u = 0; u < 2; ++u)
+                {
+                    if (0 != mMergedEvents.LightFlickerEvents[d][u])
+                        sink->OnLightFlicker(static_cast<DurationShortLongType>(d), u != 0, mMergedEvents.LightFlickerEvents[d][u]);
+                }
             }
 
-            for (auto const & entry : mBombExplosionEvents)
+            for (size_t b = 0; b < BombTypeCount; ++b)
             {
-                sink->OnBombExplosion(std::get<0>(entry.first), std::get<1>(entry.first), entry.second);
+                for (size_t u = 0; u < 2; ++u)
+                {
+                    if (0 != mMergedEvents.BombExplosionEvents[b][u])
+                        sink->OnBombExplosion(static_cast<BombType>(b), u != 0, mMergedEvents.BombExplosionEvents[b][u]);
+                }
             }
 
-            for (auto const & entry : mRCBombPingEvents)
+            for (size_t u = 0; u < 2; ++u)
             {
-                sink->OnRCBombPing(std::get<0>(entry.first), entry.second);
+                if (0 != mMergedEvents.RCBombPingEvents[u])
+                    sink->OnRCBombPing(u != 0, mMergedEvents.RCBombPingEvents[u]);
             }
 
-            for (auto const & entry : mTimerBombDefusedEvents)
+            for (size_t u = 0; u < 2; ++u)
             {
-                sink->OnTimerBombDefused(std::get<0>(entry.first), entry.second);
+                if (0 != mMergedEvents.TimerBombDefusedEvents[u])
+                    sink->OnTimerBombDefused(u != 0, mMergedEvents.TimerBombDefusedEvents[u]);
             }
         }
 
         // Clear collections
-        mStressEvents.clear();
-        mBreakEvents.clear();
+        mMergedEvents.Clear();
         mSinkingBeginEvents.clear();
-        mLightFlickerEvents.clear();
-        mBombExplosionEvents.clear();
-        mRCBombPingEvents.clear();
-        mTimerBombDefusedEvents.clear();
     }
 
     void RegisterSink(IGameEventHandler * sink)
@@ -355,14 +428,328 @@ public:
 
 private:
 
-    // The current events being aggregated
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mStressEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mBreakEvents;
+    static constexpr size_t DurationShortLongTypeCount = static_cast<size_t>(DurationShortLongType::Long) + 1;
+    static constexpr size_t BombTypeCount = static_cast<size_t>(BombType::TimerBomb) + 1;
+
+    /*
+     * Sizes of events by structural material and by underwater-ness, indexed by material ordinal.
+     *
+     * Materials that do not come from the material database might share ordinals; the ones
+     * that find their ordinal taken by a different material are kept in a (slow) list instead.
+     */
+    struct StructuralMaterialEvents
+    {
+        std::vector<StructuralMaterial const *> Materials;
+        std::vector<std::array<unsigned int, 2>> Sizes;
+        std::vector<std::tuple<StructuralMaterial const *, bool, unsigned int>> OverflowSizes;
+
+        inline void Add(
+            StructuralMaterial const & structuralMaterial,
+            bool isUnderwater,
+            unsigned int size)
+        {
+            size_t const ordinal = structuralMaterial.Ordinal;
+
+            if (ordinal >= Materials.size())
+            {
+                // Only grows until it has seen all materials
+                Materials.resize(ordinal + 1, nullptr);
+                Sizes.resize(ordinal + 1, { 0, 0 });
+            }
+
+            if (nullptr == Materials[ordinal])
+            {
+                Materials[ordinal] = &structuralMaterial;
+            }
+
+            if (Materials[ordinal] == &structuralMaterial)
+            {
+                Sizes[ordinal][isUnderwater ? 1 : 0] += size;
+            }
+            else
+            {
+                auto it = std::find_if(
+                    OverflowSizes.begin(),
+                    OverflowSizes.end(),
+                    [&structuralMaterial, isUnderwater](auto const & entry)
+                    {
+                        return std::get<0>(entry) == &structuralMaterial && std::get<1>(entry) == isUnderwater;
+                    });
+
+                if (it != OverflowSizes.end())
+                    std::get<2>(*it) += size;
+                else
+                    OverflowSizes.emplace_back(&structuralMaterial, isUnderwater, size);
+            }
+        }
+
+        template<typename TVisitor>
+        inline void Visit(TVisitor && visitor) const
+        {
+            for (size_t m = 0; m < Materials.size(); ++m)
+            {
+                for (size_t u = 0; u < 2; ++u)
+                {
+                    if (0 != Sizes[m][u])
+                        visitor(*(Materials[m]), u != 0, Sizes[m][u]);
+                }
+            }
+
+            for (auto const & entry : OverflowSizes)
+            {
+                visitor(*(std::get<0>(entry)), std::get<1>(entry), std::get<2>(entry));
+            }
+        }
+
+        inline void Clear()
+        {
+            // Keep the materials and the capacity, they will most likely be needed again
+            std::fill(Sizes.begin(), Sizes.end(), std::array<unsigned int, 2>{ 0, 0 });
+            OverflowSizes.clear();
+        }
+    };
+
+    /*
+     * The events staged by a single thread. Aligned so that threads do not share cache lines.
+     */
+    struct alignas(64) EventStagingArea
+    {
+        StructuralMaterialEvents StressEvents;
+        StructuralMaterialEvents BreakEvents;
+        std::array<std::array<unsigned int, 2>, DurationShortLongTypeCount> LightFlickerEvents;
+        std::array<std::array<unsigned int, 2>, BombTypeCount> BombExplosionEvents;
+        std::array<unsigned int, 2> RCBombPingEvents;
+        std::array<unsigned int, 2> TimerBombDefusedEvents;
+
+        EventStagingArea()
+            : StressEvents()
+            , BreakEvents()
+            , LightFlickerEvents()
+            , BombExplosionEvents()
+            , RCBombPingEvents()
+            , TimerBombDefusedEvents()
+        {
+            Clear();
+        }
+
+        void MergeInto(EventStagingArea & target) const
+        {
+            StressEvents.Visit(
+                [&target](StructuralMaterial const & structuralMaterial, bool isUnderwater, unsigned int size)
+                {
+                    target.StressEvents.Add(structuralMaterial, isUnderwater, size);
+                });
+
+            BreakEvents.Visit(
+                [&target](StructuralMaterial const & structuralMaterial, bool isUnderwater, unsigned int size)
+                {
+                    target.BreakEvents.Add(structuralMaterial, isUnderwater, size);
+                });
+
+            for (size_t u = 0; u < 2; ++u)
+            {
+                for (size_t d = 0; d < DurationShortLongTypeCount; ++d)
+                    target.LightFlickerEvents[d][u] += LightFlickerEvents[d][u];
+
+                for (size_t b = 0; b < BombTypeCount; ++b)
+                    target.BombExplosionEvents[b][u] += BombExplosionEvents[b][u];
+
+                target.RCBombPingEvents[u] += RCBombPingEvents[u];
+                target.TimerBombDefusedEvents[u] += TimerBombDefusedEvents[u];
+            }
+        }
+
+        void Clear()
+        {
+            StressEvents.Clear();
+            BreakEvents.Clear();
+
+            for (auto & entry : LightFlickerEvents)
+                entry.fill(0);
+
+            for (auto & entry : BombExplosionEvents)
+                entry.fill(0);
+
+            RCBombPingEvents.fill(0);
+            TimerBombDefusedEvents.fill(0);
+        }
+    };
+
+    static std::uint64_t MakeId()
+    {
+        static std::atomic<std::uint64_t> nextId(1);
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*
+     * Which of the staging areas of a dispatcher are claimed by a (live) thread. Shared
+     * between the dispatcher and the threads that claimed its areas, so that a thread
+     * exiting after the dispatcher is gone does not touch it.
+     */
+    struct StagingAreaClaims
+    {
+        std::array<std::atomic<bool>, MaxStagingAreas> IsClaimed;
+
+        // The number of areas that have ever been claimed
+        std::atomic<size_t> UsedCount;
+
+        StagingAreaClaims()
+            : IsClaimed()
+            , UsedCount(0)
+        {
+            for (auto & isClaimed : IsClaimed)
+            {
+                isClaimed.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /*
+     * The staging areas claimed by a thread, which it gives back when it exits.
+     */
+    struct ThreadStagingAreas
+    {
+        struct Claim
+        {
+            std::uint64_t DispatcherId;
+            std::weak_ptr<StagingAreaClaims> DispatcherClaims;
+
+            // The index of the claimed area, or none when the thread stages its events
+            // in the dispatcher's shared area
+            std::optional<size_t> StagingAreaIndex;
+        };
+
+        std::vector<Claim> Claims;
+
+        ~ThreadStagingAreas()
+        {
+            for (auto const & claim : Claims)
+            {
+                auto const dispatcherClaims = claim.DispatcherClaims.lock();
+                if (!!dispatcherClaims && !!claim.StagingAreaIndex)
+                {
+                    // Let the next claimant see - and keep adding to - the events we have staged
+                    dispatcherClaims->IsClaimed[*claim.StagingAreaIndex].store(false, std::memory_order_release);
+                }
+            }
+        }
+    };
+
+    /*
+     * Stages an event in the staging area of the calling thread.
+     */
+    template<typename TStager>
+    inline void StageEvent(TStager && stager)
+    {
+        EventStagingArea * const stagingArea = GetStagingArea();
+        if (nullptr != stagingArea)
+        {
+            stager(*stagingArea);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mSharedStagingAreaLock);
+
+            stager(mSharedStagingArea);
+        }
+    }
+
+    /*
+     * Returns the staging area of the calling thread, or nullptr if the thread has to stage its
+     * events in the shared area. The area of the dispatcher the thread has last fired events into
+     * is remembered by the thread; the areas of other dispatchers are looked up among the thread's
+     * claims, and claimed the first time the thread fires an event into them.
+     */
+    inline EventStagingArea * GetStagingArea()
+    {
+        thread_local std::uint64_t threadDispatcherId = 0;
+        thread_local EventStagingArea * threadStagingArea = nullptr;
+
+        if (threadDispatcherId != mId)
+        {
+            threadStagingArea = FindOrClaimStagingArea();
+            threadDispatcherId = mId;
+        }
+
+        return threadStagingArea;
+    }
+
+    EventStagingArea * FindOrClaimStagingArea()
+    {
+        thread_local ThreadStagingAreas threadStagingAreas;
+
+        auto & claims = threadStagingAreas.Claims;
+
+        auto const claimIt = std::find_if(
+            claims.cbegin(),
+            claims.cend(),
+            [this](auto const & claim)
+            {
+                return claim.DispatcherId == mId;
+            });
+
+        if (claimIt != claims.cend())
+        {
+            return !!(claimIt->StagingAreaIndex)
+                ? &(mStagingAreas[*(claimIt->StagingAreaIndex)])
+                : nullptr;
+        }
+
+        // Forget about dispatchers that are gone
+        claims.erase(
+            std::remove_if(
+                claims.begin(),
+                claims.end(),
+                [](auto const & claim)
+                {
+                    return claim.DispatcherClaims.expired();
+                }),
+            claims.end());
+
+        // Claim the first free area
+        std::optional<size_t> stagingAreaIndex;
+        for (size_t s = 0; s < MaxStagingAreas; ++s)
+        {
+            bool isClaimed = false;
+            if (mStagingAreaClaims->IsClaimed[s].compare_exchange_strong(isClaimed, true, std::memory_order_acquire))
+            {
+                stagingAreaIndex = s;
+
+                size_t usedCount = mStagingAreaClaims->UsedCount.load(std::memory_order_relaxed);
+                while (usedCount < s + 1
+                    && !mStagingAreaClaims->UsedCount.compare_exchange_weak(usedCount, s + 1, std::memory_order_release))
+                {
+                }
+
+                break;
+            }
+        }
+
+        claims.push_back({ mId, mStagingAreaClaims, stagingAreaIndex });
+
+        return !!stagingAreaIndex
+            ? &(mStagingAreas[*stagingAreaIndex])
+            : nullptr;
+    }
+
+private:
+
+    // Our identity, distinguishing our staging areas from those of other dispatchers
+    std::uint64_t const mId;
+
+    // The aggregated events being staged, one area per thread
+    std::array<EventStagingArea, MaxStagingAreas> mStagingAreas;
+    std::shared_ptr<StagingAreaClaims> mStagingAreaClaims;
+
+    // The aggregated events staged by the threads that found no free area
+    EventStagingArea mSharedStagingArea;
+    std::mutex mSharedStagingAreaLock;
+
+    // The aggregated events staged by all threads, while flushing
+    EventStagingArea mMergedEvents;
+
+    // The current events being aggregated which are never fired concurrently
     std::vector<ShipId> mSinkingBeginEvents;
-    unordered_tuple_map<std::tuple<DurationShortLongType, bool>, unsigned int> mLightFlickerEvents;
-    unordered_tuple_map<std::tuple<BombType, bool>, unsigned int> mBombExplosionEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mRCBombPingEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mTimerBombDefusedEvents;
 
     // The registered sinks
     std::vector<IGameEventHandler *> mSinks;
@@ -46,5 +46,7 @@ GameParameters::GameParameters()
     , FloodQuantityOfWater(1.0f)
     , IsUltraViolentMode(false)
     , MoveToolInertia(8.0f)
+    // Diagnostics
+    , DoProfileShipUpdates(false)
 {
 }
\ No newline at end of file
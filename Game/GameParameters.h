@@ -224,6 +224,12 @@ struct GameParameters
 
     float MoveToolInertia;
 
+    //
+    // Diagnostics
+    //
+
+    bool DoProfileShipUpdates;
+
     //
     // Limits
     //
@@ -129,6 +129,13 @@ public:
         // Default-implemented
     }
 
+    virtual void OnShipUpdatePhaseDurationUpdated(
+        ShipUpdatePhase /*phase*/,
+        float /*averageDurationMs*/)
+    {
+        // Default-implemented
+    }
+
     //
     // Bombs
     //
@@ -12,13 +12,20 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
+#include <fstream>
 #include <regex>
 
 bool ImageFileTools::mIsInitialized = false;
 
 ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
 {
+    // Try first without decoding the whole image
+    auto const pngImageSize = TryGetPngImageSize(filepath);
+    if (!!pngImageSize)
+        return *pngImageSize;
+
     CheckInitialized();
 
     ILuint imghandle;
@@ -167,6 +174,43 @@ void ImageFileTools::SaveImage(
 ////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+std::optional<ImageSize> ImageFileTools::TryGetPngImageSize(std::filesystem::path const & filepath)
+{
+    //
+    // A PNG file starts with an 8-byte signature, immediately followed by the IHDR
+    // chunk: 4 bytes of length, 4 bytes of type, and then width and height, each
+    // as a 4-byte big-endian integer
+    //
+
+    static constexpr unsigned char PngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a };
+
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return std::nullopt;
+
+    unsigned char header[24];
+    if (!file.read(reinterpret_cast<char *>(header), sizeof(header)))
+        return std::nullopt;
+
+    if (0 != std::memcmp(header, PngSignature, sizeof(PngSignature))
+        || 0 != std::memcmp(header + 12, "IHDR", 4))
+    {
+        return std::nullopt;
+    }
+
+    auto const readBigEndian = [&header](size_t offset)
+    {
+        return (static_cast<uint32_t>(header[offset]) << 24)
+            | (static_cast<uint32_t>(header[offset + 1]) << 16)
+            | (static_cast<uint32_t>(header[offset + 2]) << 8)
+            | static_cast<uint32_t>(header[offset + 3]);
+    };
+
+    return ImageSize(
+        static_cast<int>(readBigEndian(16)),
+        static_cast<int>(readBigEndian(20)));
+}
+
 void ImageFileTools::CheckInitialized()
 {
     if (!mIsInitialized)
@@ -34,6 +34,8 @@ public:
 
 private:
 
+    static std::optional<ImageSize> TryGetPngImageSize(std::filesystem::path const & filepath);
+
     static void CheckInitialized();
 
     struct ResizeInfo
@@ -82,6 +82,7 @@ bool ImpactBomb::Update(
 
 void ImpactBomb::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     switch (mState)
@@ -93,10 +94,10 @@ void ImpactBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::ImpactBomb, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -111,10 +112,10 @@ void ImpactBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBombExplosion, mExplodingStepCounter), // Squat on RC bomb explosion
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f + static_cast<float>(mExplodingStepCounter) / static_cast<float>(ExplosionStepsCount),
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
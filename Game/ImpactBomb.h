@@ -65,6 +65,7 @@ public:
 
     virtual void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const override;
 
 private:
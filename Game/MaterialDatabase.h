@@ -14,10 +14,13 @@
 
 #include <picojson/picojson.h>
 
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <optional>
+#include <vector>
 
 class MaterialDatabase
 {
@@ -31,8 +34,69 @@ private:
 
     static constexpr auto RopeUniqueMaterialIndex = static_cast<size_t>(StructuralMaterial::MaterialUniqueType::Rope);
 
+    /*
+     * Maps color keys to materials in constant time, without hashing nor searching:
+     * the red and green components select a page of 256 entries, which is then indexed
+     * by the blue component. Only the pages of (red, green) pairs that have at least
+     * one material are allocated; all the other pairs share the same, empty page.
+     */
+    template<typename TMaterial>
+    class ColorKeyLookupTable
+    {
+    public:
+
+        ColorKeyLookupTable()
+            : mPageIndices(256 * 256, EmptyPageIndex)
+            , mPages(1) // The empty page
+        {
+            mPages[EmptyPageIndex].fill(nullptr);
+        }
+
+        void Set(
+            ColorKey const & colorKey,
+            TMaterial const * material)
+        {
+            auto & pageIndex = mPageIndices[MakePageIndicesIndex(colorKey)];
+            if (pageIndex == EmptyPageIndex)
+            {
+                assert(mPages.size() < std::numeric_limits<PageIndex>::max());
+
+                pageIndex = static_cast<PageIndex>(mPages.size());
+                mPages.emplace_back();
+                mPages.back().fill(nullptr);
+            }
+
+            mPages[pageIndex][colorKey.b] = material;
+        }
+
+        inline TMaterial const * Find(ColorKey const & colorKey) const
+        {
+            return mPages[mPageIndices[MakePageIndicesIndex(colorKey)]][colorKey.b];
+        }
+
+    private:
+
+        using PageIndex = uint16_t;
+
+        static constexpr PageIndex EmptyPageIndex = 0;
+
+        static inline size_t MakePageIndicesIndex(ColorKey const & colorKey)
+        {
+            return (static_cast<size_t>(colorKey.r) << 8) | static_cast<size_t>(colorKey.g);
+        }
+
+        std::vector<PageIndex> mPageIndices;
+        std::vector<std::array<TMaterial const *, 256>> mPages;
+    };
+
 public:
 
+    MaterialDatabase(MaterialDatabase const & other) = delete;
+    MaterialDatabase(MaterialDatabase && other) = default;
+
+    MaterialDatabase & operator=(MaterialDatabase const & other) = delete;
+    MaterialDatabase & operator=(MaterialDatabase && other) = default;
+
     static MaterialDatabase Load(ResourceLoader const & resourceLoader)
     {
         return Load(resourceLoader.GetMaterialDatabaseRootFilepath());
@@ -77,6 +141,8 @@ public:
                 throw GameException("Structural material \"" + material.Name + "\" has a duplicate color key");
             }
 
+            material.Ordinal = static_cast<std::uint32_t>(structuralMaterialsMap.size());
+
             // Store
             auto const storedEntry = structuralMaterialsMap.emplace(
                 std::make_pair(
@@ -160,29 +226,36 @@ public:
                     material));
         }
 
+        //
+        // Content hash, of the definitions as parsed - i.e. regardless of formatting and comments
+        //
+
+        std::string const structuralMaterialsSerialization = structuralMaterialsRoot.serialize();
+        std::string const electricalMaterialsSerialization = electricalMaterialsRoot.serialize();
+
+        uint64_t contentHash = Utils::Hash64(
+            structuralMaterialsSerialization.data(),
+            structuralMaterialsSerialization.size());
+
+        contentHash = Utils::Hash64(
+            electricalMaterialsSerialization.data(),
+            electricalMaterialsSerialization.size(),
+            contentHash);
+
         return MaterialDatabase(
             std::move(structuralMaterialsMap),
             std::move(electricalMaterialsMap),
-            uniqueStructuralMaterials);
+            uniqueStructuralMaterials,
+            contentHash);
     }
 
+    /*
+     * Returns nullptr if the color key is not of any structural material, nor
+     * of a rope endpoint.
+     */
     StructuralMaterial const * FindStructuralMaterial(ColorKey const & colorKey) const
     {
-        auto srchIt = mStructuralMaterialMap.find(colorKey);
-        if (srchIt != mStructuralMaterialMap.end())
-        {
-            return &(srchIt->second);
-        }
-
-        // Check whether it's a rope endpoint
-        if (colorKey.r == mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.r
-            && ((colorKey.g & 0xF0) == (mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.g & 0xF0)))
-        {
-            return mUniqueStructuralMaterials[RopeUniqueMaterialIndex].second;
-        }
-
-        // No luck
-        return nullptr;
+        return mStructuralMaterialLookupTable.Find(colorKey);
     }
 
     auto const & GetStructuralMaterials() const
@@ -192,14 +265,12 @@ public:
 
     ElectricalMaterial const * FindElectricalMaterial(ColorKey const & colorKey) const
     {
-        auto srchIt = mElectricalMaterialMap.find(colorKey);
-        if (srchIt != mElectricalMaterialMap.end())
-        {
-            return &(srchIt->second);
-        }
+        return mElectricalMaterialLookupTable.Find(colorKey);
+    }
 
-        // No luck
-        return nullptr;
+    auto const & GetElectricalMaterials() const
+    {
+        return mElectricalMaterialMap;
     }
 
     StructuralMaterial const & GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType uniqueType) const
@@ -220,19 +291,65 @@ public:
         return colorKey == mUniqueStructuralMaterials[static_cast<size_t>(uniqueType)].first;
     }
 
+    /*
+     * A hash of the material definitions; two databases with the same hash
+     * contain the same materials, in the same order.
+     */
+    uint64_t GetContentHash() const
+    {
+        return mContentHash;
+    }
+
 private:
 
     MaterialDatabase(
         std::map<ColorKey, StructuralMaterial> structuralMaterialMap,
         std::map<ColorKey, ElectricalMaterial> electricalMaterialMap,
-        UniqueMaterialsArray uniqueStructuralMaterials)
+        UniqueMaterialsArray uniqueStructuralMaterials,
+        uint64_t contentHash)
         : mStructuralMaterialMap(std::move(structuralMaterialMap))
         , mElectricalMaterialMap(std::move(electricalMaterialMap))
         , mUniqueStructuralMaterials(uniqueStructuralMaterials)
+        , mStructuralMaterialLookupTable()
+        , mElectricalMaterialLookupTable()
+        , mContentHash(contentHash)
     {
+        //
+        // Populate lookup tables; the materials live in the map nodes,
+        // which stay where they are when the maps are moved
+        //
+
+        // Rope endpoints first, so that exact color keys take precedence -
+        // though at load time we've verified that none clashes with ropes anyway
+        auto const & ropeColorKey = mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first;
+        for (int g = (ropeColorKey.g & 0xF0); g <= (ropeColorKey.g | 0x0F); ++g)
+        {
+            for (int b = 0; b <= 0xFF; ++b)
+            {
+                mStructuralMaterialLookupTable.Set(
+                    ColorKey(ropeColorKey.r, static_cast<uint8_t>(g), static_cast<uint8_t>(b)),
+                    mUniqueStructuralMaterials[RopeUniqueMaterialIndex].second);
+            }
+        }
+
+        for (auto const & entry : mStructuralMaterialMap)
+        {
+            mStructuralMaterialLookupTable.Set(entry.first, &(entry.second));
+        }
+
+        for (auto const & entry : mElectricalMaterialMap)
+        {
+            mElectricalMaterialLookupTable.Set(entry.first, &(entry.second));
+        }
     }
 
     std::map<ColorKey, StructuralMaterial> mStructuralMaterialMap;
     std::map<ColorKey, ElectricalMaterial> mElectricalMaterialMap;
     UniqueMaterialsArray mUniqueStructuralMaterials;
+
+    // Resolve color keys to the materials in the maps above
+    ColorKeyLookupTable<StructuralMaterial> mStructuralMaterialLookupTable;
+    ColorKeyLookupTable<ElectricalMaterial> mElectricalMaterialLookupTable;
+
+    uint64_t mContentHash;
 };
@@ -11,6 +11,7 @@
 
 #include <picojson/picojson.h>
 
+#include <cstdint>
 #include <optional>
 #include <string>
 
@@ -50,6 +51,9 @@ struct StructuralMaterial
 
     std::optional<MaterialSoundType> MaterialSound;
 
+    // Position of this material in the material database
+    std::uint32_t Ordinal;
+
 public:
 
     static StructuralMaterial Create(picojson::object const & structuralMaterialJson);
@@ -86,6 +90,7 @@ public:
         , WindReceptivity(windReceptivity)
         , UniqueType(uniqueType)
         , MaterialSound(materialSound)
+        , Ordinal(0)
     {}
 };
 
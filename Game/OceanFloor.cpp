@@ -5,6 +5,10 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/LibSimdPp.h>
+
+#include <cstdint>
+
 namespace Physics {
 
 OceanFloor::OceanFloor(ResourceLoader & resourceLoader)
@@ -145,4 +149,55 @@ void OceanFloor::Update(GameParameters const & gameParameters)
     }
 }
 
+void OceanFloor::GetFloorHeightsAt(
+    vec2f const * restrict positions,
+    float * restrict heights,
+    size_t count) const
+{
+    //
+    // The divisions and the truncations are done four at a time; the samples
+    // are then fetched one by one, as there are no gathers in SSE
+    //
+
+    using float_packet = simdpp::float32<4>;
+    using int_packet = simdpp::int32<4>;
+
+    float_packet const dx = simdpp::splat(Dx);
+
+    alignas(16) int32_t absoluteSampleIndexI[4];
+    alignas(16) float sampleIndexDx[4];
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float_packet const x = simdpp::make_float(
+            positions[i].x,
+            positions[i + 1].x,
+            positions[i + 2].x,
+            positions[i + 3].x);
+
+        // Fractional absolute index in the (infinite) sample array
+        float_packet const absoluteSampleIndexF = x / dx;
+
+        // Integral part, truncated as FastFloorInt64() does
+        int_packet const absoluteSampleIndexIPacket = simdpp::to_int32(absoluteSampleIndexF);
+
+        simdpp::store(absoluteSampleIndexI, absoluteSampleIndexIPacket);
+        simdpp::store(sampleIndexDx, absoluteSampleIndexF - simdpp::to_float32(absoluteSampleIndexIPacket));
+
+        for (size_t j = 0; j < 4; ++j)
+        {
+            heights[i + j] = SampleAt(
+                positions[i + j].x,
+                absoluteSampleIndexI[j],
+                sampleIndexDx[j]);
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        heights[i] = GetFloorHeightAt(positions[i].x);
+    }
+}
+
 }
\ No newline at end of file
@@ -12,7 +12,11 @@
 #include "ResourceLoader.h"
 
 #include <GameCore/GameMath.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
 
+#include <cassert>
+#include <cstdint>
 #include <memory>
 
 namespace Physics
@@ -41,14 +45,32 @@ public:
         float const absoluteSampleIndexF = x / Dx;
 
         // Integral part
-        int64_t absoluteSampleIndexI = FastFloorInt64(absoluteSampleIndexF);
+        int64_t const absoluteSampleIndexI = FastFloorInt64(absoluteSampleIndexF);
 
+        return SampleAt(
+            x,
+            absoluteSampleIndexI,
+            absoluteSampleIndexF - absoluteSampleIndexI);
+    }
+
+    /*
+     * Same as GetFloorHeightAt(), for the x of each of the specified positions at once.
+     */
+    void GetFloorHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const;
+
+private:
+
+    inline float SampleAt(
+        float x,
+        int64_t absoluteSampleIndexI,
+        float sampleIndexDx) const
+    {
         // Integral part - sample
         int64_t sampleIndexI = absoluteSampleIndexI % SamplesCount;
 
-        // Fractional part within sample index and the next sample index
-        float sampleIndexDx = absoluteSampleIndexF - absoluteSampleIndexI;
-
         if (x < 0.0f)
         {
             // Wrap around and anchor to the left sample
@@ -63,8 +85,6 @@ public:
             + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
-private:
-
     // Frequencies of the wave components
     static constexpr float Frequency1 = 0.005f;
     static constexpr float Frequency2 = 0.015f;
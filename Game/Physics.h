@@ -13,6 +13,7 @@ namespace Physics
     class OceanFloor;
     class PinnedPoints;
 	class Points;
+    class PointSpatialGrid;
 	class Ship;
 	class Springs;
     class Stars;
@@ -25,6 +26,7 @@ namespace Physics
 #include <GameCore/ElementContainer.h>
 
 #include "Points.h"
+#include "PointSpatialGrid.h"
 #include "Springs.h"
 #include "Triangles.h"
 #include "ElectricalElements.h"
@@ -58,6 +58,7 @@ void PinnedPoints::OnSpringDestroyed(ElementIndex springElementIndex)
 
 void PinnedPoints::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     for (auto pinnedPointIndex : mCurrentPinnedPoints)
@@ -69,7 +70,7 @@ void PinnedPoints::Upload(
             shipId,
             mShipPoints.GetConnectedComponentId(pinnedPointIndex),
             TextureFrameId(TextureGroupType::PinnedPoint, 0),
-            mShipPoints.GetPosition(pinnedPointIndex));
+            mShipPoints.GetInterpolatedPosition(pinnedPointIndex, interpolationFactor));
     }
 }
 
@@ -32,12 +32,14 @@ public:
         ShipId shipId,
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         Points & shipPoints,
-        Springs & shipSprings)
+        Springs & shipSprings,
+        PointSpatialGrid const & shipPointSpatialGrid)
         : mParentWorld(parentWorld)
         , mShipId(shipId)
         , mGameEventHandler(std::move(gameEventHandler))
         , mShipPoints(shipPoints)
         , mShipSprings(shipSprings)
+        , mShipPointSpatialGrid(shipPointSpatialGrid)
         , mCurrentPinnedPoints()
         , mNextLocalObjectId(0)
     {
@@ -88,30 +90,35 @@ public:
         //
         // No pinned points in radius...
         // ...so find closest unpinned point within the search radius, and
-        // if found, pin it
+        // if found, pin it; among equally-close points we pick the one with
+        // the lowest index, as the grid visits points in no particular order
         //
 
         ElementIndex nearestUnpinnedPointIndex = NoneElementIndex;
         float nearestUnpinnedPointDistance = std::numeric_limits<float>::max();
 
-        for (auto pointIndex : mShipPoints)
-        {
-            if (!mShipPoints.IsDeleted(pointIndex) && !mShipPoints.IsPinned(pointIndex))
+        mShipPointSpatialGrid.VisitPointsInRadius(
+            targetPos,
+            gameParameters.ToolSearchRadius,
+            [&](ElementIndex pointIndex)
             {
-                float squareDistance = (mShipPoints.GetPosition(pointIndex) - targetPos).squareLength();
-                if (squareDistance < squareSearchRadius)
+                if (!mShipPoints.IsDeleted(pointIndex) && !mShipPoints.IsPinned(pointIndex))
                 {
-                    // This point is within the search radius
-
-                    // Keep the nearest
-                    if (squareDistance < squareSearchRadius && squareDistance < nearestUnpinnedPointDistance)
+                    float squareDistance = (mShipPoints.GetPosition(pointIndex) - targetPos).squareLength();
+                    if (squareDistance < squareSearchRadius)
                     {
-                        nearestUnpinnedPointIndex = pointIndex;
-                        nearestUnpinnedPointDistance = squareDistance;
+                        // This point is within the search radius
+
+                        // Keep the nearest
+                        if (squareDistance < nearestUnpinnedPointDistance
+                            || (squareDistance == nearestUnpinnedPointDistance && pointIndex < nearestUnpinnedPointIndex))
+                        {
+                            nearestUnpinnedPointIndex = pointIndex;
+                            nearestUnpinnedPointDistance = squareDistance;
+                        }
                     }
                 }
-            }
-        }
+            });
 
         if (NoneElementIndex != nearestUnpinnedPointIndex)
         {
@@ -147,6 +154,7 @@ public:
 
     void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const;
 
 private:
@@ -272,6 +280,9 @@ private:
     // The container of all the ship's springs
     Springs & mShipSprings;
 
+    // The index of the positions of the ship's points
+    PointSpatialGrid const & mShipPointSpatialGrid;
+
     // The current set of pinned points
     CircularList<ElementIndex, GameParameters::MaxPinnedPoints> mCurrentPinnedPoints;
 
@@ -0,0 +1,172 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-08
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "PointSpatialGrid.h"
+
+#include <cassert>
+#include <limits>
+
+namespace Physics {
+
+void PointSpatialGrid::Rebuild(Points const & points)
+{
+    //
+    // 1. Calculate the extent of the grid
+    //
+
+    vec2f bottomLeft(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    vec2f topRight(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+    ElementCount pointCount = 0;
+
+    for (auto pointIndex : points.NonEphemeralPoints())
+    {
+        if (!points.IsDeleted(pointIndex))
+        {
+            vec2f const & position = points.GetPosition(pointIndex);
+
+            bottomLeft.x = std::min(bottomLeft.x, position.x);
+            bottomLeft.y = std::min(bottomLeft.y, position.y);
+            topRight.x = std::max(topRight.x, position.x);
+            topRight.y = std::max(topRight.y, position.y);
+
+            ++pointCount;
+        }
+    }
+
+    mPointCells.assign(points.GetShipPointCount(), NoneElementIndex);
+    mNextPointInCell.resize(points.GetShipPointCount());
+
+    if (0 == pointCount)
+    {
+        mWidth = 0;
+        mHeight = 0;
+        mCellHeads.clear();
+
+        return;
+    }
+
+    //
+    // 2. Size the grid, making sure that the number of cells is in the order of
+    // the number of points - even when pieces of the ship have drifted far apart
+    //
+
+    float const gridWidth = topRight.x - bottomLeft.x;
+    float const gridHeight = topRight.y - bottomLeft.y;
+
+    float const maxCellCount = static_cast<float>(pointCount) * 2.0f;
+
+    mEffectiveCellSize = std::max(
+        mCellSize,
+        std::sqrt((gridWidth + mCellSize) * (gridHeight + mCellSize) / maxCellCount));
+
+    // Leave a margin all around the points
+    mOrigin = bottomLeft - vec2f(mEffectiveCellSize, mEffectiveCellSize) * static_cast<float>(MarginCellCount);
+    mWidth = static_cast<int>(gridWidth / mEffectiveCellSize) + 1 + 2 * MarginCellCount;
+    mHeight = static_cast<int>(gridHeight / mEffectiveCellSize) + 1 + 2 * MarginCellCount;
+
+    size_t const cellCount = static_cast<size_t>(mWidth) * static_cast<size_t>(mHeight);
+
+    //
+    // 3. Place points; visiting points backwards and adding each at the head
+    // of its cell's list maintains the points in each cell sorted by index
+    //
+
+    mCellHeads.assign(cellCount, NoneElementIndex);
+
+    for (ElementIndex pointIndex = static_cast<ElementIndex>(points.GetShipPointCount()); pointIndex-- > 0; )
+    {
+        if (!points.IsDeleted(pointIndex))
+        {
+            vec2f const & position = points.GetPosition(pointIndex);
+
+            int const x = ToCellX(position.x);
+            int const y = ToCellY(position.y);
+            assert(x >= 0 && x < mWidth && y >= 0 && y < mHeight);
+
+            ElementIndex const cellIndex = static_cast<ElementIndex>(y * mWidth + x);
+
+            mPointCells[pointIndex] = cellIndex;
+            mNextPointInCell[pointIndex] = mCellHeads[cellIndex];
+            mCellHeads[cellIndex] = pointIndex;
+        }
+    }
+}
+
+void PointSpatialGrid::Update(Points const & points)
+{
+    if (mPointCells.size() != points.GetShipPointCount()
+        || 0 == mWidth)
+    {
+        Rebuild(points);
+        return;
+    }
+
+    for (auto pointIndex : points.NonEphemeralPoints())
+    {
+        ElementIndex newCellIndex = NoneElementIndex;
+
+        if (!points.IsDeleted(pointIndex))
+        {
+            vec2f const & position = points.GetPosition(pointIndex);
+
+            int const x = ToCellX(position.x);
+            int const y = ToCellY(position.y);
+
+            if (x < 0 || x >= mWidth || y < 0 || y >= mHeight)
+            {
+                // The point has left the grid
+                Rebuild(points);
+                return;
+            }
+
+            newCellIndex = static_cast<ElementIndex>(y * mWidth + x);
+        }
+
+        ElementIndex const oldCellIndex = mPointCells[pointIndex];
+
+        if (newCellIndex != oldCellIndex)
+        {
+            if (NoneElementIndex != oldCellIndex)
+                RemoveFromCell(pointIndex, oldCellIndex);
+
+            if (NoneElementIndex != newCellIndex)
+                AddToCell(pointIndex, newCellIndex);
+
+            mPointCells[pointIndex] = newCellIndex;
+        }
+    }
+}
+
+void PointSpatialGrid::AddToCell(
+    ElementIndex pointIndex,
+    ElementIndex cellIndex)
+{
+    // Find the link to the first point in the cell with a higher index
+    ElementIndex * link = &(mCellHeads[cellIndex]);
+    while (NoneElementIndex != *link && *link < pointIndex)
+    {
+        link = &(mNextPointInCell[*link]);
+    }
+
+    mNextPointInCell[pointIndex] = *link;
+    *link = pointIndex;
+}
+
+void PointSpatialGrid::RemoveFromCell(
+    ElementIndex pointIndex,
+    ElementIndex cellIndex)
+{
+    // Find the link to the point
+    ElementIndex * link = &(mCellHeads[cellIndex]);
+    while (*link != pointIndex)
+    {
+        assert(NoneElementIndex != *link);
+        link = &(mNextPointInCell[*link]);
+    }
+
+    *link = mNextPointInCell[pointIndex];
+}
+
+}
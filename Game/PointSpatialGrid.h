@@ -0,0 +1,162 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-08
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Physics.h"
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * A uniform grid over the positions of the non-ephemeral points of a ship, used to
+ * answer radius and rectangle queries without visiting all points.
+ *
+ * The grid is a snapshot: it is updated once per step, after the points have moved, and
+ * it is not updated when points are destroyed in between; queries visit candidate points,
+ * and it is up to the caller to check for deletion and for the exact position of each
+ * candidate.
+ *
+ * Each cell keeps its points in a list sorted by index, so that updating the grid only
+ * costs relinking the - usually few - points that have changed cell; the grid covers the
+ * points with a margin, and it is rebuilt from scratch only when points leave it.
+ */
+class PointSpatialGrid
+{
+public:
+
+    explicit PointSpatialGrid(float cellSize)
+        : mCellSize(cellSize)
+        , mEffectiveCellSize(cellSize)
+        , mOrigin(0.0f, 0.0f)
+        , mWidth(0)
+        , mHeight(0)
+        , mCellHeads()
+        , mNextPointInCell()
+        , mPointCells()
+    {}
+
+    /*
+     * Re-populates the grid from scratch with the current positions of all non-deleted,
+     * non-ephemeral points; meant for when all points have moved at once, e.g. when
+     * the ship has been moved or rotated.
+     */
+    void Rebuild(Points const & points);
+
+    /*
+     * Brings the grid up to date with the current positions of the points, moving
+     * the points that have changed cell and removing the points that have been
+     * destroyed; falls back to a rebuild when any point has left the grid.
+     */
+    void Update(Points const & points);
+
+    /*
+     * Visits all points that, at the time of the last update, were in a cell overlapping
+     * the specified rectangle; some of the points visited might be outside of the rectangle.
+     */
+    template <typename TVisitor>
+    void VisitPointsInRect(
+        vec2f const & bottomLeft,
+        vec2f const & topRight,
+        TVisitor && visitor) const
+    {
+        if (mWidth == 0 || mHeight == 0)
+            return;
+
+        int const xStart = std::max(ToCellX(bottomLeft.x), 0);
+        int const xEnd = std::min(ToCellX(topRight.x), mWidth - 1);
+        int const yStart = std::max(ToCellY(bottomLeft.y), 0);
+        int const yEnd = std::min(ToCellY(topRight.y), mHeight - 1);
+
+        for (int y = yStart; y <= yEnd; ++y)
+        {
+            for (int x = xStart; x <= xEnd; ++x)
+            {
+                size_t const cellIndex = static_cast<size_t>(y) * static_cast<size_t>(mWidth) + static_cast<size_t>(x);
+
+                for (ElementIndex p = mCellHeads[cellIndex]; p != NoneElementIndex; p = mNextPointInCell[p])
+                {
+                    visitor(p);
+                }
+            }
+        }
+    }
+
+    /*
+     * Visits all points that, at the time of the last update, were in a cell overlapping
+     * the square circumscribing the specified circle.
+     */
+    template <typename TVisitor>
+    void VisitPointsInRadius(
+        vec2f const & center,
+        float radius,
+        TVisitor && visitor) const
+    {
+        VisitPointsInRect(
+            center - vec2f(radius, radius),
+            center + vec2f(radius, radius),
+            std::forward<TVisitor>(visitor));
+    }
+
+private:
+
+    inline int ToCellX(float x) const
+    {
+        // Clamp in float space first, to avoid overflowing the int conversion
+        return static_cast<int>(std::floor(std::min(std::max((x - mOrigin.x) / mEffectiveCellSize, -1.0f), static_cast<float>(mWidth))));
+    }
+
+    inline int ToCellY(float y) const
+    {
+        return static_cast<int>(std::floor(std::min(std::max((y - mOrigin.y) / mEffectiveCellSize, -1.0f), static_cast<float>(mHeight))));
+    }
+
+    void AddToCell(
+        ElementIndex pointIndex,
+        ElementIndex cellIndex);
+
+    void RemoveFromCell(
+        ElementIndex pointIndex,
+        ElementIndex cellIndex);
+
+private:
+
+    // The number of empty cells we leave around the points at each rebuild,
+    // so that points may drift for a while before we have to rebuild the grid
+    static constexpr int MarginCellCount = 4;
+
+    // The cell size we've been asked to use; the actual cell size might be larger,
+    // when the points are scattered over an area too large for the number of points
+    float const mCellSize;
+    float mEffectiveCellSize;
+
+    // The bottom-left corner of the grid
+    vec2f mOrigin;
+
+    // Grid size, in cells
+    int mWidth;
+    int mHeight;
+
+    // For each cell, the lowest-index point in the cell, or NoneElementIndex
+    // if the cell is empty
+    std::vector<ElementIndex> mCellHeads;
+
+    // For each point, the next point in the same cell, or NoneElementIndex
+    // if the point is the last of its cell
+    std::vector<ElementIndex> mNextPointInCell;
+
+    // For each point, the cell it is in, or NoneElementIndex if the point is not in the grid
+    std::vector<ElementIndex> mPointCells;
+};
+
+}
@@ -8,6 +8,7 @@
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/Log.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -31,6 +32,7 @@ void Points::Add(
     mIsRopeBuffer.emplace_back(isRope);
 
     mPositionBuffer.emplace_back(position);
+    mPreviousPositionBuffer.emplace_back(position);
     mVelocityBuffer.emplace_back(vec2f::zero());
     mForceBuffer.emplace_back(vec2f::zero());
     mMassBuffer.emplace_back(structuralMaterial.Mass);
@@ -46,11 +48,12 @@ void Points::Add(
     mWaterRestitutionBuffer.emplace_back(1.0f - structuralMaterial.WaterRetention);
     mWaterDiffusionSpeedBuffer.emplace_back(structuralMaterial.WaterDiffusionSpeed);
 
+    mWaterSurfaceHeightBuffer.emplace_back(0.0f);
     mWaterBuffer.emplace_back(0.0f);
     mWaterVelocityBuffer.emplace_back(vec2f::zero());
     mWaterMomentumBuffer.emplace_back(vec2f::zero());
     mCumulatedIntakenWater.emplace_back(0.0f);
-    mIsLeakingBuffer.emplace_back(isLeaking);
+    mIsLeakingBuffer.emplace_back(false);
     if (isLeaking)
         SetLeaking(pointIndex);
 
@@ -100,6 +103,7 @@ void Points::CreateEphemeralParticleAirBubble(
     assert(false == mIsDeletedBuffer[pointIndex]);
 
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
     mVelocityBuffer[pointIndex] = vec2f::zero();
     mForceBuffer[pointIndex] = vec2f::zero();
     mMassBuffer[pointIndex] = structuralMaterial.Mass;
@@ -109,6 +113,7 @@ void Points::CreateEphemeralParticleAirBubble(
     mWaterVolumeFillBuffer[pointIndex] = structuralMaterial.WaterVolumeFill;
     mWaterRestitutionBuffer[pointIndex] = 1.0f - structuralMaterial.WaterRetention;
     mWaterDiffusionSpeedBuffer[pointIndex] = structuralMaterial.WaterDiffusionSpeed;
+    mWaterSurfaceHeightBuffer[pointIndex] = mParentWorld.GetWaterHeightAt(position.x);
     mWaterBuffer[pointIndex] = 0.0f;
     assert(false == mIsLeakingBuffer[pointIndex]);
 
@@ -116,6 +121,8 @@ void Points::CreateEphemeralParticleAirBubble(
 
     mWindReceptivityBuffer[pointIndex] = 0.0f;
 
+    if (EphemeralType::None == mEphemeralTypeBuffer[pointIndex])
+        mLiveEphemeralParticles.push_back(pointIndex); // Not stolen from a live particle
     mEphemeralTypeBuffer[pointIndex] = EphemeralType::AirBubble;
     mEphemeralStartTimeBuffer[pointIndex] = currentSimulationTime;
     mEphemeralMaxLifetimeBuffer[pointIndex] = std::numeric_limits<float>::max();
@@ -154,6 +161,7 @@ void Points::CreateEphemeralParticleDebris(
     assert(false == mIsDeletedBuffer[pointIndex]);
 
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
     mVelocityBuffer[pointIndex] = velocity;
     mForceBuffer[pointIndex] = vec2f::zero();
     mMassBuffer[pointIndex] = structuralMaterial.Mass;
@@ -163,6 +171,7 @@ void Points::CreateEphemeralParticleDebris(
     mWaterVolumeFillBuffer[pointIndex] = 0.0f; // No buoyancy
     mWaterRestitutionBuffer[pointIndex] = 1.0f - structuralMaterial.WaterRetention;
     mWaterDiffusionSpeedBuffer[pointIndex] = structuralMaterial.WaterDiffusionSpeed;
+    mWaterSurfaceHeightBuffer[pointIndex] = mParentWorld.GetWaterHeightAt(position.x);
     mWaterBuffer[pointIndex] = 0.0f;
     assert(false == mIsLeakingBuffer[pointIndex]);
 
@@ -170,6 +179,8 @@ void Points::CreateEphemeralParticleDebris(
 
     mWindReceptivityBuffer[pointIndex] = 3.0f;
 
+    if (EphemeralType::None == mEphemeralTypeBuffer[pointIndex])
+        mLiveEphemeralParticles.push_back(pointIndex); // Not stolen from a live particle
     mEphemeralTypeBuffer[pointIndex] = EphemeralType::Debris;
     mEphemeralStartTimeBuffer[pointIndex] = currentSimulationTime;
     mEphemeralMaxLifetimeBuffer[pointIndex] = std::chrono::duration_cast<std::chrono::duration<float>>(maxLifetime).count();
@@ -203,6 +214,7 @@ void Points::CreateEphemeralParticleSparkle(
     assert(false == mIsDeletedBuffer[pointIndex]);
 
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
     mVelocityBuffer[pointIndex] = velocity;
     mForceBuffer[pointIndex] = vec2f::zero();
     mMassBuffer[pointIndex] = structuralMaterial.Mass;
@@ -212,6 +224,7 @@ void Points::CreateEphemeralParticleSparkle(
     mWaterVolumeFillBuffer[pointIndex] = 0.0f; // No buoyancy
     mWaterRestitutionBuffer[pointIndex] = 1.0f - structuralMaterial.WaterRetention;
     mWaterDiffusionSpeedBuffer[pointIndex] = structuralMaterial.WaterDiffusionSpeed;
+    mWaterSurfaceHeightBuffer[pointIndex] = mParentWorld.GetWaterHeightAt(position.x);
     mWaterBuffer[pointIndex] = 0.0f;
     assert(false == mIsLeakingBuffer[pointIndex]);
 
@@ -219,6 +232,8 @@ void Points::CreateEphemeralParticleSparkle(
 
     mWindReceptivityBuffer[pointIndex] = 3.0f;
 
+    if (EphemeralType::None == mEphemeralTypeBuffer[pointIndex])
+        mLiveEphemeralParticles.push_back(pointIndex); // Not stolen from a live particle
     mEphemeralTypeBuffer[pointIndex] = EphemeralType::Sparkle;
     mEphemeralStartTimeBuffer[pointIndex] = currentSimulationTime;
     mEphemeralMaxLifetimeBuffer[pointIndex] = std::chrono::duration_cast<std::chrono::duration<float>>(maxLifetime).count();
@@ -289,115 +304,149 @@ void Points::UpdateGameParameters(GameParameters const & gameParameters)
     }
 }
 
+void Points::UpdateLeakingPoints()
+{
+    if (mNewLeakingPoints.empty())
+        return;
+
+    std::sort(mNewLeakingPoints.begin(), mNewLeakingPoints.end());
+
+    auto const oldLeakingPointCount = mLeakingPoints.size();
+    mLeakingPoints.insert(mLeakingPoints.end(), mNewLeakingPoints.cbegin(), mNewLeakingPoints.cend());
+    std::inplace_merge(
+        mLeakingPoints.begin(),
+        mLeakingPoints.begin() + oldLeakingPointCount,
+        mLeakingPoints.end());
+
+    mNewLeakingPoints.clear();
+}
+
 void Points::UpdateEphemeralParticles(
     float currentSimulationTime,
     GameParameters const & /*gameParameters*/)
 {
-    for (ElementIndex pointIndex : this->EphemeralPoints())
+    // Visit the live particles only, compacting away those that expire
+    size_t liveEphemeralParticleCount = 0;
+
+    for (ElementIndex const pointIndex : mLiveEphemeralParticles)
     {
         auto const ephemeralType = GetEphemeralType(pointIndex);
-        if (EphemeralType::None != ephemeralType)
-        {
-            //
-            // Run this particle's state machine
-            //
+        assert(EphemeralType::None != ephemeralType);
 
-            switch (ephemeralType)
+        //
+        // Run this particle's state machine
+        //
+
+        switch (ephemeralType)
+        {
+            case EphemeralType::AirBubble:
             {
-                case EphemeralType::AirBubble:
+                float const waterHeight = GetWaterSurfaceHeight(pointIndex);
+                float const deltaY = waterHeight - GetPosition(pointIndex).y;
+
+                if (deltaY <= 0.0f)
+                {
+                    // Expire
+                    ExpireEphemeralParticle(pointIndex);
+                }
+                else
                 {
-                    float const waterHeight = mParentWorld.GetWaterHeightAt(GetPosition(pointIndex).x);
-                    float const deltaY = waterHeight - GetPosition(pointIndex).y;
+                    //
+                    // Update progress based off remaining y
+                    //
 
-                    if (deltaY <= 0.0f)
-                    {
-                        // Expire
-                        ExpireEphemeralParticle(pointIndex);
-                    }
-                    else
-                    {
-                        //
-                        // Update progress based off remaining y
-                        //
+                    mEphemeralStateBuffer[pointIndex].AirBubble.CurrentDeltaY = deltaY;
 
-                        mEphemeralStateBuffer[pointIndex].AirBubble.CurrentDeltaY = deltaY;
+                    mEphemeralStateBuffer[pointIndex].AirBubble.Progress = 1.0f -
+                        deltaY
+                        / (waterHeight - mEphemeralStateBuffer[pointIndex].AirBubble.InitialY);
 
-                        mEphemeralStateBuffer[pointIndex].AirBubble.Progress = 1.0f -
-                            deltaY
-                            / (waterHeight - mEphemeralStateBuffer[pointIndex].AirBubble.InitialY);
+                    //
+                    // Update vortex
+                    //
 
-                        //
-                        // Update vortex
-                        //
+                    float const lifetime = currentSimulationTime - mEphemeralStartTimeBuffer[pointIndex];
 
-                        float const lifetime = currentSimulationTime - mEphemeralStartTimeBuffer[pointIndex];
+                    float const vortexAmplitude =
+                        mEphemeralStateBuffer[pointIndex].AirBubble.VortexAmplitude
+                        + mEphemeralStateBuffer[pointIndex].AirBubble.Progress;
 
-                        float const vortexAmplitude =
-                            mEphemeralStateBuffer[pointIndex].AirBubble.VortexAmplitude
-                            + mEphemeralStateBuffer[pointIndex].AirBubble.Progress;
+                    float vortexValue =
+                        vortexAmplitude
+                        * sin(lifetime * mEphemeralStateBuffer[pointIndex].AirBubble.VortexFrequency);
 
-                        float vortexValue =
-                            vortexAmplitude
-                            * sin(lifetime * mEphemeralStateBuffer[pointIndex].AirBubble.VortexFrequency);
+                    // Update position
+                    mPositionBuffer[pointIndex].x +=
+                        vortexValue - mEphemeralStateBuffer[pointIndex].AirBubble.LastVortexValue;
 
-                        // Update position
-                        mPositionBuffer[pointIndex].x +=
-                            vortexValue - mEphemeralStateBuffer[pointIndex].AirBubble.LastVortexValue;
+                    mEphemeralStateBuffer[pointIndex].AirBubble.LastVortexValue = vortexValue;
+                }
 
-                        mEphemeralStateBuffer[pointIndex].AirBubble.LastVortexValue = vortexValue;
-                    }
+                break;
+            }
 
-                    break;
+            case EphemeralType::Debris:
+            {
+                // Check if expired
+                auto const elapsedLifetime = currentSimulationTime - mEphemeralStartTimeBuffer[pointIndex];
+                if (elapsedLifetime >= mEphemeralMaxLifetimeBuffer[pointIndex])
+                {
+                    ExpireEphemeralParticle(pointIndex);
                 }
-
-                case EphemeralType::Debris:
+                else
                 {
-                    // Check if expired
-                    auto const elapsedLifetime = currentSimulationTime - mEphemeralStartTimeBuffer[pointIndex];
-                    if (elapsedLifetime >= mEphemeralMaxLifetimeBuffer[pointIndex])
-                    {
-                        ExpireEphemeralParticle(pointIndex);
-                    }
-                    else
-                    {
-                        // Update alpha based off remaining time
-
-                        float alpha = std::max(
-                            1.0f - elapsedLifetime / mEphemeralMaxLifetimeBuffer[pointIndex],
-                            0.0f);
-
-                        mColorBuffer[pointIndex].w = alpha;
-                    }
-
-                    break;
+                    // Update alpha based off remaining time
+
+                    float alpha = std::max(
+                        1.0f - elapsedLifetime / mEphemeralMaxLifetimeBuffer[pointIndex],
+                        0.0f);
+
+                    mColorBuffer[pointIndex].w = alpha;
                 }
 
-                case EphemeralType::Sparkle:
+                break;
+            }
+
+            case EphemeralType::Sparkle:
+            {
+                // Check if expired
+                auto const elapsedLifetime = currentSimulationTime - mEphemeralStartTimeBuffer[pointIndex];
+                if (elapsedLifetime >= mEphemeralMaxLifetimeBuffer[pointIndex])
                 {
-                    // Check if expired
-                    auto const elapsedLifetime = currentSimulationTime - mEphemeralStartTimeBuffer[pointIndex];
-                    if (elapsedLifetime >= mEphemeralMaxLifetimeBuffer[pointIndex])
-                    {
-                        ExpireEphemeralParticle(pointIndex);
-                    }
-                    else
-                    {
-                        // Update progress based off remaining time
-
-                        mEphemeralStateBuffer[pointIndex].Sparkle.Progress =
-                            elapsedLifetime / mEphemeralMaxLifetimeBuffer[pointIndex];
-                    }
-
-                    break;
+                    ExpireEphemeralParticle(pointIndex);
                 }
-
-                default:
+                else
                 {
-                    // Do nothing
+                    // Update progress based off remaining time
+
+                    mEphemeralStateBuffer[pointIndex].Sparkle.Progress =
+                        elapsedLifetime / mEphemeralMaxLifetimeBuffer[pointIndex];
                 }
+
+                break;
+            }
+
+            default:
+            {
+                // Do nothing
             }
         }
+
+        if (EphemeralType::None != GetEphemeralType(pointIndex))
+        {
+            mLiveEphemeralParticles[liveEphemeralParticleCount++] = pointIndex;
+        }
     }
+
+    mLiveEphemeralParticles.resize(liveEphemeralParticleCount);
+}
+
+void Points::UpdateWaterSurfaceHeights()
+{
+    mParentWorld.GetWaterHeightsAt(
+        mPositionBuffer.data(),
+        mWaterSurfaceHeightBuffer.data(),
+        mElementCount);
 }
 
 void Points::Query(ElementIndex pointElementIndex) const
@@ -411,6 +460,7 @@ void Points::Query(ElementIndex pointElementIndex) const
 
 void Points::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     // Upload immutable attributes, if we haven't uploaded them yet
@@ -427,7 +477,9 @@ void Points::Upload(
     // Upload mutable attributes
     renderContext.UploadShipPoints(
         shipId,
+        mPreviousPositionBuffer.data(),
         mPositionBuffer.data(),
+        interpolationFactor,
         mLightBuffer.data(),
         mWaterBuffer.data());
 }
@@ -450,6 +502,7 @@ void Points::UploadElements(
 
 void Points::UploadVectors(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     static constexpr vec4f VectorColor(0.5f, 0.1f, 0.f, 1.0f);
@@ -459,7 +512,9 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
+            mPreviousPositionBuffer.data(),
             mPositionBuffer.data(),
+            interpolationFactor,
             mVelocityBuffer.data(),
             0.25f,
             VectorColor);
@@ -469,7 +524,9 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
+            mPreviousPositionBuffer.data(),
             mPositionBuffer.data(),
+            interpolationFactor,
             mForceRenderBuffer.data(),
             0.0005f,
             VectorColor);
@@ -479,7 +536,9 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
+            mPreviousPositionBuffer.data(),
             mPositionBuffer.data(),
+            interpolationFactor,
             mWaterVelocityBuffer.data(),
             1.0f,
             VectorColor);
@@ -489,7 +548,9 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
+            mPreviousPositionBuffer.data(),
             mPositionBuffer.data(),
+            interpolationFactor,
             mWaterMomentumBuffer.data(),
             0.4f,
             VectorColor);
@@ -525,7 +586,7 @@ void Points::UploadEphemeralParticles(
     // have an associated ConnectedComponent buffer, and the shader will automagically
     // draw ephemeral points at the right Z for their point's connected component ID.
     // Remember to make sure Ship always tracks the max connected component ID it has
-    // ever seen, and that it specifies it at RenderContext::RenderShipStart() via an
+    // ever seen, and that it specifies it at RenderContext::UploadShipStart() via an
     // additional, new argument.
 
     if (mAreEphemeralParticlesDirty)
@@ -178,6 +178,7 @@ public:
         , mIsRopeBuffer(mBufferElementCount, shipPointCount, false)
         // Mechanical dynamics
         , mPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+        , mPreviousPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mVelocityBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mForceBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mMassBuffer(mBufferElementCount, shipPointCount, 1.0f)
@@ -190,6 +191,7 @@ public:
         , mWaterVolumeFillBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mWaterRestitutionBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mWaterDiffusionSpeedBuffer(mBufferElementCount, shipPointCount, 0.0f)
+        , mWaterSurfaceHeightBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mWaterBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mWaterVelocityBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mWaterMomentumBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
@@ -228,6 +230,9 @@ public:
         , mAreImmutableRenderAttributesUploaded(false)
         , mFloatBufferAllocator(mBufferElementCount)
         , mVec2fBufferAllocator(mBufferElementCount)
+        , mLeakingPoints()
+        , mNewLeakingPoints()
+        , mLiveEphemeralParticles()
         , mFreeEphemeralParticleSearchStartIndex(mShipPointCount)
         , mAreEphemeralParticlesDirty(false)
     {
@@ -235,6 +240,14 @@ public:
 
     Points(Points && other) = default;
 
+    /*
+     * Returns the number of non-ephemeral points.
+     */
+    ElementCount GetShipPointCount() const
+    {
+        return mShipPointCount;
+    }
+
     /*
      * Returns an iterator for the non-ephemeral points only.
      */
@@ -315,14 +328,25 @@ public:
         float currentSimulationTime,
         GameParameters const & gameParameters);
 
+    /*
+     * Merges the points that have started leaking since the last invocation into the
+     * leaking points; invoked once per step, before the leaking points are visited.
+     */
+    void UpdateLeakingPoints();
+
     void Query(ElementIndex pointElementIndex) const;
 
     //
     // Render
     //
 
+    /*
+     * Uploads positions interpolated between the previous and the current simulation
+     * states by the specified factor, together with the other mutable attributes.
+     */
     void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const;
 
     void UploadElements(
@@ -331,6 +355,7 @@ public:
 
     void UploadVectors(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const;
 
     void UploadEphemeralParticles(
@@ -383,6 +408,23 @@ public:
         return mPositionBuffer[pointElementIndex];
     }
 
+    /*
+     * Returns the position interpolated between the previous and the current simulation
+     * states by the specified factor, i.e. the position at which the point is rendered.
+     */
+    vec2f GetInterpolatedPosition(
+        ElementIndex pointElementIndex,
+        float interpolationFactor) const
+    {
+        return mPreviousPositionBuffer[pointElementIndex]
+            + (mPositionBuffer[pointElementIndex] - mPreviousPositionBuffer[pointElementIndex]) * interpolationFactor;
+    }
+
+    vec2f const * restrict GetPositionBufferAsVec2() const
+    {
+        return mPositionBuffer.data();
+    }
+
     vec2f * restrict GetPositionBufferAsVec2()
     {
         return mPositionBuffer.data();
@@ -423,6 +465,11 @@ public:
         return mForceBuffer[pointElementIndex];
     }
 
+    vec2f * restrict GetForceBufferAsVec2()
+    {
+        return mForceBuffer.data();
+    }
+
     float * restrict GetForceBufferAsFloat()
     {
         return reinterpret_cast<float *>(mForceBuffer.data());
@@ -433,11 +480,25 @@ public:
         mForceRenderBuffer.copy_from(mForceBuffer);
     }
 
+    /*
+     * Remembers the current positions as the positions at the start of a simulation step,
+     * so that rendering may interpolate between the last two simulation states.
+     */
+    void CopyPositionBufferToPreviousPositionBuffer()
+    {
+        mPreviousPositionBuffer.copy_from(mPositionBuffer);
+    }
+
     float GetMass(ElementIndex pointElementIndex) const
     {
         return mMassBuffer[pointElementIndex];
     }
 
+    float const * restrict GetMassBufferAsFloat() const
+    {
+        return mMassBuffer.data();
+    }
+
     void SetMassToStructuralMaterialOffset(
         ElementIndex pointElementIndex,
         float offset,
@@ -509,6 +570,18 @@ public:
         return mWaterDiffusionSpeedBuffer[pointElementIndex];
     }
 
+    /*
+     * Samples the height of the sea surface at the current positions of all points,
+     * at once; the heights are then returned by GetWaterSurfaceHeight() until the
+     * next sampling.
+     */
+    void UpdateWaterSurfaceHeights();
+
+    float GetWaterSurfaceHeight(ElementIndex pointElementIndex) const
+    {
+        return mWaterSurfaceHeightBuffer[pointElementIndex];
+    }
+
     float * restrict GetWaterBufferAsFloat()
     {
         return mWaterBuffer.data();
@@ -531,69 +604,20 @@ public:
         return mWaterBuffer[pointElementIndex] > threshold;
     }
 
-    std::shared_ptr<Buffer<float>> MakeWaterBufferCopy()
-    {
-        auto waterBufferCopy = mFloatBufferAllocator.Allocate();
-        waterBufferCopy->copy_from(mWaterBuffer);
-
-        return waterBufferCopy;
-    }
-
-    void UpdateWaterBuffer(std::shared_ptr<Buffer<float>> newWaterBuffer)
-    {
-        mWaterBuffer.copy_from(*newWaterBuffer);
-    }
-
     vec2f * restrict GetWaterVelocityBufferAsVec2()
     {
         return mWaterVelocityBuffer.data();
     }
 
     /*
-     * Only valid after a call to UpdateWaterMomentaFromVelocities() and when
-     * neither water quantities nor velocities have changed.
+     * The momenta of the water at the points, as calculated by the last water diffusion;
+     * zero at dry points.
      */
     vec2f * restrict GetWaterMomentumBufferAsVec2f()
     {
         return mWaterMomentumBuffer.data();
     }
 
-    void UpdateWaterMomentaFromVelocities()
-    {
-        float * const restrict waterBuffer = mWaterBuffer.data();
-        vec2f * const restrict waterVelocityBuffer = mWaterVelocityBuffer.data();
-        vec2f * restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
-
-        for (ElementIndex p = 0; p < mBufferElementCount; ++p)
-        {
-            waterMomentumBuffer[p] =
-                waterVelocityBuffer[p]
-                * waterBuffer[p];
-        }
-    }
-
-    void UpdateWaterVelocitiesFromMomenta()
-    {
-        float * const restrict waterBuffer = mWaterBuffer.data();
-        vec2f * restrict waterVelocityBuffer = mWaterVelocityBuffer.data();
-        vec2f * const restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
-
-        for (ElementIndex p = 0; p < mBufferElementCount; ++p)
-        {
-            if (waterBuffer[p] != 0.0f)
-            {
-                waterVelocityBuffer[p] =
-                    waterMomentumBuffer[p]
-                    / waterBuffer[p];
-            }
-            else
-            {
-                // No mass, no velocity
-                waterVelocityBuffer[p] = vec2f::zero();
-            }
-        }
-    }
-
     float GetCumulatedIntakenWater(ElementIndex pointElementIndex) const
     {
         return mCumulatedIntakenWater[pointElementIndex];
@@ -609,9 +633,24 @@ public:
         return mIsLeakingBuffer[pointElementIndex];
     }
 
+    /*
+     * The indices of the leaking points, in ascending order, as of the last
+     * invocation of UpdateLeakingPoints().
+     */
+    std::vector<ElementIndex> const & GetLeakingPoints() const
+    {
+        return mLeakingPoints;
+    }
+
     void SetLeaking(ElementIndex pointElementIndex)
     {
-        mIsLeakingBuffer[pointElementIndex] = true;
+        if (!mIsLeakingBuffer[pointElementIndex])
+        {
+            mIsLeakingBuffer[pointElementIndex] = true;
+
+            // Joins the leaking points at the next update
+            mNewLeakingPoints.push_back(pointElementIndex);
+        }
 
         // Randomize the initial water intaken, so that air bubbles won't come out all at the same moment
         mCumulatedIntakenWater[pointElementIndex] = GameRandomEngine::GetInstance().GenerateRandomReal(
@@ -818,6 +857,7 @@ private:
     //
 
     Buffer<vec2f> mPositionBuffer;
+    Buffer<vec2f> mPreviousPositionBuffer; // At the start of the last simulation step, for render interpolation
     Buffer<vec2f> mVelocityBuffer;
     Buffer<vec2f> mForceBuffer;
     Buffer<float> mMassBuffer;
@@ -837,6 +877,10 @@ private:
     Buffer<float> mWaterRestitutionBuffer;
     Buffer<float> mWaterDiffusionSpeedBuffer;
 
+    // Height of the sea surface at the x of this point, as of the
+    // last sampling
+    Buffer<float> mWaterSurfaceHeightBuffer;
+
     // Height of a 1m2 column of water which provides a pressure equivalent to the pressure at
     // this point. Quantity of water is max(water, 1.0)
     Buffer<float> mWaterBuffer;
@@ -937,6 +981,17 @@ private:
     BufferAllocator<float> mFloatBufferAllocator;
     BufferAllocator<vec2f> mVec2fBufferAllocator;
 
+    // The indices of the leaking points, kept sorted so that they are
+    // visited in the same order as all points
+    std::vector<ElementIndex> mLeakingPoints;
+
+    // The indices of the points that have started leaking since the last
+    // update of the leaking points, in no particular order
+    std::vector<ElementIndex> mNewLeakingPoints;
+
+    // The indices of the ephemeral particles that are alive, in no particular order
+    std::vector<ElementIndex> mLiveEphemeralParticles;
+
     // The index at which to start searching for free ephemeral particles
     // (just an optimization over restarting from zero each time)
     ElementIndex mFreeEphemeralParticleSearchStartIndex;
@@ -138,6 +138,7 @@ bool RCBomb::Update(
 
 void RCBomb::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     switch (mState)
@@ -148,10 +149,10 @@ void RCBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBomb, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -163,20 +164,20 @@ void RCBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBomb, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             renderContext.UploadShipGenericTextureRenderSpecification(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBombPing, (mPingOnStepCounter - 1) % PingFramesCount),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -188,20 +189,20 @@ void RCBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBomb, 0),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             renderContext.UploadShipGenericTextureRenderSpecification(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBombPing, (mPingOnStepCounter - 1) % PingFramesCount),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -216,10 +217,10 @@ void RCBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::RcBombExplosion, mExplodingStepCounter),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f + static_cast<float>(mExplodingStepCounter) / static_cast<float>(ExplosionStepsCount),
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -61,6 +61,7 @@ public:
 
     virtual void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const override;
 
     void Detonate();
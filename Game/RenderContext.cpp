@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #include "RenderContext.h"
 
+#include "TextureAtlasCache.h"
+
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
 
@@ -14,6 +16,7 @@ namespace Render {
 
 RenderContext::RenderContext(
     ResourceLoader & resourceLoader,
+    std::filesystem::path const & textureAtlasCacheFolderPath,
     ProgressCallback const & progressCallback)
     : mShaderManager()
     , mTextureRenderManager()
@@ -123,6 +126,10 @@ RenderContext::RenderContext(
     // Create texture render manager
     mTextureRenderManager = std::make_unique<TextureRenderManager>();
 
+    // Atlases are keyed by the content of the whole database
+    TextureAtlasCache const textureAtlasCache(textureAtlasCacheFolderPath);
+    uint64_t const textureAtlasCacheKey = textureDatabase.GetContentHash();
+
 
 
     //
@@ -135,37 +142,82 @@ RenderContext::RenderContext(
 
     mShaderManager->ActivateTexture<ProgramParameterType::GenericTexturesAtlasTexture>();
 
-    TextureAtlasBuilder genericTextureAtlasBuilder;
-    for (auto const & group : textureDatabase.GetGroups())
+    // Create texture OpenGL handle
+    glGenTextures(1, &tmpGLuint);
+    mGenericTextureAtlasOpenGLHandle = tmpGLuint;
+
+    // Bind texture
+    glBindTexture(GL_TEXTURE_2D, *mGenericTextureAtlasOpenGLHandle);
+    CheckOpenGLError();
+
+    auto const cachedGenericTextureAtlas = textureAtlasCache.TryLoad("generic", textureAtlasCacheKey);
+    if (!!cachedGenericTextureAtlas)
     {
-        if (TextureGroupType::Land != group.Group
-            && TextureGroupType::Water != group.Group
-            && TextureGroupType::Cloud != group.Group)
+        // Upload atlas texture and its mipmaps straight out of the cache
+        for (size_t l = 0; l < cachedGenericTextureAtlas->GetLevelCount(); ++l)
         {
-            genericTextureAtlasBuilder.Add(group);
+            GameOpenGL::UploadTextureLevel(
+                static_cast<GLint>(l),
+                cachedGenericTextureAtlas->GetLevelSize(l),
+                cachedGenericTextureAtlas->GetLevelData(l));
         }
-    }
 
-    TextureAtlas genericTextureAtlas = genericTextureAtlasBuilder.BuildAtlas(
-        [&progressCallback](float progress, std::string const &)
+        // Set max mipmap level
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(cachedGenericTextureAtlas->GetLevelCount() - 1));
+        CheckOpenGLError();
+
+        // Store metadata
+        mGenericTextureAtlasMetadata = std::make_unique<TextureAtlasMetadata>(cachedGenericTextureAtlas->GetMetadata());
+    }
+    else
+    {
+        TextureAtlasBuilder genericTextureAtlasBuilder;
+        for (auto const & group : textureDatabase.GetGroups())
         {
-            progressCallback((3.0f + progress * GenericTextureProgressSteps) / TotalProgressSteps, "Loading textures...");
-        });
+            if (TextureGroupType::Land != group.Group
+                && TextureGroupType::Water != group.Group
+                && TextureGroupType::Cloud != group.Group)
+            {
+                genericTextureAtlasBuilder.Add(group);
+            }
+        }
 
-    LogMessage("Generic texture atlas size: ", genericTextureAtlas.AtlasData.Size.Width, "x", genericTextureAtlas.AtlasData.Size.Height);
+        TextureAtlas genericTextureAtlas = genericTextureAtlasBuilder.BuildAtlas(
+            [&progressCallback](float progress, std::string const &)
+            {
+                progressCallback((3.0f + progress * GenericTextureProgressSteps) / TotalProgressSteps, "Loading textures...");
+            });
 
-    // Create texture OpenGL handle
-    glGenTextures(1, &tmpGLuint);
-    mGenericTextureAtlasOpenGLHandle = tmpGLuint;
+        LogMessage("Generic texture atlas size: ", genericTextureAtlas.AtlasData.Size.Width, "x", genericTextureAtlas.AtlasData.Size.Height);
 
-    // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mGenericTextureAtlasOpenGLHandle);
-    CheckOpenGLError();
+        // Make mipmaps
+        std::vector<RgbaImageData> const genericTextureAtlasLevels = GameOpenGL::MakeMipmapsForPowerOfTwoTexture(
+            std::move(genericTextureAtlas.AtlasData),
+            genericTextureAtlas.Metadata.GetMaxDimension());
+
+        // Upload atlas texture and its mipmaps
+        for (size_t l = 0; l < genericTextureAtlasLevels.size(); ++l)
+        {
+            GameOpenGL::UploadTextureLevel(
+                static_cast<GLint>(l),
+                genericTextureAtlasLevels[l].Size,
+                genericTextureAtlasLevels[l].Data.get());
+        }
+
+        // Set max mipmap level
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(genericTextureAtlasLevels.size() - 1));
+        CheckOpenGLError();
+
+        // Store in cache, for the next time
+        textureAtlasCache.Store(
+            "generic",
+            textureAtlasCacheKey,
+            genericTextureAtlas.Metadata,
+            genericTextureAtlasLevels);
 
-    // Upload atlas texture
-    GameOpenGL::UploadMipmappedPowerOfTwoTexture(
-        std::move(genericTextureAtlas.AtlasData),
-        genericTextureAtlas.Metadata.GetMaxDimension());
+        // Store metadata
+        mGenericTextureAtlasMetadata = std::make_unique<TextureAtlasMetadata>(genericTextureAtlas.Metadata);
+    }
 
     // Set repeat mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -177,9 +229,6 @@ RenderContext::RenderContext(
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     CheckOpenGLError();
 
-    // Store metadata
-    mGenericTextureAtlasMetadata = std::make_unique<TextureAtlasMetadata>(genericTextureAtlas.Metadata);
-
     // Set hardcoded parameters
     mShaderManager->ActivateProgram<ProgramType::GenericTextures>();
     mShaderManager->SetTextureParameters<ProgramType::GenericTextures>();
@@ -200,15 +249,6 @@ RenderContext::RenderContext(
 
     mShaderManager->ActivateTexture<ProgramParameterType::CloudTexture>();
 
-    TextureAtlasBuilder cloudAtlasBuilder;
-    cloudAtlasBuilder.Add(textureDatabase.GetGroup(TextureGroupType::Cloud));
-
-    TextureAtlas cloudTextureAtlas = cloudAtlasBuilder.BuildAtlas(
-        [&progressCallback](float progress, std::string const &)
-        {
-            progressCallback((3.0f + GenericTextureProgressSteps + progress * CloudTextureProgressSteps) / TotalProgressSteps, "Loading textures...");
-        });
-
     // Create OpenGL handle
     glGenTextures(1, &tmpGLuint);
     mCloudTextureAtlasOpenGLHandle = tmpGLuint;
@@ -217,8 +257,48 @@ RenderContext::RenderContext(
     glBindTexture(GL_TEXTURE_2D, *mCloudTextureAtlasOpenGLHandle);
     CheckOpenGLError();
 
-    // Upload atlas texture
-    GameOpenGL::UploadTexture(std::move(cloudTextureAtlas.AtlasData));
+    auto const cachedCloudTextureAtlas = textureAtlasCache.TryLoad("cloud", textureAtlasCacheKey);
+    if (!!cachedCloudTextureAtlas)
+    {
+        // Upload atlas texture straight out of the cache
+        assert(1 == cachedCloudTextureAtlas->GetLevelCount());
+        GameOpenGL::UploadTextureLevel(
+            0,
+            cachedCloudTextureAtlas->GetLevelSize(0),
+            cachedCloudTextureAtlas->GetLevelData(0));
+
+        // Store metadata
+        mCloudTextureAtlasMetadata = std::make_unique<TextureAtlasMetadata>(cachedCloudTextureAtlas->GetMetadata());
+    }
+    else
+    {
+        TextureAtlasBuilder cloudAtlasBuilder;
+        cloudAtlasBuilder.Add(textureDatabase.GetGroup(TextureGroupType::Cloud));
+
+        TextureAtlas cloudTextureAtlas = cloudAtlasBuilder.BuildAtlas(
+            [&progressCallback](float progress, std::string const &)
+            {
+                progressCallback((3.0f + GenericTextureProgressSteps + progress * CloudTextureProgressSteps) / TotalProgressSteps, "Loading textures...");
+            });
+
+        // Upload atlas texture
+        GameOpenGL::UploadTextureLevel(
+            0,
+            cloudTextureAtlas.AtlasData.Size,
+            cloudTextureAtlas.AtlasData.Data.get());
+
+        // Store in cache, for the next time
+        std::vector<RgbaImageData> cloudTextureAtlasLevels;
+        cloudTextureAtlasLevels.emplace_back(std::move(cloudTextureAtlas.AtlasData));
+        textureAtlasCache.Store(
+            "cloud",
+            textureAtlasCacheKey,
+            cloudTextureAtlas.Metadata,
+            cloudTextureAtlasLevels);
+
+        // Store metadata
+        mCloudTextureAtlasMetadata = std::make_unique<TextureAtlasMetadata>(cloudTextureAtlas.Metadata);
+    }
 
     // Set repeat mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -230,9 +310,6 @@ RenderContext::RenderContext(
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     CheckOpenGLError();
 
-    // Store metadata
-    mCloudTextureAtlasMetadata = std::make_unique<TextureAtlasMetadata>(cloudTextureAtlas.Metadata);
-
     // Set hardcoded parameters
     mShaderManager->ActivateProgram<ProgramType::Clouds>();
     mShaderManager->SetTextureParameters<ProgramType::Clouds>();
@@ -459,30 +536,10 @@ RgbImageData RenderContext::TakeScreenshot()
 
 //////////////////////////////////////////////////////////////////////////////////
 
-void RenderContext::RenderStart()
+void RenderContext::UploadStart()
 {
-    // Set polygon mode
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-    // Clear canvas - and stencil buffer
-    static const vec3f ClearColorBase(0.529f, 0.808f, 0.980f); // (cornflower blue)
-    vec3f const clearColor = ClearColorBase * mAmbientLightIntensity;
-    glClearColor(clearColor.x, clearColor.y, clearColor.z, 1.0f);
-    glClearStencil(0x00);
-    glStencilMask(0xFF);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
-    if (mDebugShipRenderMode == DebugShipRenderMode::Wireframe)
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
     // Reset crosses of light
     mCrossOfLightBuffer.clear();
-
-    // Communicate start to child contextes
-    mTextRenderContext->RenderStart();
-
-    // Reset stats
-    mRenderStatistics.Reset();
 }
 
 void RenderContext::UploadStarsStart(size_t starCount)
@@ -502,7 +559,7 @@ void RenderContext::UploadStarsEnd()
     CheckOpenGLError();
 }
 
-void RenderContext::RenderCloudsStart(size_t cloudCount)
+void RenderContext::UploadCloudsStart(size_t cloudCount)
 {
     if (cloudCount != mCloudElementCount)
     {
@@ -523,7 +580,161 @@ void RenderContext::RenderCloudsStart(size_t cloudCount)
     mCurrentCloudElementCount = 0u;
 }
 
-void RenderContext::RenderCloudsEnd()
+void RenderContext::UploadCloudsEnd()
+{
+    assert(mCurrentCloudElementCount == mCloudElementCount);
+
+    // Bind VBO
+    glBindBuffer(GL_ARRAY_BUFFER, *mCloudVBO);
+    CheckOpenGLError();
+
+    // Upload buffer
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(CloudElement) * mCloudElementCount, mCloudElementBuffer.get());
+    CheckOpenGLError();
+}
+
+void RenderContext::UploadLandAndWaterStart(size_t slices)
+{
+    //
+    // Prepare land buffer
+    //
+
+    if (slices + 1 != mLandElementCount)
+    {
+        // Bind VBO
+        glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
+        CheckOpenGLError();
+
+        // Realloc GPU buffer
+        mLandElementCount = slices + 1;
+        glBufferData(GL_ARRAY_BUFFER, mLandElementCount * sizeof(LandElement), nullptr, GL_DYNAMIC_DRAW);
+        CheckOpenGLError();
+
+        // Realloc buffer
+        mLandElementBuffer.reset(new LandElement[mLandElementCount]);
+    }
+
+    // Reset current count of land elements
+    mCurrentLandElementCount = 0u;
+
+
+    //
+    // Prepare water buffer
+    //
+
+    if (slices + 1 != mWaterElementCount)
+    {
+        // Bind VBO
+        glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+        CheckOpenGLError();
+
+        // Realloc GPU buffer
+        mWaterElementCount = slices + 1;
+        glBufferData(GL_ARRAY_BUFFER, mWaterElementCount * sizeof(WaterElement), nullptr, GL_DYNAMIC_DRAW);
+        CheckOpenGLError();
+
+        // Realloc buffer
+        mWaterElementBuffer.reset(new WaterElement[mWaterElementCount]);
+    }
+
+    // Reset count of water elements
+    mCurrentWaterElementCount = 0u;
+}
+
+void RenderContext::UploadLandAndWaterEnd()
+{
+    // Bind land VBO
+    glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
+    CheckOpenGLError();
+
+    // Upload buffer
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(LandElement) * mLandElementCount, mLandElementBuffer.get());
+
+    // Describe vertex attribute 1
+    // (we know we'll be using before CrossOfLight - which is the only subsequent user of this attribute,
+    //  so we can describe it now and avoid a bind later)
+    glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::SharedAttribute1), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    CheckOpenGLError();
+
+
+
+    // Bind water VBO
+    glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+    CheckOpenGLError();
+
+    // Upload water buffer
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(WaterElement) * mWaterElementCount, mWaterElementBuffer.get());
+
+    // No need to describe water's vertex attribute as it is dedicated and we have described it already once and for all
+}
+
+void RenderContext::UploadEnd()
+{
+    // Nop for the moment; all uploads are complete by the time they return
+}
+
+void RenderContext::Draw()
+{
+    // Set polygon mode
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    // Clear canvas - and stencil buffer
+    static const vec3f ClearColorBase(0.529f, 0.808f, 0.980f); // (cornflower blue)
+    vec3f const clearColor = ClearColorBase * mAmbientLightIntensity;
+    glClearColor(clearColor.x, clearColor.y, clearColor.z, 1.0f);
+    glClearStencil(0x00);
+    glStencilMask(0xFF);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    if (mDebugShipRenderMode == DebugShipRenderMode::Wireframe)
+        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
+    // Communicate start to child contextes
+    mTextRenderContext->RenderStart();
+
+    // Reset stats
+    mRenderStatistics.Reset();
+
+    // Render the clouds (and stars)
+    RenderCloudsAndStars();
+
+    // Render the water now, if we want to see the ship through the water
+    if (mShowShipThroughSeaWater)
+    {
+        RenderWater();
+    }
+
+    // Render all ships
+    for (auto const & ship : mShips)
+    {
+        ship->Draw();
+    }
+
+    // Render the water now, if we want to see the ship *in* the water instead
+    if (!mShowShipThroughSeaWater)
+    {
+        RenderWater();
+    }
+
+    // Render the ocean floor
+    RenderLand();
+
+    // Render crosses of light
+    if (!mCrossOfLightBuffer.empty())
+    {
+        RenderCrossesOfLight();
+    }
+
+    // Communicate end to child contextes
+    mTextRenderContext->RenderEnd();
+
+    // Flush all pending commands (but not the GPU buffer)
+    GameOpenGL::Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+void RenderContext::RenderCloudsAndStars()
 {
     // Enable stencil test
     glEnable(GL_STENCIL_TEST);
@@ -594,8 +805,6 @@ void RenderContext::RenderCloudsEnd()
     // Draw clouds with stencil test
     ////////////////////////////////////////////////////
 
-    assert(mCurrentCloudElementCount == mCloudElementCount);
-
     // Use program
     mShaderManager->ActivateProgram<ProgramType::Clouds>();
 
@@ -603,10 +812,6 @@ void RenderContext::RenderCloudsEnd()
     glBindBuffer(GL_ARRAY_BUFFER, *mCloudVBO);
     CheckOpenGLError();
 
-    // Upload buffer
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(CloudElement) * mCloudElementCount, mCloudElementBuffer.get());
-    CheckOpenGLError();
-
     // Describe vertex attribute 0
     glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::SharedAttribute0), 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
     CheckOpenGLError();
@@ -623,81 +828,6 @@ void RenderContext::RenderCloudsEnd()
     glDisable(GL_STENCIL_TEST);
 }
 
-void RenderContext::UploadLandAndWaterStart(size_t slices)
-{
-    //
-    // Prepare land buffer
-    //
-
-    if (slices + 1 != mLandElementCount)
-    {
-        // Bind VBO
-        glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
-        CheckOpenGLError();
-
-        // Realloc GPU buffer
-        mLandElementCount = slices + 1;
-        glBufferData(GL_ARRAY_BUFFER, mLandElementCount * sizeof(LandElement), nullptr, GL_DYNAMIC_DRAW);
-        CheckOpenGLError();
-
-        // Realloc buffer
-        mLandElementBuffer.reset(new LandElement[mLandElementCount]);
-    }
-
-    // Reset current count of land elements
-    mCurrentLandElementCount = 0u;
-
-
-    //
-    // Prepare water buffer
-    //
-
-    if (slices + 1 != mWaterElementCount)
-    {
-        // Bind VBO
-        glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
-        CheckOpenGLError();
-
-        // Realloc GPU buffer
-        mWaterElementCount = slices + 1;
-        glBufferData(GL_ARRAY_BUFFER, mWaterElementCount * sizeof(WaterElement), nullptr, GL_DYNAMIC_DRAW);
-        CheckOpenGLError();
-
-        // Realloc buffer
-        mWaterElementBuffer.reset(new WaterElement[mWaterElementCount]);
-    }
-
-    // Reset count of water elements
-    mCurrentWaterElementCount = 0u;
-}
-
-void RenderContext::UploadLandAndWaterEnd()
-{
-    // Bind land VBO
-    glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
-    CheckOpenGLError();
-
-    // Upload buffer
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(LandElement) * mLandElementCount, mLandElementBuffer.get());
-
-    // Describe vertex attribute 1
-    // (we know we'll be using before CrossOfLight - which is the only subsequent user of this attribute,
-    //  so we can describe it now and avoid a bind later)
-    glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::SharedAttribute1), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
-    CheckOpenGLError();
-
-
-
-    // Bind water VBO
-    glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
-    CheckOpenGLError();
-
-    // Upload water buffer
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(WaterElement) * mWaterElementCount, mWaterElementBuffer.get());
-
-    // No need to describe water's vertex attribute as it is dedicated and we have described it already once and for all
-}
-
 void RenderContext::RenderLand()
 {
     assert(mCurrentLandElementCount == mLandElementCount);
@@ -705,8 +835,8 @@ void RenderContext::RenderLand()
     // Use program
     mShaderManager->ActivateProgram<ProgramType::Land>();
 
-    // No need to bind VBO - we've done that at UploadLandAndWaterEnd(),
-    // and we know nothing's been intervening
+    // No need to bind VBO - we've described the attribute at UploadLandAndWaterEnd(),
+    // and we know nothing has described it since
 
     // Disable vertex attribute 0
     glDisableVertexAttribArray(0);
@@ -735,23 +865,6 @@ void RenderContext::RenderWater()
     glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mWaterElementCount));
 }
 
-void RenderContext::RenderEnd()
-{
-    // Render crosses of light
-    if (!mCrossOfLightBuffer.empty())
-    {
-        RenderCrossesOfLight();
-    }
-
-    // Communicate end to child contextes
-    mTextRenderContext->RenderEnd();
-
-    // Flush all pending commands (but not the GPU buffer)
-    GameOpenGL::Flush();
-}
-
-////////////////////////////////////////////////////////////////////////////////////
-
 void RenderContext::RenderCrossesOfLight()
 {
     // Use program
@@ -25,6 +25,7 @@
 
 #include <array>
 #include <cassert>
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <vector>
@@ -37,6 +38,7 @@ public:
 
     RenderContext(
         ResourceLoader & resourceLoader,
+        std::filesystem::path const & textureAtlasCacheFolderPath,
         ProgressCallback const & progressCallback);
 
     ~RenderContext();
@@ -289,7 +291,17 @@ public:
 
 public:
 
-    void RenderStart();
+    //
+    // Rendering a frame happens in two stages:
+    //  - Upload: the world uploads its current state, between UploadStart() and UploadEnd();
+    //    this is the only stage in which the simulation state is read;
+    //  - Draw: the uploaded state is drawn; this stage only reads what has been uploaded,
+    //    hence the simulation may step forward concurrently with it.
+    //
+    // Both stages must run on the thread owning the OpenGL context.
+    //
+
+    void UploadStart();
 
     //
     // Stars
@@ -312,7 +324,7 @@ public:
     // Clouds
     //
 
-    void RenderCloudsStart(size_t cloudCount);
+    void UploadCloudsStart(size_t cloudCount);
 
     inline void UploadCloud(
         float virtualX,
@@ -393,7 +405,7 @@ public:
         ++mCurrentCloudElementCount;
     }
 
-    void RenderCloudsEnd();
+    void UploadCloudsEnd();
 
 
     //
@@ -450,10 +462,6 @@ public:
 
     void UploadLandAndWaterEnd();
 
-    void RenderLand();
-
-    void RenderWater();
-
 
     //
     // Crosses of light
@@ -507,13 +515,13 @@ public:
     // Ships
     /////////////////////////////////////////////////////////////////////////
 
-    void RenderShipStart(
+    void UploadShipStart(
         ShipId shipId,
         std::vector<std::size_t> const & connectedComponentsMaxSizes)
     {
         assert(shipId > 0 && shipId <= mShips.size());
 
-        mShips[shipId - 1]->RenderStart(connectedComponentsMaxSizes);
+        mShips[shipId - 1]->UploadStart(connectedComponentsMaxSizes);
     }
 
     //
@@ -548,14 +556,18 @@ public:
 
     void UploadShipPoints(
         ShipId shipId,
+        vec2f const * restrict previousPosition,
         vec2f const * restrict position,
+        float interpolationFactor,
         float const * restrict light,
         float const * restrict water)
     {
         assert(shipId > 0 && shipId <= mShips.size());
 
         mShips[shipId - 1]->UploadPoints(
+            previousPosition,
             position,
+            interpolationFactor,
             light,
             water);
     }
@@ -585,6 +597,7 @@ public:
 
     inline void UploadShipElementSpring(
         ShipId shipId,
+        int shipSpringIndex,
         int shipPointIndex1,
         int shipPointIndex2,
         ConnectedComponentId connectedComponentId)
@@ -592,6 +605,7 @@ public:
         assert(shipId > 0 && shipId <= mShips.size());
 
         mShips[shipId - 1]->UploadElementSpring(
+            shipSpringIndex,
             shipPointIndex1,
             shipPointIndex2,
             connectedComponentId);
@@ -599,6 +613,7 @@ public:
 
     inline void UploadShipElementRope(
         ShipId shipId,
+        int shipSpringIndex,
         int shipPointIndex1,
         int shipPointIndex2,
         ConnectedComponentId connectedComponentId)
@@ -606,6 +621,7 @@ public:
         assert(shipId > 0 && shipId <= mShips.size());
 
         mShips[shipId - 1]->UploadElementRope(
+            shipSpringIndex,
             shipPointIndex1,
             shipPointIndex2,
             connectedComponentId);
@@ -613,6 +629,7 @@ public:
 
     inline void UploadShipElementTriangle(
         ShipId shipId,
+        int shipTriangleIndex,
         int shipPointIndex1,
         int shipPointIndex2,
         int shipPointIndex3,
@@ -621,6 +638,7 @@ public:
         assert(shipId > 0 && shipId <= mShips.size());
 
         mShips[shipId - 1]->UploadElementTriangle(
+            shipTriangleIndex,
             shipPointIndex1,
             shipPointIndex2,
             shipPointIndex3,
@@ -634,6 +652,56 @@ public:
         mShips[shipId - 1]->UploadElementsEnd();
     }
 
+    inline void UpdateShipElementSpring(
+        ShipId shipId,
+        int shipSpringIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        ConnectedComponentId connectedComponentId)
+    {
+        assert(shipId > 0 && shipId <= mShips.size());
+
+        mShips[shipId - 1]->UpdateElementSpring(
+            shipSpringIndex,
+            shipPointIndex1,
+            shipPointIndex2,
+            connectedComponentId);
+    }
+
+    inline void RemoveShipElementSpring(
+        ShipId shipId,
+        int shipSpringIndex)
+    {
+        assert(shipId > 0 && shipId <= mShips.size());
+
+        mShips[shipId - 1]->RemoveElementSpring(shipSpringIndex);
+    }
+
+    inline void RemoveShipElementRope(
+        ShipId shipId,
+        int shipSpringIndex)
+    {
+        assert(shipId > 0 && shipId <= mShips.size());
+
+        mShips[shipId - 1]->RemoveElementRope(shipSpringIndex);
+    }
+
+    inline void RemoveShipElementTriangle(
+        ShipId shipId,
+        int shipTriangleIndex)
+    {
+        assert(shipId > 0 && shipId <= mShips.size());
+
+        mShips[shipId - 1]->RemoveElementTriangle(shipTriangleIndex);
+    }
+
+    inline void UploadShipElementUpdatesEnd(ShipId shipId)
+    {
+        assert(shipId > 0 && shipId <= mShips.size());
+
+        mShips[shipId - 1]->UploadElementUpdatesEnd();
+    }
+
     inline void UploadShipElementStressedSpringsStart(ShipId shipId)
     {
         assert(shipId > 0 && shipId <= mShips.size());
@@ -758,7 +826,9 @@ public:
     void UploadShipVectors(
         ShipId shipId,
         size_t count,
+        vec2f const * restrict previousPosition,
         vec2f const * restrict position,
+        float interpolationFactor,
         vec2f const * restrict vector,
         float lengthAdjustment,
         vec4f const & color)
@@ -767,19 +837,14 @@ public:
 
         mShips[shipId - 1]->UploadVectors(
             count,
+            previousPosition,
             position,
+            interpolationFactor,
             vector,
             lengthAdjustment * mVectorFieldLengthMultiplier,
             color);
     }
 
-    void RenderShipEnd(ShipId shipId)
-    {
-        assert(shipId > 0 && shipId <= mShips.size());
-
-        mShips[shipId - 1]->RenderEnd();
-    }
-
 
     //
     // Text
@@ -822,10 +887,18 @@ public:
     // Final
     //
 
-    void RenderEnd();
+    void UploadEnd();
+
+    void Draw();
 
 private:
 
+    void RenderCloudsAndStars();
+
+    void RenderLand();
+
+    void RenderWater();
+
     void RenderCrossesOfLight();
 
     void UpdateOrthoMatrix();
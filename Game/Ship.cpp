@@ -10,12 +10,14 @@
 #include <GameCore/GameDebug.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/Log.h>
 #include <GameCore/Segment.h>
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <limits>
 #include <queue>
@@ -52,7 +54,15 @@ Ship::Ship(
     , mTriangles(std::move(triangles))
     , mElectricalElements(std::move(electricalElements))
     , mConnectedComponentSizes()
+    , mConnectedComponentPoints()
+    , mConnectivitySeedPoints()
+    , mCurrentConnectivityVisitSequenceNumber(currentVisitSequenceNumber)
+    , mConnectivitySearchPoints()
+    , mConnectivityOpenSearchComponents()
     , mAreElementsDirty(true)
+    , mArePointElementsDirty(false)
+    , mDirtySpringElements()
+    , mDirtyTriangleElements()
     , mLastDebugShipRenderMode()
     , mIsSinking(false)
     , mTotalWater(0.0)
@@ -62,15 +72,37 @@ Ship::Ship(
         mId,
         mGameEventHandler,
         mPoints,
-        mSprings)
+        mSprings,
+        mPointSpatialGrid)
     , mBombs(
         mParentWorld,
         mId,
         mGameEventHandler,
         *this,
         mPoints,
-        mSprings)
+        mSprings,
+        mPointSpatialGrid)
     , mCurrentForceFields()
+    , mCurrentToolForceField()
+    , mForceFieldBatch()
+    , mSpringGeometryTasks()
+    , mSpringForceTasks()
+    , mWetPoints()
+    , mIsWaterActivePoint(mPoints.GetElementCount(), false)
+    , mWaterActivePoints()
+    , mWaterActiveSprings()
+    , mWaterDiffusionState()
+    , mWaterSpringFlowTasks()
+    , mWaterNormalizationTasks()
+    , mWaterMoveTasks()
+    , mWaterSplashedPerTask()
+    , mPointSpatialGrid(PointSpatialGridCellSize)
+    , mRandomEngine(static_cast<uint32_t>(id))
+    , mUpdateProfiler()
+    , mDiffusedLampStates()
+    , mDiffusedLightSpreadAdjustment(0.0f)
+    , mDiffusedPointPositions()
+    , mIsDiffusedLightDirty(true)
 {
     // Set destroy handlers
     mPoints.RegisterDestroyHandler(std::bind(&Ship::PointDestroyHandler, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -78,8 +110,14 @@ Ship::Ship(
     mTriangles.RegisterDestroyHandler(std::bind(&Ship::TriangleDestroyHandler, this, std::placeholders::_1));
     mElectricalElements.RegisterDestroyHandler(std::bind(&Ship::ElectricalElementDestroyHandler, this, std::placeholders::_1));
 
+    // Prepare parallel tasks
+    MakeParallelTasks();
+
     // Do a first connected component detection pass
-    DetectConnectedComponents(currentVisitSequenceNumber);
+    DetectConnectedComponents();
+
+    // Index points
+    mPointSpatialGrid.Rebuild(mPoints);
 }
 
 Ship::~Ship()
@@ -104,6 +142,9 @@ void Ship::MoveBy(
         positionBuffer[p] += offset;
         velocityBuffer[p] = velocity;
     }
+
+    // Re-index points
+    mPointSpatialGrid.Rebuild(mPoints);
 }
 
 void Ship::RotateBy(
@@ -130,6 +171,9 @@ void Ship::RotateBy(
         velocityBuffer[p] = (pos - positionBuffer[p]) * inertia;
         positionBuffer[p] = pos;
     }
+
+    // Re-index points
+    mPointSpatialGrid.Rebuild(mPoints);
 }
 
 void Ship::DestroyAt(
@@ -145,13 +189,28 @@ void Ship::DestroyAt(
 
     float const squareRadius = radius * radius;
 
-    // Destroy all points within the radius
-    for (auto pointIndex : mPoints)
+    // Destroy all non-ephemeral points within the radius
+    mPointSpatialGrid.VisitPointsInRadius(
+        targetPos,
+        radius,
+        [&](ElementIndex pointIndex)
+        {
+            if (!mPoints.IsDeleted(pointIndex)
+                && (mPoints.GetPosition(pointIndex) - targetPos).squareLength() < squareRadius)
+            {
+                // Destroy point
+                mPoints.Destroy(
+                    pointIndex,
+                    currentSimulationTime,
+                    gameParameters);
+            }
+        });
+
+    // Destroy all air bubbles within the radius - the only ephemeral points we allow to delete
+    for (auto pointIndex : mPoints.EphemeralPoints())
     {
-        // The only ephemeral points we allow to delete are air bubbles
         if (!mPoints.IsDeleted(pointIndex)
-            && (Points::EphemeralType::None == mPoints.GetEphemeralType(pointIndex)
-                   || Points::EphemeralType::AirBubble == mPoints.GetEphemeralType(pointIndex)))
+            && Points::EphemeralType::AirBubble == mPoints.GetEphemeralType(pointIndex))
         {
             if ((mPoints.GetPosition(pointIndex) - targetPos).squareLength() < squareRadius)
             {
@@ -178,7 +237,31 @@ void Ship::SawThrough(
     unsigned int metalsSawed = 0;
     unsigned int nonMetalsSawed = 0;
 
-    for (auto springIndex : mSprings)
+    // A spring may only intersect the segment if at least one of its endpoints is
+    // within one spring length from the segment's bounding box; we collect the springs
+    // of those points, and visit them in index order
+
+    float const searchMargin = mSprings.GetMaxLength();
+
+    std::vector<ElementIndex> candidateSprings;
+
+    mPointSpatialGrid.VisitPointsInRect(
+        vec2f(std::min(startPos.x, endPos.x) - searchMargin, std::min(startPos.y, endPos.y) - searchMargin),
+        vec2f(std::max(startPos.x, endPos.x) + searchMargin, std::max(startPos.y, endPos.y) + searchMargin),
+        [&](ElementIndex pointIndex)
+        {
+            for (auto springIndex : mPoints.GetConnectedSprings(pointIndex))
+            {
+                candidateSprings.push_back(springIndex);
+            }
+        });
+
+    std::sort(candidateSprings.begin(), candidateSprings.end());
+    candidateSprings.erase(
+        std::unique(candidateSprings.begin(), candidateSprings.end()),
+        candidateSprings.end());
+
+    for (auto springIndex : candidateSprings)
     {
         if (!mSprings.IsDeleted(springIndex))
         {
@@ -230,8 +313,8 @@ void Ship::DrawTo(
     float strength,
     GameParameters const & gameParameters)
 {
-    // Store the force field
-    mCurrentForceFields.emplace_back(
+    // Store the force field, replacing the one of the previous frame
+    mCurrentToolForceField.reset(
         new DrawForceField(
             targetPos,
             strength * (gameParameters.IsUltraViolentMode ? 20.0f : 1.0f)));
@@ -242,8 +325,8 @@ void Ship::SwirlAt(
     float strength,
     GameParameters const & gameParameters)
 {
-    // Store the force field
-    mCurrentForceFields.emplace_back(
+    // Store the force field, replacing the one of the previous frame
+    mCurrentToolForceField.reset(
         new SwirlForceField(
             targetPos,
             strength * (gameParameters.IsUltraViolentMode ? 40.0f : 1.0f)));
@@ -295,24 +378,32 @@ bool Ship::FloodAt(
     ElementIndex bestPointIndex = NoneElementIndex;
     float bestSquareDistance = std::numeric_limits<float>::max();
 
-    for (auto pointIndex : mPoints.NonEphemeralPoints())
-    {
-        if (!mPoints.IsDeleted(pointIndex)
-            && !mPoints.IsHull(pointIndex))
+    mPointSpatialGrid.VisitPointsInRadius(
+        targetPos,
+        searchRadius,
+        [&](ElementIndex pointIndex)
         {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < searchSquareRadius && squareDistance < bestSquareDistance)
+            if (!mPoints.IsDeleted(pointIndex)
+                && !mPoints.IsHull(pointIndex))
             {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
+                float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
+                if (squareDistance < searchSquareRadius
+                    && (squareDistance < bestSquareDistance
+                        || (squareDistance == bestSquareDistance && pointIndex < bestPointIndex)))
+                {
+                    bestPointIndex = pointIndex;
+                    bestSquareDistance = squareDistance;
+                }
             }
-        }
-    }
+        });
 
     if (NoneElementIndex != bestPointIndex)
     {
         if (quantityOfWater >= 0.0f)
+        {
             mPoints.GetWater(bestPointIndex) += quantityOfWater;
+            mWetPoints.push_back(bestPointIndex);
+        }
         else
             mPoints.GetWater(bestPointIndex) -= std::min(-quantityOfWater, mPoints.GetWater(bestPointIndex));
 
@@ -380,17 +471,32 @@ ElementIndex Ship::GetNearestPointAt(
     ElementIndex bestPointIndex = NoneElementIndex;
     float bestSquareDistance = std::numeric_limits<float>::max();
 
-    for (auto pointIndex : mPoints)
-    {
-        if (!mPoints.IsDeleted(pointIndex))
+    auto const visitor =
+        [&](ElementIndex pointIndex)
         {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
+            if (!mPoints.IsDeleted(pointIndex))
             {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
+                float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
+                if (squareDistance < squareRadius
+                    && (squareDistance < bestSquareDistance
+                        || (squareDistance == bestSquareDistance && pointIndex < bestPointIndex)))
+                {
+                    bestPointIndex = pointIndex;
+                    bestSquareDistance = squareDistance;
+                }
             }
-        }
+        };
+
+    // Non-ephemeral points
+    mPointSpatialGrid.VisitPointsInRadius(
+        targetPos,
+        radius,
+        visitor);
+
+    // Ephemeral points
+    for (auto pointIndex : mPoints.EphemeralPoints())
+    {
+        visitor(pointIndex);
     }
 
     return bestPointIndex;
@@ -400,23 +506,7 @@ bool Ship::QueryNearestPointAt(
     vec2f const & targetPos,
     float radius) const
 {
-    float const squareRadius = radius * radius;
-
-    ElementIndex bestPointIndex = NoneElementIndex;
-    float bestSquareDistance = std::numeric_limits<float>::max();
-
-    for (auto pointIndex : mPoints)
-    {
-        if (!mPoints.IsDeleted(pointIndex))
-        {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
-            {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
-            }
-        }
-    }
+    ElementIndex const bestPointIndex = GetNearestPointAt(targetPos, radius);
 
     if (NoneElementIndex != bestPointIndex)
     {
@@ -431,10 +521,13 @@ void Ship::Update(
     float currentSimulationTime,
     VisitSequenceNumber currentVisitSequenceNumber,
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
     auto const currentWallClockTime = GameWallClock::GetInstance().Now();
 
+    // Draw random numbers from our own engine while updating
+    GameRandomEngine::ScopedThreadInstance const scopedRandomEngine(mRandomEngine);
+
 #ifdef _DEBUG
     VerifyInvariants();
 #endif
@@ -455,10 +548,24 @@ void Ship::Update(
     // Update mechanical dynamics
     //
 
-    UpdateMechanicalDynamics(
-        currentSimulationTime,
-        gameParameters,
-        renderContext);
+    // Remember where points are before this step, for render interpolation
+    mPoints.CopyPositionBufferToPreviousPositionBuffer();
+
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::MechanicalDynamics, gameParameters.DoProfileShipUpdates);
+
+        UpdateMechanicalDynamics(
+            currentSimulationTime,
+            gameParameters,
+            vectorFieldRenderMode);
+    }
+
+
+    //
+    // Re-index points, now that they've moved for this step
+    //
+
+    mPointSpatialGrid.Update(mPoints);
 
 
     //
@@ -468,9 +575,13 @@ void Ship::Update(
     // (which would flag our elements as dirty)
     //
 
-    mBombs.Update(
-        currentWallClockTime,
-        gameParameters);
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::Bombs, gameParameters.DoProfileShipUpdates);
+
+        mBombs.Update(
+            currentWallClockTime,
+            gameParameters);
+    }
 
 
     //
@@ -478,19 +589,25 @@ void Ship::Update(
     // (which would flag our elements as dirty)
     //
 
-    mSprings.UpdateStrains(
-        currentSimulationTime,
-        gameParameters,
-        mPoints);
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::SpringStrains, gameParameters.DoProfileShipUpdates);
+
+        mSprings.UpdateStrains(
+            currentSimulationTime,
+            gameParameters,
+            mPoints);
+    }
 
 
     //
-    // Detect connected components, if there have been any deletions
+    // Update connected components, if any springs have been destroyed
     //
 
-    if (mAreElementsDirty)
+    if (!mConnectivitySeedPoints.empty())
     {
-        DetectConnectedComponents(currentVisitSequenceNumber);
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::ConnectedComponents, gameParameters.DoProfileShipUpdates);
+
+        UpdateConnectedComponents();
     }
 
 
@@ -517,24 +634,29 @@ void Ship::Update(
     // Update ephemeral particles
     //
 
-    UpdateEphemeralParticles(
-        currentSimulationTime,
-        gameParameters);
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::EphemeralParticles, gameParameters.DoProfileShipUpdates);
+
+        UpdateEphemeralParticles(
+            currentSimulationTime,
+            gameParameters);
+    }
 
 #ifdef _DEBUG
     VerifyInvariants();
 #endif
 }
 
-void Ship::Render(
+void Ship::RenderUpload(
     GameParameters const & /*gameParameters*/,
+    float interpolationFactor,
     Render::RenderContext & renderContext)
 {
     //
-    // Initialize render
+    // Initialize upload
     //
 
-    renderContext.RenderShipStart(
+    renderContext.UploadShipStart(
         mId,
         mConnectedComponentSizes);
 
@@ -545,6 +667,7 @@ void Ship::Render(
 
     mPoints.Upload(
         mId,
+        interpolationFactor,
         renderContext);
 
 
@@ -555,11 +678,12 @@ void Ship::Render(
     if (!mConnectedComponentSizes.empty())
     {
         //
-        // Upload elements (point (elements), springs, ropes, triangles), iff dirty
-        // or the ship debug render mode has changed
+        // Upload all elements (point (elements), springs, ropes, triangles), iff connected
+        // components have changed or the ship debug render mode has changed
         //
 
         if (mAreElementsDirty
+            || (mArePointElementsDirty && renderContext.GetDebugShipRenderMode() == DebugShipRenderMode::Points)
             || !mLastDebugShipRenderMode
             || *mLastDebugShipRenderMode != renderContext.GetDebugShipRenderMode())
         {
@@ -593,6 +717,25 @@ void Ship::Render(
 
             renderContext.UploadShipElementsEnd(mId);
         }
+        else if (!mDirtySpringElements.empty() || !mDirtyTriangleElements.empty())
+        {
+            //
+            // Upload just the springs and triangles that have changed
+            //
+
+            mSprings.UploadElementUpdates(
+                mId,
+                renderContext,
+                mPoints,
+                mDirtySpringElements);
+
+            mTriangles.UploadElementUpdates(
+                mId,
+                renderContext,
+                mDirtyTriangleElements);
+
+            renderContext.UploadShipElementUpdatesEnd(mId);
+        }
 
 
         //
@@ -616,6 +759,9 @@ void Ship::Render(
 
         // Reset state
         mAreElementsDirty = false;
+        mArePointElementsDirty = false;
+        mDirtySpringElements.clear();
+        mDirtyTriangleElements.clear();
         mLastDebugShipRenderMode = renderContext.GetDebugShipRenderMode();
     }
 
@@ -626,6 +772,7 @@ void Ship::Render(
 
     mBombs.Upload(
         mId,
+        interpolationFactor,
         renderContext);
 
     //
@@ -634,6 +781,7 @@ void Ship::Render(
 
     mPinnedPoints.Upload(
         mId,
+        interpolationFactor,
         renderContext);
 
     //
@@ -650,13 +798,8 @@ void Ship::Render(
 
     mPoints.UploadVectors(
         mId,
+        interpolationFactor,
         renderContext);
-
-    //
-    // Finalize render
-    //
-
-    renderContext.RenderShipEnd(mId);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -670,7 +813,7 @@ void Ship::Render(
 void Ship::UpdateMechanicalDynamics(
     float currentSimulationTime,
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
     //
     // 1. Recalculate total masses and everything else that derives from them, once and for all
@@ -678,18 +821,37 @@ void Ship::UpdateMechanicalDynamics(
 
     mPoints.UpdateTotalMasses(gameParameters);
 
+    //
+    // Sample the sea surface once for all iterations; the points do not move
+    // far enough during a step for the difference to matter
+    //
+
+    mPoints.UpdateWaterSurfaceHeights();
+
     //
     // 2. Run iterations
     //
 
     int const numMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<int>();
 
+    // Group force fields once for all iterations
+    mForceFieldBatch.Clear();
+    for (auto const & forceField : mCurrentForceFields)
+    {
+        forceField->AddTo(mForceFieldBatch);
+    }
+
+    if (!!mCurrentToolForceField)
+    {
+        mCurrentToolForceField->AddTo(mForceFieldBatch);
+    }
+
     for (int iter = 0; iter < numMechanicalDynamicsIterations; ++iter)
     {
         // Apply force fields - if we have any
-        for (auto const & forceField : mCurrentForceFields)
+        if (!mForceFieldBatch.IsEmpty())
         {
-            forceField->Apply(
+            mForceFieldBatch.Apply(
                 mPoints,
                 currentSimulationTime,
                 gameParameters);
@@ -703,7 +865,7 @@ void Ship::UpdateMechanicalDynamics(
 
         // Check whether we need to save the last force buffer before we zero it out
         if (iter == numMechanicalDynamicsIterations - 1
-            && VectorFieldRenderMode::PointForce == renderContext.GetVectorFieldRenderMode())
+            && VectorFieldRenderMode::PointForce == vectorFieldRenderMode)
         {
             mPoints.CopyForceBufferToForceRenderBuffer();
         }
@@ -715,8 +877,19 @@ void Ship::UpdateMechanicalDynamics(
         HandleCollisionsWithSeaFloor(gameParameters);
     }
 
-    // Consume force fields
+    // Consume force fields - except for the tool's, which lasts for all the steps of the frame
+    mForceFieldBatch.Clear();
     mCurrentForceFields.clear();
+
+    //
+    // 3. Calculate the springs' geometry and sample the sea surface at the points' final
+    // positions; points do not move anymore during this step, hence all the visits that
+    // follow - strains, water, and ephemeral particles - may share them
+    //
+
+    UpdateSpringGeometry();
+
+    mPoints.UpdateWaterSurfaceHeights();
 }
 
 void Ship::UpdatePointForces(GameParameters const & gameParameters)
@@ -742,7 +915,7 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
     for (auto pointIndex : mPoints)
     {
         // Get height of water at this point
-        float const waterHeightAtThisPoint = mParentWorld.GetWaterHeightAt(mPoints.GetPosition(pointIndex).x);
+        float const waterHeightAtThisPoint = mPoints.GetWaterSurfaceHeight(pointIndex);
 
         //
         // 1. Add gravity and buoyancy
@@ -797,7 +970,50 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
 
 void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
 {
-    for (auto springIndex : mSprings)
+    // Calculate the springs' geometry once, for all the visits that follow
+    UpdateSpringGeometry();
+
+    if (!mSpringForceTasks.empty())
+    {
+        //
+        // Springs of the same color do not share endpoints, hence tasks working on the same color
+        // never update the same point; colors are run one after the other, in the same order as the
+        // serial implementation, so the results are identical to the serial implementation's
+        //
+
+        auto & taskThreadPool = mParentWorld.GetTaskThreadPool();
+
+        for (auto const & colorTasks : mSpringForceTasks)
+        {
+            taskThreadPool.Run(colorTasks);
+        }
+    }
+    else
+    {
+        UpdateSpringForces_Vectorized(0, mSprings.GetElementCount());
+    }
+}
+
+void Ship::UpdateSpringGeometry()
+{
+    if (!mSpringGeometryTasks.empty())
+    {
+        // Springs' geometries are independent of each other
+        mParentWorld.GetTaskThreadPool().Run(mSpringGeometryTasks);
+    }
+    else
+    {
+        mSprings.UpdateGeometry(0, mSprings.GetElementCount(), mPoints);
+    }
+}
+
+void Ship::UpdateSpringForces_Naive(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
+{
+    // This is the reference implementation
+
+    for (ElementIndex springIndex = startSpringIndex; springIndex < endSpringIndex; ++springIndex)
     {
         auto const pointAIndex = mSprings.GetPointAIndex(springIndex);
         auto const pointBIndex = mSprings.GetPointBIndex(springIndex);
@@ -805,9 +1021,8 @@ void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
         // No need to check whether the spring is deleted, as a deleted spring
         // has zero coefficients
 
-        vec2f const displacement = mPoints.GetPosition(pointBIndex) - mPoints.GetPosition(pointAIndex);
-        float const displacementLength = displacement.length();
-        vec2f const springDir = displacement.normalise(displacementLength);
+        float const displacementLength = mSprings.GetLength(springIndex);
+        vec2f const springDir = mSprings.GetDirection(springIndex);
 
         //
         // 1. Hooke's law
@@ -844,6 +1059,120 @@ void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
     }
 }
 
+void Ship::UpdateSpringForces_Vectorized(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
+{
+    //
+    // Same algorithm as the reference implementation, calculating forces for packets of four
+    // springs at a time; operations are carried out in the same order as in the reference
+    // implementation, hence results are identical.
+    //
+    // Point quantities are gathered one spring at a time, and forces are scattered one spring
+    // at a time, as springs in the same packet might share endpoints.
+    //
+    // Ranges need not be aligned, as the ranges of spring colors are arbitrary.
+    //
+
+    using float_packet = simdpp::float32<4>;
+    static constexpr ElementIndex PacketSize = 4;
+
+    vec2f const * restrict const velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+    vec2f * restrict const forceBuffer = mPoints.GetForceBufferAsVec2();
+
+    ElementIndex const * restrict const endpointsBuffer = mSprings.GetEndpointsBufferAsIndices();
+    float const * restrict const directionXBuffer = mSprings.GetDirectionXBuffer();
+    float const * restrict const directionYBuffer = mSprings.GetDirectionYBuffer();
+    float const * restrict const lengthBuffer = mSprings.GetLengthBuffer();
+    float const * restrict const restLengthBuffer = mSprings.GetRestLengthBuffer();
+    float const * restrict const stiffnessCoefficientBuffer = mSprings.GetStiffnessCoefficientBuffer();
+    float const * restrict const dampingCoefficientBuffer = mSprings.GetDampingCoefficientBuffer();
+
+    alignas(16) float fX[PacketSize];
+    alignas(16) float fY[PacketSize];
+
+    ElementIndex s = startSpringIndex;
+    for (; s + PacketSize <= endSpringIndex; s += PacketSize)
+    {
+        // A0, B0, A1, B1, ...
+        ElementIndex const * restrict const endpoints = endpointsBuffer + s * 2;
+
+        //
+        // Spring directions, as precalculated
+        //
+
+        float_packet const displacementLength = simdpp::load_u<float_packet>(lengthBuffer + s);
+        float_packet const springDirX = simdpp::load_u<float_packet>(directionXBuffer + s);
+        float_packet const springDirY = simdpp::load_u<float_packet>(directionYBuffer + s);
+
+        //
+        // 1. Hooke's law
+        //
+
+        float_packet const springDisplacement =
+            displacementLength
+            - simdpp::load_u<float_packet>(restLengthBuffer + s);
+
+        float_packet const stiffnessCoefficient = simdpp::load_u<float_packet>(stiffnessCoefficientBuffer + s);
+
+        float_packet const fSpringAX = (springDirX * springDisplacement) * stiffnessCoefficient;
+        float_packet const fSpringAY = (springDirY * springDisplacement) * stiffnessCoefficient;
+
+        //
+        // 2. Damper forces
+        //
+
+        float_packet const relVelocityX =
+            simdpp::make_float(
+                velocityBuffer[endpoints[1]].x,
+                velocityBuffer[endpoints[3]].x,
+                velocityBuffer[endpoints[5]].x,
+                velocityBuffer[endpoints[7]].x)
+            - simdpp::make_float(
+                velocityBuffer[endpoints[0]].x,
+                velocityBuffer[endpoints[2]].x,
+                velocityBuffer[endpoints[4]].x,
+                velocityBuffer[endpoints[6]].x);
+
+        float_packet const relVelocityY =
+            simdpp::make_float(
+                velocityBuffer[endpoints[1]].y,
+                velocityBuffer[endpoints[3]].y,
+                velocityBuffer[endpoints[5]].y,
+                velocityBuffer[endpoints[7]].y)
+            - simdpp::make_float(
+                velocityBuffer[endpoints[0]].y,
+                velocityBuffer[endpoints[2]].y,
+                velocityBuffer[endpoints[4]].y,
+                velocityBuffer[endpoints[6]].y);
+
+        float_packet const relVelocityProjection = relVelocityX * springDirX + relVelocityY * springDirY;
+
+        float_packet const dampingCoefficient = simdpp::load_u<float_packet>(dampingCoefficientBuffer + s);
+
+        float_packet const fDampAX = (springDirX * relVelocityProjection) * dampingCoefficient;
+        float_packet const fDampAY = (springDirY * relVelocityProjection) * dampingCoefficient;
+
+        //
+        // Apply forces
+        //
+
+        simdpp::store(fX, fSpringAX + fDampAX);
+        simdpp::store(fY, fSpringAY + fDampAY);
+
+        for (ElementIndex i = 0; i < PacketSize; ++i)
+        {
+            vec2f const fA(fX[i], fY[i]);
+
+            forceBuffer[endpoints[i * 2]] += fA;
+            forceBuffer[endpoints[i * 2 + 1]] -= fA;
+        }
+    }
+
+    // Do the remaining springs
+    UpdateSpringForces_Naive(s, endSpringIndex);
+}
+
 void Ship::IntegrateAndResetPointForces(GameParameters const & gameParameters)
 {
     float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
@@ -869,31 +1198,43 @@ void Ship::IntegrateAndResetPointForces(GameParameters const & gameParameters)
         12.0f / gameParameters.NumMechanicalDynamicsIterations<float>());
 
     //
-    // Take the four buffers that we need as restrict pointers, so that the compiler
-    // can better see it should parallelize this loop as much as possible
+    // Take the four buffers that we need as restrict pointers, and integrate
+    // eight components - i.e. four points - at each iteration.
     //
-    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
-    // integrating two points at each iteration
+    // Buffers are aligned to the vectorization word, and their size is a multiple
+    // of the vectorization word, hence we can visit them in whole packets
     //
 
+    using float_packet = simdpp::float32<8>;
+    static constexpr size_t PacketSize = 8;
+
     float * restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
     float * restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
     float * restrict forceBuffer = mPoints.GetForceBufferAsFloat();
     float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
 
+    float_packet const dtPacket = simdpp::splat(dt);
+    float_packet const globalDampCoefficientPacket = simdpp::splat(globalDampCoefficient);
+    float_packet const zeroPacket = simdpp::make_zero();
+
     size_t const count = mPoints.GetBufferElementCount() * 2; // Two components per vector
-    for (size_t i = 0; i < count; ++i)
+    assert(0 == (count % PacketSize));
+
+    for (size_t i = 0; i < count; i += PacketSize)
     {
         //
         // Verlet integration (fourth order, with velocity being first order)
         //
 
-        float const deltaPos = velocityBuffer[i] * dt + forceBuffer[i] * integrationFactorBuffer[i];
-        positionBuffer[i] += deltaPos;
-        velocityBuffer[i] = deltaPos * globalDampCoefficient / dt;
+        float_packet const deltaPos =
+            simdpp::load<float_packet>(velocityBuffer + i) * dtPacket
+            + simdpp::load<float_packet>(forceBuffer + i) * simdpp::load<float_packet>(integrationFactorBuffer + i);
+
+        simdpp::store(positionBuffer + i, simdpp::load<float_packet>(positionBuffer + i) + deltaPos);
+        simdpp::store(velocityBuffer + i, deltaPos * globalDampCoefficientPacket / dtPacket);
 
         // Zero out force now that we've integrated it
-        forceBuffer[i] = 0.0f;
+        simdpp::store(forceBuffer + i, zeroPacket);
     }
 }
 
@@ -918,10 +1259,18 @@ void Ship::HandleCollisionsWithSeaFloor(GameParameters const & gameParameters)
 
     float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
 
+    // Sample the sea floor at all the points at once
+    auto floorHeightBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict const floorHeightBufferData = floorHeightBuffer->data();
+    mParentWorld.GetOceanFloorHeightsAt(
+        mPoints.GetPositionBufferAsVec2(),
+        floorHeightBufferData,
+        mPoints.GetElementCount());
+
     for (auto pointIndex : mPoints)
     {
         // Check if point is now below the sea floor
-        float const floorheight = mParentWorld.GetOceanFloorHeightAt(mPoints.GetPosition(pointIndex).x);
+        float const floorheight = floorHeightBufferData[pointIndex];
         if (mPoints.GetPosition(pointIndex).y < floorheight)
         {
             // Move point back to where it was
@@ -953,10 +1302,14 @@ void Ship::UpdateWaterDynamics(
 
     float waterTakenInStep = 0.f;
 
-    UpdateWaterInflow(
-        currentSimulationTime,
-        gameParameters,
-        waterTakenInStep);
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::WaterInflow, gameParameters.DoProfileShipUpdates);
+
+        UpdateWaterInflow(
+            currentSimulationTime,
+            gameParameters,
+            waterTakenInStep);
+    }
 
     // Notify
     mGameEventHandler->OnWaterTaken(waterTakenInStep);
@@ -967,7 +1320,12 @@ void Ship::UpdateWaterDynamics(
     //
 
     float waterSplashedInStep = 0.f;
-    UpdateWaterVelocities(gameParameters, waterSplashedInStep);
+
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::WaterVelocities, gameParameters.DoProfileShipUpdates);
+
+        UpdateWaterVelocities(gameParameters, waterSplashedInStep);
+    }
 
     // Notify
     mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
@@ -996,97 +1354,101 @@ void Ship::UpdateWaterInflow(
     // Intake/outtake water into/from all the leaking nodes that are underwater
     //
 
-    for (auto pointIndex : mPoints)
+    // Take in the points that have started leaking since the last step
+    mPoints.UpdateLeakingPoints();
+
+    for (auto const pointIndex : mPoints.GetLeakingPoints())
     {
         // Avoid taking water into points that are destroyed, as that would change total water taken
         if (!mPoints.IsDeleted(pointIndex))
         {
-            if (mPoints.IsLeaking(pointIndex))
-            {
-                //
-                // 1) Calculate velocity of incoming water, based off Bernoulli's equation applied to point:
-                //  v**2/2 + p/density = c (assuming y of incoming water does not change along the intake)
-                //      With: p = pressure of water at point = d*wh*g (d = water density, wh = water height in point)
-                //
-                // Considering that at equilibrium we have v=0 and p=external_pressure,
-                // then c=external_pressure/density;
-                // external_pressure is height_of_water_at_y*g*density, then c=height_of_water_at_y*g;
-                // hence, the velocity of water incoming at point p, when the "water height" in the point is already
-                // wh and the external water pressure is d*height_of_water_at_y*g, is:
-                //  v = +/- sqrt(2*g*|height_of_water_at_y-wh|)
-                //
+            //
+            // 1) Calculate velocity of incoming water, based off Bernoulli's equation applied to point:
+            //  v**2/2 + p/density = c (assuming y of incoming water does not change along the intake)
+            //      With: p = pressure of water at point = d*wh*g (d = water density, wh = water height in point)
+            //
+            // Considering that at equilibrium we have v=0 and p=external_pressure,
+            // then c=external_pressure/density;
+            // external_pressure is height_of_water_at_y*g*density, then c=height_of_water_at_y*g;
+            // hence, the velocity of water incoming at point p, when the "water height" in the point is already
+            // wh and the external water pressure is d*height_of_water_at_y*g, is:
+            //  v = +/- sqrt(2*g*|height_of_water_at_y-wh|)
+            //
 
-                float const externalWaterHeight = std::max(
-                    mParentWorld.GetWaterHeightAt(mPoints.GetPosition(pointIndex).x) - mPoints.GetPosition(pointIndex).y,
-                    0.0f);
+            float const externalWaterHeight = std::max(
+                mPoints.GetWaterSurfaceHeight(pointIndex) - mPoints.GetPosition(pointIndex).y,
+                0.0f);
 
-                float const internalWaterHeight = mPoints.GetWater(pointIndex);
+            float const internalWaterHeight = mPoints.GetWater(pointIndex);
 
-                float incomingWaterVelocity;
-                if (externalWaterHeight >= internalWaterHeight)
-                {
-                    // Incoming water
-                    incomingWaterVelocity = sqrtf(2.0f * GameParameters::GravityMagnitude * (externalWaterHeight - internalWaterHeight));
-                }
-                else
-                {
-                    // Outgoing water
-                    incomingWaterVelocity = - sqrtf(2.0f * GameParameters::GravityMagnitude * (internalWaterHeight - externalWaterHeight));
-                }
+            float incomingWaterVelocity;
+            if (externalWaterHeight >= internalWaterHeight)
+            {
+                // Incoming water
+                incomingWaterVelocity = sqrtf(2.0f * GameParameters::GravityMagnitude * (externalWaterHeight - internalWaterHeight));
+            }
+            else
+            {
+                // Outgoing water
+                incomingWaterVelocity = - sqrtf(2.0f * GameParameters::GravityMagnitude * (internalWaterHeight - externalWaterHeight));
+            }
 
-                //
-                // 2) In/Outtake water according to velocity:
-                // - During dt, we move a volume of water Vw equal to A*v*dt; the equivalent change in water
-                //   height is thus Vw/A, i.e. v*dt
-                //
+            //
+            // 2) In/Outtake water according to velocity:
+            // - During dt, we move a volume of water Vw equal to A*v*dt; the equivalent change in water
+            //   height is thus Vw/A, i.e. v*dt
+            //
 
-                float newWater =
-                    incomingWaterVelocity
-                    * GameParameters::SimulationStepTimeDuration<float>
-                    * gameParameters.WaterIntakeAdjustment;
+            float newWater =
+                incomingWaterVelocity
+                * GameParameters::SimulationStepTimeDuration<float>
+                * gameParameters.WaterIntakeAdjustment;
 
-                if (newWater < 0.0f)
-                {
-                    // Outgoing water
+            if (newWater < 0.0f)
+            {
+                // Outgoing water
 
-                    // Make sure we don't over-drain the point
-                    newWater = -std::min(-newWater, mPoints.GetWater(pointIndex));
+                // Make sure we don't over-drain the point
+                newWater = -std::min(-newWater, mPoints.GetWater(pointIndex));
 
-                    // Honor the water retention of this material
-                    newWater *= mPoints.GetWaterRestitution(pointIndex);
-                }
+                // Honor the water retention of this material
+                newWater *= mPoints.GetWaterRestitution(pointIndex);
+            }
 
-                // Adjust water
-                mPoints.GetWater(pointIndex) += newWater;
+            // Adjust water
+            mPoints.GetWater(pointIndex) += newWater;
 
-                // Adjust total cumulated intaken water at this point
-                mPoints.GetCumulatedIntakenWater(pointIndex) += newWater;
+            // Adjust total cumulated intaken water at this point
+            mPoints.GetCumulatedIntakenWater(pointIndex) += newWater;
 
-                // Check if it's time to produce air bubbles
-                if (mPoints.GetCumulatedIntakenWater(pointIndex) > gameParameters.CumulatedIntakenWaterThresholdForAirBubbles)
+            // Check if it's time to produce air bubbles
+            if (mPoints.GetCumulatedIntakenWater(pointIndex) > gameParameters.CumulatedIntakenWaterThresholdForAirBubbles)
+            {
+                // Generate air bubbles - but not on ropes as that looks awful
+                //
+                // FUTURE: and for the time being, also not on orphaned points as those are not visible
+                // at the moment; this may be removed later when orphaned points will be visible
+                if (gameParameters.DoGenerateAirBubbles
+                    && !mPoints.IsRope(pointIndex)
+                    && mPoints.GetConnectedSprings(pointIndex).size() > 0)
                 {
-                    // Generate air bubbles - but not on ropes as that looks awful
-                    //
-                    // FUTURE: and for the time being, also not on orphaned points as those are not visible
-                    // at the moment; this may be removed later when orphaned points will be visible
-                    if (gameParameters.DoGenerateAirBubbles
-                        && !mPoints.IsRope(pointIndex)
-                        && mPoints.GetConnectedSprings(pointIndex).size() > 0)
-                    {
-                        GenerateAirBubbles(
-                            mPoints.GetPosition(pointIndex),
-                            currentSimulationTime,
-                            mPoints.GetConnectedComponentId(pointIndex),
-                            gameParameters);
-                    }
-
-                    // Consume all cumulated water
-                    mPoints.GetCumulatedIntakenWater(pointIndex) = 0.0f;
+                    GenerateAirBubbles(
+                        mPoints.GetPosition(pointIndex),
+                        currentSimulationTime,
+                        mPoints.GetConnectedComponentId(pointIndex),
+                        gameParameters);
                 }
 
-                // Adjust total water taken during step
-                waterTaken += newWater;
+                // Consume all cumulated water
+                mPoints.GetCumulatedIntakenWater(pointIndex) = 0.0f;
             }
+
+            // Adjust total water taken during step
+            waterTaken += newWater;
+
+            // Remember the point might now be wet
+            if (mPoints.GetWater(pointIndex) != 0.0f)
+                mWetPoints.push_back(pointIndex);
         }
     }
 }
@@ -1096,212 +1458,426 @@ void Ship::UpdateWaterVelocities(
     float & waterSplashed)
 {
     //
-    // For each point, move each spring's outgoing water momentum to
-    // its destination point
+    // Move each spring's outgoing water momentum to its destination point
     //
     // Implementation of https://gabrielegiuseppini.wordpress.com/2018/09/08/momentum-based-simulation-of-water-flooding-2d-spaces/
     //
-
-    // Calculate water momenta
-    mPoints.UpdateWaterMomentaFromVelocities();
-
-    // Source and result water buffers
-    float * restrict oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
-    auto newPointWaterBuffer = mPoints.MakeWaterBufferCopy();
-    float * restrict newPointWaterBufferData = newPointWaterBuffer->data();
-    vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
-    vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
-
-    // Weights of outbound water flows along each spring, including impermeable ones;
-    // set to zero for springs whose resultant scalar water velocities are
-    // directed towards the point being visited
-    std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundWaterFlowWeights;
-
-    // Total weight
-    float totalOutboundWaterFlowWeight;
-
-    // Resultant water velocities along each spring
-    std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
-
+    // Water may only move along springs with at least one wet endpoint, hence we only visit
+    // those springs and the points they connect - the wet points and their neighbors.
     //
-    // Precalculate point "freeness factors", i.e. how much each point's
-    // quantity of water "suppresses" splashes from adjacent kinetic energy losses
+    // The flows are calculated in three phases, each one only writing to the elements
+    // of its own range and only reading what the previous phases have written, so that
+    // each phase may be split among multiple threads:
+    //  1) Springs: outbound water velocities and flow weights, from each endpoint
+    //  2) Points: normalization factors for the quantities of water leaving each point
+    //  3) Points: water and momenta gathered from the flows along the point's springs
     //
 
+    UpdateWaterActiveElements();
+
+    // Work buffers
+    auto newPointWaterBuffer = mPoints.AllocateWorkBufferFloat();
     auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
-    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
-    for (auto pointIndex : mPoints)
+    auto pointWaterQuantityNormalizationFactorBuffer = mPoints.AllocateWorkBufferFloat();
+    auto springOutboundWaterVelocityBuffer = mSprings.AllocateWorkBufferVec2f();
+    auto springOutboundWaterFlowWeightBuffer = mSprings.AllocateWorkBufferVec2f();
+
+    mWaterDiffusionState.WaterCrazyness = gameParameters.WaterCrazyness;
+    mWaterDiffusionState.WaterDiffusionSpeedAdjustment = gameParameters.WaterDiffusionSpeedAdjustment;
+    mWaterDiffusionState.NewPointWater = newPointWaterBuffer->data();
+    mWaterDiffusionState.PointFreenessFactor = pointFreenessFactorBuffer->data();
+    mWaterDiffusionState.PointWaterQuantityNormalizationFactor = pointWaterQuantityNormalizationFactorBuffer->data();
+    mWaterDiffusionState.SpringOutboundWaterVelocities = springOutboundWaterVelocityBuffer->data();
+    mWaterDiffusionState.SpringOutboundWaterFlowWeights = springOutboundWaterFlowWeightBuffer->data();
+
+    if (!mWaterSpringFlowTasks.empty()
+        && mWaterActivePoints.size() >= MinPointsPerTask)
     {
-        pointFreenessFactorBufferData[pointIndex] =
-            FastExp(-oldPointWaterBufferData[pointIndex] * 10.0f);
-    }
+        auto & taskThreadPool = mParentWorld.GetTaskThreadPool();
+
+        taskThreadPool.Run(mWaterSpringFlowTasks);
+        taskThreadPool.Run(mWaterNormalizationTasks);
+        taskThreadPool.Run(mWaterMoveTasks);
+
+        // Sum in task order, so that the result does not depend on scheduling
+        for (float const taskWaterSplashed : mWaterSplashedPerTask)
+        {
+            waterSplashed += taskWaterSplashed;
+        }
+    }
+    else
+    {
+        CalculateSpringWaterFlows(0, mWaterActiveSprings.size());
+        CalculatePointWaterNormalizationFactors(0, mWaterActivePoints.size());
+        waterSplashed += MovePointWater(0, mWaterActivePoints.size());
+    }
+
 
 
     //
-    // Visit all points and move water and its momenta
+    // Average kinetic energy loss
     //
 
-    for (auto pointIndex : mPoints)
-    {
-        //
-        // 1) Calculate water momenta along all springs
-        //
+    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
 
-        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
-        // and gravity were exaggerated
-        //
-        // WV[t] = WV[t-1] + alpha * Bernoulli
-        //
-        // WaterCrazyness=0   -> alpha=1
-        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
-        // WaterCrazyness=1   -> alpha=Wh
-        float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
 
-        // Kinetic energy lost at this point
-        float pointKineticEnergyLoss = 0.0f;
 
-        // Count of non-hull free and drowned neighbor points
-        float pointSplashNeighbors = 0.0f;
-        float pointSplashFreeNeighbors = 0.0f;
+    //
+    // Move result values back to points, transforming momenta into velocities,
+    // and remember which points are still wet
+    //
 
-        totalOutboundWaterFlowWeight = 0.0f;
+    float * restrict const pointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    vec2f * restrict const pointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    vec2f * restrict const pointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+    float const * restrict const newPointWaterBufferData = newPointWaterBuffer->data();
 
-        for (size_t s = 0; s < mPoints.GetConnectedSprings(pointIndex).size(); ++s)
+    mWetPoints.clear();
+
+    for (auto const pointIndex : mWaterActivePoints)
+    {
+        pointWaterBufferData[pointIndex] = newPointWaterBufferData[pointIndex];
+
+        if (newPointWaterBufferData[pointIndex] != 0.0f)
         {
-            auto const springIndex = mPoints.GetConnectedSprings(pointIndex)[s];
+            pointWaterVelocityBufferData[pointIndex] =
+                pointWaterMomentumBufferData[pointIndex]
+                / newPointWaterBufferData[pointIndex];
 
-            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+            mWetPoints.push_back(pointIndex);
+        }
+        else
+        {
+            // No mass, no velocity
+            pointWaterVelocityBufferData[pointIndex] = vec2f::zero();
+            pointWaterMomentumBufferData[pointIndex] = vec2f::zero();
+        }
+    }
+}
 
-            // Normalized spring vector, oriented point -> other endpoint
-            vec2f const springNormalizedVector = (mPoints.GetPosition(otherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
+void Ship::UpdateWaterActiveElements()
+{
+    float const * restrict const pointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    vec2f * restrict const pointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    vec2f * restrict const pointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
 
-            // Component of the point's own water velocity along the spring
-            float const pointWaterVelocityAlongSpring =
-                oldPointWaterVelocityBufferData[pointIndex]
-                .dot(springNormalizedVector);
+    mWaterActivePoints.clear();
+    mWaterActiveSprings.clear();
 
-            //
-            // Calulate Bernoulli's velocity gained along this spring, from this point to
-            // the other endpoint
-            //
+    // Points may have become wet more than once since the last visit
+    std::sort(mWetPoints.begin(), mWetPoints.end());
+    mWetPoints.erase(
+        std::unique(mWetPoints.begin(), mWetPoints.end()),
+        mWetPoints.end());
 
-            // Pressure difference (positive implies point -> other endpoint flow)
-            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[otherEndpointIndex];
+    for (auto const pointIndex : mWetPoints)
+    {
+        if (pointWaterBufferData[pointIndex] == 0.0f)
+        {
+            // Dried up in the meantime; we won't visit it anymore,
+            // so make sure it's not left with any stale velocity
+            pointWaterVelocityBufferData[pointIndex] = vec2f::zero();
+            pointWaterMomentumBufferData[pointIndex] = vec2f::zero();
 
-            // Gravity potential difference (positive implies point -> other endpoint flow)
-            float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(otherEndpointIndex).y;
+            continue;
+        }
 
-            // Calculate gained water velocity along this spring, from point to other endpoint
-            // (Bernoulli, 1738)
-            float bernoulliVelocityAlongSpring;
-            float const dwy = dw + dy;
-            if (dwy >= 0.0f)
+        if (!mIsWaterActivePoint[pointIndex])
+        {
+            mIsWaterActivePoint[pointIndex] = true;
+            mWaterActivePoints.push_back(pointIndex);
+        }
+
+        for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
+        {
+            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+
+            // Springs between two wet points are taken by the lowest endpoint only
+            if (pointWaterBufferData[otherEndpointIndex] == 0.0f
+                || pointIndex < otherEndpointIndex)
             {
-                // Gained velocity goes from point to other endpoint
-                bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
+                mWaterActiveSprings.push_back(springIndex);
             }
-            else
+
+            if (!mIsWaterActivePoint[otherEndpointIndex])
             {
-                // Gained velocity goes from other endpoint to point
-                bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
+                mIsWaterActivePoint[otherEndpointIndex] = true;
+                mWaterActivePoints.push_back(otherEndpointIndex);
             }
+        }
+    }
 
-            // Resultant scalar velocity along spring; outbound only, as
-            // if this were inbound it wouldn't result in any movement of the point's
-            // water between these two springs. Morevoer, Bernoulli's velocity injected
-            // along this spring will be picked up later also by the other endpoint,
-            // and at that time it would move water if it agrees with its velocity
-            float const springOutboundScalarWaterVelocity = std::max(
-                pointWaterVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
-                0.0f);
+    // Reset flags for next time
+    for (auto const pointIndex : mWaterActivePoints)
+    {
+        mIsWaterActivePoint[pointIndex] = false;
+    }
 
-            // Store weight along spring, scaling for the greater distance traveled along
-            // diagonalsprings
-            springOutboundWaterFlowWeights[s] =
-                springOutboundScalarWaterVelocity
-                / mSprings.GetRestLength(springIndex);
+    // Visit in memory order
+    std::sort(mWaterActivePoints.begin(), mWaterActivePoints.end());
+    std::sort(mWaterActiveSprings.begin(), mWaterActiveSprings.end());
+}
 
-            // Resultant outbound velocity along spring
-            springOutboundWaterVelocities[s] =
-                springNormalizedVector
-                * springOutboundScalarWaterVelocity;
+void Ship::CalculateSpringWaterFlows(
+    size_t startActiveSpring,
+    size_t endActiveSpring)
+{
+    float const * restrict const pointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    vec2f const * restrict const pointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    vec2f * restrict const springOutboundWaterVelocityBufferData = mWaterDiffusionState.SpringOutboundWaterVelocities;
+    vec2f * restrict const springOutboundWaterFlowWeightBufferData = mWaterDiffusionState.SpringOutboundWaterFlowWeights;
 
-            // Update total outbound flow weight
-            totalOutboundWaterFlowWeight += springOutboundWaterFlowWeights[s];
+    for (size_t s = startActiveSpring; s < endActiveSpring; ++s)
+    {
+        auto const springIndex = mWaterActiveSprings[s];
 
+        auto const pointAIndex = mSprings.GetPointAIndex(springIndex);
+        auto const pointBIndex = mSprings.GetPointBIndex(springIndex);
 
-            //
-            // Update splash neighbors counts
-            //
+        // Active springs are connected to at least one wet point
+        assert(!mSprings.IsDeleted(springIndex));
+        assert(pointWaterBufferData[pointAIndex] != 0.0f || pointWaterBufferData[pointBIndex] != 0.0f);
 
-            pointSplashFreeNeighbors +=
-                mSprings.GetWaterPermeability(springIndex)
-                * pointFreenessFactorBufferData[otherEndpointIndex];
+        // Normalized spring vector, oriented A -> B
+        vec2f const springNormalizedVector = mSprings.GetDirection(springIndex);
 
-            pointSplashNeighbors += mSprings.GetWaterPermeability(springIndex);
+        // Components of the endpoints' own water velocities along the spring, outbound
+        float const pointAWaterVelocityAlongSpring =
+            pointWaterVelocityBufferData[pointAIndex]
+            .dot(springNormalizedVector);
+        float const pointBWaterVelocityAlongSpring =
+            pointWaterVelocityBufferData[pointBIndex]
+            .dot(-springNormalizedVector);
+
+        //
+        // Calulate Bernoulli's velocity gained along this spring, from A to B;
+        // the velocity gained from B to A is its opposite
+        //
+
+        // Pressure difference (positive implies A -> B flow)
+        float const dw = pointWaterBufferData[pointAIndex] - pointWaterBufferData[pointBIndex];
+
+        // Gravity potential difference (positive implies A -> B flow)
+        float const dy = mPoints.GetPosition(pointAIndex).y - mPoints.GetPosition(pointBIndex).y;
+
+        // Calculate gained water velocity along this spring, from A to B
+        // (Bernoulli, 1738)
+        float bernoulliVelocityAlongSpring;
+        float const dwy = dw + dy;
+        if (dwy >= 0.0f)
+        {
+            // Gained velocity goes from A to B
+            bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
         }
+        else
+        {
+            // Gained velocity goes from B to A
+            bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
+        }
+
+        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
+        // and gravity were exaggerated
+        //
+        // WV[t] = WV[t-1] + alpha * Bernoulli
+        //
+        // WaterCrazyness=0   -> alpha=1
+        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
+        // WaterCrazyness=1   -> alpha=Wh
+        float const pointAAlphaCrazyness = 1.0f + mWaterDiffusionState.WaterCrazyness * (pointWaterBufferData[pointAIndex] - 1.0f);
+        float const pointBAlphaCrazyness = 1.0f + mWaterDiffusionState.WaterCrazyness * (pointWaterBufferData[pointBIndex] - 1.0f);
+
+        // Resultant scalar velocities along spring; outbound only, as
+        // if these were inbound they wouldn't result in any movement of the endpoint's
+        // water along this spring. Inbound velocities are picked up by the
+        // other endpoint, which moves water if they agree with its velocity
+        vec2f const springOutboundScalarWaterVelocities(
+            std::max(
+                pointAWaterVelocityAlongSpring + bernoulliVelocityAlongSpring * pointAAlphaCrazyness,
+                0.0f),
+            std::max(
+                pointBWaterVelocityAlongSpring - bernoulliVelocityAlongSpring * pointBAlphaCrazyness,
+                0.0f));
+
+        springOutboundWaterVelocityBufferData[springIndex] = springOutboundScalarWaterVelocities;
+
+        // Store weights along spring, scaling for the greater distance traveled along
+        // diagonal springs
+        springOutboundWaterFlowWeightBufferData[springIndex] =
+            springOutboundScalarWaterVelocities
+            / mSprings.GetRestLength(springIndex);
+    }
+}
+
+void Ship::CalculatePointWaterNormalizationFactors(
+    size_t startActivePoint,
+    size_t endActivePoint)
+{
+    float const * restrict const pointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    vec2f const * restrict const springOutboundWaterFlowWeightBufferData = mWaterDiffusionState.SpringOutboundWaterFlowWeights;
+    float * restrict const pointFreenessFactorBufferData = mWaterDiffusionState.PointFreenessFactor;
+    float * restrict const pointWaterQuantityNormalizationFactorBufferData = mWaterDiffusionState.PointWaterQuantityNormalizationFactor;
 
+    for (size_t p = startActivePoint; p < endActivePoint; ++p)
+    {
+        auto const pointIndex = mWaterActivePoints[p];
 
+        // The point's "freeness factor", i.e. how much its quantity of water
+        // "suppresses" splashes from adjacent kinetic energy losses
+        pointFreenessFactorBufferData[pointIndex] =
+            FastExp(-pointWaterBufferData[pointIndex] * 10.0f);
+
+        if (pointWaterBufferData[pointIndex] == 0.0f)
+        {
+            // Nothing leaves a dry point
+            pointWaterQuantityNormalizationFactorBufferData[pointIndex] = 0.0f;
+
+            continue;
+        }
 
         //
-        // 2) Calculate normalization factor for water flows:
-        //    the quantity of water along a spring is proportional to the weight of the spring
-        //    (resultant velocity along that spring), and the sum of all outbound water flows must
-        //    match the water currently at the point times the water speed fraction and the adjustment
+        // The quantity of water along a spring is proportional to the weight of the spring
+        // (resultant velocity along that spring), and the sum of all outbound water flows must
+        // match the water currently at the point times the water speed fraction and the adjustment
         //
 
+        float totalOutboundWaterFlowWeight = 0.0f;
+        for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
+        {
+            totalOutboundWaterFlowWeight += (pointIndex == mSprings.GetPointAIndex(springIndex))
+                ? springOutboundWaterFlowWeightBufferData[springIndex].x
+                : springOutboundWaterFlowWeightBufferData[springIndex].y;
+        }
+
         assert(totalOutboundWaterFlowWeight >= 0.0f);
 
         float waterQuantityNormalizationFactor = 0.0f;
         if (totalOutboundWaterFlowWeight != 0.0f)
         {
             waterQuantityNormalizationFactor =
-                oldPointWaterBufferData[pointIndex]
+                pointWaterBufferData[pointIndex]
                 * mPoints.GetWaterDiffusionSpeed(pointIndex)
-                * gameParameters.WaterDiffusionSpeedAdjustment
+                * mWaterDiffusionState.WaterDiffusionSpeedAdjustment
                 / totalOutboundWaterFlowWeight;
         }
 
+        pointWaterQuantityNormalizationFactorBufferData[pointIndex] = waterQuantityNormalizationFactor;
+    }
+}
 
-        //
-        // 3) Move water along all springs according to their flows,
-        //    and update destination's momenta accordingly
-        //
+float Ship::MovePointWater(
+    size_t startActivePoint,
+    size_t endActivePoint)
+{
+    float const * restrict const oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    vec2f const * restrict const oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    float const * restrict const pointFreenessFactorBufferData = mWaterDiffusionState.PointFreenessFactor;
+    float const * restrict const pointWaterQuantityNormalizationFactorBufferData = mWaterDiffusionState.PointWaterQuantityNormalizationFactor;
+    vec2f const * restrict const springOutboundWaterVelocityBufferData = mWaterDiffusionState.SpringOutboundWaterVelocities;
+    vec2f const * restrict const springOutboundWaterFlowWeightBufferData = mWaterDiffusionState.SpringOutboundWaterFlowWeights;
+    float * restrict const newPointWaterBufferData = mWaterDiffusionState.NewPointWater;
+    vec2f * restrict const newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+
+    float waterSplashed = 0.0f;
+
+    for (size_t p = startActivePoint; p < endActivePoint; ++p)
+    {
+        auto const pointIndex = mWaterActivePoints[p];
+
+        bool const isPointWet = (oldPointWaterBufferData[pointIndex] != 0.0f);
+
+        float newPointWater = oldPointWaterBufferData[pointIndex];
+        vec2f newPointWaterMomentum =
+            oldPointWaterVelocityBufferData[pointIndex]
+            * oldPointWaterBufferData[pointIndex];
 
-        for (size_t s = 0; s < mPoints.GetConnectedSprings(pointIndex).size(); ++s)
+        // Kinetic energy lost at this point
+        float pointKineticEnergyLoss = 0.0f;
+
+        // Count of non-hull free and drowned neighbor points
+        float pointSplashNeighbors = 0.0f;
+        float pointSplashFreeNeighbors = 0.0f;
+
+        for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
         {
-            auto const springIndex = mPoints.GetConnectedSprings(pointIndex)[s];
+            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+
+            if (!isPointWet && oldPointWaterBufferData[otherEndpointIndex] == 0.0f)
+            {
+                // Not an active spring, nothing moves along it
+                continue;
+            }
 
-            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(
-                springIndex,
-                pointIndex);
+            bool const isPointA = (pointIndex == mSprings.GetPointAIndex(springIndex));
+
+            //
+            // Update splash neighbors counts; these only matter for
+            // the kinetic energy lost by wet points
+            //
+
+            if (isPointWet)
+            {
+                pointSplashFreeNeighbors +=
+                    mSprings.GetWaterPermeability(springIndex)
+                    * pointFreenessFactorBufferData[otherEndpointIndex];
+
+                pointSplashNeighbors += mSprings.GetWaterPermeability(springIndex);
+            }
+
+            //
+            // Calculate quantities of water directed outwards and inwards
+            //
 
-            // Calculate quantity of water directed outwards
             float const springOutboundQuantityOfWater =
-                springOutboundWaterFlowWeights[s]
-                * waterQuantityNormalizationFactor;
+                (isPointA ? springOutboundWaterFlowWeightBufferData[springIndex].x : springOutboundWaterFlowWeightBufferData[springIndex].y)
+                * pointWaterQuantityNormalizationFactorBufferData[pointIndex];
+
+            float const springInboundQuantityOfWater =
+                (isPointA ? springOutboundWaterFlowWeightBufferData[springIndex].y : springOutboundWaterFlowWeightBufferData[springIndex].x)
+                * pointWaterQuantityNormalizationFactorBufferData[otherEndpointIndex];
 
             assert(springOutboundQuantityOfWater >= 0.0f);
+            assert(springInboundQuantityOfWater >= 0.0f);
+
+            if (springOutboundQuantityOfWater == 0.0f && springInboundQuantityOfWater == 0.0f)
+            {
+                // Nothing moves along this spring
+                continue;
+            }
+
+            // Normalized spring vector, oriented point -> other endpoint
+            vec2f const springNormalizedVector = isPointA
+                ? mSprings.GetDirection(springIndex)
+                : -mSprings.GetDirection(springIndex);
+
+            // Resultant outbound velocity along spring
+            vec2f const springOutboundWaterVelocity =
+                springNormalizedVector
+                * (isPointA ? springOutboundWaterVelocityBufferData[springIndex].x : springOutboundWaterVelocityBufferData[springIndex].y);
 
             if (mSprings.GetWaterPermeability(springIndex) != 0.0f)
             {
                 //
-                // Water - and momentum - move from point to endpoint
+                // Water - and momentum - move out of the point and into it
                 //
 
                 // Move water quantity
-                newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
-                newPointWaterBufferData[otherEndpointIndex] += springOutboundQuantityOfWater;
+                newPointWater -= springOutboundQuantityOfWater;
+                newPointWater += springInboundQuantityOfWater;
 
-                // Remove "old momentum" (old velocity) from point
-                newPointWaterMomentumBufferData[pointIndex] -=
+                // Remove "old momentum" (old velocity) of the water leaving the point
+                newPointWaterMomentum -=
                     oldPointWaterVelocityBufferData[pointIndex]
                     * springOutboundQuantityOfWater;
 
-                // Add "new momentum" (old velocity + velocity gained) to other endpoint
-                newPointWaterMomentumBufferData[otherEndpointIndex] +=
-                    springOutboundWaterVelocities[s]
-                    * springOutboundQuantityOfWater;
+                // Add "new momentum" (old velocity + velocity gained) of the water
+                // coming from the other endpoint
+                vec2f const springInboundWaterVelocity =
+                    -springNormalizedVector
+                    * (isPointA ? springOutboundWaterVelocityBufferData[springIndex].y : springOutboundWaterVelocityBufferData[springIndex].x);
+
+                newPointWaterMomentum +=
+                    springInboundWaterVelocity
+                    * springInboundQuantityOfWater;
 
 
                 //
@@ -1309,11 +1885,8 @@ void Ship::UpdateWaterVelocities(
                 // splintered water colliding with whole other endpoint
                 //
 
-                // FUTURE: get rid of this re-calculation once we pre-calculate all spring normalized vectors
-                vec2f const springNormalizedVector = (mPoints.GetPosition(otherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
-
                 float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
+                float va = springOutboundWaterVelocity.length();
                 float mb = oldPointWaterBufferData[otherEndpointIndex];
                 float vb = oldPointWaterVelocityBufferData[otherEndpointIndex].dot(springNormalizedVector);
 
@@ -1327,8 +1900,8 @@ void Ship::UpdateWaterVelocities(
                     * (va * va - vf * vf);
 
                 // Note: deltaKa might be negative, in which case deltaKb would have been
-                // more positive (perfectly inelastic -> deltaK == max); we will pickup
-                // deltaKb later
+                // more positive (perfectly inelastic -> deltaK == max); the other endpoint
+                // picks up deltaKb
                 pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
             }
             else
@@ -1343,8 +1916,8 @@ void Ship::UpdateWaterVelocities(
                 // No changes to other endpoint
                 //
 
-                newPointWaterMomentumBufferData[pointIndex] -=
-                    springOutboundWaterVelocities[s]
+                newPointWaterMomentum -=
+                    springOutboundWaterVelocity
                     * springOutboundQuantityOfWater;
 
 
@@ -1354,7 +1927,7 @@ void Ship::UpdateWaterVelocities(
                 //
 
                 float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
+                float va = springOutboundWaterVelocity.length();
 
                 float deltaKa =
                     0.5f
@@ -1366,8 +1939,11 @@ void Ship::UpdateWaterVelocities(
             }
         }
 
+        newPointWaterBufferData[pointIndex] = newPointWater;
+        newPointWaterMomentumBufferData[pointIndex] = newPointWaterMomentum;
+
         //
-        // 4) Update water splash
+        // Update water splash
         //
 
         if (pointSplashNeighbors != 0.0f)
@@ -1381,22 +1957,7 @@ void Ship::UpdateWaterVelocities(
         }
     }
 
-
-
-    //
-    // Average kinetic energy loss
-    //
-
-    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
-
-
-
-    //
-    // Move result values back to point, transforming momenta into velocities
-    //
-
-    mPoints.UpdateWaterBuffer(std::move(newPointWaterBuffer));
-    mPoints.UpdateWaterVelocitiesFromMomenta();
+    return waterSplashed;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -1408,137 +1969,286 @@ void Ship::UpdateElectricalDynamics(
     VisitSequenceNumber currentVisitSequenceNumber,
     GameParameters const & gameParameters)
 {
-    // Invoked regardless of dirty elements, as generators might become wet
-    UpdateElectricalConnectivity(currentVisitSequenceNumber);
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::Electrical, gameParameters.DoProfileShipUpdates);
 
-    mElectricalElements.Update(
-        currentWallclockTime,
-        currentVisitSequenceNumber,
-        mPoints,
-        gameParameters);
+        // Invoked regardless of dirty elements, as generators might become wet
+        mElectricalElements.UpdateConnectivity(
+            currentVisitSequenceNumber,
+            mPoints);
+
+        mElectricalElements.Update(
+            currentWallclockTime,
+            mPoints,
+            gameParameters);
+    }
+
+    {
+        ShipUpdateProfiler::ScopedPhaseTimer const timer(mUpdateProfiler, ShipUpdatePhase::Light, gameParameters.DoProfileShipUpdates);
 
-    DiffuseLight(gameParameters);
+        DiffuseLight(gameParameters);
+    }
 }
 
-void Ship::UpdateElectricalConnectivity(VisitSequenceNumber currentVisitSequenceNumber)
+void Ship::DiffuseLight(GameParameters const & gameParameters)
 {
     //
-    // Visit electrical graph starting from (non-wet) generators, and propagate
-    // visit sequence number
+    // Diffuse light from each lamp to all connected (i.e. spring-connected) points,
+    // inverse-proportionally to the nth power of the distance, where n is the spread.
+    //
+    // The light of the non-ephemeral points only changes when the lamps or the structure
+    // of the ship change, hence we only re-diffuse it to them when any of those has changed
+    // meaningfully - including points moving relative to the lamps of their component, e.g.
+    // swinging ropes or parts hanging from the structure; ephemeral particles come and go and
+    // move freely, and we light them at each step.
     //
 
-    std::queue<ElementIndex> electricalElementsToVisit;
+    auto const & lamps = mElectricalElements.Lamps();
 
-    for (auto generatorIndex : mElectricalElements.Generators())
-    {
-        // Do not visit deleted generators
-        if (!mElectricalElements.IsDeleted(generatorIndex))
+    auto const calculateEffectiveLampLight =
+        [&](ElementIndex lampIndex)
         {
-            // Make sure we haven't visited it already
-            if (currentVisitSequenceNumber != mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(generatorIndex))
-            {
-                // Mark it as visited
-                mElectricalElements.SetConnectivityVisitSequenceNumber(
-                    generatorIndex,
-                    currentVisitSequenceNumber);
+            return mElectricalElements.GetAvailableCurrent(lampIndex)
+                * mElectricalElements.GetLuminiscence(lampIndex)
+                * gameParameters.LuminiscenceAdjustment;
+        };
 
-                // Check if dry enough
-                if (!mPoints.IsWet(mElectricalElements.GetPointIndex(generatorIndex), 0.3f))
-                {
-                    // Add generator to queue
-                    assert(electricalElementsToVisit.empty());
-                    electricalElementsToVisit.push(generatorIndex);
+    auto const calculateEffectiveExponent =
+        [&](float lampLightSpread)
+        {
+            return (1.0f / lampLightSpread)
+                * gameParameters.LightSpreadAdjustment
+                / 2.0f; // We piggyback on the power to avoid taking a sqrt for distance
+        };
+
+    // Visits the points in the lamp's connected component that are within the cutoff distance
+    // from the lamp; visits the points around the lamp when the cutoff circle is small compared
+    // to the component, and the whole component otherwise
+    auto const visitLampPointsInCutoff =
+        [&](vec2f const & lampPosition,
+            ConnectedComponentId lampConnectedComponentId,
+            float cutoffSquareDistance,
+            auto && visitor)
+        {
+            assert(lampConnectedComponentId > 0 && lampConnectedComponentId <= mConnectedComponentPoints.size());
+            auto const & connectedComponentPoints = mConnectedComponentPoints[lampConnectedComponentId - 1];
 
-                    // Visit all electrical elements reachable from this generator
-                    while (!electricalElementsToVisit.empty())
+            auto const visitPoint =
+                [&](ElementIndex pointIndex)
+                {
+                    if (mPoints.GetConnectedComponentId(pointIndex) == lampConnectedComponentId)
                     {
-                        auto e = electricalElementsToVisit.front();
-                        electricalElementsToVisit.pop();
-
-                        assert(currentVisitSequenceNumber == mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(e));
-
-                        for (auto reachableElectricalElementIndex : mElectricalElements.GetConnectedElectricalElements(e))
+                        float const squareDistance = (mPoints.GetPosition(pointIndex) - lampPosition).squareLength();
+                        if (squareDistance <= cutoffSquareDistance)
                         {
-                            assert(!mElectricalElements.IsDeleted(reachableElectricalElementIndex));
-
-                            // Make sure not visited already
-                            if (currentVisitSequenceNumber != mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(reachableElectricalElementIndex))
-                            {
-                                // Add to queue
-                                electricalElementsToVisit.push(reachableElectricalElementIndex);
-
-                                // Mark it as visited
-                                mElectricalElements.SetConnectivityVisitSequenceNumber(
-                                    reachableElectricalElementIndex,
-                                    currentVisitSequenceNumber);
-                            }
+                            visitor(pointIndex, squareDistance);
                         }
                     }
+                };
+
+            if (4.0f * cutoffSquareDistance
+                < static_cast<float>(connectedComponentPoints.size()) * PointSpatialGridCellSize * PointSpatialGridCellSize)
+            {
+                mPointSpatialGrid.VisitPointsInRadius(
+                    lampPosition,
+                    std::sqrt(cutoffSquareDistance),
+                    visitPoint);
+            }
+            else
+            {
+                for (auto pointIndex : connectedComponentPoints)
+                {
+                    visitPoint(pointIndex);
                 }
             }
-        }
-    }
-}
+        };
 
-void Ship::DiffuseLight(GameParameters const & gameParameters)
-{
     //
-    // Diffuse light from each lamp to all connected (i.e. spring-connected) points,
-    // inverse-proportionally to the nth power of the distance, where n is the spread
+    // 1. Check whether we need to re-diffuse light to non-ephemeral points
     //
 
-    // Zero-out light at all points first
-    for (auto pointIndex : mPoints)
+    bool doDiffuse =
+        mIsDiffusedLightDirty
+        || mDiffusedLampStates.size() != lamps.size()
+        || mDiffusedLightSpreadAdjustment != gameParameters.LightSpreadAdjustment;
+
+    for (size_t l = 0; !doDiffuse && l < lamps.size(); ++l)
     {
-        // Zero its light
-        mPoints.GetLight(pointIndex) = 0.0f;
+        auto const lampIndex = lamps[l];
+        auto const & diffusedLampState = mDiffusedLampStates[l];
+
+        if (std::abs(calculateEffectiveLampLight(lampIndex) - diffusedLampState.EffectiveLight) >= MinLampLightChangeForDiffusion
+            || mElectricalElements.GetLightSpread(lampIndex) != diffusedLampState.LightSpread)
+        {
+            doDiffuse = true;
+        }
     }
 
-    // Go through all lamps;
-    // can safely visit deleted lamps as their current will always be zero
-    for (auto lampIndex : mElectricalElements.Lamps())
+    if (!doDiffuse)
     {
-        auto const lampPointIndex = mElectricalElements.GetPointIndex(lampIndex);
-
-        float const effectiveLampLight =
-            mElectricalElements.GetAvailableCurrent(lampIndex)
-            * mElectricalElements.GetLuminiscence(lampIndex)
-            * gameParameters.LuminiscenceAdjustment;
+        //
+        // The light of a point only depends on its distance from the lamps of its component,
+        // hence we check whether the points of the lit components have moved away from the
+        // mean displacement of their component since we last diffused; a component that
+        // drifts or sinks as a whole keeps its light. Two points of the same component have
+        // moved relative to each other by at most the sum of their distances from the mean
+        // displacement.
+        //
 
-        float const lampLightSpread = mElectricalElements.GetLightSpread(lampIndex);
-        if (lampLightSpread == 0.0f)
+        std::vector<ConnectedComponentId> litConnectedComponentIds;
+        for (size_t l = 0; l < lamps.size(); ++l)
         {
-            // No spread, just the lamp point itself
-            mPoints.GetLight(lampPointIndex) = effectiveLampLight;
+            if (mDiffusedLampStates[l].LightSpread != 0.0f
+                && mDiffusedLampStates[l].EffectiveLight > MinDiffusedLight)
+            {
+                litConnectedComponentIds.push_back(
+                    mPoints.GetConnectedComponentId(mElectricalElements.GetPointIndex(lamps[l])));
+            }
         }
-        else
-        {
-            // Spread light to all the points in the same connected component
 
-            float const effectiveExponent =
-                (1.0f / lampLightSpread)
-                * gameParameters.LightSpreadAdjustment
-                / 2.0f; // We piggyback on the power to avoid taking a sqrt for distance
+        std::sort(litConnectedComponentIds.begin(), litConnectedComponentIds.end());
+        litConnectedComponentIds.erase(
+            std::unique(litConnectedComponentIds.begin(), litConnectedComponentIds.end()),
+            litConnectedComponentIds.end());
 
-            vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
-            ConnectedComponentId const lampConnectedComponentId = mPoints.GetConnectedComponentId(lampPointIndex);
+        for (size_t c = 0; !doDiffuse && c < litConnectedComponentIds.size(); ++c)
+        {
+            ConnectedComponentId const connectedComponentId = litConnectedComponentIds[c];
+
+            assert(connectedComponentId > 0 && connectedComponentId <= mConnectedComponentPoints.size());
+            auto const & connectedComponentPoints = mConnectedComponentPoints[connectedComponentId - 1];
 
-            for (auto pointIndex : mPoints)
+            vec2f meanDisplacement = vec2f::zero();
+            size_t pointCount = 0;
+            for (auto pointIndex : connectedComponentPoints)
             {
-                if (mPoints.GetConnectedComponentId(pointIndex) == lampConnectedComponentId)
+                if (!mPoints.IsDeleted(pointIndex)
+                    && mPoints.GetConnectedComponentId(pointIndex) == connectedComponentId)
                 {
-                    float const squareDistance = (mPoints.GetPosition(pointIndex) - lampPosition).squareLength();
+                    meanDisplacement += mPoints.GetPosition(pointIndex) - mDiffusedPointPositions[pointIndex];
+                    ++pointCount;
+                }
+            }
+
+            if (0 == pointCount)
+                continue;
 
-                    float const newLight =
-                        effectiveLampLight
-                        / (1.0f + FastPow(squareDistance, effectiveExponent));
+            meanDisplacement /= static_cast<float>(pointCount);
 
-                    if (newLight > mPoints.GetLight(pointIndex))
-                        mPoints.GetLight(pointIndex) = newLight;
+            for (auto pointIndex : connectedComponentPoints)
+            {
+                if (!mPoints.IsDeleted(pointIndex)
+                    && mPoints.GetConnectedComponentId(pointIndex) == connectedComponentId
+                    && (mPoints.GetPosition(pointIndex) - mDiffusedPointPositions[pointIndex] - meanDisplacement).length()
+                        >= MinPointDisplacementForDiffusion / 2.0f)
+                {
+                    doDiffuse = true;
+                    break;
                 }
             }
         }
     }
+
+    //
+    // 2. Diffuse to non-ephemeral points
+    //
+
+    if (doDiffuse)
+    {
+        mDiffusedLampStates.clear();
+        mDiffusedLightSpreadAdjustment = gameParameters.LightSpreadAdjustment;
+        mDiffusedPointPositions.assign(
+            mPoints.GetPositionBufferAsVec2(),
+            mPoints.GetPositionBufferAsVec2() + mPoints.GetShipPointCount());
+        mIsDiffusedLightDirty = false;
+
+        // Zero-out light at all non-ephemeral points first
+        for (auto pointIndex : mPoints.NonEphemeralPoints())
+        {
+            mPoints.GetLight(pointIndex) = 0.0f;
+        }
+
+        // Go through all lamps;
+        // can safely visit deleted lamps as their current will always be zero
+        for (auto lampIndex : lamps)
+        {
+            auto const lampPointIndex = mElectricalElements.GetPointIndex(lampIndex);
+            vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
+
+            float const effectiveLampLight = calculateEffectiveLampLight(lampIndex);
+            float const lampLightSpread = mElectricalElements.GetLightSpread(lampIndex);
+
+            mDiffusedLampStates.emplace_back(
+                effectiveLampLight,
+                lampLightSpread);
+
+            if (lampLightSpread == 0.0f)
+            {
+                // No spread, just the lamp point itself
+                mPoints.GetLight(lampPointIndex) = effectiveLampLight;
+            }
+            else if (effectiveLampLight > MinDiffusedLight)
+            {
+                // Spread light to all the points in the same connected component,
+                // as long as they are close enough to get a noticeable amount of it
+
+                float const effectiveExponent = calculateEffectiveExponent(lampLightSpread);
+
+                // Solve effectiveLampLight / (1 + d^(2*exponent)) = MinDiffusedLight for d^2
+                float const cutoffSquareDistance = effectiveExponent > 0.0f
+                    ? std::pow(effectiveLampLight / MinDiffusedLight - 1.0f, 1.0f / effectiveExponent)
+                    : std::numeric_limits<float>::max();
+
+                visitLampPointsInCutoff(
+                    lampPosition,
+                    mPoints.GetConnectedComponentId(lampPointIndex),
+                    cutoffSquareDistance,
+                    [&](ElementIndex pointIndex, float squareDistance)
+                    {
+                        float const newLight =
+                            effectiveLampLight
+                            / (1.0f + FastPow(squareDistance, effectiveExponent));
+
+                        if (newLight > mPoints.GetLight(pointIndex))
+                            mPoints.GetLight(pointIndex) = newLight;
+                    });
+            }
+        }
+    }
+
+    //
+    // 3. Diffuse to ephemeral particles
+    //
+
+    for (auto pointIndex : mPoints.EphemeralPoints())
+    {
+        mPoints.GetLight(pointIndex) = 0.0f;
+
+        if (Points::EphemeralType::None == mPoints.GetEphemeralType(pointIndex))
+            continue;
+
+        ConnectedComponentId const pointConnectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+        vec2f const & pointPosition = mPoints.GetPosition(pointIndex);
+
+        for (size_t l = 0; l < lamps.size(); ++l)
+        {
+            auto const lampPointIndex = mElectricalElements.GetPointIndex(lamps[l]);
+            auto const & diffusedLampState = mDiffusedLampStates[l];
+
+            if (diffusedLampState.LightSpread != 0.0f
+                && mPoints.GetConnectedComponentId(lampPointIndex) == pointConnectedComponentId)
+            {
+                float const squareDistance = (pointPosition - mPoints.GetPosition(lampPointIndex)).squareLength();
+
+                float const newLight =
+                    diffusedLampState.EffectiveLight
+                    / (1.0f + FastPow(squareDistance, calculateEffectiveExponent(diffusedLampState.LightSpread)));
+
+                if (newLight > mPoints.GetLight(pointIndex))
+                    mPoints.GetLight(pointIndex) = newLight;
+            }
+        }
+    }
 }
 
 void Ship::UpdateEphemeralParticles(
@@ -1565,10 +2275,133 @@ void Ship::UpdateEphemeralParticles(
 // Private helpers
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
-void Ship::DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNumber)
+void Ship::MakeParallelTasks()
+{
+    mSpringGeometryTasks.clear();
+    mSpringForceTasks.clear();
+    mWaterSpringFlowTasks.clear();
+    mWaterNormalizationTasks.clear();
+    mWaterMoveTasks.clear();
+    mWaterSplashedPerTask.clear();
+
+    size_t const parallelism = mParentWorld.GetTaskThreadPool().GetParallelism();
+    if (parallelism <= 1)
+    {
+        // Not worth it
+        return;
+    }
+
+    //
+    // Geometry: all springs at once, split in whole packets
+    //
+
+    {
+        ElementCount const springCount = mSprings.GetElementCount();
+
+        size_t const taskCount = std::max(
+            size_t(1),
+            std::min(parallelism, static_cast<size_t>(springCount / MinSpringsPerTask)));
+
+        ElementCount const springsPerTask = (springCount / static_cast<ElementCount>(taskCount)) & ~ElementCount(3);
+
+        for (size_t t = 0; t < taskCount; ++t)
+        {
+            ElementIndex const startSpringIndex = static_cast<ElementIndex>(t) * springsPerTask;
+            ElementIndex const endSpringIndex = (t == taskCount - 1)
+                ? springCount
+                : startSpringIndex + springsPerTask;
+
+            mSpringGeometryTasks.emplace_back(
+                [this, startSpringIndex, endSpringIndex]()
+                {
+                    mSprings.UpdateGeometry(startSpringIndex, endSpringIndex, mPoints);
+                });
+        }
+    }
+
+    //
+    // Forces: one batch per color
+    //
+
+    for (auto const & colorRange : mSprings.GetColorRanges())
+    {
+        ElementCount const colorSpringCount = colorRange.EndSpringIndex - colorRange.StartSpringIndex;
+
+        // Split this color among as many tasks as it makes sense
+        size_t const taskCount = std::max(
+            size_t(1),
+            std::min(parallelism, static_cast<size_t>(colorSpringCount / MinSpringsPerTask)));
+
+        ElementCount const springsPerTask = colorSpringCount / static_cast<ElementCount>(taskCount);
+
+        std::vector<TaskThreadPool::Task> colorTasks;
+
+        for (size_t t = 0; t < taskCount; ++t)
+        {
+            ElementIndex const startSpringIndex = colorRange.StartSpringIndex + static_cast<ElementIndex>(t) * springsPerTask;
+            ElementIndex const endSpringIndex = (t == taskCount - 1)
+                ? colorRange.EndSpringIndex
+                : startSpringIndex + springsPerTask;
+
+            colorTasks.emplace_back(
+                [this, startSpringIndex, endSpringIndex]()
+                {
+                    UpdateSpringForces_Vectorized(startSpringIndex, endSpringIndex);
+                });
+        }
+
+        mSpringForceTasks.emplace_back(std::move(colorTasks));
+    }
+
+    //
+    // Water diffusion: springs, then points, then points again; the tasks split the
+    // active elements of the step among themselves, as their number changes at each step
+    //
+
+    size_t const waterTaskCount = parallelism;
+
+    mWaterSplashedPerTask.resize(waterTaskCount, 0.0f);
+
+    for (size_t t = 0; t < waterTaskCount; ++t)
+    {
+        mWaterSpringFlowTasks.emplace_back(
+            [this, t, waterTaskCount]()
+            {
+                CalculateSpringWaterFlows(
+                    mWaterActiveSprings.size() * t / waterTaskCount,
+                    mWaterActiveSprings.size() * (t + 1) / waterTaskCount);
+            });
+
+        mWaterNormalizationTasks.emplace_back(
+            [this, t, waterTaskCount]()
+            {
+                CalculatePointWaterNormalizationFactors(
+                    mWaterActivePoints.size() * t / waterTaskCount,
+                    mWaterActivePoints.size() * (t + 1) / waterTaskCount);
+            });
+
+        mWaterMoveTasks.emplace_back(
+            [this, t, waterTaskCount]()
+            {
+                mWaterSplashedPerTask[t] = MovePointWater(
+                    mWaterActivePoints.size() * t / waterTaskCount,
+                    mWaterActivePoints.size() * (t + 1) / waterTaskCount);
+            });
+    }
+}
+
+void Ship::DetectConnectedComponents()
 {
+    VisitSequenceNumber const currentVisitSequenceNumber = NextConnectivityVisitSequenceNumber(1);
+
     mConnectedComponentSizes.clear();
 
+    // Keep the point lists' capacity, as most components survive a detection
+    for (auto & connectedComponentPoints : mConnectedComponentPoints)
+    {
+        connectedComponentPoints.clear();
+    }
+
     ConnectedComponentId currentConnectedComponentId = 0;
     std::queue<ElementIndex> pointsToVisitForConnectedComponents;
 
@@ -1585,6 +2418,11 @@ void Ship::DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNum
                 ++currentConnectedComponentId;
                 size_t pointsInCurrentConnectedComponent = 0;
 
+                if (mConnectedComponentPoints.size() < currentConnectedComponentId)
+                    mConnectedComponentPoints.emplace_back();
+
+                auto & currentConnectedComponentPoints = mConnectedComponentPoints[currentConnectedComponentId - 1];
+
                 //
                 // Propagate the connected component ID to all points reachable from this point
                 //
@@ -1608,6 +2446,7 @@ void Ship::DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNum
 
                     // Assign the connected component ID
                     mPoints.SetConnectedComponentId(currentPointIndex, currentConnectedComponentId);
+                    currentConnectedComponentPoints.push_back(currentPointIndex);
                     ++pointsInCurrentConnectedComponent;
 
                     // Go through this point's adjacents
@@ -1638,6 +2477,225 @@ void Ship::DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNum
             }
         }
     }
+
+    // Drop the lists of the components that do not exist anymore
+    mConnectedComponentPoints.resize(currentConnectedComponentId);
+
+    // We've seen everything there is to see
+    mConnectivitySeedPoints.clear();
+
+    // Light is diffused within connected components
+    mIsDiffusedLightDirty = true;
+
+    // Elements are rendered by connected component
+    mAreElementsDirty = true;
+}
+
+void Ship::UpdateConnectedComponents()
+{
+    //
+    // Components only ever split - they never join - and they may only split where springs
+    // have been destroyed. We thus search only from the surviving endpoints of the destroyed
+    // springs, each search exploring the region reachable from its seed:
+    //  - If the search is exhausted and finds fewer points than the seed's component has,
+    //    then the region has been cut off from the rest of the component, and it becomes
+    //    a new component;
+    //  - If the search is exhausted and finds all the points of the seed's component,
+    //    then the component is still whole;
+    //  - If the search visits too many points, we give up on it - the region is "open" and,
+    //    if it got cut off at all, it's the rest of the component that gets split off by
+    //    the other seeds' searches. Should a component end up with two open regions we can't
+    //    tell whether they are still connected, and we fall back to a full detection.
+    //
+    // Each search uses its own visit sequence number, so that a search stumbling upon
+    // a point visited by an earlier search of this same update knows that it's in an open
+    // region - closed regions can't be reached from elsewhere - and may stop right away.
+    //
+
+    // Visit seeds in a deterministic order, once each
+    std::sort(mConnectivitySeedPoints.begin(), mConnectivitySeedPoints.end());
+    mConnectivitySeedPoints.erase(
+        std::unique(mConnectivitySeedPoints.begin(), mConnectivitySeedPoints.end()),
+        mConnectivitySeedPoints.end());
+
+    // Reserve all the visit sequence numbers of this update, so that they are contiguous
+    VisitSequenceNumber const firstVisitSequenceNumber = NextConnectivityVisitSequenceNumber(mConnectivitySeedPoints.size());
+    VisitSequenceNumber currentVisitSequenceNumber = firstVisitSequenceNumber - 1;
+
+    mConnectivityOpenSearchComponents.clear();
+
+    bool haveComponentsChanged = false;
+
+    for (auto const seedPointIndex : mConnectivitySeedPoints)
+    {
+        ++currentVisitSequenceNumber;
+
+        // Skip seeds that have been destroyed or that have been visited by an earlier search
+        if (mPoints.IsDeleted(seedPointIndex)
+            || mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(seedPointIndex) >= firstVisitSequenceNumber)
+        {
+            continue;
+        }
+
+        ConnectedComponentId const seedConnectedComponentId = mPoints.GetConnectedComponentId(seedPointIndex);
+        assert(seedConnectedComponentId > 0 && seedConnectedComponentId <= mConnectedComponentSizes.size());
+
+        //
+        // Search, using the search points themselves as the queue
+        //
+
+        mConnectivitySearchPoints.clear();
+        mConnectivitySearchPoints.push_back(seedPointIndex);
+        mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(seedPointIndex, currentVisitSequenceNumber);
+
+        bool isOpen = false;
+        bool hasReachedOpenRegion = false;
+
+        for (size_t s = 0; s < mConnectivitySearchPoints.size() && !hasReachedOpenRegion; ++s)
+        {
+            if (mConnectivitySearchPoints.size() > MaxConnectivitySearchSize)
+            {
+                isOpen = true;
+                break;
+            }
+
+            for (auto adjacentSpringElementIndex : mPoints.GetConnectedSprings(mConnectivitySearchPoints[s]))
+            {
+                assert(!mSprings.IsDeleted(adjacentSpringElementIndex));
+
+                // One of the endpoints is the current point, which is visited already
+                for (auto const adjacentPointIndex : { mSprings.GetPointAIndex(adjacentSpringElementIndex), mSprings.GetPointBIndex(adjacentSpringElementIndex) })
+                {
+                    assert(!mPoints.IsDeleted(adjacentPointIndex));
+
+                    auto const adjacentVisitSequenceNumber = mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(adjacentPointIndex);
+                    if (adjacentVisitSequenceNumber != currentVisitSequenceNumber)
+                    {
+                        if (adjacentVisitSequenceNumber >= firstVisitSequenceNumber)
+                        {
+                            // Visited by an earlier, open search
+                            hasReachedOpenRegion = true;
+                            break;
+                        }
+
+                        mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(adjacentPointIndex, currentVisitSequenceNumber);
+                        mConnectivitySearchPoints.push_back(adjacentPointIndex);
+                    }
+                }
+
+                if (hasReachedOpenRegion)
+                    break;
+            }
+        }
+
+        if (hasReachedOpenRegion)
+        {
+            // Part of an open region, nothing to learn
+            continue;
+        }
+
+        if (isOpen)
+        {
+            if (mConnectivityOpenSearchComponents.end() != std::find(
+                mConnectivityOpenSearchComponents.begin(),
+                mConnectivityOpenSearchComponents.end(),
+                seedConnectedComponentId))
+            {
+                // Two large regions that might or might not be connected; take the long road
+                DetectConnectedComponents();
+                return;
+            }
+
+            mConnectivityOpenSearchComponents.push_back(seedConnectedComponentId);
+
+            continue;
+        }
+
+        assert(mConnectivitySearchPoints.size() <= mConnectedComponentSizes[seedConnectedComponentId - 1]);
+        if (mConnectivitySearchPoints.size() < mConnectedComponentSizes[seedConnectedComponentId - 1])
+        {
+            //
+            // This region has been cut off from its component - make it a new component
+            //
+
+            ConnectedComponentId const newConnectedComponentId = static_cast<ConnectedComponentId>(mConnectedComponentSizes.size() + 1);
+
+            for (auto const pointIndex : mConnectivitySearchPoints)
+            {
+                mPoints.SetConnectedComponentId(pointIndex, newConnectedComponentId);
+            }
+
+            mConnectedComponentSizes[seedConnectedComponentId - 1] -= mConnectivitySearchPoints.size();
+            mConnectedComponentSizes.push_back(mConnectivitySearchPoints.size());
+            mConnectedComponentPoints.emplace_back(mConnectivitySearchPoints);
+
+            // Compact the list of the old component once it's mostly made of points that have left it
+            auto & oldConnectedComponentPoints = mConnectedComponentPoints[seedConnectedComponentId - 1];
+            if (oldConnectedComponentPoints.size() > 2 * mConnectedComponentSizes[seedConnectedComponentId - 1])
+            {
+                oldConnectedComponentPoints.erase(
+                    std::remove_if(
+                        oldConnectedComponentPoints.begin(),
+                        oldConnectedComponentPoints.end(),
+                        [this, seedConnectedComponentId](ElementIndex pointIndex)
+                        {
+                            return mPoints.IsDeleted(pointIndex)
+                                || mPoints.GetConnectedComponentId(pointIndex) != seedConnectedComponentId;
+                        }),
+                    oldConnectedComponentPoints.end());
+            }
+
+            haveComponentsChanged = true;
+        }
+    }
+
+    mConnectivitySeedPoints.clear();
+
+    //
+    // Components only ever grow in number; once most of them are empty, renumber them
+    // all so that we don't render and diffuse light over a sea of empty components
+    //
+
+    size_t const emptyConnectedComponentCount = std::count(
+        mConnectedComponentSizes.cbegin(),
+        mConnectedComponentSizes.cend(),
+        size_t(0));
+
+    if (emptyConnectedComponentCount > 0
+        && 2 * emptyConnectedComponentCount >= mConnectedComponentSizes.size())
+    {
+        DetectConnectedComponents();
+    }
+    else if (haveComponentsChanged)
+    {
+        // Light is diffused within connected components
+        mIsDiffusedLightDirty = true;
+
+        // Elements are rendered by connected component
+        mAreElementsDirty = true;
+    }
+}
+
+VisitSequenceNumber Ship::NextConnectivityVisitSequenceNumber(size_t count)
+{
+    assert(count > 0);
+
+    // Make sure the numbers we hand out are contiguous and never wrap around, so
+    // that they may be compared; on the very rare wrap-around, forget all visits
+    if (mCurrentConnectivityVisitSequenceNumber > std::numeric_limits<VisitSequenceNumber>::max() - count)
+    {
+        for (auto pointIndex : mPoints.NonEphemeralPoints())
+        {
+            mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(pointIndex, NoneVisitSequenceNumber);
+        }
+
+        mCurrentConnectivityVisitSequenceNumber = NoneVisitSequenceNumber;
+    }
+
+    VisitSequenceNumber const firstVisitSequenceNumber = mCurrentConnectivityVisitSequenceNumber + 1;
+    mCurrentConnectivityVisitSequenceNumber += static_cast<VisitSequenceNumber>(count);
+
+    return firstVisitSequenceNumber;
 }
 
 void Ship::DestroyConnectedTriangles(ElementIndex pointElementIndex)
@@ -1758,8 +2816,20 @@ void Ship::PointDestroyHandler(
         currentSimulationTime,
         gameParameters);
 
-    // Remember our elements are now dirty
-    mAreElementsDirty = true;
+    // Keep the size of the point's connected component up-to-date
+    if (pointElementIndex < mPoints.GetShipPointCount())
+    {
+        auto const connectedComponentId = mPoints.GetConnectedComponentId(pointElementIndex);
+        assert(connectedComponentId > 0 && connectedComponentId <= mConnectedComponentSizes.size());
+        assert(mConnectedComponentSizes[connectedComponentId - 1] > 0);
+        --mConnectedComponentSizes[connectedComponentId - 1];
+
+        // Remember to re-diffuse light without this point
+        mIsDiffusedLightDirty = true;
+    }
+
+    // Remember our point elements are now dirty
+    mArePointElementsDirty = true;
 }
 
 void Ship::SpringDestroyHandler(
@@ -1812,6 +2882,13 @@ void Ship::SpringDestroyHandler(
     mPoints.RemoveConnectedSpring(pointAIndex, springElementIndex);
     mPoints.RemoveConnectedSpring(pointBIndex, springElementIndex);
 
+    // The endpoints might now be disconnected from each other
+    mConnectivitySeedPoints.push_back(pointAIndex);
+    mConnectivitySeedPoints.push_back(pointBIndex);
+
+    // Remember to re-diffuse light once the structure has settled
+    mIsDiffusedLightDirty = true;
+
 
     //
     // Make non-hull endpoints leak
@@ -1851,8 +2928,8 @@ void Ship::SpringDestroyHandler(
     // Notify pinned points
     mPinnedPoints.OnSpringDestroyed(springElementIndex);
 
-    // Remember our elements are now dirty
-    mAreElementsDirty = true;
+    // Remember this spring's element is now dirty
+    mDirtySpringElements.push_back(springElementIndex);
 }
 
 void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
@@ -1861,6 +2938,9 @@ void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
     for (ElementIndex subSpringIndex : mTriangles.GetSubSprings(triangleElementIndex))
     {
         mSprings.RemoveSuperTriangle(subSpringIndex, triangleElementIndex);
+
+        // The sub spring might now be uncovered
+        mDirtySpringElements.push_back(subSpringIndex);
     }
 
     // Let's be neat
@@ -1871,14 +2951,13 @@ void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
     mPoints.RemoveConnectedTriangle(mTriangles.GetPointBIndex(triangleElementIndex), triangleElementIndex);
     mPoints.RemoveConnectedTriangle(mTriangles.GetPointCIndex(triangleElementIndex), triangleElementIndex);
 
-    // Remember our elements are now dirty
-    mAreElementsDirty = true;
+    // Remember this triangle's element is now dirty
+    mDirtyTriangleElements.push_back(triangleElementIndex);
 }
 
 void Ship::ElectricalElementDestroyHandler(ElementIndex /*electricalElementIndex*/)
 {
-    // Remember our elements are now dirty
-    mAreElementsDirty = true;
+    // Nothing to do: electrical elements are not among the elements we upload
 }
 
 void Ship::GenerateAirBubbles(
@@ -2014,13 +3093,40 @@ void Ship::DoBombExplosion(
         750.0f
         * (gameParameters.IsUltraViolentMode ? 100.0f : 1.0f);
 
+    //
+    // Find the points that might be affected by the blast; since the blast is applied
+    // throughout the next step, while points move, we search in a larger radius.
+    // We only look at non-ephemeral points (ephemerals would be blown immediately away otherwise).
+    //
+    // Twice the radius is conservative: the grid has been updated at the end of this step,
+    // and a point outside of it would have to travel more than the blast radius - at least
+    // 0.6m - during the single step in which the blast is applied, i.e. faster than 30m/s,
+    // to be within the blast radius; and the grid visits whole cells, hence more points.
+    //
+
+    std::vector<ElementIndex> candidatePoints;
+
+    mPointSpatialGrid.VisitPointsInRadius(
+        blastPosition,
+        blastRadius * 2.0f,
+        [&](ElementIndex pointIndex)
+        {
+            if (mPoints.GetConnectedComponentId(pointIndex) == connectedComponentId)
+            {
+                candidatePoints.push_back(pointIndex);
+            }
+        });
+
+    // Visit points in index order, like in a full visit
+    std::sort(candidatePoints.begin(), candidatePoints.end());
+
     // Store the force field
     mCurrentForceFields.emplace_back(
         new BlastForceField(
             blastPosition,
             blastRadius,
             strength,
-            connectedComponentId,
+            std::move(candidatePoints),
             sequenceProgress == 0.0f));
 }
 
@@ -2029,17 +3135,42 @@ void Ship::DoAntiMatterBombPreimplosion(
     float sequenceProgress,
     GameParameters const & gameParameters)
 {
+    float const radius = 7.0f + sequenceProgress * 100.0f;
+    float const radiusThickness = 10.0f;
+
     float const strength =
         100000.0f
         * (gameParameters.IsUltraViolentMode ? 5.0f : 1.0f);
 
+    //
+    // Find the points that might be within the thickness of the circle, i.e. within the
+    // square circumscribing the outer circle; since the warp is applied throughout the
+    // next step, while points move, we search in a square that is larger by the thickness,
+    // which a point could only cover during a single step at hundreds of m/s.
+    // Ephemeral particles, which the grid does not index, are visited by the warp itself.
+    //
+
+    std::vector<ElementIndex> candidatePoints;
+
+    mPointSpatialGrid.VisitPointsInRadius(
+        centerPosition,
+        radius + 2.0f * radiusThickness,
+        [&](ElementIndex pointIndex)
+        {
+            candidatePoints.push_back(pointIndex);
+        });
+
+    // Visit points in index order, like in a full visit
+    std::sort(candidatePoints.begin(), candidatePoints.end());
+
     // Store the force field
     mCurrentForceFields.emplace_back(
         new RadialSpaceWarpForceField(
             centerPosition,
-            7.0f + sequenceProgress * 100.0f,
-            10.0f,
-            strength));
+            radius,
+            radiusThickness,
+            strength,
+            std::move(candidatePoints)));
 }
 
 void Ship::DoAntiMatterBombImplosion(
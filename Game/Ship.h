@@ -10,9 +10,12 @@
 #include "Physics.h"
 #include "RenderContext.h"
 #include "ShipDefinition.h"
+#include "ShipUpdateProfiler.h"
 
+#include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <memory>
@@ -59,6 +62,8 @@ public:
     auto const & GetElectricalElements() const { return mElectricalElements; }
     auto & GetElectricalElements() { return mElectricalElements; }
 
+    ShipUpdateProfiler & GetUpdateProfiler() { return mUpdateProfiler; }
+
     void MoveBy(
         vec2f const & offset,
         GameParameters const & gameParameters);
@@ -90,6 +95,11 @@ public:
         float strength,
         GameParameters const & gameParameters);
 
+    void ResetToolForceField()
+    {
+        mCurrentToolForceField.reset();
+    }
+
     bool TogglePinAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters);
@@ -137,10 +147,11 @@ public:
         float currentSimulationTime,
         VisitSequenceNumber currentVisitSequenceNumber,
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
 
-    void Render(
+    void RenderUpload(
         GameParameters const & gameParameters,
+        float interpolationFactor,
         Render::RenderContext & renderContext);
 
 public:
@@ -154,12 +165,22 @@ public:
     void UpdateMechanicalDynamics(
         float currentSimulationTime,
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
 
     void UpdatePointForces(GameParameters const & gameParameters);
 
+    void UpdateSpringGeometry();
+
     void UpdateSpringForces(GameParameters const & gameParameters);
 
+    void UpdateSpringForces_Naive(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex);
+
+    void UpdateSpringForces_Vectorized(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex);
+
     void IntegrateAndResetPointForces(GameParameters const & gameParameters);
 
     void HandleCollisionsWithSeaFloor(GameParameters const & gameParameters);
@@ -179,6 +200,23 @@ public:
         GameParameters const & gameParameters,
         float & waterSplashed);
 
+    void UpdateWaterActiveElements();
+
+    // The water diffusion phases work on ranges of the active springs and points
+
+    void CalculateSpringWaterFlows(
+        size_t startActiveSpring,
+        size_t endActiveSpring);
+
+    void CalculatePointWaterNormalizationFactors(
+        size_t startActivePoint,
+        size_t endActivePoint);
+
+    // Returns the water splashed at the points in the range
+    float MovePointWater(
+        size_t startActivePoint,
+        size_t endActivePoint);
+
     // Electrical
 
     void UpdateElectricalDynamics(
@@ -186,8 +224,6 @@ public:
         VisitSequenceNumber currentVisitSequenceNumber,
         GameParameters const & gameParameters);
 
-    void UpdateElectricalConnectivity(VisitSequenceNumber currentVisitSequenceNumber);
-
     void DiffuseLight(GameParameters const & gameParameters);
 
     // Ephemeral particles
@@ -196,9 +232,20 @@ public:
         float currentSimulationTime,
         GameParameters const & gameParameters);
 
+    // Connectivity
+
+    void DetectConnectedComponents();
+
+    // Only searches from the endpoints of the springs destroyed since the last update
+    void UpdateConnectedComponents();
+
+    std::vector<std::size_t> const & GetConnectedComponentSizes() const { return mConnectedComponentSizes; }
+
 private:
 
-    void DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNumber);
+    void MakeParallelTasks();
+
+    VisitSequenceNumber NextConnectivityVisitSequenceNumber(size_t count);
 
     void DestroyConnectedTriangles(ElementIndex pointElementIndex);
 
@@ -272,6 +319,29 @@ private:
     void VerifyInvariants();
 #endif
 
+private:
+
+    // The minimum number of springs that is worth giving to a single task
+    static constexpr ElementCount MinSpringsPerTask = 512;
+
+    // The minimum number of points that is worth giving to a single task
+    static constexpr ElementCount MinPointsPerTask = 512;
+
+    // The size of the cells of the point spatial grid
+    static constexpr float PointSpatialGridCellSize = 2.0f;
+
+    // The maximum number of points that an incremental connected component search may visit
+    // before giving up on finding the boundary of the region it started from
+    static constexpr size_t MaxConnectivitySearchSize = 2048;
+
+    // The light below which we consider a lamp not to be lighting a point at all
+    static constexpr float MinDiffusedLight = 0.005f;
+
+    // How much the light of a lamp must change, and how much points might have moved
+    // relative to each other, for us to re-diffuse light
+    static constexpr float MinLampLightChangeForDiffusion = 0.005f;
+    static constexpr float MinPointDisplacementForDiffusion = 0.25f;
+
 private:
 
     ShipId const mId;
@@ -285,15 +355,43 @@ private:
     Triangles mTriangles;
     ElectricalElements mElectricalElements;
 
-    // Connected components metadata
+    // Connected components metadata; the size of a connected component is the number of its
+    // non-deleted points, and may be zero for components whose points have all been destroyed
     std::vector<std::size_t> mConnectedComponentSizes;
 
-    // Flag remembering whether points (elements) and/or springs (incl. ropes) and/or triangles have changed
-    // since the last step.
-    // When this flag is set, we'll re-detect connected components and re-upload elements
-    // to the rendering context
+    // The (non-ephemeral) points of each connected component, indexed by connected
+    // component ID - 1; after incremental updates a list may also contain points that
+    // have since been destroyed or have moved to another component, hence users must
+    // check the points' connected component IDs
+    std::vector<std::vector<ElementIndex>> mConnectedComponentPoints;
+
+    // The points that may have been disconnected from (some of) their component since the
+    // last connected component update - i.e. the endpoints of the springs destroyed since then
+    std::vector<ElementIndex> mConnectivitySeedPoints;
+
+    // The visit sequence number of the last connected component search; owned by the ship,
+    // as an incremental update uses a different number for each of its searches
+    VisitSequenceNumber mCurrentConnectivityVisitSequenceNumber;
+
+    // Scratch buffers for the incremental connected component update
+    std::vector<ElementIndex> mConnectivitySearchPoints;
+    std::vector<ConnectedComponentId> mConnectivityOpenSearchComponents;
+
+    // Flag remembering whether connected components have changed since the last upload of elements.
+    // When this flag is set, we'll re-upload all elements to the rendering context
     bool mAreElementsDirty;
 
+    // Flag remembering whether points have been destroyed since the last upload of elements;
+    // point elements are only rendered in the points debug mode, in which case we'll re-upload
+    // all elements
+    bool mArePointElementsDirty;
+
+    // The springs (incl. ropes) and triangles that have been destroyed - or, for springs, that have
+    // lost a super-triangle - since the last upload of elements; as long as connected components
+    // don't change, we upload just these to the rendering context
+    std::vector<ElementIndex> mDirtySpringElements;
+    std::vector<ElementIndex> mDirtyTriangleElements;
+
     // The debug ship render mode that was in effect the last time we've uploaded elements;
     // used to detect changes and eventually re-upload
     std::optional<DebugShipRenderMode> mLastDebugShipRenderMode;
@@ -313,6 +411,110 @@ private:
 
     // Force fields to apply at next iteration
     std::vector<std::unique_ptr<ForceField>> mCurrentForceFields;
+
+    // The force field of the current tool - if any - to apply at each step of the current frame
+    std::unique_ptr<ForceField> mCurrentToolForceField;
+
+    // The current force fields, grouped by type for applying them
+    ForceFieldBatch mForceFieldBatch;
+
+    // The tasks for calculating spring geometries in parallel;
+    // empty when we're not running in parallel
+    std::vector<TaskThreadPool::Task> mSpringGeometryTasks;
+
+    // The tasks for calculating spring forces in parallel, one batch per spring color;
+    // empty when we're not running in parallel
+    std::vector<std::vector<TaskThreadPool::Task>> mSpringForceTasks;
+
+    //
+    // Water active elements
+    //
+
+    // The points that were wet after the last water diffusion, and those that
+    // have received water since; may contain duplicates and points that dried up
+    std::vector<ElementIndex> mWetPoints;
+
+    // The wet points plus their neighbors, and the springs connected to wet points;
+    // water may only move among these
+    std::vector<bool> mIsWaterActivePoint;
+    std::vector<ElementIndex> mWaterActivePoints;
+    std::vector<ElementIndex> mWaterActiveSprings;
+
+    //
+    // Water diffusion state: the work buffers of the diffusion in progress,
+    // shared among the water diffusion phases
+    //
+
+    struct WaterDiffusionState
+    {
+        float WaterCrazyness;
+        float WaterDiffusionSpeedAdjustment;
+
+        float * NewPointWater;
+        float * PointFreenessFactor;
+        float * PointWaterQuantityNormalizationFactor;
+
+        // Outbound from A in x, outbound from B in y
+        vec2f * SpringOutboundWaterVelocities;
+        vec2f * SpringOutboundWaterFlowWeights;
+
+        WaterDiffusionState()
+            : WaterCrazyness(0.0f)
+            , WaterDiffusionSpeedAdjustment(0.0f)
+            , NewPointWater(nullptr)
+            , PointFreenessFactor(nullptr)
+            , PointWaterQuantityNormalizationFactor(nullptr)
+            , SpringOutboundWaterVelocities(nullptr)
+            , SpringOutboundWaterFlowWeights(nullptr)
+        {}
+    };
+
+    WaterDiffusionState mWaterDiffusionState;
+
+    // The tasks for each phase of the water diffusion, each taking a slice of the active elements;
+    // empty when we're not running in parallel
+    std::vector<TaskThreadPool::Task> mWaterSpringFlowTasks;
+    std::vector<TaskThreadPool::Task> mWaterNormalizationTasks;
+    std::vector<TaskThreadPool::Task> mWaterMoveTasks;
+
+    // The water splashed at the points of each water move task
+    std::vector<float> mWaterSplashedPerTask;
+
+    // The index of the positions of non-ephemeral points, updated
+    // at each step after the points have moved
+    PointSpatialGrid mPointSpatialGrid;
+
+    // The random engine used while updating this ship; ships might be updated
+    // concurrently, and each ship must draw the same numbers regardless
+    GameRandomEngine mRandomEngine;
+
+    // The durations of our update phases, when profiling
+    ShipUpdateProfiler mUpdateProfiler;
+
+    //
+    // Light diffusion state: what the current light of the non-ephemeral points
+    // has been calculated from
+    //
+
+    struct DiffusedLampState
+    {
+        float EffectiveLight;
+        float LightSpread;
+
+        DiffusedLampState(
+            float effectiveLight,
+            float lightSpread)
+            : EffectiveLight(effectiveLight)
+            , LightSpread(lightSpread)
+        {}
+    };
+
+    std::vector<DiffusedLampState> mDiffusedLampStates; // Parallel to lamps
+    float mDiffusedLightSpreadAdjustment;
+
+    std::vector<vec2f> mDiffusedPointPositions; // Of the non-ephemeral points
+
+    bool mIsDiffusedLightDirty; // Set when points or springs are destroyed, and when connected components change
 };
 
 }
\ No newline at end of file
@@ -13,11 +13,42 @@
 #include <cassert>
 #include <limits>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 
 using namespace Physics;
 
+namespace /* anonymous */ {
+
+    // The number of tiles that each thread gets to build, so that the load stays
+    // balanced even though the density of the structure varies across the image
+    static constexpr int TilesPerThread = 4;
+
+    /*
+     * Splits the range [0, count) into contiguous tiles, in order; with a parallelism
+     * of one there is a single tile, hence the ship is built exactly as by a serial scan.
+     */
+    std::vector<std::pair<int, int>> MakeTiles(
+        int count,
+        TaskThreadPool const & taskThreadPool)
+    {
+        int const tileCount = (taskThreadPool.GetParallelism() == 1)
+            ? 1
+            : std::max(
+                1,
+                std::min(count, static_cast<int>(taskThreadPool.GetParallelism()) * TilesPerThread));
+
+        std::vector<std::pair<int, int>> tiles;
+        for (int t = 0; t < tileCount; ++t)
+        {
+            tiles.emplace_back(
+                count * t / tileCount,
+                count * (t + 1) / tileCount);
+        }
+
+        return tiles;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<Ship> ShipBuilder::Create(
@@ -26,93 +57,227 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     std::shared_ptr<IGameEventHandler> gameEventHandler,
     ShipDefinition const & shipDefinition,
     MaterialDatabase const & materialDatabase,
+    ShipCache const * shipCache,
     GameParameters const & gameParameters,
     VisitSequenceNumber currentVisitSequenceNumber)
 {
-    int const structureWidth = shipDefinition.StructuralLayerImage.Size.Width;
-    float const halfWidth = static_cast<float>(structureWidth) / 2.0f;
-    int const structureHeight = shipDefinition.StructuralLayerImage.Size.Height;
-
     // PointInfo's
     std::vector<PointInfo> pointInfos;
 
     // SpringInfo's
     std::vector<SpringInfo> springInfos;
 
-    // RopeSegment's, indexed by the rope color key
-    std::map<MaterialDatabase::ColorKey, RopeSegment> ropeSegments;
-
     // TriangleInfo's
     std::vector<TriangleInfo> triangleInfos;
 
+    // Maps indices of PointInfo's to indices of Points
+    std::vector<ElementIndex> pointIndexRemap;
+
+    // The ranges of springs of each color
+    std::vector<Springs::ColorRange> springColorRanges;
+
 
     //
-    // Process structural layer points and:
-    // - Identify all points, calculate texture coordinates, and create PointInfo's for them
-    // - Build a 2D matrix containing indices to the points above
-    // - Identify rope endpoints on structural layer, and create RopeSegment's for them
+    // See if we have already built this very ship - with these very materials
     //
 
-    // Matrix of points - we allocate 2 extra dummy rows and cols to avoid checking for boundaries
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> pointIndexMatrix(new std::unique_ptr<std::optional<ElementIndex>[]>[structureWidth + 2]);
-    for (int c = 0; c < structureWidth + 2; ++c)
+    uint64_t shipCacheKey = 0;
+    std::unique_ptr<ShipCache::CachedShip> cachedShip;
+
+    if (nullptr != shipCache)
     {
-        pointIndexMatrix[c] = std::unique_ptr<std::optional<ElementIndex>[]>(new std::optional<ElementIndex>[structureHeight + 2]);
+        shipCacheKey = ShipCache::CalculateKey(shipDefinition, materialDatabase);
+
+        cachedShip = shipCache->TryLoad(
+            shipDefinition.Metadata.ShipName,
+            shipCacheKey);
     }
 
-    // Visit all columns
-    for (int x = 0; x < structureWidth; ++x)
+    bool isLoadedFromCache = false;
+
+    if (!!cachedShip)
     {
-        // From bottom to top
-        for (int y = 0; y < structureHeight; ++y)
+        //
+        // Take the element info's as they are, they're already in their final shape
+        //
+
+        isLoadedFromCache = LoadElementInfosFromCache(
+            *cachedShip,
+            materialDatabase,
+            pointInfos,
+            springInfos,
+            triangleInfos,
+            pointIndexRemap,
+            springColorRanges);
+    }
+
+    if (!isLoadedFromCache)
+    {
+        //
+        // Process the layers and create all element info's
+        //
+
+        CreateElementInfos(
+            shipDefinition,
+            materialDatabase,
+            parentWorld.GetTaskThreadPool(),
+            pointInfos,
+            springInfos,
+            triangleInfos,
+            pointIndexRemap,
+            springColorRanges);
+    }
+
+
+    //
+    // Visit all PointInfo's and create Points, i.e. the entire set of points
+    //
+
+    Points points = CreatePoints(
+        pointInfos,
+        parentWorld,
+        gameEventHandler,
+        gameParameters);
+
+
+    if (!isLoadedFromCache)
+    {
+        //
+        // Filter out redundant triangles
+        //
+
+        triangleInfos = FilterOutRedundantTriangles(
+            triangleInfos,
+            points,
+            pointIndexRemap,
+            springInfos);
+
+
+        //
+        // Associate all springs with the triangles that cover them
+        //
+
+        ConnectSpringsAndTriangles(
+            springInfos,
+            triangleInfos,
+            pointInfos.size());
+
+
+        //
+        // Remember this ship for the next time
+        //
+
+        if (nullptr != shipCache)
         {
-            MaterialDatabase::ColorKey colorKey = shipDefinition.StructuralLayerImage.Data[x + (structureHeight - y - 1) * structureWidth];
-            StructuralMaterial const * structuralMaterial = materialDatabase.FindStructuralMaterial(colorKey);
-            if (nullptr != structuralMaterial)
-            {
-                //
-                // Make a point
-                //
-
-                ElementIndex const pointIndex = static_cast<ElementIndex>(pointInfos.size());
-
-                pointIndexMatrix[x + 1][y + 1] = static_cast<ElementIndex>(pointIndex);
-
-                pointInfos.emplace_back(
-                    vec2f(
-                        static_cast<float>(x) - halfWidth,
-                        static_cast<float>(y))
-                        + shipDefinition.Metadata.Offset,
-                    MakeTextureCoordinates(x, y, shipDefinition.StructuralLayerImage.Size),
-                    structuralMaterial->RenderColor,
-                    *structuralMaterial,
-                    structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope));
-
-                //
-                // Check if it's a (custom) rope endpoint
-                //
-
-                if (structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope)
-                    && !materialDatabase.IsUniqueStructuralMaterialColorKey(StructuralMaterial::MaterialUniqueType::Rope, colorKey))
-                {
-                    // Store in RopeSegments, using the color key as the color of the rope
-                    RopeSegment & ropeSegment = ropeSegments[colorKey];
-                    if (!ropeSegment.SetEndpoint(pointIndex, colorKey))
-                    {
-                        throw GameException(
-                            std::string("More than two \"" + Utils::RgbColor2Hex(colorKey) + "\" rope endpoints found at (")
-                            + std::to_string(x) + "," + std::to_string(structureHeight - y - 1) + ")");
-                    }
-                }
-            }
-            else
-            {
-                // Just ignore this pixel
-            }
+            StoreElementInfosToCache(
+                pointInfos,
+                springInfos,
+                triangleInfos,
+                pointIndexRemap,
+                springColorRanges,
+                materialDatabase,
+                shipDefinition.Metadata.ShipName,
+                shipCacheKey,
+                *shipCache);
         }
     }
 
 
+    //
+    // Create Springs for all SpringInfo's
+    //
+
+    Springs springs = CreateSprings(
+        springInfos,
+        springColorRanges,
+        points,
+        pointIndexRemap,
+        parentWorld,
+        gameEventHandler,
+        gameParameters);
+
+
+    //
+    // Create Triangles for all (filtered out) TriangleInfo's
+    //
+
+    Triangles triangles = CreateTriangles(
+        triangleInfos,
+        points,
+        pointIndexRemap);
+
+
+    //
+    // Create Electrical Elements
+    //
+
+    ElectricalElements electricalElements = CreateElectricalElements(
+        points,
+        springs,
+        parentWorld,
+        gameEventHandler);
+
+
+    //
+    // We're done!
+    //
+
+    LogMessage("Created ship: W=", shipDefinition.StructuralLayerImage.Size.Width, ", H=", shipDefinition.StructuralLayerImage.Size.Height, ", ",
+        points.GetElementCount(), " points, ", springs.GetElementCount(), " springs, ", triangles.GetElementCount(), " triangles, ",
+        electricalElements.GetElementCount(), " electrical elements.");
+
+    return std::make_unique<Ship>(
+        shipId,
+        parentWorld,
+        gameEventHandler,
+        materialDatabase,
+        std::move(points),
+        std::move(springs),
+        std::move(triangles),
+        std::move(electricalElements),
+        currentVisitSequenceNumber);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Building helpers
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShipBuilder::CreateElementInfos(
+    ShipDefinition const & shipDefinition,
+    MaterialDatabase const & materialDatabase,
+    TaskThreadPool & taskThreadPool,
+    std::vector<PointInfo> & pointInfos,
+    std::vector<SpringInfo> & springInfos,
+    std::vector<TriangleInfo> & triangleInfos,
+    std::vector<ElementIndex> & pointIndexRemap,
+    std::vector<Springs::ColorRange> & springColorRanges)
+{
+    int const structureWidth = shipDefinition.StructuralLayerImage.Size.Width;
+    int const structureHeight = shipDefinition.StructuralLayerImage.Size.Height;
+
+    // RopeSegment's, indexed by the rope color key
+    std::map<MaterialDatabase::ColorKey, RopeSegment> ropeSegments;
+
+
+    //
+    // Process structural layer points and:
+    // - Identify all points, calculate texture coordinates, and create PointInfo's for them
+    // - Build a 2D matrix containing indices to the points above
+    // - Identify rope endpoints on structural layer, and create RopeSegment's for them
+    //
+
+    PointIndexMatrix pointIndexMatrix(structureWidth, structureHeight);
+
+    AppendStructuralPoints(
+        shipDefinition.StructuralLayerImage,
+        ropeSegments,
+        pointInfos,
+        pointIndexMatrix,
+        materialDatabase,
+        shipDefinition.Metadata.Offset,
+        taskThreadPool);
+
+
     //
     // Process the rope layer - if any - and append rope endpoints
     //
@@ -154,7 +319,8 @@ std::unique_ptr<Ship> ShipBuilder::Create(
             pointInfos,
             true,
             pointIndexMatrix,
-            materialDatabase);
+            materialDatabase,
+            taskThreadPool);
     }
     else
     {
@@ -164,7 +330,8 @@ std::unique_ptr<Ship> ShipBuilder::Create(
             pointInfos,
             false,
             pointIndexMatrix,
-            materialDatabase);
+            materialDatabase,
+            taskThreadPool);
     }
 
 
@@ -197,7 +364,8 @@ std::unique_ptr<Ship> ShipBuilder::Create(
         pointInfos,
         springInfos,
         triangleInfos,
-        leakingPointsCount);
+        leakingPointsCount,
+        taskThreadPool);
 
 
 
@@ -228,8 +396,6 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     // Now reorder points to improve data locality when visiting springs
     //
 
-    std::vector<ElementIndex> pointIndexRemap;
-
     pointInfos = ReorderPointsOptimally_FollowingSprings(
         pointInfos,
         springInfos,
@@ -237,99 +403,398 @@ std::unique_ptr<Ship> ShipBuilder::Create(
 
 
     //
-    // Visit all PointInfo's and create Points, i.e. the entire set of points
+    // Partition springs into colors, i.e. sets of springs that do not share
+    // any endpoints, so that spring forces may be calculated in parallel
     //
 
-    Points points = CreatePoints(
-        pointInfos,
-        parentWorld,
-        gameEventHandler,
-        gameParameters);
+    springInfos = ReorderSpringsByColor(
+        springInfos,
+        pointInfos.size(),
+        springColorRanges);
 
+    LogMessage("Spring colors: ", springColorRanges.size());
+}
 
+bool ShipBuilder::LoadElementInfosFromCache(
+    ShipCache::CachedShip const & cachedShip,
+    MaterialDatabase const & materialDatabase,
+    std::vector<PointInfo> & pointInfos,
+    std::vector<SpringInfo> & springInfos,
+    std::vector<TriangleInfo> & triangleInfos,
+    std::vector<ElementIndex> & pointIndexRemap,
+    std::vector<Springs::ColorRange> & springColorRanges)
+{
     //
-    // Filter out redundant triangles
+    // Materials are stored as indices into the (ordered) material maps
     //
 
-    triangleInfos = FilterOutRedundantTriangles(
-        triangleInfos,
+    std::vector<StructuralMaterial const *> structuralMaterials;
+    for (auto const & entry : materialDatabase.GetStructuralMaterials())
+        structuralMaterials.push_back(&(entry.second));
+
+    std::vector<ElectricalMaterial const *> electricalMaterials;
+    for (auto const & entry : materialDatabase.GetElectricalMaterials())
+        electricalMaterials.push_back(&(entry.second));
+
+    //
+    // Make sure that all indices are in range, before we use any of them
+    //
+
+    if (!cachedShip.IsConsistent(structuralMaterials.size(), electricalMaterials.size()))
+    {
+        LogMessage("Ship element infos in cache are inconsistent, ignoring them");
+        return false;
+    }
+
+    //
+    // Points - already in their final order, hence the remap is the identity
+    //
+
+    pointInfos.reserve(cachedShip.GetPointCount());
+    pointIndexRemap.reserve(cachedShip.GetPointCount());
+
+    for (size_t p = 0; p < cachedShip.GetPointCount(); ++p)
+    {
+        ShipCache::Point const & point = cachedShip.GetPoints()[p];
+
+        pointInfos.emplace_back(
+            point.Position,
+            point.TextureCoordinates,
+            point.RenderColor,
+            *(structuralMaterials[point.StructuralMaterialIndex]),
+            0 != point.IsRope);
+
+        pointInfos.back().IsLeaking = (0 != point.IsLeaking);
+
+        if (ShipCache::NoneMaterialIndex != point.ElectricalMaterialIndex)
+        {
+            pointInfos.back().ElectricalMtl = electricalMaterials[point.ElectricalMaterialIndex];
+        }
+
+        pointIndexRemap.push_back(static_cast<ElementIndex>(p));
+    }
+
+    //
+    // Springs
+    //
+
+    springInfos.reserve(cachedShip.GetSpringCount());
+
+    for (size_t s = 0; s < cachedShip.GetSpringCount(); ++s)
+    {
+        ShipCache::Spring const & spring = cachedShip.GetSprings()[s];
+
+        springInfos.emplace_back(
+            spring.PointAIndex,
+            spring.PointBIndex);
+
+        for (uint32_t st = 0; st < spring.SuperTrianglesCount; ++st)
+            springInfos.back().SuperTriangles2.push_back(spring.SuperTriangles[st]);
+    }
+
+    springColorRanges.assign(
+        cachedShip.GetSpringColorRanges(),
+        cachedShip.GetSpringColorRanges() + cachedShip.GetSpringColorRangeCount());
+
+    //
+    // Triangles
+    //
+
+    triangleInfos.reserve(cachedShip.GetTriangleCount());
+
+    for (size_t t = 0; t < cachedShip.GetTriangleCount(); ++t)
+    {
+        ShipCache::Triangle const & triangle = cachedShip.GetTriangles()[t];
+
+        triangleInfos.emplace_back(triangle.PointIndices);
+
+        for (uint32_t ss = 0; ss < triangle.SubSpringsCount; ++ss)
+            triangleInfos.back().SubSprings2.push_back(triangle.SubSprings[ss]);
+    }
+
+    LogMessage("Loaded ship element infos from cache");
+
+    return true;
+}
+
+
+void ShipBuilder::StoreElementInfosToCache(
+    std::vector<PointInfo> const & pointInfos,
+    std::vector<SpringInfo> const & springInfos,
+    std::vector<TriangleInfo> const & triangleInfos,
+    std::vector<ElementIndex> const & pointIndexRemap,
+    std::vector<Springs::ColorRange> const & springColorRanges,
+    MaterialDatabase const & materialDatabase,
+    std::string const & shipName,
+    uint64_t shipCacheKey,
+    ShipCache const & shipCache)
+{
+    //
+    // Materials are stored as indices into the (ordered) material maps
+    //
+
+    std::unordered_map<StructuralMaterial const *, uint32_t> structuralMaterialIndices;
+    for (auto const & entry : materialDatabase.GetStructuralMaterials())
+        structuralMaterialIndices.emplace(&(entry.second), static_cast<uint32_t>(structuralMaterialIndices.size()));
+
+    std::unordered_map<ElectricalMaterial const *, uint32_t> electricalMaterialIndices;
+    for (auto const & entry : materialDatabase.GetElectricalMaterials())
+        electricalMaterialIndices.emplace(&(entry.second), static_cast<uint32_t>(electricalMaterialIndices.size()));
+
+    //
+    // Points - PointInfo's are already in the order of Points
+    //
+
+    std::vector<ShipCache::Point> points;
+    points.reserve(pointInfos.size());
+
+    for (auto const & pointInfo : pointInfos)
+    {
+        ShipCache::Point point{};
+        point.Position = pointInfo.Position;
+        point.TextureCoordinates = pointInfo.TextureCoordinates;
+        point.RenderColor = pointInfo.RenderColor;
+        point.StructuralMaterialIndex = structuralMaterialIndices.at(&(pointInfo.StructuralMtl));
+        point.ElectricalMaterialIndex = (nullptr != pointInfo.ElectricalMtl)
+            ? electricalMaterialIndices.at(pointInfo.ElectricalMtl)
+            : ShipCache::NoneMaterialIndex;
+        point.IsRope = pointInfo.IsRope ? 1 : 0;
+        point.IsLeaking = pointInfo.IsLeaking ? 1 : 0;
+
+        points.push_back(point);
+    }
+
+    //
+    // Springs and triangles - stored with their final point indices
+    //
+
+    std::vector<ShipCache::Spring> springs;
+    springs.reserve(springInfos.size());
+
+    for (auto const & springInfo : springInfos)
+    {
+        ShipCache::Spring spring{};
+        spring.PointAIndex = pointIndexRemap[springInfo.PointAIndex1];
+        spring.PointBIndex = pointIndexRemap[springInfo.PointBIndex1];
+        spring.SuperTrianglesCount = static_cast<uint32_t>(springInfo.SuperTriangles2.size());
+        spring.SuperTriangles.fill(NoneElementIndex);
+        for (size_t st = 0; st < springInfo.SuperTriangles2.size(); ++st)
+            spring.SuperTriangles[st] = springInfo.SuperTriangles2[st];
+
+        springs.push_back(spring);
+    }
+
+    std::vector<ShipCache::Triangle> triangles;
+    triangles.reserve(triangleInfos.size());
+
+    for (auto const & triangleInfo : triangleInfos)
+    {
+        ShipCache::Triangle triangle{};
+        for (size_t v = 0; v < triangleInfo.PointIndices1.size(); ++v)
+            triangle.PointIndices[v] = pointIndexRemap[triangleInfo.PointIndices1[v]];
+        triangle.SubSpringsCount = static_cast<uint32_t>(triangleInfo.SubSprings2.size());
+        triangle.SubSprings.fill(NoneElementIndex);
+        for (size_t ss = 0; ss < triangleInfo.SubSprings2.size(); ++ss)
+            triangle.SubSprings[ss] = triangleInfo.SubSprings2[ss];
+
+        triangles.push_back(triangle);
+    }
+
+    shipCache.Store(
+        shipName,
+        shipCacheKey,
         points,
-        pointIndexRemap,
-        springInfos);
+        springs,
+        springColorRanges,
+        triangles);
+}
+
+void ShipBuilder::AppendStructuralPoints(
+    RgbImageData const & structuralLayerImage,
+    std::map<MaterialDatabase::ColorKey, RopeSegment> & ropeSegments,
+    std::vector<PointInfo> & pointInfos1,
+    PointIndexMatrix & pointIndexMatrix,
+    MaterialDatabase const & materialDatabase,
+    vec2f const & shipOffset,
+    TaskThreadPool & taskThreadPool)
+{
+    int const width = structuralLayerImage.Size.Width;
+    float const halfWidth = static_cast<float>(width) / 2.0f;
+    int const height = structuralLayerImage.Size.Height;
+
+    //
+    // Points are numbered in the order in which they are found when visiting the image
+    // column by column, left to right, and each column from bottom to top; hence we visit
+    // strips of columns concurrently, numbering their points locally, and then we stitch
+    // the strips together in order
+    //
+
+    struct RopeEndpoint
+    {
+        ElementIndex PointIndex;
+        MaterialDatabase::ColorKey ColorKey;
+        int X;
+        int Y;
+    };
+
+    struct Strip
+    {
+        int StartX;
+        int EndX;
+        std::vector<PointInfo> PointInfos;
+        std::vector<RopeEndpoint> RopeEndpoints;
+        ElementIndex StartPointIndex;
+
+        Strip(
+            int startX,
+            int endX)
+            : StartX(startX)
+            , EndX(endX)
+            , PointInfos()
+            , RopeEndpoints()
+            , StartPointIndex(0)
+        {}
+    };
+
+    std::vector<Strip> strips;
+    for (auto const & tile : MakeTiles(width, taskThreadPool))
+    {
+        strips.emplace_back(tile.first, tile.second);
+    }
+
+    //
+    // 1. Visit the strips, creating their points
+    //
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t s = 0; s < strips.size(); ++s)
+    {
+        tasks.emplace_back(
+            [&, s]()
+            {
+                Strip & strip = strips[s];
 
+                for (int x = strip.StartX; x < strip.EndX; ++x)
+                {
+                    // From bottom to top
+                    for (int y = 0; y < height; ++y)
+                    {
+                        MaterialDatabase::ColorKey colorKey = structuralLayerImage.Data[x + (height - y - 1) * width];
+                        StructuralMaterial const * structuralMaterial = materialDatabase.FindStructuralMaterial(colorKey);
+                        if (nullptr != structuralMaterial)
+                        {
+                            //
+                            // Make a point
+                            //
 
-    //
-    // Associate all springs with the triangles that cover them
-    //
+                            ElementIndex const pointIndex = static_cast<ElementIndex>(strip.PointInfos.size());
 
-    ConnectSpringsAndTriangles(
-        springInfos,
-        triangleInfos);
+                            pointIndexMatrix(x + 1, y + 1) = pointIndex;
 
+                            strip.PointInfos.emplace_back(
+                                vec2f(
+                                    static_cast<float>(x) - halfWidth,
+                                    static_cast<float>(y))
+                                    + shipOffset,
+                                MakeTextureCoordinates(x, y, structuralLayerImage.Size),
+                                structuralMaterial->RenderColor,
+                                *structuralMaterial,
+                                structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope));
 
-    //
-    // Create Springs for all SpringInfo's
-    //
+                            //
+                            // Check if it's a (custom) rope endpoint
+                            //
 
-    Springs springs = CreateSprings(
-        springInfos,
-        points,
-        pointIndexRemap,
-        parentWorld,
-        gameEventHandler,
-        gameParameters);
+                            if (structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope)
+                                && !materialDatabase.IsUniqueStructuralMaterialColorKey(StructuralMaterial::MaterialUniqueType::Rope, colorKey))
+                            {
+                                strip.RopeEndpoints.push_back({ pointIndex, colorKey, x, y });
+                            }
+                        }
+                        else
+                        {
+                            // Just ignore this pixel
+                        }
+                    }
+                }
+            });
+    }
 
+    taskThreadPool.Run(tasks);
 
     //
-    // Create Triangles for all (filtered out) TriangleInfo's
+    // 2. Stitch the strips together
     //
 
-    Triangles triangles = CreateTriangles(
-        triangleInfos,
-        points,
-        pointIndexRemap);
+    size_t pointCount = pointInfos1.size();
+    for (auto const & strip : strips)
+    {
+        pointCount += strip.PointInfos.size();
+    }
 
+    pointInfos1.reserve(pointCount);
 
-    //
-    // Create Electrical Elements
-    //
+    for (auto & strip : strips)
+    {
+        strip.StartPointIndex = static_cast<ElementIndex>(pointInfos1.size());
 
-    ElectricalElements electricalElements = CreateElectricalElements(
-        points,
-        springs,
-        parentWorld,
-        gameEventHandler);
+        for (auto & pointInfo : strip.PointInfos)
+        {
+            pointInfos1.emplace_back(std::move(pointInfo));
+        }
 
+        for (auto const & ropeEndpoint : strip.RopeEndpoints)
+        {
+            // Store in RopeSegments, using the color key as the color of the rope
+            RopeSegment & ropeSegment = ropeSegments[ropeEndpoint.ColorKey];
+            if (!ropeSegment.SetEndpoint(strip.StartPointIndex + ropeEndpoint.PointIndex, ropeEndpoint.ColorKey))
+            {
+                throw GameException(
+                    std::string("More than two \"" + Utils::RgbColor2Hex(ropeEndpoint.ColorKey) + "\" rope endpoints found at (")
+                    + std::to_string(ropeEndpoint.X) + "," + std::to_string(height - ropeEndpoint.Y - 1) + ")");
+            }
+        }
+    }
 
     //
-    // We're done!
+    // 3. Turn the local point indices in the matrix into global ones
     //
 
-    LogMessage("Created ship: W=", shipDefinition.StructuralLayerImage.Size.Width, ", H=", shipDefinition.StructuralLayerImage.Size.Height, ", ",
-        points.GetElementCount(), " points, ", springs.GetElementCount(), " springs, ", triangles.GetElementCount(), " triangles, ",
-        electricalElements.GetElementCount(), " electrical elements.");
+    tasks.clear();
+    for (size_t s = 0; s < strips.size(); ++s)
+    {
+        if (0 != strips[s].StartPointIndex)
+        {
+            tasks.emplace_back(
+                [&, s]()
+                {
+                    Strip const & strip = strips[s];
 
-    return std::make_unique<Ship>(
-        shipId,
-        parentWorld,
-        gameEventHandler,
-        materialDatabase,
-        std::move(points),
-        std::move(springs),
-        std::move(triangles),
-        std::move(electricalElements),
-        currentVisitSequenceNumber);
-}
+                    for (int x = strip.StartX; x < strip.EndX; ++x)
+                    {
+                        for (int y = 0; y < height; ++y)
+                        {
+                            if (pointIndexMatrix.HasPoint(x + 1, y + 1))
+                            {
+                                pointIndexMatrix(x + 1, y + 1) += strip.StartPointIndex;
+                            }
+                        }
+                    }
+                });
+        }
+    }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////
-// Building helpers
-//////////////////////////////////////////////////////////////////////////////////////////////////
+    if (!tasks.empty())
+    {
+        taskThreadPool.Run(tasks);
+    }
+}
 
 void ShipBuilder::AppendRopeEndpoints(
     RgbImageData const & ropeLayerImage,
     std::map<MaterialDatabase::ColorKey, RopeSegment> & ropeSegments,
     std::vector<PointInfo> & pointInfos1,
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> & pointIndexMatrix,
+    PointIndexMatrix & pointIndexMatrix,
     MaterialDatabase const & materialDatabase,
     vec2f const & shipOffset)
 {
@@ -352,7 +817,7 @@ void ShipBuilder::AppendRopeEndpoints(
             {
                 // Check whether we have a structural point here
                 ElementIndex pointIndex;
-                if (!pointIndexMatrix[x + 1][y + 1])
+                if (!pointIndexMatrix.HasPoint(x + 1, y + 1))
                 {
                     // Make a point
                     pointIndex = static_cast<ElementIndex>(pointInfos1.size());
@@ -366,11 +831,11 @@ void ShipBuilder::AppendRopeEndpoints(
                         materialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Rope),
                         true);
 
-                    pointIndexMatrix[x + 1][y + 1] = pointIndex;
+                    pointIndexMatrix(x + 1, y + 1) = pointIndex;
                 }
                 else
                 {
-                    pointIndex = *(pointIndexMatrix[x + 1][y + 1]);
+                    pointIndex = pointIndexMatrix(x + 1, y + 1);
                 }
 
                 // Make sure we don't have a rope already with an endpoint here
@@ -407,55 +872,88 @@ void ShipBuilder::DecoratePointsWithElectricalMaterials(
     RgbImageData const & layerImage,
     std::vector<PointInfo> & pointInfos1,
     bool isDedicatedElectricalLayer,
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
-    MaterialDatabase const & materialDatabase)
+    PointIndexMatrix const & pointIndexMatrix,
+    MaterialDatabase const & materialDatabase,
+    TaskThreadPool & taskThreadPool)
 {
     int const width = layerImage.Size.Width;
     int const height = layerImage.Size.Height;
 
     constexpr MaterialDatabase::ColorKey BackgroundColorKey = { 0xff, 0xff, 0xff };
 
-    for (int x = 0; x < width; ++x)
-    {
-        // From bottom to top
-        for (int y = 0; y < height; ++y)
-        {
-            // Get color
-            MaterialDatabase::ColorKey colorKey = layerImage.Data[x + (height - y - 1) * width];
+    //
+    // Each point is decorated by at most one pixel, hence we visit strips of columns concurrently;
+    // each strip stops at its first error, and we then report the error that a visit of the whole
+    // image - column by column - would have found first
+    //
 
-            // Check if it's an electrical material
-            ElectricalMaterial const * electricalMaterial = materialDatabase.FindElectricalMaterial(colorKey);
-            if (nullptr == electricalMaterial)
-            {
-                if (isDedicatedElectricalLayer
-                    && colorKey != BackgroundColorKey)
-                {
-                    throw GameException(
-                        std::string("Cannot find electrical material for color key \"" + Utils::RgbColor2Hex(colorKey)
-                        + "\" of pixel found at (")
-                        + std::to_string(x) + "," + std::to_string(height - y - 1) + ") in the "
-                        + (isDedicatedElectricalLayer ? "electrical" : "structural")
-                        + " layer image");
-                }
+    auto const strips = MakeTiles(width, taskThreadPool);
 
-                // Just ignore
-            }
-            else
+    std::vector<std::string> stripErrors(strips.size());
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t s = 0; s < strips.size(); ++s)
+    {
+        tasks.emplace_back(
+            [&, s]()
             {
-                // Make sure we have a structural point here
-                if (!pointIndexMatrix[x + 1][y + 1])
+                for (int x = strips[s].first; x < strips[s].second; ++x)
                 {
-                    throw GameException(
-                        std::string("The electrical layer image specifies an electrical material at (")
-                        + std::to_string(x) + "," + std::to_string(height - y - 1)
-                        + "), but no pixel may be found at those coordinates in the structural layer image");
+                    // From bottom to top
+                    for (int y = 0; y < height; ++y)
+                    {
+                        // Get color
+                        MaterialDatabase::ColorKey colorKey = layerImage.Data[x + (height - y - 1) * width];
+
+                        // Check if it's an electrical material
+                        ElectricalMaterial const * electricalMaterial = materialDatabase.FindElectricalMaterial(colorKey);
+                        if (nullptr == electricalMaterial)
+                        {
+                            if (isDedicatedElectricalLayer
+                                && colorKey != BackgroundColorKey)
+                            {
+                                stripErrors[s] =
+                                    std::string("Cannot find electrical material for color key \"" + Utils::RgbColor2Hex(colorKey)
+                                    + "\" of pixel found at (")
+                                    + std::to_string(x) + "," + std::to_string(height - y - 1) + ") in the "
+                                    + (isDedicatedElectricalLayer ? "electrical" : "structural")
+                                    + " layer image";
+
+                                return;
+                            }
+
+                            // Just ignore
+                        }
+                        else
+                        {
+                            // Make sure we have a structural point here
+                            if (!pointIndexMatrix.HasPoint(x + 1, y + 1))
+                            {
+                                stripErrors[s] =
+                                    std::string("The electrical layer image specifies an electrical material at (")
+                                    + std::to_string(x) + "," + std::to_string(height - y - 1)
+                                    + "), but no pixel may be found at those coordinates in the structural layer image";
+
+                                return;
+                            }
+
+                            // Store electrical material
+                            auto const pointIndex = pointIndexMatrix(x + 1, y + 1);
+                            assert(nullptr == pointInfos1[pointIndex].ElectricalMtl);
+                            pointInfos1[pointIndex].ElectricalMtl = electricalMaterial;
+                        }
+                    }
                 }
+            });
+    }
 
-                // Store electrical material
-                auto const pointIndex = *(pointIndexMatrix[x + 1][y + 1]);
-                assert(nullptr == pointInfos1[pointIndex].ElectricalMtl);
-                pointInfos1[pointIndex].ElectricalMtl = electricalMaterial;
-            }
+    taskThreadPool.Run(tasks);
+
+    for (auto const & stripError : stripErrors)
+    {
+        if (!stripError.empty())
+        {
+            throw GameException(stripError);
         }
     }
 }
@@ -595,12 +1093,13 @@ void ShipBuilder::AppendRopes(
 }
 
 void ShipBuilder::CreateShipElementInfos(
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
+    PointIndexMatrix const & pointIndexMatrix,
     ImageSize const & structureImageSize,
     std::vector<PointInfo> & pointInfos1,
     std::vector<SpringInfo> & springInfos1,
     std::vector<TriangleInfo> & triangleInfos1,
-    size_t & leakingPointsCount)
+    size_t & leakingPointsCount,
+    TaskThreadPool & taskThreadPool)
 {
     //
     // Visit point matrix and:
@@ -608,9 +1107,9 @@ void ShipBuilder::CreateShipElementInfos(
     //  - Detect springs and create SpringInfo's for them (additional to ropes)
     //  - Do tessellation and create TriangleInfo's
     //
-
-    // Initialize count of leaking points
-    leakingPointsCount = 0;
+    // Each row is visited independently of the others, hence we visit bands of rows
+    // concurrently, and then we append their springs and triangles in order
+    //
 
     // This is our local circular order
     static const int Directions[8][2] = {
@@ -624,146 +1123,206 @@ void ShipBuilder::CreateShipElementInfos(
         {  1,  1 }   // NE
     };
 
-    // From bottom to top
-    for (int y = 1; y <= structureImageSize.Height; ++y)
+    struct Band
+    {
+        int StartY;
+        int EndY;
+        std::vector<SpringInfo> SpringInfos;
+        std::vector<TriangleInfo> TriangleInfos;
+        size_t LeakingPointsCount;
+
+        Band(
+            int startY,
+            int endY)
+            : StartY(startY)
+            , EndY(endY)
+            , SpringInfos()
+            , TriangleInfos()
+            , LeakingPointsCount(0)
+        {}
+    };
+
+    std::vector<Band> bands;
+    for (auto const & tile : MakeTiles(structureImageSize.Height, taskThreadPool))
     {
-        // We're starting a new row, so we're not in a ship now
-        bool isInShip = false;
+        // Rows in the matrix start at 1
+        bands.emplace_back(tile.first + 1, tile.second + 1);
+    }
 
-        for (int x = 1; x <= structureImageSize.Width; ++x)
-        {
-            if (!!pointIndexMatrix[x][y])
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t b = 0; b < bands.size(); ++b)
+    {
+        tasks.emplace_back(
+            [&, b]()
             {
-                //
-                // A point exists at these coordinates
-                //
-
-                ElementIndex pointIndex = *pointIndexMatrix[x][y];
+                Band & band = bands[b];
 
-                // If a non-hull node has empty space on one of its four sides, it is leaking.
-                // Check if a is leaking; a is leaking if:
-                // - a is not hull, AND
-                // - there is at least a hole at E, S, W, N
-                if (!pointInfos1[pointIndex].StructuralMtl.IsHull)
+                // From bottom to top
+                for (int y = band.StartY; y < band.EndY; ++y)
                 {
-                    if (!pointIndexMatrix[x + 1][y]
-                        || !pointIndexMatrix[x][y + 1]
-                        || !pointIndexMatrix[x - 1][y]
-                        || !pointIndexMatrix[x][y - 1])
-                    {
-                        pointInfos1[pointIndex].IsLeaking = true;
-                        ++leakingPointsCount;
-                    }
-                }
-
+                    // We're starting a new row, so we're not in a ship now
+                    bool isInShip = false;
 
-                //
-                // Check if a spring exists
-                //
+                    for (int x = 1; x <= structureImageSize.Width; ++x)
+                    {
+                        if (pointIndexMatrix.HasPoint(x, y))
+                        {
+                            //
+                            // A point exists at these coordinates
+                            //
 
-                // First four directions out of 8: from 0 deg (+x) through to 225 deg (-x -y),
-                // i.e. E, SE, S, SW - this covers each pair of points in each direction
-                for (int i = 0; i < 4; ++i)
-                {
-                    int adjx1 = x + Directions[i][0];
-                    int adjy1 = y + Directions[i][1];
+                            ElementIndex pointIndex = pointIndexMatrix(x, y);
 
-                    if (!!pointIndexMatrix[adjx1][adjy1])
-                    {
-                        // This point is adjacent to the first point at one of E, SE, S, SW
+                            // If a non-hull node has empty space on one of its four sides, it is leaking.
+                            // Check if a is leaking; a is leaking if:
+                            // - a is not hull, AND
+                            // - there is at least a hole at E, S, W, N
+                            if (!pointInfos1[pointIndex].StructuralMtl.IsHull)
+                            {
+                                if (!pointIndexMatrix.HasPoint(x + 1, y)
+                                    || !pointIndexMatrix.HasPoint(x, y + 1)
+                                    || !pointIndexMatrix.HasPoint(x - 1, y)
+                                    || !pointIndexMatrix.HasPoint(x, y - 1))
+                                {
+                                    pointInfos1[pointIndex].IsLeaking = true;
+                                    ++band.LeakingPointsCount;
+                                }
+                            }
 
-                        //
-                        // Create SpringInfo
-                        //
 
-                        ElementIndex const otherEndpointIndex = *pointIndexMatrix[adjx1][adjy1];
+                            //
+                            // Check if a spring exists
+                            //
 
-                        ElementIndex const springIndex = static_cast<ElementIndex>(springInfos1.size());
+                            // First four directions out of 8: from 0 deg (+x) through to 225 deg (-x -y),
+                            // i.e. E, SE, S, SW - this covers each pair of points in each direction
+                            for (int i = 0; i < 4; ++i)
+                            {
+                                int adjx1 = x + Directions[i][0];
+                                int adjy1 = y + Directions[i][1];
 
-                        springInfos1.emplace_back(
-                            pointIndex,
-                            otherEndpointIndex);
+                                if (pointIndexMatrix.HasPoint(adjx1, adjy1))
+                                {
+                                    // This point is adjacent to the first point at one of E, SE, S, SW
 
-                        // Add the spring to its endpoints
-                        pointInfos1[pointIndex].AddConnectedSpring(springIndex);
-                        pointInfos1[otherEndpointIndex].AddConnectedSpring(springIndex);
+                                    //
+                                    // Create SpringInfo
+                                    //
 
+                                    ElementIndex const otherEndpointIndex = pointIndexMatrix(adjx1, adjy1);
 
-                        //
-                        // Check if a triangle exists
-                        // - If this is the first point that is in a ship, we check all the way up to W;
-                        // - Else, we check up to S, so to avoid covering areas already covered by the triangulation
-                        //   at the previous point
-                        //
+                                    // The spring is added to its endpoints once it gets its final index
+                                    band.SpringInfos.emplace_back(
+                                        pointIndex,
+                                        otherEndpointIndex);
 
-                        // Check adjacent point in next CW direction
-                        int adjx2 = x + Directions[i + 1][0];
-                        int adjy2 = y + Directions[i + 1][1];
-                        if ((!isInShip || i < 2)
-                            && !!pointIndexMatrix[adjx2][adjy2])
-                        {
-                            // This point is adjacent to the first point at one of SE, S, SW, W
 
-                            //
-                            // Create TriangleInfo
-                            //
+                                    //
+                                    // Check if a triangle exists
+                                    // - If this is the first point that is in a ship, we check all the way up to W;
+                                    // - Else, we check up to S, so to avoid covering areas already covered by the triangulation
+                                    //   at the previous point
+                                    //
 
-                            triangleInfos1.emplace_back(
-                                std::array<ElementIndex, 3>(
+                                    // Check adjacent point in next CW direction
+                                    int adjx2 = x + Directions[i + 1][0];
+                                    int adjy2 = y + Directions[i + 1][1];
+                                    if ((!isInShip || i < 2)
+                                        && pointIndexMatrix.HasPoint(adjx2, adjy2))
                                     {
-                                        pointIndex,
-                                        otherEndpointIndex,
-                                        *pointIndexMatrix[adjx2][adjy2]
-                                    }));
-                        }
+                                        // This point is adjacent to the first point at one of SE, S, SW, W
+
+                                        //
+                                        // Create TriangleInfo
+                                        //
+
+                                        band.TriangleInfos.emplace_back(
+                                            std::array<ElementIndex, 3>(
+                                                {
+                                                    pointIndex,
+                                                    otherEndpointIndex,
+                                                    pointIndexMatrix(adjx2, adjy2)
+                                                }));
+                                    }
+
+                                    // Now, we also want to check whether the single "irregular" triangle from this point exists,
+                                    // i.e. the triangle between this point, the point at its E, and the point at its
+                                    // S, in case there is no point at SE.
+                                    // We do this so that we can forget the entire W side for inner points and yet ensure
+                                    // full coverage of the area
+                                    if (i == 0
+                                        && !pointIndexMatrix.HasPoint(x + Directions[1][0], y + Directions[1][1])
+                                        && pointIndexMatrix.HasPoint(x + Directions[2][0], y + Directions[2][1]))
+                                    {
+                                        // If we're here, the point at E exists
+                                        assert(pointIndexMatrix.HasPoint(x + Directions[0][0], y + Directions[0][1]));
+
+                                        //
+                                        // Create TriangleInfo
+                                        //
+
+                                        band.TriangleInfos.emplace_back(
+                                            std::array<ElementIndex, 3>(
+                                                {
+                                                    pointIndex,
+                                                    pointIndexMatrix(x + Directions[0][0], y + Directions[0][1]),
+                                                    pointIndexMatrix(x + Directions[2][0], y + Directions[2][1])
+                                                }));
+                                    }
+                                }
+                            }
 
-                        // Now, we also want to check whether the single "irregular" triangle from this point exists,
-                        // i.e. the triangle between this point, the point at its E, and the point at its
-                        // S, in case there is no point at SE.
-                        // We do this so that we can forget the entire W side for inner points and yet ensure
-                        // full coverage of the area
-                        if (i == 0
-                            && !pointIndexMatrix[x + Directions[1][0]][y + Directions[1][1]]
-                            && !!pointIndexMatrix[x + Directions[2][0]][y + Directions[2][1]])
+                            // Remember now that we're in a ship
+                            isInShip = true;
+                        }
+                        else
                         {
-                            // If we're here, the point at E exists
-                            assert(!!pointIndexMatrix[x + Directions[0][0]][y + Directions[0][1]]);
-
                             //
-                            // Create TriangleInfo
+                            // No point exists at these coordinates
                             //
 
-                            triangleInfos1.emplace_back(
-                                std::array<ElementIndex, 3>(
-                                    {
-                                        pointIndex,
-                                        *pointIndexMatrix[x + Directions[0][0]][y + Directions[0][1]],
-                                        *pointIndexMatrix[x + Directions[2][0]][y + Directions[2][1]]
-                                    }));
+                            // From now on we're not in a ship anymore
+                            isInShip = false;
                         }
                     }
                 }
+            });
+    }
 
-                // Remember now that we're in a ship
-                isInShip = true;
-            }
-            else
-            {
-                //
-                // No point exists at these coordinates
-                //
+    taskThreadPool.Run(tasks);
 
-                // From now on we're not in a ship anymore
-                isInShip = false;
-            }
+    //
+    // Append the bands' elements in order
+    //
+
+    leakingPointsCount = 0;
+
+    for (auto const & band : bands)
+    {
+        for (auto const & springInfo : band.SpringInfos)
+        {
+            ElementIndex const springIndex = static_cast<ElementIndex>(springInfos1.size());
+
+            springInfos1.push_back(springInfo);
+
+            // Add the spring to its endpoints
+            pointInfos1[springInfo.PointAIndex1].AddConnectedSpring(springIndex);
+            pointInfos1[springInfo.PointBIndex1].AddConnectedSpring(springIndex);
         }
+
+        triangleInfos1.insert(
+            triangleInfos1.end(),
+            band.TriangleInfos.cbegin(),
+            band.TriangleInfos.cend());
+
+        leakingPointsCount += band.LeakingPointsCount;
     }
 }
 
 template <int BlockSize>
 std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderSpringsOptimally_Tiling(
     std::vector<SpringInfo> const & springInfos1,
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
+    PointIndexMatrix const & pointIndexMatrix,
     ImageSize const & structureImageSize,
     std::vector<PointInfo> const & pointInfos1)
 {
@@ -787,9 +1346,9 @@ std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderSpringsOptimally_Tiling
             {
                 for (int x2 = 0; x2 < BlockSize && x + x2 <= structureImageSize.Width; ++x2)
                 {
-                    if (!!pointIndexMatrix[x + x2][y + y2])
+                    if (pointIndexMatrix.HasPoint(x + x2, y + y2))
                     {
-                        ElementIndex pointIndex = *(pointIndexMatrix[x + x2][y + y2]);
+                        ElementIndex pointIndex = pointIndexMatrix(x + x2, y + y2);
 
                         // Add all springs connected to this point
                         for (auto connectedSpringIndex : pointInfos1[pointIndex].ConnectedSprings1)
@@ -835,18 +1394,24 @@ std::vector<ShipBuilder::PointInfo> ShipBuilder::ReorderPointsOptimally_Followin
     std::vector<PointInfo> pointInfos2;
     pointIndexRemap.resize(pointInfos1.size());
 
-    std::unordered_set<ElementIndex> visitedPoints;
+    pointInfos2.reserve(pointInfos1.size());
+
+    std::vector<bool> visitedPoints(pointInfos1.size(), false);
 
     for (auto const & springInfo : springInfos2)
     {
-        if (visitedPoints.insert(springInfo.PointAIndex1).second)
+        if (!visitedPoints[springInfo.PointAIndex1])
         {
+            visitedPoints[springInfo.PointAIndex1] = true;
+
             pointIndexRemap[springInfo.PointAIndex1] = static_cast<ElementIndex>(pointInfos2.size());
             pointInfos2.push_back(pointInfos1[springInfo.PointAIndex1]);
         }
 
-        if (visitedPoints.insert(springInfo.PointBIndex1).second)
+        if (!visitedPoints[springInfo.PointBIndex1])
         {
+            visitedPoints[springInfo.PointBIndex1] = true;
+
             pointIndexRemap[springInfo.PointBIndex1] = static_cast<ElementIndex>(pointInfos2.size());
             pointInfos2.push_back(pointInfos1[springInfo.PointBIndex1]);
         }
@@ -859,7 +1424,7 @@ std::vector<ShipBuilder::PointInfo> ShipBuilder::ReorderPointsOptimally_Followin
 
     for (ElementIndex p = 0; p < pointInfos1.size(); ++p)
     {
-        if (0 == visitedPoints.count(p))
+        if (!visitedPoints[p])
         {
             pointIndexRemap[p] = static_cast<ElementIndex>(pointInfos2.size());
             pointInfos2.push_back(pointInfos1[p]);
@@ -885,6 +1450,76 @@ std::vector<ShipBuilder::PointInfo> ShipBuilder::ReorderPointsOptimally_Idempote
     return pointInfos1;
 }
 
+std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderSpringsByColor(
+    std::vector<SpringInfo> const & springInfos2,
+    size_t pointCount,
+    std::vector<Physics::Springs::ColorRange> & springColorRanges)
+{
+    //
+    // 1. Greedily assign to each spring the lowest color that is not yet
+    // used by any other spring at either of its endpoints; the greedy
+    // algorithm uses at most 2 * MaxSpringsPerPoint - 1 colors
+    //
+
+    static_assert(2 * GameParameters::MaxSpringsPerPoint - 1 <= 32, "Colors must fit in a 32-bit mask");
+
+    std::vector<uint32_t> pointUsedColors(pointCount, 0u);
+    std::vector<size_t> springColors;
+    springColors.reserve(springInfos2.size());
+
+    size_t colorCount = 0;
+
+    for (auto const & springInfo : springInfos2)
+    {
+        uint32_t const usedColors =
+            pointUsedColors[springInfo.PointAIndex1]
+            | pointUsedColors[springInfo.PointBIndex1];
+
+        size_t color = 0;
+        while (0 != (usedColors & (1u << color)))
+        {
+            ++color;
+        }
+
+        assert(color < 32);
+
+        pointUsedColors[springInfo.PointAIndex1] |= (1u << color);
+        pointUsedColors[springInfo.PointBIndex1] |= (1u << color);
+
+        springColors.push_back(color);
+        colorCount = std::max(colorCount, color + 1);
+    }
+
+    //
+    // 2. Stable-partition springs by color, so that within each color we
+    // maintain the original - cache-friendly - order
+    //
+
+    std::vector<SpringInfo> springInfos3;
+    springInfos3.reserve(springInfos2.size());
+
+    springColorRanges.clear();
+
+    for (size_t color = 0; color < colorCount; ++color)
+    {
+        ElementIndex const startSpringIndex = static_cast<ElementIndex>(springInfos3.size());
+
+        for (size_t s = 0; s < springInfos2.size(); ++s)
+        {
+            if (springColors[s] == color)
+                springInfos3.push_back(springInfos2[s]);
+        }
+
+        springColorRanges.emplace_back(
+            startSpringIndex,
+            static_cast<ElementIndex>(springInfos3.size()));
+    }
+
+    assert(springInfos3.size() == springInfos2.size());
+
+    return springInfos3;
+}
+
 Points ShipBuilder::CreatePoints(
     std::vector<PointInfo> const & pointInfos2,
     World & parentWorld,
@@ -983,49 +1618,56 @@ std::vector<ShipBuilder::TriangleInfo> ShipBuilder::FilterOutRedundantTriangles(
 
 void ShipBuilder::ConnectSpringsAndTriangles(
     std::vector<SpringInfo> & springInfos2,
-    std::vector<TriangleInfo> & triangleInfos2)
+    std::vector<TriangleInfo> & triangleInfos2,
+    size_t pointCount)
 {
     //
-    // 1. Build Edge -> Spring table
+    // 1. Build Point -> Springs table, laid out flat: the springs of point p are at
+    // [pointSpringsStart[p], pointSpringsStart[p + 1]), in spring order; an edge is
+    // then found by visiting the - few - springs at one of its endpoints
     //
 
-    struct Edge
+    std::vector<ElementIndex> pointSpringsStart(pointCount + 1, 0);
+
+    for (auto const & springInfo : springInfos2)
+    {
+        ++pointSpringsStart[springInfo.PointAIndex1 + 1];
+        ++pointSpringsStart[springInfo.PointBIndex1 + 1];
+    }
+
+    for (size_t p = 0; p < pointCount; ++p)
     {
-        ElementIndex Endpoint1Index;
-        ElementIndex Endpoint2Index;
+        pointSpringsStart[p + 1] += pointSpringsStart[p];
+    }
 
-        Edge(
-            ElementIndex endpoint1Index,
-            ElementIndex endpoint2Index)
-            : Endpoint1Index(std::min(endpoint1Index, endpoint2Index))
-            , Endpoint2Index(std::max(endpoint1Index, endpoint2Index))
-        {}
+    std::vector<ElementIndex> pointSprings(pointSpringsStart[pointCount]);
+
+    {
+        std::vector<ElementIndex> pointSpringsEnd(pointSpringsStart.cbegin(), pointSpringsStart.cend() - 1);
 
-        bool operator==(Edge const & other) const
+        for (ElementIndex s = 0; s < springInfos2.size(); ++s)
         {
-            return this->Endpoint1Index == other.Endpoint1Index
-                && this->Endpoint2Index == other.Endpoint2Index;
+            pointSprings[pointSpringsEnd[springInfos2[s].PointAIndex1]++] = s;
+            pointSprings[pointSpringsEnd[springInfos2[s].PointBIndex1]++] = s;
         }
+    }
 
-        struct Hasher
+    // Returns the first spring between the two points, or NoneElementIndex
+    auto const findSpring = [&](ElementIndex endpoint1Index, ElementIndex endpoint2Index) -> ElementIndex
+    {
+        for (ElementIndex i = pointSpringsStart[endpoint1Index]; i < pointSpringsStart[endpoint1Index + 1]; ++i)
         {
-            size_t operator()(Edge const & edge) const
+            ElementIndex const springIndex = pointSprings[i];
+
+            if (springInfos2[springIndex].PointAIndex1 == endpoint2Index
+                || springInfos2[springIndex].PointBIndex1 == endpoint2Index)
             {
-                return edge.Endpoint1Index * 23
-                    + edge.Endpoint2Index;
+                return springIndex;
             }
-        };
-    };
-
-    std::unordered_map<Edge, ElementIndex, Edge::Hasher> pointToSpringMap;
+        }
 
-    for (ElementIndex s = 0; s < springInfos2.size(); ++s)
-    {
-        pointToSpringMap.emplace(
-            std::piecewise_construct,
-            std::forward_as_tuple(springInfos2[s].PointAIndex1, springInfos2[s].PointBIndex1),
-            std::forward_as_tuple(s));
-    }
+        return NoneElementIndex;
+    };
 
 
     //
@@ -1044,10 +1686,8 @@ void ShipBuilder::ConnectSpringsAndTriangles(
                 : triangleInfos2[t].PointIndices1[0];
 
             // Lookup spring for this edge
-            auto const springIt = pointToSpringMap.find({ endpointIndex, nextEndpointIndex });
-            assert(springIt != pointToSpringMap.end());
-
-            ElementIndex const springIndex = springIt->second;
+            ElementIndex const springIndex = findSpring(endpointIndex, nextEndpointIndex);
+            assert(NoneElementIndex != springIndex);
 
             // Tell this spring that it has an extra super triangle
             springInfos2[springIndex].SuperTriangles2.push_back(t);
@@ -1075,73 +1715,84 @@ void ShipBuilder::ConnectSpringsAndTriangles(
     //    *---*
     //   C     D
     //
+    // Springs are ordered by color, hence a traverse spring may come after the common edge
+    // that gives it its two super triangles; so we collect the common edges first, lest
+    // we mistake such a traverse spring for a common edge
+    //
 
+    std::vector<ElementIndex> commonEdgeSprings;
     for (ElementIndex s = 0; s < springInfos2.size(); ++s)
     {
         if (2 == springInfos2[s].SuperTriangles2.size())
         {
-            // This spring is the common edge between two triangles
-            // (A-D above)
+            commonEdgeSprings.push_back(s);
+        }
+    }
+
+    for (ElementIndex const s : commonEdgeSprings)
+    {
+        // This spring is the common edge between two triangles
+        // (A-D above)
 
-            //
-            // Find the B and C endpoints
-            //
+        //
+        // Find the B and C endpoints
+        //
 
-            ElementIndex endpoint1Index = NoneElementIndex;
-            TriangleInfo & triangle1 = triangleInfos2[springInfos2[s].SuperTriangles2[0]];
-            for (ElementIndex triangleVertex : triangle1.PointIndices1)
+        ElementIndex endpoint1Index = NoneElementIndex;
+        TriangleInfo & triangle1 = triangleInfos2[springInfos2[s].SuperTriangles2[0]];
+        for (ElementIndex triangleVertex : triangle1.PointIndices1)
+        {
+            if (triangleVertex != springInfos2[s].PointAIndex1
+                && triangleVertex != springInfos2[s].PointBIndex1)
             {
-                if (triangleVertex != springInfos2[s].PointAIndex1
-                    && triangleVertex != springInfos2[s].PointBIndex1)
-                {
-                    endpoint1Index = triangleVertex;
-                    break;
-                }
+                endpoint1Index = triangleVertex;
+                break;
             }
+        }
 
-            assert(NoneElementIndex != endpoint1Index);
+        assert(NoneElementIndex != endpoint1Index);
 
-            ElementIndex endpoint2Index = NoneElementIndex;
-            TriangleInfo & triangle2 = triangleInfos2[springInfos2[s].SuperTriangles2[1]];
-            for (ElementIndex triangleVertex : triangle2.PointIndices1)
+        ElementIndex endpoint2Index = NoneElementIndex;
+        TriangleInfo & triangle2 = triangleInfos2[springInfos2[s].SuperTriangles2[1]];
+        for (ElementIndex triangleVertex : triangle2.PointIndices1)
+        {
+            if (triangleVertex != springInfos2[s].PointAIndex1
+                && triangleVertex != springInfos2[s].PointBIndex1)
             {
-                if (triangleVertex != springInfos2[s].PointAIndex1
-                    && triangleVertex != springInfos2[s].PointBIndex1)
-                {
-                    endpoint2Index = triangleVertex;
-                    break;
-                }
+                endpoint2Index = triangleVertex;
+                break;
             }
+        }
 
-            assert(NoneElementIndex != endpoint2Index);
+        assert(NoneElementIndex != endpoint2Index);
 
 
-            //
-            // See if there's a B-C spring
-            //
+        //
+        // See if there's a B-C spring
+        //
 
-            auto const traverseSpringIt = pointToSpringMap.find({ endpoint1Index, endpoint2Index });
-            if (traverseSpringIt != pointToSpringMap.end())
-            {
-                // We have a traverse spring
+        ElementIndex const traverseSpringIndex = findSpring(endpoint1Index, endpoint2Index);
+        if (NoneElementIndex != traverseSpringIndex)
+        {
+            // We have a traverse spring
 
-                assert(0 == springInfos2[traverseSpringIt->second].SuperTriangles2.size());
+            assert(0 == springInfos2[traverseSpringIndex].SuperTriangles2.size());
 
-                // Tell the traverse spring that it has these super triangles
-                springInfos2[traverseSpringIt->second].SuperTriangles2.push_back(springInfos2[s].SuperTriangles2[0]);
-                springInfos2[traverseSpringIt->second].SuperTriangles2.push_back(springInfos2[s].SuperTriangles2[1]);
-                assert(springInfos2[traverseSpringIt->second].SuperTriangles2.size() == 2);
+            // Tell the traverse spring that it has these super triangles
+            springInfos2[traverseSpringIndex].SuperTriangles2.push_back(springInfos2[s].SuperTriangles2[0]);
+            springInfos2[traverseSpringIndex].SuperTriangles2.push_back(springInfos2[s].SuperTriangles2[1]);
+            assert(springInfos2[traverseSpringIndex].SuperTriangles2.size() == 2);
 
-                // Tell the triangles about this new sub spring of theirs
-                triangle1.SubSprings2.push_back(traverseSpringIt->second);
-                triangle2.SubSprings2.push_back(traverseSpringIt->second);
-            }
+            // Tell the triangles about this new sub spring of theirs
+            triangle1.SubSprings2.push_back(traverseSpringIndex);
+            triangle2.SubSprings2.push_back(traverseSpringIndex);
         }
     }
 }
 
 Physics::Springs ShipBuilder::CreateSprings(
     std::vector<SpringInfo> const & springInfos2,
+    std::vector<Physics::Springs::ColorRange> const & springColorRanges,
     Physics::Points & points,
     std::vector<ElementIndex> const & pointIndexRemap,
     World & parentWorld,
@@ -1150,6 +1801,7 @@ Physics::Springs ShipBuilder::CreateSprings(
 {
     Physics::Springs springs(
         static_cast<ElementIndex>(springInfos2.size()),
+        springColorRanges,
         parentWorld,
         std::move(gameEventHandler),
         gameParameters);
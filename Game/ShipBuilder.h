@@ -8,10 +8,12 @@
 #include "GameParameters.h"
 #include "MaterialDatabase.h"
 #include "Physics.h"
+#include "ShipCache.h"
 #include "ShipDefinition.h"
 
 #include <GameCore/FixedSizeVector.h>
 #include <GameCore/ImageSize.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -19,6 +21,8 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 /*
@@ -34,6 +38,7 @@ public:
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         ShipDefinition const & shipDefinition,
         MaterialDatabase const & materialDatabase,
+        ShipCache const * shipCache,
         GameParameters const & gameParameters,
         VisitSequenceNumber currentVisitSequenceNumber);
 
@@ -153,6 +158,53 @@ private:
         }
     };
 
+    /*
+     * The indices of the points at each pixel of the structure, in a single contiguous
+     * block of memory laid out by rows. The matrix has one extra row and one extra column
+     * of empty pixels on each side, so that neighbors may be visited without checking for
+     * boundaries; as a consequence, matrix coordinates are pixel coordinates plus one.
+     */
+    class PointIndexMatrix
+    {
+    public:
+
+        PointIndexMatrix(
+            int structureWidth,
+            int structureHeight)
+            : mWidth(structureWidth + 2)
+            , mHeight(structureHeight + 2)
+            , mData(new ElementIndex[static_cast<size_t>(mWidth) * static_cast<size_t>(mHeight)])
+        {
+            std::fill(
+                mData.get(),
+                mData.get() + static_cast<size_t>(mWidth) * static_cast<size_t>(mHeight),
+                NoneElementIndex);
+        }
+
+        inline bool HasPoint(int x, int y) const
+        {
+            return NoneElementIndex != (*this)(x, y);
+        }
+
+        inline ElementIndex operator()(int x, int y) const
+        {
+            assert(x >= 0 && x < mWidth && y >= 0 && y < mHeight);
+            return mData[static_cast<size_t>(y) * static_cast<size_t>(mWidth) + static_cast<size_t>(x)];
+        }
+
+        inline ElementIndex & operator()(int x, int y)
+        {
+            assert(x >= 0 && x < mWidth && y >= 0 && y < mHeight);
+            return mData[static_cast<size_t>(y) * static_cast<size_t>(mWidth) + static_cast<size_t>(x)];
+        }
+
+    private:
+
+        int const mWidth;
+        int const mHeight;
+        std::unique_ptr<ElementIndex[]> const mData;
+    };
+
 private:
 
     /////////////////////////////////////////////////////////////////
@@ -191,11 +243,54 @@ private:
             textureDy + static_cast<float>(y) / static_cast<float>(imageSize.Height));
     }
 
+    static void CreateElementInfos(
+        ShipDefinition const & shipDefinition,
+        MaterialDatabase const & materialDatabase,
+        TaskThreadPool & taskThreadPool,
+        std::vector<PointInfo> & pointInfos,
+        std::vector<SpringInfo> & springInfos,
+        std::vector<TriangleInfo> & triangleInfos,
+        std::vector<ElementIndex> & pointIndexRemap,
+        std::vector<Physics::Springs::ColorRange> & springColorRanges);
+
+    /*
+     * Returns false - leaving the element info's empty - if the cached ship
+     * turns out to be inconsistent, in which case the ship has to be built.
+     */
+    static bool LoadElementInfosFromCache(
+        ShipCache::CachedShip const & cachedShip,
+        MaterialDatabase const & materialDatabase,
+        std::vector<PointInfo> & pointInfos,
+        std::vector<SpringInfo> & springInfos,
+        std::vector<TriangleInfo> & triangleInfos,
+        std::vector<ElementIndex> & pointIndexRemap,
+        std::vector<Physics::Springs::ColorRange> & springColorRanges);
+
+    static void StoreElementInfosToCache(
+        std::vector<PointInfo> const & pointInfos,
+        std::vector<SpringInfo> const & springInfos,
+        std::vector<TriangleInfo> const & triangleInfos,
+        std::vector<ElementIndex> const & pointIndexRemap,
+        std::vector<Physics::Springs::ColorRange> const & springColorRanges,
+        MaterialDatabase const & materialDatabase,
+        std::string const & shipName,
+        uint64_t shipCacheKey,
+        ShipCache const & shipCache);
+
+    static void AppendStructuralPoints(
+        RgbImageData const & structuralLayerImage,
+        std::map<MaterialDatabase::ColorKey, RopeSegment> & ropeSegments,
+        std::vector<PointInfo> & pointInfos1,
+        PointIndexMatrix & pointIndexMatrix,
+        MaterialDatabase const & materialDatabase,
+        vec2f const & shipOffset,
+        TaskThreadPool & taskThreadPool);
+
     static void AppendRopeEndpoints(
         RgbImageData const & ropeLayerImage,
         std::map<MaterialDatabase::ColorKey, RopeSegment> & ropeSegments,
         std::vector<PointInfo> & pointInfos1,
-        std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> & pointIndexMatrix,
+        PointIndexMatrix & pointIndexMatrix,
         MaterialDatabase const & materialDatabase,
         vec2f const & shipOffset);
 
@@ -203,8 +298,9 @@ private:
         RgbImageData const & layerImage,
         std::vector<PointInfo> & pointInfos1,
         bool isDedicatedElectricalLayer,
-        std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
-        MaterialDatabase const & materialDatabase);
+        PointIndexMatrix const & pointIndexMatrix,
+        MaterialDatabase const & materialDatabase,
+        TaskThreadPool & taskThreadPool);
 
     static void AppendRopes(
         std::map<MaterialDatabase::ColorKey, RopeSegment> const & ropeSegments,
@@ -214,17 +310,18 @@ private:
         std::vector<SpringInfo> & springInfos1);
 
     static void CreateShipElementInfos(
-        std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
+        PointIndexMatrix const & pointIndexMatrix,
         ImageSize const & structureImageSize,
         std::vector<PointInfo> & pointInfos1,
         std::vector<SpringInfo> & springInfos1,
         std::vector<TriangleInfo> & triangleInfos1,
-        size_t & leakingPointsCount);
+        size_t & leakingPointsCount,
+        TaskThreadPool & taskThreadPool);
 
     template <int BlockSize>
     static std::vector<SpringInfo> ReorderSpringsOptimally_Tiling(
         std::vector<SpringInfo> const & springInfos1,
-        std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
+        PointIndexMatrix const & pointIndexMatrix,
         ImageSize const & structureImageSize,
         std::vector<PointInfo> const & pointInfos1);
 
@@ -237,6 +334,11 @@ private:
         std::vector<PointInfo> const & pointInfos1,
         std::vector<ElementIndex> & pointIndexRemap);
 
+    static std::vector<SpringInfo> ReorderSpringsByColor(
+        std::vector<SpringInfo> const & springInfos2,
+        size_t pointCount,
+        std::vector<Physics::Springs::ColorRange> & springColorRanges);
+
     static Physics::Points CreatePoints(
         std::vector<PointInfo> const & pointInfos2,
         Physics::World & parentWorld,
@@ -251,10 +353,12 @@ private:
 
     static void ConnectSpringsAndTriangles(
         std::vector<SpringInfo> & springInfos2,
-        std::vector<TriangleInfo> & triangleInfos2);
+        std::vector<TriangleInfo> & triangleInfos2,
+        size_t pointCount);
 
     static Physics::Springs CreateSprings(
         std::vector<SpringInfo> const & springInfos2,
+        std::vector<Physics::Springs::ColorRange> const & springColorRanges,
         Physics::Points & points,
         std::vector<ElementIndex> const & pointIndexRemap,
         Physics::World & parentWorld,
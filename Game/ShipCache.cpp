@@ -0,0 +1,249 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-20
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipCache.h"
+
+#include <GameCore/Log.h>
+#include <GameCore/Utils.h>
+
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of the file, or the way ships are built, changes
+    static constexpr uint32_t CurrentVersion = 1;
+
+    static constexpr char Magic[4] = { 'F', 'S', 'S', 'C' };
+
+    // Follows the header common to all cache files
+    struct Counts
+    {
+        uint64_t PointCount;
+        uint64_t SpringCount;
+        uint64_t SpringColorRangeCount;
+        uint64_t TriangleCount;
+    };
+
+    static_assert(std::is_trivially_copyable<Counts>::value);
+    static_assert(std::is_trivially_copyable<ShipCache::Point>::value);
+    static_assert(std::is_trivially_copyable<ShipCache::Spring>::value);
+    static_assert(std::is_trivially_copyable<Physics::Springs::ColorRange>::value);
+    static_assert(std::is_trivially_copyable<ShipCache::Triangle>::value);
+
+    std::string MakeEntryName(std::string const & shipName)
+    {
+        return "ship \"" + shipName + "\"";
+    }
+}
+
+uint64_t ShipCache::CalculateKey(
+    ShipDefinition const & shipDefinition,
+    MaterialDatabase const & materialDatabase)
+{
+    auto const hashLayer = [](RgbImageData const & layerImage, uint64_t hash)
+    {
+        hash = Utils::Hash64(&(layerImage.Size), sizeof(ImageSize), hash);
+
+        return Utils::Hash64(
+            layerImage.Data.get(),
+            static_cast<size_t>(layerImage.Size.Width) * static_cast<size_t>(layerImage.Size.Height) * sizeof(rgbColor),
+            hash);
+    };
+
+    uint64_t hash = Utils::Hash64(&CurrentVersion, sizeof(CurrentVersion));
+
+    hash = hashLayer(shipDefinition.StructuralLayerImage, hash);
+
+    uint8_t const hasRopesLayer = !!shipDefinition.RopesLayerImage ? 1 : 0;
+    hash = Utils::Hash64(&hasRopesLayer, sizeof(hasRopesLayer), hash);
+    if (!!shipDefinition.RopesLayerImage)
+        hash = hashLayer(*shipDefinition.RopesLayerImage, hash);
+
+    uint8_t const hasElectricalLayer = !!shipDefinition.ElectricalLayerImage ? 1 : 0;
+    hash = Utils::Hash64(&hasElectricalLayer, sizeof(hasElectricalLayer), hash);
+    if (!!shipDefinition.ElectricalLayerImage)
+        hash = hashLayer(*shipDefinition.ElectricalLayerImage, hash);
+
+    // The offset is baked into the positions of the points
+    hash = Utils::Hash64(&(shipDefinition.Metadata.Offset), sizeof(vec2f), hash);
+
+    uint64_t const materialDatabaseHash = materialDatabase.GetContentHash();
+    hash = Utils::Hash64(&materialDatabaseHash, sizeof(materialDatabaseHash), hash);
+
+    return hash;
+}
+
+std::unique_ptr<ShipCache::CachedShip> ShipCache::TryLoad(
+    std::string const & shipName,
+    uint64_t key) const
+{
+    auto file = CacheFile::TryOpen(
+        MakeFilepath(shipName),
+        Magic,
+        CurrentVersion,
+        key,
+        "ShipCache",
+        MakeEntryName(shipName));
+
+    if (!file)
+        return nullptr;
+
+    Counts const * const counts = file->Read<Counts>(1);
+    if (nullptr == counts)
+    {
+        file->LogEntryMessage("is truncated");
+        return nullptr;
+    }
+
+    //
+    // Map sections
+    //
+
+    std::unique_ptr<CachedShip> cachedShip(new CachedShip(std::move(file)));
+
+    cachedShip->mPoints = cachedShip->mFile->Read<Point>(static_cast<size_t>(counts->PointCount));
+    cachedShip->mPointCount = static_cast<size_t>(counts->PointCount);
+
+    cachedShip->mSprings = cachedShip->mFile->Read<Spring>(static_cast<size_t>(counts->SpringCount));
+    cachedShip->mSpringCount = static_cast<size_t>(counts->SpringCount);
+
+    cachedShip->mSpringColorRanges = cachedShip->mFile->Read<Physics::Springs::ColorRange>(static_cast<size_t>(counts->SpringColorRangeCount));
+    cachedShip->mSpringColorRangeCount = static_cast<size_t>(counts->SpringColorRangeCount);
+
+    cachedShip->mTriangles = cachedShip->mFile->Read<Triangle>(static_cast<size_t>(counts->TriangleCount));
+    cachedShip->mTriangleCount = static_cast<size_t>(counts->TriangleCount);
+
+    if (nullptr == cachedShip->mPoints
+        || nullptr == cachedShip->mSprings
+        || nullptr == cachedShip->mSpringColorRanges
+        || nullptr == cachedShip->mTriangles
+        || !cachedShip->mFile->IsAtEnd())
+    {
+        cachedShip->mFile->LogEntryMessage("has an unexpected size");
+        return nullptr;
+    }
+
+    LogMessage("ShipCache: loaded entry for ", MakeEntryName(shipName));
+
+    return cachedShip;
+}
+
+bool ShipCache::CachedShip::IsConsistent(
+    size_t structuralMaterialCount,
+    size_t electricalMaterialCount) const
+{
+    for (size_t p = 0; p < mPointCount; ++p)
+    {
+        Point const & point = mPoints[p];
+
+        if (point.StructuralMaterialIndex >= structuralMaterialCount
+            || (NoneMaterialIndex != point.ElectricalMaterialIndex
+                && point.ElectricalMaterialIndex >= electricalMaterialCount))
+        {
+            return false;
+        }
+    }
+
+    for (size_t s = 0; s < mSpringCount; ++s)
+    {
+        Spring const & spring = mSprings[s];
+
+        if (spring.PointAIndex >= mPointCount
+            || spring.PointBIndex >= mPointCount
+            || spring.SuperTrianglesCount > spring.SuperTriangles.size())
+        {
+            return false;
+        }
+
+        for (uint32_t st = 0; st < spring.SuperTrianglesCount; ++st)
+        {
+            if (spring.SuperTriangles[st] >= mTriangleCount)
+                return false;
+        }
+    }
+
+    // Color ranges must cover all springs, one after the other
+    ElementIndex nextStartSpringIndex = 0;
+    for (size_t c = 0; c < mSpringColorRangeCount; ++c)
+    {
+        Physics::Springs::ColorRange const & colorRange = mSpringColorRanges[c];
+
+        if (colorRange.StartSpringIndex != nextStartSpringIndex
+            || colorRange.EndSpringIndex < colorRange.StartSpringIndex)
+        {
+            return false;
+        }
+
+        nextStartSpringIndex = colorRange.EndSpringIndex;
+    }
+
+    if (nextStartSpringIndex != mSpringCount)
+        return false;
+
+    for (size_t t = 0; t < mTriangleCount; ++t)
+    {
+        Triangle const & triangle = mTriangles[t];
+
+        for (ElementIndex const pointIndex : triangle.PointIndices)
+        {
+            if (pointIndex >= mPointCount)
+                return false;
+        }
+
+        if (triangle.SubSpringsCount > triangle.SubSprings.size())
+            return false;
+
+        for (uint32_t ss = 0; ss < triangle.SubSpringsCount; ++ss)
+        {
+            if (triangle.SubSprings[ss] >= mSpringCount)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void ShipCache::Store(
+    std::string const & shipName,
+    uint64_t key,
+    std::vector<Point> const & points,
+    std::vector<Spring> const & springs,
+    std::vector<Physics::Springs::ColorRange> const & springColorRanges,
+    std::vector<Triangle> const & triangles) const
+{
+    CacheFile::Store(
+        MakeFilepath(shipName),
+        Magic,
+        CurrentVersion,
+        key,
+        [&](std::ostream & stream)
+        {
+            Counts counts;
+            counts.PointCount = points.size();
+            counts.SpringCount = springs.size();
+            counts.SpringColorRangeCount = springColorRanges.size();
+            counts.TriangleCount = triangles.size();
+
+            CacheFile::Write(stream, &counts, 1);
+
+            CacheFile::Write(stream, points.data(), points.size());
+            CacheFile::Write(stream, springs.data(), springs.size());
+            CacheFile::Write(stream, springColorRanges.data(), springColorRanges.size());
+            CacheFile::Write(stream, triangles.data(), triangles.size());
+        },
+        "ShipCache",
+        MakeEntryName(shipName));
+}
+
+std::filesystem::path ShipCache::MakeFilepath(std::string const & shipName) const
+{
+    // Ship names may contain anything, hence we name files after their hash
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << Utils::Hash64(shipName.data(), shipName.size());
+
+    return mFolderPath / (ss.str() + ".shipcache");
+}
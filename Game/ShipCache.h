@@ -0,0 +1,163 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-20
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "MaterialDatabase.h"
+#include "Physics.h"
+#include "ShipDefinition.h"
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/CacheFile.h>
+#include <GameCore/Vectors.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * A folder of binary files, one per ship, containing the elements of ships exactly as
+ * they come out of the ship builder - i.e. after tiling, reordering, coloring, and
+ * filtering - so that loading a ship again does not require building it again.
+ *
+ * Each file is keyed by a hash of the layers of the ship and of the material database;
+ * a file whose key or version does not match is simply ignored, and eventually
+ * overwritten with the new build of the ship.
+ */
+class ShipCache
+{
+public:
+
+    //
+    // The elements, as stored in a file; indices of points, springs, and triangles are final,
+    // while materials are indices into the ordered material maps of the material database
+    //
+
+    static constexpr uint32_t NoneMaterialIndex = std::numeric_limits<uint32_t>::max();
+
+    struct Point
+    {
+        vec2f Position;
+        vec2f TextureCoordinates;
+        vec4f RenderColor;
+        uint32_t StructuralMaterialIndex;
+        uint32_t ElectricalMaterialIndex;
+        uint8_t IsRope;
+        uint8_t IsLeaking;
+    };
+
+    struct Spring
+    {
+        ElementIndex PointAIndex;
+        ElementIndex PointBIndex;
+        uint32_t SuperTrianglesCount;
+        std::array<ElementIndex, 2> SuperTriangles;
+    };
+
+    struct Triangle
+    {
+        std::array<ElementIndex, 3> PointIndices;
+        uint32_t SubSpringsCount;
+        std::array<ElementIndex, 4> SubSprings;
+    };
+
+    /*
+     * A ship found in the cache; the elements are read straight out of the
+     * file mapped in memory, hence they are only valid while this lives.
+     */
+    class CachedShip
+    {
+    public:
+
+        Point const * GetPoints() const { return mPoints; }
+        size_t GetPointCount() const { return mPointCount; }
+
+        Spring const * GetSprings() const { return mSprings; }
+        size_t GetSpringCount() const { return mSpringCount; }
+
+        Physics::Springs::ColorRange const * GetSpringColorRanges() const { return mSpringColorRanges; }
+        size_t GetSpringColorRangeCount() const { return mSpringColorRangeCount; }
+
+        Triangle const * GetTriangles() const { return mTriangles; }
+        size_t GetTriangleCount() const { return mTriangleCount; }
+
+        /*
+         * Checks that all the indices in the elements are in range, and that the
+         * color ranges cover all springs; a file might be corrupted in ways that
+         * its size does not reveal.
+         */
+        bool IsConsistent(
+            size_t structuralMaterialCount,
+            size_t electricalMaterialCount) const;
+
+    private:
+
+        friend class ShipCache;
+
+        explicit CachedShip(std::unique_ptr<CacheFile> file)
+            : mFile(std::move(file))
+            , mPoints(nullptr)
+            , mPointCount(0)
+            , mSprings(nullptr)
+            , mSpringCount(0)
+            , mSpringColorRanges(nullptr)
+            , mSpringColorRangeCount(0)
+            , mTriangles(nullptr)
+            , mTriangleCount(0)
+        {}
+
+        std::unique_ptr<CacheFile> const mFile;
+
+        Point const * mPoints;
+        size_t mPointCount;
+        Spring const * mSprings;
+        size_t mSpringCount;
+        Physics::Springs::ColorRange const * mSpringColorRanges;
+        size_t mSpringColorRangeCount;
+        Triangle const * mTriangles;
+        size_t mTriangleCount;
+    };
+
+public:
+
+    explicit ShipCache(std::filesystem::path folderPath)
+        : mFolderPath(std::move(folderPath))
+    {}
+
+    static uint64_t CalculateKey(
+        ShipDefinition const & shipDefinition,
+        MaterialDatabase const & materialDatabase);
+
+    /*
+     * Returns nullptr if the ship is not in the cache, or if the file in the cache
+     * is for a different key or for a different version of the cache.
+     */
+    std::unique_ptr<CachedShip> TryLoad(
+        std::string const & shipName,
+        uint64_t key) const;
+
+    /*
+     * Best effort, see CacheFile::Store().
+     */
+    void Store(
+        std::string const & shipName,
+        uint64_t key,
+        std::vector<Point> const & points,
+        std::vector<Spring> const & springs,
+        std::vector<Physics::Springs::ColorRange> const & springColorRanges,
+        std::vector<Triangle> const & triangles) const;
+
+private:
+
+    std::filesystem::path MakeFilepath(std::string const & shipName) const;
+
+private:
+
+    std::filesystem::path const mFolderPath;
+};
@@ -45,8 +45,6 @@ public:
 
     static ShipDefinition Load(std::filesystem::path const & filepath);
 
-private:
-
     ShipDefinition(
         RgbImageData structuralLayerImage,
         std::optional<RgbImageData> ropesLayerImage,
@@ -62,7 +62,11 @@ ShipRenderContext::ShipRenderContext(
     , mGenericTextureRenderPolygonVertexVBO()
     // Connected components
     , mConnectedComponentsMaxSizes()
-    , mConnectedComponents()
+    , mPointElementBuffer()
+    , mSpringElementBuffer()
+    , mRopeElementBuffer()
+    , mTriangleElementBuffer()
+    , mStressedSpringElementBuffer()
     // Ephemeral points
     , mEphemeralPoints()
     , mEphemeralPointVBO()
@@ -205,6 +209,21 @@ ShipRenderContext::ShipRenderContext(
     CheckOpenGLError();
 
 
+    //
+    // Initialize elements
+    //
+
+    // Create VBOs
+    GLuint elementVBOs[5];
+    glGenBuffers(5, elementVBOs);
+    mPointElementBuffer.mVBO = elementVBOs[0];
+    mSpringElementBuffer.mVBO = elementVBOs[1];
+    mRopeElementBuffer.mVBO = elementVBOs[2];
+    mTriangleElementBuffer.mVBO = elementVBOs[3];
+    mStressedSpringElementBuffer.mVBO = elementVBOs[4];
+
+
+
     //
     // Initialize ephemeral points
     //
@@ -374,7 +393,7 @@ void ShipRenderContext::UpdateShowStressedSprings(bool showStressedSprings)
 
 //////////////////////////////////////////////////////////////////////////////////
 
-void ShipRenderContext::RenderStart(std::vector<std::size_t> const & connectedComponentsMaxSizes)
+void ShipRenderContext::UploadStart(std::vector<std::size_t> const & connectedComponentsMaxSizes)
 {
     // Store connected component max sizes
     mConnectedComponentsMaxSizes = connectedComponentsMaxSizes;
@@ -419,147 +438,62 @@ void ShipRenderContext::UploadShipPointColorRange(
 }
 
 void ShipRenderContext::UploadPoints(
+    vec2f const * restrict previousPosition,
     vec2f const * restrict position,
+    float interpolationFactor,
     float const * restrict light,
     float const * restrict water)
 {
+    //
+    // These buffers are re-uploaded in their entirety at each frame, hence we orphan
+    // their storage first: the driver hands us new storage while the GPU may still be
+    // drawing the previous frame out of the old one, rather than making us wait for it
+    //
+
     // Upload positions
     glBindBuffer(GL_ARRAY_BUFFER, *mPointPositionVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(vec2f), position);
+    glBufferData(GL_ARRAY_BUFFER, mPointCount * sizeof(vec2f), nullptr, GL_DYNAMIC_DRAW);
+    if (interpolationFactor >= 1.0f)
+    {
+        // Nothing to interpolate
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(vec2f), position);
+    }
+    else
+    {
+        // Interpolate straight into the buffer's storage
+        auto mappedBuffer = GameOpenGL::MapBuffer<GL_ARRAY_BUFFER>(GL_WRITE_ONLY);
+        vec2f * restrict interpolatedPosition = static_cast<vec2f *>(*mappedBuffer);
+
+        for (size_t p = 0; p < mPointCount; ++p)
+        {
+            interpolatedPosition[p] =
+                previousPosition[p]
+                + (position[p] - previousPosition[p]) * interpolationFactor;
+        }
+
+        GameOpenGL::UnmapBuffer(std::move(mappedBuffer));
+    }
     CheckOpenGLError();
 
     // Upload light
     glBindBuffer(GL_ARRAY_BUFFER, *mPointLightVBO);
+    glBufferData(GL_ARRAY_BUFFER, mPointCount * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
     glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(float), light);
     CheckOpenGLError();
 
     // Upload water
     glBindBuffer(GL_ARRAY_BUFFER, *mPointWaterVBO);
+    glBufferData(GL_ARRAY_BUFFER, mPointCount * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
     glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(float), water);
     CheckOpenGLError();
 }
 
 void ShipRenderContext::UploadElementsStart()
 {
-    GLuint elementVBO;
-
-    if (mConnectedComponentsMaxSizes.size() != mConnectedComponents.size())
-    {
-        // A change in the number of connected components, nuke everything
-        mConnectedComponents.clear();
-        mConnectedComponents.resize(mConnectedComponentsMaxSizes.size());
-    }
-
-    for (size_t c = 0; c < mConnectedComponentsMaxSizes.size(); ++c)
-    {
-        //
-        // Prepare point elements
-        //
-
-        // Max # of points = number of points
-        size_t maxConnectedComponentPoints = mConnectedComponentsMaxSizes[c];
-        if (mConnectedComponents[c].pointElementMaxCount != maxConnectedComponentPoints)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].pointElementBuffer.reset();
-            mConnectedComponents[c].pointElementBuffer.reset(new PointElement[maxConnectedComponentPoints]);
-            mConnectedComponents[c].pointElementMaxCount = maxConnectedComponentPoints;
-        }
-
-        mConnectedComponents[c].pointElementCount = 0;
-
-        if (!mConnectedComponents[c].pointElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].pointElementVBO = elementVBO;
-        }
-
-        //
-        // Prepare spring elements
-        //
-
-        size_t maxConnectedComponentSprings = mConnectedComponentsMaxSizes[c] * GameParameters::MaxSpringsPerPoint;
-        if (mConnectedComponents[c].springElementMaxCount != maxConnectedComponentSprings)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].springElementBuffer.reset();
-            mConnectedComponents[c].springElementBuffer.reset(new SpringElement[maxConnectedComponentSprings]);
-            mConnectedComponents[c].springElementMaxCount = maxConnectedComponentSprings;
-        }
-
-        mConnectedComponents[c].springElementCount = 0;
-
-        if (!mConnectedComponents[c].springElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].springElementVBO = elementVBO;
-        }
-
-        //
-        // Prepare rope elements
-        //
-
-        // Max # of ropes = max number of springs
-        size_t maxConnectedComponentRopes = maxConnectedComponentSprings;
-        if (mConnectedComponents[c].ropeElementMaxCount != maxConnectedComponentRopes)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].ropeElementBuffer.reset();
-            mConnectedComponents[c].ropeElementBuffer.reset(new RopeElement[maxConnectedComponentRopes]);
-            mConnectedComponents[c].ropeElementMaxCount = maxConnectedComponentRopes;
-        }
-
-        mConnectedComponents[c].ropeElementCount = 0;
-
-        if (!mConnectedComponents[c].ropeElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].ropeElementVBO = elementVBO;
-        }
-
-        //
-        // Prepare triangle elements
-        //
-
-        size_t maxConnectedComponentTriangles = mConnectedComponentsMaxSizes[c] * GameParameters::MaxTrianglesPerPoint;
-        if (mConnectedComponents[c].triangleElementMaxCount != maxConnectedComponentTriangles)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].triangleElementBuffer.reset();
-            mConnectedComponents[c].triangleElementBuffer.reset(new TriangleElement[maxConnectedComponentTriangles]);
-            mConnectedComponents[c].triangleElementMaxCount = maxConnectedComponentTriangles;
-        }
-
-        mConnectedComponents[c].triangleElementCount = 0;
-
-        if (!mConnectedComponents[c].triangleElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].triangleElementVBO = elementVBO;
-        }
-
-        //
-        // Prepare stressed spring elements
-        //
-
-        // Max # of stressed springs = max number of springs
-        size_t maxConnectedComponentStressedSprings = maxConnectedComponentSprings;
-        if (mConnectedComponents[c].stressedSpringElementMaxCount != maxConnectedComponentStressedSprings)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].stressedSpringElementBuffer.reset();
-            mConnectedComponents[c].stressedSpringElementBuffer.reset(new StressedSpringElement[maxConnectedComponentStressedSprings]);
-            mConnectedComponents[c].stressedSpringElementMaxCount = maxConnectedComponentStressedSprings;
-        }
-
-        mConnectedComponents[c].stressedSpringElementCount = 0;
-
-        if (!mConnectedComponents[c].stressedSpringElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].stressedSpringElementVBO = elementVBO;
-        }
-    }
+    mPointElementBuffer.Reset(mConnectedComponentsMaxSizes.size());
+    mSpringElementBuffer.Reset(mConnectedComponentsMaxSizes.size());
+    mRopeElementBuffer.Reset(mConnectedComponentsMaxSizes.size());
+    mTriangleElementBuffer.Reset(mConnectedComponentsMaxSizes.size());
 }
 
 void ShipRenderContext::UploadElementsEnd()
@@ -568,37 +502,26 @@ void ShipRenderContext::UploadElementsEnd()
     // Upload all elements, except for stressed springs
     //
 
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
-    {
-        // Points
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].pointElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].pointElementCount * sizeof(PointElement), mConnectedComponents[c].pointElementBuffer.get(), GL_STATIC_DRAW);
-        CheckOpenGLError();
-
-        // Springs
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].springElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].springElementCount * sizeof(SpringElement), mConnectedComponents[c].springElementBuffer.get(), GL_STATIC_DRAW);
-        CheckOpenGLError();
+    UploadElementBuffer(mPointElementBuffer, GL_STATIC_DRAW);
+    UploadElementBuffer(mSpringElementBuffer, GL_STATIC_DRAW);
+    UploadElementBuffer(mRopeElementBuffer, GL_STATIC_DRAW);
+    UploadElementBuffer(mTriangleElementBuffer, GL_STATIC_DRAW);
+}
 
-        // Ropes
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].ropeElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].ropeElementCount * sizeof(RopeElement), mConnectedComponents[c].ropeElementBuffer.get(), GL_STATIC_DRAW);
-        CheckOpenGLError();
+void ShipRenderContext::UploadElementUpdatesEnd()
+{
+    //
+    // Upload the changes to springs, ropes, and triangles
+    //
 
-        // Triangles
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].triangleElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].triangleElementCount * sizeof(TriangleElement), mConnectedComponents[c].triangleElementBuffer.get(), GL_STATIC_DRAW);
-        CheckOpenGLError();
-    }
+    UploadElementBufferUpdates(mSpringElementBuffer, GL_STATIC_DRAW);
+    UploadElementBufferUpdates(mRopeElementBuffer, GL_STATIC_DRAW);
+    UploadElementBufferUpdates(mTriangleElementBuffer, GL_STATIC_DRAW);
 }
 
 void ShipRenderContext::UploadElementStressedSpringsStart()
 {
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
-    {
-        // Zero-out count of stressed springs
-        mConnectedComponents[c].stressedSpringElementCount = 0;
-    }
+    mStressedSpringElementBuffer.Reset(mConnectedComponentsMaxSizes.size());
 }
 
 void ShipRenderContext::UploadElementStressedSpringsEnd()
@@ -607,12 +530,7 @@ void ShipRenderContext::UploadElementStressedSpringsEnd()
     // Upload stressed spring elements
     //
 
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
-    {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].stressedSpringElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].stressedSpringElementCount * sizeof(StressedSpringElement), mConnectedComponents[c].stressedSpringElementBuffer.get(), GL_DYNAMIC_DRAW);
-        CheckOpenGLError();
-    }
+    UploadElementBuffer(mStressedSpringElementBuffer, GL_DYNAMIC_DRAW);
 }
 
 void ShipRenderContext::UploadEphemeralPointsStart()
@@ -633,7 +551,9 @@ void ShipRenderContext::UploadEphemeralPointsEnd()
 
 void ShipRenderContext::UploadVectors(
     size_t count,
+    vec2f const * restrict previousPosition,
     vec2f const * restrict position,
+    float interpolationFactor,
     vec2f const * restrict vector,
     float lengthAdjustment,
     vec4f const & color)
@@ -656,9 +576,10 @@ void ShipRenderContext::UploadVectors(
 
     for (size_t i = 0; i < count; ++i)
     {
-        // Stem
-        vec2f stemEndpoint = position[i] + vector[i] * lengthAdjustment;
-        mVectorArrowPointPositionBuffer.push_back(position[i]);
+        // Stem, rooted where the point is rendered
+        vec2f const stemStartpoint = previousPosition[i] + (position[i] - previousPosition[i]) * interpolationFactor;
+        vec2f stemEndpoint = stemStartpoint + vector[i] * lengthAdjustment;
+        mVectorArrowPointPositionBuffer.push_back(stemStartpoint);
         mVectorArrowPointPositionBuffer.push_back(stemEndpoint);
 
         // Left
@@ -689,7 +610,7 @@ void ShipRenderContext::UploadVectors(
     mVectorArrowColor = color;
 }
 
-void ShipRenderContext::RenderEnd()
+void ShipRenderContext::Draw()
 {
     //
     // Disable vertex attribute 0, as we won't use it in here (it's all dedicated)
@@ -702,7 +623,7 @@ void ShipRenderContext::RenderEnd()
     // Process all connected components, from first to last, and draw all elements
     //
 
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
+    for (size_t c = 0; c < mConnectedComponentsMaxSizes.size(); ++c)
     {
         //
         // Draw points
@@ -710,7 +631,7 @@ void ShipRenderContext::RenderEnd()
 
         if (mDebugShipRenderMode == DebugShipRenderMode::Points)
         {
-            RenderPointElements(mConnectedComponents[c]);
+            RenderPointElements(c);
         }
 
 
@@ -730,7 +651,7 @@ void ShipRenderContext::RenderEnd()
                 && (mShipRenderMode == ShipRenderMode::Structure || mShipRenderMode == ShipRenderMode::Texture)))
         {
             RenderSpringElements(
-                mConnectedComponents[c],
+                c,
                 mDebugShipRenderMode == DebugShipRenderMode::None && mShipRenderMode == ShipRenderMode::Texture);
         }
 
@@ -745,7 +666,7 @@ void ShipRenderContext::RenderEnd()
             || mDebugShipRenderMode == DebugShipRenderMode::EdgeSprings
             || (mDebugShipRenderMode == DebugShipRenderMode::None && mShipRenderMode == ShipRenderMode::Texture))
         {
-            RenderRopeElements(mConnectedComponents[c]);
+            RenderRopeElements(c);
         }
 
 
@@ -758,7 +679,7 @@ void ShipRenderContext::RenderEnd()
                 && (mShipRenderMode == ShipRenderMode::Structure || mShipRenderMode == ShipRenderMode::Texture)))
         {
             RenderTriangleElements(
-                mConnectedComponents[c],
+                c,
                 mShipRenderMode == ShipRenderMode::Texture);
         }
 
@@ -771,7 +692,7 @@ void ShipRenderContext::RenderEnd()
         if (mDebugShipRenderMode == DebugShipRenderMode::None
             && mShipRenderMode == ShipRenderMode::Structure)
         {
-            RenderRopeElements(mConnectedComponents[c]);
+            RenderRopeElements(c);
         }
 
 
@@ -782,7 +703,7 @@ void ShipRenderContext::RenderEnd()
         if (mDebugShipRenderMode == DebugShipRenderMode::None
             && mShowStressedSprings)
         {
-            RenderStressedSpringElements(mConnectedComponents[c]);
+            RenderStressedSpringElements(c);
         }
 
 
@@ -797,7 +718,7 @@ void ShipRenderContext::RenderEnd()
     }
 
     // Update stats
-    mRenderStatistics.LastRenderedShipConnectedComponents += mConnectedComponents.size();
+    mRenderStatistics.LastRenderedShipConnectedComponents += mConnectedComponentsMaxSizes.size();
 
 
     //
@@ -819,7 +740,106 @@ void ShipRenderContext::RenderEnd()
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void ShipRenderContext::RenderPointElements(ConnectedComponentData const & connectedComponent)
+template<typename TElement>
+void ShipRenderContext::UploadElementBuffer(
+    ElementBuffer<TElement> & elementBuffer,
+    GLenum usage)
+{
+    elementBuffer.Pack();
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *elementBuffer.mVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementBuffer.mElements.size() * sizeof(TElement), elementBuffer.mElements.data(), usage);
+    CheckOpenGLError();
+}
+
+template<typename TElement>
+void ShipRenderContext::UploadElementBufferUpdates(
+    ElementBuffer<TElement> & elementBuffer,
+    GLenum usage)
+{
+    // Coalesce dirty slots that are this close to each other into a single upload
+    static constexpr size_t MaxDirtySlotGap = 64;
+
+    if (elementBuffer.mDirtySlots.empty() && !elementBuffer.mIsLayoutDirty)
+        return;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *elementBuffer.mVBO);
+
+    if (elementBuffer.mIsLayoutDirty)
+    {
+        //
+        // The ranges have moved to make room for new elements; upload the whole buffer
+        //
+
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementBuffer.mElements.size() * sizeof(TElement), elementBuffer.mElements.data(), usage);
+        CheckOpenGLError();
+
+        elementBuffer.mIsLayoutDirty = false;
+    }
+    else
+    {
+        //
+        // Upload the runs of dirty slots
+        //
+
+        auto & dirtySlots = elementBuffer.mDirtySlots;
+        std::sort(dirtySlots.begin(), dirtySlots.end());
+
+        size_t runStart = dirtySlots[0];
+        size_t runEnd = runStart + 1;
+        for (size_t d = 1; d <= dirtySlots.size(); ++d)
+        {
+            if (d == dirtySlots.size()
+                || dirtySlots[d] > runEnd + MaxDirtySlotGap)
+            {
+                glBufferSubData(
+                    GL_ELEMENT_ARRAY_BUFFER,
+                    runStart * sizeof(TElement),
+                    (runEnd - runStart) * sizeof(TElement),
+                    &(elementBuffer.mElements[runStart]));
+
+                if (d < dirtySlots.size())
+                {
+                    runStart = dirtySlots[d];
+                    runEnd = runStart + 1;
+                }
+            }
+            else
+            {
+                runEnd = std::max(runEnd, static_cast<size_t>(dirtySlots[d]) + 1);
+            }
+        }
+
+        CheckOpenGLError();
+    }
+
+    elementBuffer.mDirtySlots.clear();
+}
+
+template<typename TElement>
+void ShipRenderContext::DrawElementBuffer(
+    ElementBuffer<TElement> const & elementBuffer,
+    size_t connectedComponentIndex,
+    GLenum mode)
+{
+    auto const range = elementBuffer.GetRange(connectedComponentIndex);
+    if (range.second == 0)
+        return;
+
+    // Bind VBO
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *elementBuffer.mVBO);
+    CheckOpenGLError();
+
+    // Draw the range of the connected component
+    glDrawElements(
+        mode,
+        static_cast<GLsizei>(range.second * ElementBuffer<TElement>::IndicesPerElement),
+        GL_UNSIGNED_INT,
+        reinterpret_cast<void const *>(range.first * sizeof(TElement)));
+    CheckOpenGLError();
+}
+
+void ShipRenderContext::RenderPointElements(size_t connectedComponentIndex)
 {
     // Use color program
     mShaderManager.ActivateProgram<ProgramType::ShipTrianglesColor>();
@@ -827,16 +847,12 @@ void ShipRenderContext::RenderPointElements(ConnectedComponentData const & conne
     // Set point size
     glPointSize(0.2f * 2.0f * mCanvasToVisibleWorldHeightRatio);
 
-    // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.pointElementVBO);
-    CheckOpenGLError();
-
     // Draw
-    glDrawElements(GL_POINTS, static_cast<GLsizei>(1 * connectedComponent.pointElementCount), GL_UNSIGNED_INT, 0);
+    DrawElementBuffer(mPointElementBuffer, connectedComponentIndex, GL_POINTS);
 }
 
 void ShipRenderContext::RenderSpringElements(
-    ConnectedComponentData const & connectedComponent,
+    size_t connectedComponentIndex,
     bool withTexture)
 {
     if (withTexture && !!mElementShipTexture)
@@ -858,20 +874,16 @@ void ShipRenderContext::RenderSpringElements(
     // Set line size
     glLineWidth(0.1f * 2.0f * mCanvasToVisibleWorldHeightRatio);
 
-    // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.springElementVBO);
-    CheckOpenGLError();
-
     // Draw
-    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * connectedComponent.springElementCount), GL_UNSIGNED_INT, 0);
+    DrawElementBuffer(mSpringElementBuffer, connectedComponentIndex, GL_LINES);
 
     // Update stats
-    mRenderStatistics.LastRenderedShipSprings += connectedComponent.springElementCount;
+    mRenderStatistics.LastRenderedShipSprings += mSpringElementBuffer.GetElementCount(connectedComponentIndex);
 }
 
-void ShipRenderContext::RenderRopeElements(ConnectedComponentData const & connectedComponent)
+void ShipRenderContext::RenderRopeElements(size_t connectedComponentIndex)
 {
-    if (connectedComponent.ropeElementCount > 0)
+    if (mRopeElementBuffer.GetElementCount(connectedComponentIndex) > 0)
     {
         // Use rope program
         mShaderManager.ActivateProgram<ProgramType::ShipRopes>();
@@ -879,17 +891,13 @@ void ShipRenderContext::RenderRopeElements(ConnectedComponentData const & connec
         // Set line size
         glLineWidth(0.1f * 2.0f * mCanvasToVisibleWorldHeightRatio);
 
-        // Bind VBO
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.ropeElementVBO);
-        CheckOpenGLError();
-
         // Draw
-        glDrawElements(GL_LINES, static_cast<GLsizei>(2 * connectedComponent.ropeElementCount), GL_UNSIGNED_INT, 0);
+        DrawElementBuffer(mRopeElementBuffer, connectedComponentIndex, GL_LINES);
     }
 }
 
 void ShipRenderContext::RenderTriangleElements(
-    ConnectedComponentData const & connectedComponent,
+    size_t connectedComponentIndex,
     bool withTexture)
 {
     if (withTexture && !!mElementShipTexture)
@@ -910,20 +918,16 @@ void ShipRenderContext::RenderTriangleElements(
     if (mDebugShipRenderMode == DebugShipRenderMode::Wireframe)
         glLineWidth(0.1f);
 
-    // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.triangleElementVBO);
-    CheckOpenGLError();
-
     // Draw
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(3 * connectedComponent.triangleElementCount), GL_UNSIGNED_INT, 0);
+    DrawElementBuffer(mTriangleElementBuffer, connectedComponentIndex, GL_TRIANGLES);
 
     // Update stats
-    mRenderStatistics.LastRenderedShipTriangles += connectedComponent.triangleElementCount;
+    mRenderStatistics.LastRenderedShipTriangles += mTriangleElementBuffer.GetElementCount(connectedComponentIndex);
 }
 
-void ShipRenderContext::RenderStressedSpringElements(ConnectedComponentData const & connectedComponent)
+void ShipRenderContext::RenderStressedSpringElements(size_t connectedComponentIndex)
 {
-    if (connectedComponent.stressedSpringElementCount > 0)
+    if (mStressedSpringElementBuffer.GetElementCount(connectedComponentIndex) > 0)
     {
         // Use program
         mShaderManager.ActivateProgram<ProgramType::ShipStressedSprings>();
@@ -936,12 +940,8 @@ void ShipRenderContext::RenderStressedSpringElements(ConnectedComponentData cons
         glBindTexture(GL_TEXTURE_2D, *mElementStressedSpringTexture);
         CheckOpenGLError();
 
-        // Bind VBO
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.stressedSpringElementVBO);
-        CheckOpenGLError();
-
         // Draw
-        glDrawElements(GL_LINES, static_cast<GLsizei>(2 * connectedComponent.stressedSpringElementCount), GL_UNSIGNED_INT, 0);
+        DrawElementBuffer(mStressedSpringElementBuffer, connectedComponentIndex, GL_LINES);
     }
 }
 
@@ -17,11 +17,15 @@
 #include <GameCore/SysSpecifics.h>
 #include <GameCore/Vectors.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Render {
@@ -77,7 +81,7 @@ public:
 
 public:
 
-    void RenderStart(std::vector<std::size_t> const & connectedComponentsMaxSizes);
+    void UploadStart(std::vector<std::size_t> const & connectedComponentsMaxSizes);
 
     //
     // Points
@@ -92,8 +96,14 @@ public:
         size_t startIndex,
         size_t count);
 
+    /*
+     * Positions are uploaded at interpolationFactor of the way between
+     * the previous and the current positions.
+     */
     void UploadPoints(
+        vec2f const * restrict previousPosition,
         vec2f const * restrict position,
+        float interpolationFactor,
         float const * restrict light,
         float const * restrict water);
 
@@ -108,75 +118,83 @@ public:
         int pointIndex,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
-
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].pointElementCount + 1u <= mConnectedComponents[connectedComponentIndex].pointElementMaxCount);
-
-        PointElement * const pointElement = &(mConnectedComponents[connectedComponentIndex].pointElementBuffer[mConnectedComponents[connectedComponentIndex].pointElementCount]);
-
-        pointElement->pointIndex = pointIndex;
-
-        ++(mConnectedComponents[connectedComponentIndex].pointElementCount);
+        mPointElementBuffer.Add(
+            { pointIndex },
+            connectedComponentId - 1);
     }
 
     inline void UploadElementSpring(
+        int springIndex,
         int pointIndex1,
         int pointIndex2,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
-
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].springElementCount + 1u <= mConnectedComponents[connectedComponentIndex].springElementMaxCount);
-
-        SpringElement * const springElement = &(mConnectedComponents[connectedComponentIndex].springElementBuffer[mConnectedComponents[connectedComponentIndex].springElementCount]);
-
-        springElement->pointIndex1 = pointIndex1;
-        springElement->pointIndex2 = pointIndex2;
-
-        ++(mConnectedComponents[connectedComponentIndex].springElementCount);
+        mSpringElementBuffer.Add(
+            { pointIndex1, pointIndex2 },
+            connectedComponentId - 1,
+            springIndex);
     }
 
     inline void UploadElementRope(
+        int springIndex,
         int pointIndex1,
         int pointIndex2,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
-
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].ropeElementCount + 1u <= mConnectedComponents[connectedComponentIndex].ropeElementMaxCount);
-
-        RopeElement * const ropeElement = &(mConnectedComponents[connectedComponentIndex].ropeElementBuffer[mConnectedComponents[connectedComponentIndex].ropeElementCount]);
-
-        ropeElement->pointIndex1 = pointIndex1;
-        ropeElement->pointIndex2 = pointIndex2;
-
-        ++(mConnectedComponents[connectedComponentIndex].ropeElementCount);
+        mRopeElementBuffer.Add(
+            { pointIndex1, pointIndex2 },
+            connectedComponentId - 1,
+            springIndex);
     }
 
     inline void UploadElementTriangle(
+        int triangleIndex,
         int pointIndex1,
         int pointIndex2,
         int pointIndex3,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
+        mTriangleElementBuffer.Add(
+            { pointIndex1, pointIndex2, pointIndex3 },
+            connectedComponentId - 1,
+            triangleIndex);
+    }
 
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].triangleElementCount + 1u <= mConnectedComponents[connectedComponentIndex].triangleElementMaxCount);
+    void UploadElementsEnd();
 
-        TriangleElement * const triangleElement = &(mConnectedComponents[connectedComponentIndex].triangleElementBuffer[mConnectedComponents[connectedComponentIndex].triangleElementCount]);
+    //
+    // Updates to the elements uploaded last time, for as long as connected components
+    // don't change; springs, ropes, and triangles are identified by their element index
+    //
 
-        triangleElement->pointIndex1 = pointIndex1;
-        triangleElement->pointIndex2 = pointIndex2;
-        triangleElement->pointIndex3 = pointIndex3;
+    inline void UpdateElementSpring(
+        int springIndex,
+        int pointIndex1,
+        int pointIndex2,
+        ConnectedComponentId connectedComponentId)
+    {
+        mSpringElementBuffer.Update(
+            { pointIndex1, pointIndex2 },
+            connectedComponentId - 1,
+            springIndex);
+    }
 
-        ++(mConnectedComponents[connectedComponentIndex].triangleElementCount);
+    inline void RemoveElementSpring(int springIndex)
+    {
+        mSpringElementBuffer.Remove(springIndex);
     }
 
-    void UploadElementsEnd();
+    inline void RemoveElementRope(int springIndex)
+    {
+        mRopeElementBuffer.Remove(springIndex);
+    }
+
+    inline void RemoveElementTriangle(int triangleIndex)
+    {
+        mTriangleElementBuffer.Remove(triangleIndex);
+    }
+
+    void UploadElementUpdatesEnd();
 
     void UploadElementStressedSpringsStart();
 
@@ -185,17 +203,9 @@ public:
         int pointIndex2,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
-
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].stressedSpringElementCount + 1u <= mConnectedComponents[connectedComponentIndex].stressedSpringElementMaxCount);
-
-        StressedSpringElement * const stressedSpringElement = &(mConnectedComponents[connectedComponentIndex].stressedSpringElementBuffer[mConnectedComponents[connectedComponentIndex].stressedSpringElementCount]);
-
-        stressedSpringElement->pointIndex1 = pointIndex1;
-        stressedSpringElement->pointIndex2 = pointIndex2;
-
-        ++(mConnectedComponents[connectedComponentIndex].stressedSpringElementCount);
+        mStressedSpringElementBuffer.Add(
+            { pointIndex1, pointIndex2 },
+            connectedComponentId - 1);
     }
 
     void UploadElementStressedSpringsEnd();
@@ -360,31 +370,55 @@ public:
 
     void UploadVectors(
         size_t count,
+        vec2f const * restrict previousPosition,
         vec2f const * restrict position,
+        float interpolationFactor,
         vec2f const * restrict vector,
         float lengthAdjustment,
         vec4f const & color);
 
-    void RenderEnd();
+    /*
+     * Draws what has been uploaded; does not require any upload to have happened since
+     * the last draw.
+     */
+    void Draw();
 
 private:
 
-    struct ConnectedComponentData;
+    template<typename TElement>
+    class ElementBuffer;
+
     struct GenericTextureConnectedComponentData;
 
-    void RenderPointElements(ConnectedComponentData const & connectedComponent);
+    template<typename TElement>
+    static void UploadElementBuffer(
+        ElementBuffer<TElement> & elementBuffer,
+        GLenum usage);
+
+    template<typename TElement>
+    static void UploadElementBufferUpdates(
+        ElementBuffer<TElement> & elementBuffer,
+        GLenum usage);
+
+    template<typename TElement>
+    static void DrawElementBuffer(
+        ElementBuffer<TElement> const & elementBuffer,
+        size_t connectedComponentIndex,
+        GLenum mode);
+
+    void RenderPointElements(size_t connectedComponentIndex);
 
     void RenderSpringElements(
-        ConnectedComponentData const & connectedComponent,
+        size_t connectedComponentIndex,
         bool withTexture);
 
-    void RenderRopeElements(ConnectedComponentData const & connectedComponent);
+    void RenderRopeElements(size_t connectedComponentIndex);
 
     void RenderTriangleElements(
-        ConnectedComponentData const & connectedComponent,
+        size_t connectedComponentIndex,
         bool withTexture);
 
-    void RenderStressedSpringElements(ConnectedComponentData const & connectedComponent);
+    void RenderStressedSpringElements(size_t connectedComponentIndex);
 
     void RenderGenericTextures(GenericTextureConnectedComponentData const & connectedComponent);
 
@@ -532,61 +566,338 @@ struct TextureRenderPolygonVertex
 
 
     //
-    // All the data that belongs to a single connected component
+    // The elements of one type, of all connected components, in a single buffer
+    // in which each connected component has its own range.
+    //
+    // Elements are staged as they are uploaded - in whatever order of connected
+    // components - and they are then packed by connected component, so that the
+    // buffer is exactly as large as the number of elements.
+    //
+    // Elements uploaded with a key may then be updated individually, for as long as
+    // connected components don't change: removed elements are overwritten in place
+    // with a degenerate element, while new elements are appended to the range of
+    // their own connected component, so that they are drawn with it. When a range
+    // has no room left, all ranges are moved apart to make some room; otherwise,
+    // only the slots that have changed are uploaded again.
     //
 
-    struct ConnectedComponentData
+    template<typename TElement>
+    class ElementBuffer
     {
-        size_t pointElementCount;
-        size_t pointElementMaxCount;
-        std::unique_ptr<PointElement[]> pointElementBuffer;
-        GameOpenGLVBO pointElementVBO;
-
-        size_t springElementCount;
-        size_t springElementMaxCount;
-        std::unique_ptr<SpringElement[]> springElementBuffer;
-        GameOpenGLVBO springElementVBO;
-
-        size_t ropeElementCount;
-        size_t ropeElementMaxCount;
-        std::unique_ptr<RopeElement[]> ropeElementBuffer;
-        GameOpenGLVBO ropeElementVBO;
-
-        size_t triangleElementCount;
-        size_t triangleElementMaxCount;
-        std::unique_ptr<TriangleElement[]> triangleElementBuffer;
-        GameOpenGLVBO triangleElementVBO;
-
-        size_t stressedSpringElementCount;
-        size_t stressedSpringElementMaxCount;
-        std::unique_ptr<StressedSpringElement[]> stressedSpringElementBuffer;
-        GameOpenGLVBO stressedSpringElementVBO;
-
-        ConnectedComponentData()
-            : pointElementCount(0)
-            , pointElementMaxCount(0)
-            , pointElementBuffer()
-            , pointElementVBO()
-            , springElementCount(0)
-            , springElementMaxCount(0)
-            , springElementBuffer()
-            , springElementVBO()
-            , ropeElementCount(0)
-            , ropeElementMaxCount(0)
-            , ropeElementBuffer()
-            , ropeElementVBO()
-            , triangleElementCount(0)
-            , triangleElementMaxCount(0)
-            , triangleElementBuffer()
-            , triangleElementVBO()
-            , stressedSpringElementCount(0)
-            , stressedSpringElementMaxCount(0)
-            , stressedSpringElementBuffer()
-            , stressedSpringElementVBO()
+    public:
+
+        static constexpr size_t IndicesPerElement = sizeof(TElement) / sizeof(int);
+
+        static constexpr std::uint32_t NoneSlot = std::numeric_limits<std::uint32_t>::max();
+
+        // The minimum room made for new elements after each range, when making room
+        static constexpr size_t MinRangeRoom = 4;
+
+        ElementBuffer()
+            : mStagedElements()
+            , mStagedConnectedComponentIndices()
+            , mStagedKeys()
+            , mConnectedComponentCounts()
+            , mElements()
+            , mConnectedComponentStarts()
+            , mConnectedComponentEnds()
+            , mKeySlots()
+            , mDirtySlots()
+            , mIsLayoutDirty(false)
+            , mVBO()
         {}
+
+        void Reset(size_t connectedComponentCount)
+        {
+            mStagedElements.clear();
+            mStagedConnectedComponentIndices.clear();
+            mStagedKeys.clear();
+            mConnectedComponentCounts.assign(connectedComponentCount, 0);
+        }
+
+        inline void Add(
+            TElement const & element,
+            size_t connectedComponentIndex)
+        {
+            assert(connectedComponentIndex < mConnectedComponentCounts.size());
+            assert(mStagedKeys.empty());
+
+            mStagedElements.push_back(element);
+            mStagedConnectedComponentIndices.push_back(static_cast<std::uint32_t>(connectedComponentIndex));
+            ++mConnectedComponentCounts[connectedComponentIndex];
+        }
+
+        inline void Add(
+            TElement const & element,
+            size_t connectedComponentIndex,
+            int key)
+        {
+            assert(connectedComponentIndex < mConnectedComponentCounts.size());
+            assert(mStagedKeys.size() == mStagedElements.size());
+
+            mStagedElements.push_back(element);
+            mStagedConnectedComponentIndices.push_back(static_cast<std::uint32_t>(connectedComponentIndex));
+            mStagedKeys.push_back(key);
+            ++mConnectedComponentCounts[connectedComponentIndex];
+        }
+
+        /*
+         * Packs the staged elements by connected component, calculating the
+         * ranges of the connected components along the way.
+         */
+        void Pack()
+        {
+            //
+            // Calculate ranges, from the counts taken while staging
+            //
+
+            mConnectedComponentStarts.resize(mConnectedComponentCounts.size());
+            mConnectedComponentEnds.resize(mConnectedComponentCounts.size());
+
+            size_t elementCount = 0;
+            for (size_t c = 0; c < mConnectedComponentCounts.size(); ++c)
+            {
+                mConnectedComponentStarts[c] = elementCount;
+                elementCount += mConnectedComponentCounts[c];
+                mConnectedComponentEnds[c] = elementCount;
+            }
+
+            assert(elementCount == mStagedElements.size());
+
+            //
+            // Scatter elements to their connected components' ranges,
+            // remembering where keyed elements end up
+            //
+
+            mElements.resize(elementCount);
+
+            std::fill(mKeySlots.begin(), mKeySlots.end(), NoneSlot);
+            mDirtySlots.clear();
+            mIsLayoutDirty = false;
+
+            std::vector<size_t> connectedComponentSlots(mConnectedComponentStarts);
+
+            for (size_t e = 0; e < mStagedElements.size(); ++e)
+            {
+                size_t const slot = connectedComponentSlots[mStagedConnectedComponentIndices[e]]++;
+
+                mElements[slot] = mStagedElements[e];
+
+                if (!mStagedKeys.empty())
+                {
+                    SetKeySlot(mStagedKeys[e], slot);
+                }
+            }
+        }
+
+        /*
+         * Makes the keyed element current, appending it to the range of its
+         * connected component if it's not there.
+         */
+        void Update(
+            TElement const & element,
+            size_t connectedComponentIndex,
+            int key)
+        {
+            assert(connectedComponentIndex < mConnectedComponentCounts.size());
+
+            std::uint32_t slot = GetKeySlot(key);
+            if (NoneSlot == slot)
+            {
+                if (mConnectedComponentEnds[connectedComponentIndex] == GetRangeRoomEnd(connectedComponentIndex))
+                {
+                    MakeRoom();
+                }
+
+                slot = static_cast<std::uint32_t>(mConnectedComponentEnds[connectedComponentIndex]++);
+                mElements[slot] = element;
+                ++mConnectedComponentCounts[connectedComponentIndex];
+
+                SetKeySlot(key, slot);
+            }
+            else
+            {
+                assert(GetConnectedComponentIndex(slot) == connectedComponentIndex);
+
+                mElements[slot] = element;
+            }
+
+            mDirtySlots.push_back(slot);
+        }
+
+        /*
+         * Removes the keyed element, if it's there.
+         */
+        void Remove(int key)
+        {
+            std::uint32_t const slot = GetKeySlot(key);
+            if (NoneSlot != slot)
+            {
+                // Collapse the element onto its first vertex, so that it rasterizes nothing
+                int * const indices = reinterpret_cast<int *>(&(mElements[slot]));
+                for (size_t i = 1; i < IndicesPerElement; ++i)
+                {
+                    indices[i] = indices[0];
+                }
+
+                size_t const c = GetConnectedComponentIndex(slot);
+                assert(mConnectedComponentCounts[c] > 0);
+                --mConnectedComponentCounts[c];
+
+                mKeySlots[key] = NoneSlot;
+                mDirtySlots.push_back(slot);
+            }
+        }
+
+        /*
+         * Returns the first slot and the number of slots of the connected component's range.
+         */
+        std::pair<size_t, size_t> GetRange(size_t connectedComponentIndex) const
+        {
+            assert(connectedComponentIndex < mConnectedComponentStarts.size());
+
+            return std::make_pair(
+                mConnectedComponentStarts[connectedComponentIndex],
+                mConnectedComponentEnds[connectedComponentIndex] - mConnectedComponentStarts[connectedComponentIndex]);
+        }
+
+        /*
+         * Returns the number of live (i.e. not removed) elements of the connected component.
+         */
+        size_t GetElementCount(size_t connectedComponentIndex) const
+        {
+            assert(connectedComponentIndex < mConnectedComponentCounts.size());
+
+            return mConnectedComponentCounts[connectedComponentIndex];
+        }
+
+    private:
+
+        inline std::uint32_t GetKeySlot(int key) const
+        {
+            assert(key >= 0);
+
+            return static_cast<size_t>(key) < mKeySlots.size()
+                ? mKeySlots[key]
+                : NoneSlot;
+        }
+
+        inline void SetKeySlot(
+            int key,
+            size_t slot)
+        {
+            assert(key >= 0);
+
+            if (static_cast<size_t>(key) >= mKeySlots.size())
+                mKeySlots.resize(static_cast<size_t>(key) + 1, NoneSlot);
+
+            mKeySlots[key] = static_cast<std::uint32_t>(slot);
+        }
+
+        inline size_t GetRangeRoomEnd(size_t connectedComponentIndex) const
+        {
+            return (connectedComponentIndex + 1 < mConnectedComponentStarts.size())
+                ? mConnectedComponentStarts[connectedComponentIndex + 1]
+                : mElements.size();
+        }
+
+        inline size_t GetConnectedComponentIndex(size_t slot) const
+        {
+            // The last connected component whose range starts at or before the slot;
+            // ranges that might start at the same slot are empty and have no room,
+            // hence the slot may only belong to the last of them
+            return std::upper_bound(mConnectedComponentStarts.cbegin(), mConnectedComponentStarts.cend(), slot)
+                - mConnectedComponentStarts.cbegin() - 1;
+        }
+
+        /*
+         * Moves the ranges apart, making room after each one for some more elements.
+         */
+        void MakeRoom()
+        {
+            std::vector<size_t> newConnectedComponentStarts(mConnectedComponentStarts.size());
+
+            size_t elementCount = 0;
+            for (size_t c = 0; c < mConnectedComponentStarts.size(); ++c)
+            {
+                newConnectedComponentStarts[c] = elementCount;
+
+                size_t const rangeSize = mConnectedComponentEnds[c] - mConnectedComponentStarts[c];
+                elementCount += rangeSize + std::max(rangeSize / 8, MinRangeRoom);
+            }
+
+            //
+            // Move elements and keys
+            //
+
+            std::vector<TElement> newElements(elementCount);
+
+            for (size_t c = 0; c < mConnectedComponentStarts.size(); ++c)
+            {
+                std::copy(
+                    mElements.cbegin() + mConnectedComponentStarts[c],
+                    mElements.cbegin() + mConnectedComponentEnds[c],
+                    newElements.begin() + newConnectedComponentStarts[c]);
+            }
+
+            for (auto & slot : mKeySlots)
+            {
+                if (NoneSlot != slot)
+                {
+                    size_t const c = GetConnectedComponentIndex(slot);
+                    slot = static_cast<std::uint32_t>(newConnectedComponentStarts[c] + (slot - mConnectedComponentStarts[c]));
+                }
+            }
+
+            for (size_t c = 0; c < mConnectedComponentStarts.size(); ++c)
+            {
+                mConnectedComponentEnds[c] = newConnectedComponentStarts[c] + (mConnectedComponentEnds[c] - mConnectedComponentStarts[c]);
+            }
+
+            mConnectedComponentStarts = std::move(newConnectedComponentStarts);
+            mElements = std::move(newElements);
+
+            // The whole buffer has to be uploaded again
+            mDirtySlots.clear();
+            mIsLayoutDirty = true;
+        }
+
+    private:
+
+        friend class ShipRenderContext;
+
+        // As uploaded
+        std::vector<TElement> mStagedElements;
+        std::vector<std::uint32_t> mStagedConnectedComponentIndices;
+        std::vector<int> mStagedKeys;
+
+        // The number of live elements of each connected component
+        std::vector<size_t> mConnectedComponentCounts;
+
+        // Packed by connected component, with the room - if any - after each range
+        std::vector<TElement> mElements;
+
+        // The first slot of each connected component's range, and the slot after its last element
+        std::vector<size_t> mConnectedComponentStarts;
+        std::vector<size_t> mConnectedComponentEnds;
+
+        // The slot of each keyed element, by key
+        std::vector<std::uint32_t> mKeySlots;
+
+        // The slots changed since the last upload
+        std::vector<std::uint32_t> mDirtySlots;
+
+        // Whether the ranges have moved since the last upload
+        bool mIsLayoutDirty;
+
+        GameOpenGLVBO mVBO;
     };
 
-    std::vector<ConnectedComponentData> mConnectedComponents;
+    ElementBuffer<PointElement> mPointElementBuffer;
+    ElementBuffer<SpringElement> mSpringElementBuffer;
+    ElementBuffer<RopeElement> mRopeElementBuffer;
+    ElementBuffer<TriangleElement> mTriangleElementBuffer;
+    ElementBuffer<StressedSpringElement> mStressedSpringElementBuffer;
 
 
     //
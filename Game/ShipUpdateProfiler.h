@@ -0,0 +1,105 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-13
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/LockFreeRingBuffer.h>
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+/*
+ * Collects the durations of the phases of the updates of a ship.
+ *
+ * Durations are registered by the thread updating the ship, and may be drained
+ * by any other thread, concurrently; durations that are not drained in time are
+ * dropped.
+ */
+class ShipUpdateProfiler
+{
+public:
+
+    /*
+     * Times the phase spanning its lifetime; when not enabled, does nothing at all -
+     * not even reading the clock.
+     */
+    class ScopedPhaseTimer
+    {
+    public:
+
+        ScopedPhaseTimer(
+            ShipUpdateProfiler & profiler,
+            ShipUpdatePhase phase,
+            bool isEnabled)
+            : mProfiler(isEnabled ? &profiler : nullptr)
+            , mPhase(phase)
+            , mStartTime()
+        {
+            if (nullptr != mProfiler)
+                mStartTime = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedPhaseTimer()
+        {
+            if (nullptr != mProfiler)
+                mProfiler->RegisterDuration(mPhase, std::chrono::steady_clock::now() - mStartTime);
+        }
+
+        ScopedPhaseTimer(ScopedPhaseTimer const &) = delete;
+        ScopedPhaseTimer & operator=(ScopedPhaseTimer const &) = delete;
+
+    private:
+
+        ShipUpdateProfiler * const mProfiler;
+        ShipUpdatePhase const mPhase;
+        std::chrono::steady_clock::time_point mStartTime;
+    };
+
+public:
+
+    ShipUpdateProfiler()
+        : mPhaseDurations()
+    {}
+
+    ShipUpdateProfiler(ShipUpdateProfiler const &) = delete;
+    ShipUpdateProfiler & operator=(ShipUpdateProfiler const &) = delete;
+
+    void RegisterDuration(
+        ShipUpdatePhase phase,
+        std::chrono::steady_clock::duration duration)
+    {
+        assert(static_cast<size_t>(phase) < mPhaseDurations.size());
+
+        mPhaseDurations[static_cast<size_t>(phase)].TryPush(
+            std::chrono::duration<float, std::milli>(duration).count());
+    }
+
+    /*
+     * Visits and removes all the durations - in milliseconds - registered for
+     * the specified phase since the last time they were drained.
+     */
+    template<typename TVisitor>
+    void DrainDurations(
+        ShipUpdatePhase phase,
+        TVisitor && visitor)
+    {
+        assert(static_cast<size_t>(phase) < mPhaseDurations.size());
+
+        mPhaseDurations[static_cast<size_t>(phase)].Drain(std::forward<TVisitor>(visitor));
+    }
+
+private:
+
+    // Enough for a few seconds of updates between two drains
+    static constexpr size_t MaxDurationsPerPhase = 256;
+
+    std::array<
+        LockFreeRingBuffer<float, MaxDurationsPerPhase>,
+        static_cast<size_t>(ShipUpdatePhase::_Last) + 1> mPhaseDurations;
+};
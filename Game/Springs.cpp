@@ -5,6 +5,9 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/LibSimdPp.h>
+
+#include <algorithm>
 #include <cmath>
 
 namespace Physics {
@@ -33,16 +36,26 @@ void Springs::Add(
         / 2.0f;
     mStiffnessBuffer.emplace_back(stiffness);
 
-    mRestLengthBuffer.emplace_back((points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length());
+    float const restLength = (points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length();
+    mRestLengthBuffer.emplace_back(restLength);
+    mMaxLength = std::max(mMaxLength, restLength);
+
+    vec2f const displacement = points.GetPosition(pointBIndex) - points.GetPosition(pointAIndex);
+    vec2f const direction = displacement.normalise(restLength);
+    mDirectionXBuffer.emplace_back(direction.x);
+    mDirectionYBuffer.emplace_back(direction.y);
+    mLengthBuffer.emplace_back(restLength);
 
-    mCoefficientsBuffer.emplace_back(
+    mStiffnessCoefficientBuffer.emplace_back(
         CalculateStiffnessCoefficient(
             pointAIndex,
             pointBIndex,
             stiffness,
             mCurrentStiffnessAdjustment,
             mCurrentNumMechanicalDynamicsIterations,
-            points),
+            points));
+
+    mDampingCoefficientBuffer.emplace_back(
         CalculateDampingCoefficient(
             pointAIndex,
             pointBIndex,
@@ -101,8 +114,8 @@ void Springs::Destroy(
     // Zero out our coefficients, so that we can still calculate Hooke's
     // and damping forces for this spring without running the risk of
     // affecting non-deleted points
-    mCoefficientsBuffer[springElementIndex].StiffnessCoefficient = 0.0f;
-    mCoefficientsBuffer[springElementIndex].DampingCoefficient = 0.0f;
+    mStiffnessCoefficientBuffer[springElementIndex] = 0.0f;
+    mDampingCoefficientBuffer[springElementIndex] = 0.0f;
 
     // Flag ourselves as deleted
     mIsDeletedBuffer[springElementIndex] = true;
@@ -121,7 +134,7 @@ void Springs::UpdateGameParameters(
         {
             if (!IsDeleted(i))
             {
-                mCoefficientsBuffer[i].StiffnessCoefficient = CalculateStiffnessCoefficient(
+                mStiffnessCoefficientBuffer[i] = CalculateStiffnessCoefficient(
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     GetStiffness(i),
@@ -129,7 +142,7 @@ void Springs::UpdateGameParameters(
                     numMechanicalDynamicsIterations,
                     points);
 
-                mCoefficientsBuffer[i].DampingCoefficient = CalculateDampingCoefficient(
+                mDampingCoefficientBuffer[i] = CalculateDampingCoefficient(
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     numMechanicalDynamicsIterations,
@@ -163,6 +176,7 @@ void Springs::UploadElements(
             {
                 renderContext.UploadShipElementRope(
                     shipId,
+                    i,
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     points.GetConnectedComponentId(GetPointAIndex(i)));
@@ -171,6 +185,7 @@ void Springs::UploadElements(
             {
                 renderContext.UploadShipElementSpring(
                     shipId,
+                    i,
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     points.GetConnectedComponentId(GetPointAIndex(i)));
@@ -179,6 +194,43 @@ void Springs::UploadElements(
     }
 }
 
+void Springs::UploadElementUpdates(
+    ShipId shipId,
+    Render::RenderContext & renderContext,
+    Points const & points,
+    std::vector<ElementIndex> const & springElementIndices) const
+{
+    // Same criteria as when uploading all springs
+    bool const doUploadAllSprings = (DebugShipRenderMode::Springs == renderContext.GetDebugShipRenderMode());
+
+    for (ElementIndex i : springElementIndices)
+    {
+        if (IsRope(i))
+        {
+            // Ropes never get uncovered, they may only go
+            if (mIsDeletedBuffer[i])
+            {
+                renderContext.RemoveShipElementRope(shipId, i);
+            }
+        }
+        else if (!mIsDeletedBuffer[i]
+            && (mSuperTrianglesBuffer[i].size() < 2 || doUploadAllSprings))
+        {
+            // Might have just been uncovered by a destroyed triangle
+            renderContext.UpdateShipElementSpring(
+                shipId,
+                i,
+                GetPointAIndex(i),
+                GetPointBIndex(i),
+                points.GetConnectedComponentId(GetPointAIndex(i)));
+        }
+        else
+        {
+            renderContext.RemoveShipElementSpring(shipId, i);
+        }
+    }
+}
+
 void Springs::UploadStressedSpringElements(
     ShipId shipId,
     Render::RenderContext & renderContext,
@@ -202,6 +254,75 @@ void Springs::UploadStressedSpringElements(
     }
 }
 
+void Springs::UpdateGeometry(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    Points const & points)
+{
+    //
+    // Packets of four springs at a time; endpoint positions are gathered one spring at a time
+    //
+
+    using float_packet = simdpp::float32<4>;
+    static constexpr ElementIndex PacketSize = 4;
+
+    vec2f const * restrict const positionBuffer = points.GetPositionBufferAsVec2();
+    ElementIndex const * restrict const endpointsBuffer = GetEndpointsBufferAsIndices();
+    float * restrict const directionXBuffer = mDirectionXBuffer.data();
+    float * restrict const directionYBuffer = mDirectionYBuffer.data();
+    float * restrict const lengthBuffer = mLengthBuffer.data();
+
+    ElementIndex s = startSpringIndex;
+    for (; s + PacketSize <= endSpringIndex; s += PacketSize)
+    {
+        // A0, B0, A1, B1, ...
+        ElementIndex const * restrict const endpoints = endpointsBuffer + s * 2;
+
+        float_packet const displacementX =
+            simdpp::make_float(
+                positionBuffer[endpoints[1]].x,
+                positionBuffer[endpoints[3]].x,
+                positionBuffer[endpoints[5]].x,
+                positionBuffer[endpoints[7]].x)
+            - simdpp::make_float(
+                positionBuffer[endpoints[0]].x,
+                positionBuffer[endpoints[2]].x,
+                positionBuffer[endpoints[4]].x,
+                positionBuffer[endpoints[6]].x);
+
+        float_packet const displacementY =
+            simdpp::make_float(
+                positionBuffer[endpoints[1]].y,
+                positionBuffer[endpoints[3]].y,
+                positionBuffer[endpoints[5]].y,
+                positionBuffer[endpoints[7]].y)
+            - simdpp::make_float(
+                positionBuffer[endpoints[0]].y,
+                positionBuffer[endpoints[2]].y,
+                positionBuffer[endpoints[4]].y,
+                positionBuffer[endpoints[6]].y);
+
+        float_packet const length = simdpp::sqrt(displacementX * displacementX + displacementY * displacementY);
+
+        // Zero-length springs have a zero direction
+        simdpp::store_u(directionXBuffer + s, SafeDivide(displacementX, length));
+        simdpp::store_u(directionYBuffer + s, SafeDivide(displacementY, length));
+        simdpp::store_u(lengthBuffer + s, length);
+    }
+
+    // Do the remaining springs
+    for (; s < endSpringIndex; ++s)
+    {
+        vec2f const displacement = positionBuffer[mEndpointsBuffer[s].PointBIndex] - positionBuffer[mEndpointsBuffer[s].PointAIndex];
+        float const length = displacement.length();
+        vec2f const direction = displacement.normalise(length);
+
+        directionXBuffer[s] = direction.x;
+        directionYBuffer[s] = direction.y;
+        lengthBuffer[s] = length;
+    }
+}
+
 bool Springs::UpdateStrains(
     float currentSimulationTime,
     GameParameters const & gameParameters,
@@ -233,6 +354,9 @@ bool Springs::UpdateStrains(
     // Flag remembering whether at least one spring broke
     bool isAtLeastOneBroken = false;
 
+    // The length of the longest spring that survives
+    float maxLength = 0.0f;
+
     // Visit all springs
     for (ElementIndex s : *this)
     {
@@ -240,7 +364,7 @@ bool Springs::UpdateStrains(
         if (!mIsDeletedBuffer[s])
         {
             // Calculate strain
-            float dx = (points.GetPosition(mEndpointsBuffer[s].PointAIndex) - points.GetPosition(mEndpointsBuffer[s].PointBIndex)).length();
+            float const dx = mLengthBuffer[s];
             float const strain = fabs(mRestLengthBuffer[s] - dx) / mRestLengthBuffer[s];
 
             // Check against strength
@@ -270,7 +394,7 @@ bool Springs::UpdateStrains(
                     // Notify stress
                     mGameEventHandler->OnStress(
                         GetBaseStructuralMaterial(s),
-                        mParentWorld.IsUnderwater(points.GetPosition(mEndpointsBuffer[s].PointAIndex)),
+                        points.GetPosition(mEndpointsBuffer[s].PointAIndex).y < points.GetWaterSurfaceHeight(mEndpointsBuffer[s].PointAIndex),
                         1);
                 }
             }
@@ -279,9 +403,16 @@ bool Springs::UpdateStrains(
                 // Just fine
                 mIsStressedBuffer[s] = false;
             }
+
+            if (!mIsDeletedBuffer[s])
+            {
+                maxLength = std::max(maxLength, dx);
+            }
         }
     }
 
+    mMaxLength = maxLength;
+
     return isAtLeastOneBroken;
 }
 
@@ -19,6 +19,7 @@
 #include <cassert>
 #include <functional>
 #include <limits>
+#include <vector>
 
 namespace Physics
 {
@@ -49,6 +50,24 @@ public:
         float /*currentSimulationTime*/,
         GameParameters const &)>;
 
+    /*
+     * A contiguous range of springs of the same "color", i.e. springs that do not
+     * share any endpoints with each other. Springs of the same color may thus be
+     * visited concurrently while updating their endpoints.
+     */
+    struct ColorRange
+    {
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndex; // Excluded
+
+        ColorRange(
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndex)
+            : StartSpringIndex(startSpringIndex)
+            , EndSpringIndex(endSpringIndex)
+        {}
+    };
+
 private:
 
     /*
@@ -69,26 +88,11 @@ private:
 
     using SuperTrianglesVector = FixedSizeVector<ElementIndex, 2>;
 
-    /*
-     * The coefficients used for the spring dynamics.
-     */
-    struct Coefficients
-    {
-        float StiffnessCoefficient;
-        float DampingCoefficient;
-
-        Coefficients(
-            float stiffnessCoefficient,
-            float dampingCoefficient)
-            : StiffnessCoefficient(stiffnessCoefficient)
-            , DampingCoefficient(dampingCoefficient)
-        {}
-    };
-
 public:
 
     Springs(
         ElementCount elementCount,
+        std::vector<ColorRange> colorRanges,
         World & parentWorld,
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         GameParameters const & gameParameters)
@@ -105,7 +109,12 @@ public:
         , mStrengthBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mStiffnessBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mRestLengthBuffer(mBufferElementCount, mElementCount, 1.0f)
-        , mCoefficientsBuffer(mBufferElementCount, mElementCount, Coefficients(0.0f, 0.0f))
+        , mStiffnessCoefficientBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mDampingCoefficientBuffer(mBufferElementCount, mElementCount, 0.0f)
+        // Geometry
+        , mDirectionXBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mDirectionYBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mLengthBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mCharacteristicsBuffer(mBufferElementCount, mElementCount, Characteristics::None)
         , mBaseStructuralMaterialBuffer(mBufferElementCount, mElementCount, nullptr)
         // Water
@@ -117,6 +126,8 @@ public:
         //////////////////////////////////
         // Container
         //////////////////////////////////
+        , mColorRanges(std::move(colorRanges))
+        , mMaxLength(0.0f)
         , mParentWorld(parentWorld)
         , mGameEventHandler(std::move(gameEventHandler))
         , mDestroyHandler()
@@ -180,8 +191,18 @@ public:
             points);
     }
 
+    /*
+     * Calculates the current direction and length of the springs in the specified range,
+     * from the current positions of their endpoints; these stay current until points move.
+     */
+    void UpdateGeometry(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex,
+        Points const & points);
+
     /*
      * Calculates the current strain - due to tension or compression - and acts depending on it.
+     * Uses the current geometry of the springs.
      *
      * Returns true if the spring got broken.
      */
@@ -190,6 +211,15 @@ public:
         GameParameters const & gameParameters,
         Points & points);
 
+    /*
+     * Returns the length of the longest non-deleted spring, as of the last strain update;
+     * used to bound the search for springs intersecting a given area.
+     */
+    float GetMaxLength() const
+    {
+        return mMaxLength;
+    }
+
     //
     // Render
     //
@@ -199,6 +229,16 @@ public:
         Render::RenderContext & renderContext,
         Points const & points) const;
 
+    /*
+     * Uploads the current state of the specified springs, as changes to the
+     * elements uploaded last time; the springs may be specified more than once.
+     */
+    void UploadElementUpdates(
+        ShipId shipId,
+        Render::RenderContext & renderContext,
+        Points const & points,
+        std::vector<ElementIndex> const & springElementIndices) const;
+
     void UploadStressedSpringElements(
         ShipId shipId,
         Render::RenderContext & renderContext,
@@ -206,6 +246,19 @@ public:
 
 public:
 
+    //
+    // Colors
+    //
+
+    /*
+     * Gets the ranges of springs that may be visited concurrently; the ranges are
+     * contiguous and together they cover all springs.
+     */
+    std::vector<ColorRange> const & GetColorRanges() const
+    {
+        return mColorRanges;
+    }
+
     //
     // IsDeleted
     //
@@ -338,12 +391,47 @@ public:
 
     float GetStiffnessCoefficient(ElementIndex springElementIndex) const
     {
-        return mCoefficientsBuffer[springElementIndex].StiffnessCoefficient;
+        return mStiffnessCoefficientBuffer[springElementIndex];
     }
 
     float GetDampingCoefficient(ElementIndex springElementIndex) const
     {
-        return mCoefficientsBuffer[springElementIndex].DampingCoefficient;
+        return mDampingCoefficientBuffer[springElementIndex];
+    }
+
+    //
+    // Geometry
+    //
+
+    /*
+     * The normalized direction of the spring, from A to B, as of the last geometry update.
+     */
+    vec2f GetDirection(ElementIndex springElementIndex) const
+    {
+        return vec2f(mDirectionXBuffer[springElementIndex], mDirectionYBuffer[springElementIndex]);
+    }
+
+    /*
+     * The direction of the spring pointing away from the specified endpoint.
+     */
+    vec2f GetDirectionFrom(
+        ElementIndex springElementIndex,
+        ElementIndex pointIndex) const
+    {
+        assert(pointIndex == mEndpointsBuffer[springElementIndex].PointAIndex
+            || pointIndex == mEndpointsBuffer[springElementIndex].PointBIndex);
+
+        return pointIndex == mEndpointsBuffer[springElementIndex].PointAIndex
+            ? GetDirection(springElementIndex)
+            : -GetDirection(springElementIndex);
+    }
+
+    /*
+     * The length of the spring, as of the last geometry update.
+     */
+    float GetLength(ElementIndex springElementIndex) const
+    {
+        return mLengthBuffer[springElementIndex];
     }
 
     StructuralMaterial const & GetBaseStructuralMaterial(ElementIndex springElementIndex) const
@@ -418,6 +506,49 @@ public:
             *this);
     }
 
+    //
+    // Raw buffers, for vectorized visits
+    //
+
+    /*
+     * Returns the endpoints as a sequence of index pairs: A0, B0, A1, B1, ...
+     */
+    ElementIndex const * restrict GetEndpointsBufferAsIndices() const
+    {
+        static_assert(sizeof(Endpoints) == 2 * sizeof(ElementIndex), "Endpoints must be tightly packed");
+        return reinterpret_cast<ElementIndex const *>(mEndpointsBuffer.data());
+    }
+
+    float const * restrict GetRestLengthBuffer() const
+    {
+        return mRestLengthBuffer.data();
+    }
+
+    float const * restrict GetStiffnessCoefficientBuffer() const
+    {
+        return mStiffnessCoefficientBuffer.data();
+    }
+
+    float const * restrict GetDampingCoefficientBuffer() const
+    {
+        return mDampingCoefficientBuffer.data();
+    }
+
+    float const * restrict GetDirectionXBuffer() const
+    {
+        return mDirectionXBuffer.data();
+    }
+
+    float const * restrict GetDirectionYBuffer() const
+    {
+        return mDirectionYBuffer.data();
+    }
+
+    float const * restrict GetLengthBuffer() const
+    {
+        return mLengthBuffer.data();
+    }
+
     //
     // Temporary buffer
     //
@@ -474,7 +605,23 @@ private:
     Buffer<float> mStrengthBuffer;
     Buffer<float> mStiffnessBuffer;
     Buffer<float> mRestLengthBuffer;
-    Buffer<Coefficients> mCoefficientsBuffer;
+
+    // The coefficients used for the spring dynamics; kept in separate
+    // buffers so that they may be loaded in vectorized packets
+    Buffer<float> mStiffnessCoefficientBuffer;
+    Buffer<float> mDampingCoefficientBuffer;
+
+    //
+    // Geometry
+    //
+
+    // The normalized direction (A -> B) and the length of each spring, calculated once
+    // after points move and shared by all the visits that need them until points move
+    // again; kept in separate buffers so that they may be loaded in vectorized packets
+    Buffer<float> mDirectionXBuffer;
+    Buffer<float> mDirectionYBuffer;
+    Buffer<float> mLengthBuffer;
+
     Buffer<Characteristics> mCharacteristicsBuffer;
     Buffer<StructuralMaterial const *> mBaseStructuralMaterialBuffer;
 
@@ -503,6 +650,12 @@ private:
     // Container
     //////////////////////////////////////////////////////////
 
+    // The spring color partitions, as calculated at build time
+    std::vector<ColorRange> mColorRanges;
+
+    // The length of the longest spring, as of the last strain update
+    float mMaxLength;
+
     World & mParentWorld;
     std::shared_ptr<IGameEventHandler> const mGameEventHandler;
 
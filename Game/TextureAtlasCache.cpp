@@ -0,0 +1,239 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-02-09
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TextureAtlasCache.h"
+
+#include <GameCore/Log.h>
+
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+namespace Render {
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of the file, or the way atlases or their mipmaps are built, changes
+    static constexpr uint32_t CurrentVersion = 1;
+
+    static constexpr char Magic[4] = { 'F', 'S', 'T', 'A' };
+
+    // Follows the header common to all cache files
+    struct Counts
+    {
+        uint64_t FrameCount;
+        uint64_t LevelCount;
+    };
+
+    // The metadata of a frame in the atlas, as stored in a file
+    struct Frame
+    {
+        vec2f TextureCoordinatesBottomLeft;
+        vec2f TextureCoordinatesTopRight;
+        int32_t FrameLeftX;
+        int32_t FrameBottomY;
+        int32_t Width;
+        int32_t Height;
+        float WorldWidth;
+        float WorldHeight;
+        float AnchorWorldX;
+        float AnchorWorldY;
+        uint16_t Group;
+        uint16_t FrameIndex;
+        uint32_t HasOwnAmbientLight;
+    };
+
+    struct Level
+    {
+        int32_t Width;
+        int32_t Height;
+    };
+
+    static_assert(std::is_trivially_copyable<Counts>::value);
+    static_assert(std::is_trivially_copyable<Frame>::value);
+    static_assert(std::is_trivially_copyable<Level>::value);
+    static_assert(std::is_trivially_copyable<rgbaColor>::value);
+
+    size_t GetLevelPixelCount(Level const & level)
+    {
+        return static_cast<size_t>(level.Width) * static_cast<size_t>(level.Height);
+    }
+
+    std::string MakeEntryName(std::string const & atlasName)
+    {
+        return "atlas \"" + atlasName + "\"";
+    }
+}
+
+std::unique_ptr<TextureAtlasCache::CachedAtlas> TextureAtlasCache::TryLoad(
+    std::string const & atlasName,
+    uint64_t key) const
+{
+    auto file = CacheFile::TryOpen(
+        MakeFilepath(atlasName),
+        Magic,
+        CurrentVersion,
+        key,
+        "TextureAtlasCache",
+        MakeEntryName(atlasName));
+
+    if (!file)
+        return nullptr;
+
+    Counts const * const counts = file->Read<Counts>(1);
+    if (nullptr == counts)
+    {
+        file->LogEntryMessage("is truncated");
+        return nullptr;
+    }
+
+    Frame const * const frames = file->Read<Frame>(static_cast<size_t>(counts->FrameCount));
+    Level const * const levels = file->Read<Level>(static_cast<size_t>(counts->LevelCount));
+
+    if (nullptr == frames
+        || nullptr == levels
+        || 0 == counts->LevelCount)
+    {
+        file->LogEntryMessage("has an unexpected size");
+        return nullptr;
+    }
+
+    //
+    // Map levels
+    //
+
+    std::vector<ImageSize> levelSizes;
+    std::vector<rgbaColor const *> levelData;
+
+    for (size_t l = 0; l < counts->LevelCount; ++l)
+    {
+        Level const & level = levels[l];
+
+        rgbaColor const * const data = (level.Width > 0 && level.Height > 0)
+            ? file->Read<rgbaColor>(GetLevelPixelCount(level))
+            : nullptr;
+
+        if (nullptr == data)
+        {
+            file->LogEntryMessage("has an unexpected size");
+            return nullptr;
+        }
+
+        levelSizes.emplace_back(level.Width, level.Height);
+        levelData.emplace_back(data);
+    }
+
+    if (!file->IsAtEnd())
+    {
+        file->LogEntryMessage("has an unexpected size");
+        return nullptr;
+    }
+
+    //
+    // Rebuild metadata
+    //
+
+    std::vector<TextureAtlasFrameMetadata> frameMetadata;
+    frameMetadata.reserve(static_cast<size_t>(counts->FrameCount));
+
+    for (size_t f = 0; f < counts->FrameCount; ++f)
+    {
+        Frame const & frame = frames[f];
+
+        frameMetadata.emplace_back(
+            frame.TextureCoordinatesBottomLeft,
+            frame.TextureCoordinatesTopRight,
+            frame.FrameLeftX,
+            frame.FrameBottomY,
+            TextureFrameMetadata(
+                ImageSize(frame.Width, frame.Height),
+                frame.WorldWidth,
+                frame.WorldHeight,
+                frame.HasOwnAmbientLight != 0,
+                frame.AnchorWorldX,
+                frame.AnchorWorldY,
+                TextureFrameId(
+                    static_cast<TextureGroupType>(frame.Group),
+                    static_cast<TextureFrameIndex>(frame.FrameIndex))));
+    }
+
+    LogMessage("TextureAtlasCache: loaded entry for ", MakeEntryName(atlasName));
+
+    return std::unique_ptr<CachedAtlas>(
+        new CachedAtlas(
+            std::move(file),
+            TextureAtlasMetadata(std::move(frameMetadata)),
+            std::move(levelSizes),
+            std::move(levelData)));
+}
+
+void TextureAtlasCache::Store(
+    std::string const & atlasName,
+    uint64_t key,
+    TextureAtlasMetadata const & metadata,
+    std::vector<RgbaImageData> const & levels) const
+{
+    assert(!levels.empty());
+
+    CacheFile::Store(
+        MakeFilepath(atlasName),
+        Magic,
+        CurrentVersion,
+        key,
+        [&](std::ostream & stream)
+        {
+            auto const & frames = metadata.GetFrameMetadata();
+
+            Counts counts;
+            counts.FrameCount = frames.size();
+            counts.LevelCount = levels.size();
+
+            CacheFile::Write(stream, &counts, 1);
+
+            for (auto const & frameMetadata : frames)
+            {
+                Frame frame;
+                std::memset(&frame, 0, sizeof(Frame));
+                frame.TextureCoordinatesBottomLeft = frameMetadata.TextureCoordinatesBottomLeft;
+                frame.TextureCoordinatesTopRight = frameMetadata.TextureCoordinatesTopRight;
+                frame.FrameLeftX = frameMetadata.FrameLeftX;
+                frame.FrameBottomY = frameMetadata.FrameBottomY;
+                frame.Width = frameMetadata.FrameMetadata.Size.Width;
+                frame.Height = frameMetadata.FrameMetadata.Size.Height;
+                frame.WorldWidth = frameMetadata.FrameMetadata.WorldWidth;
+                frame.WorldHeight = frameMetadata.FrameMetadata.WorldHeight;
+                frame.AnchorWorldX = frameMetadata.FrameMetadata.AnchorWorldX;
+                frame.AnchorWorldY = frameMetadata.FrameMetadata.AnchorWorldY;
+                frame.Group = static_cast<uint16_t>(frameMetadata.FrameMetadata.FrameId.Group);
+                frame.FrameIndex = static_cast<uint16_t>(frameMetadata.FrameMetadata.FrameId.FrameIndex);
+                frame.HasOwnAmbientLight = frameMetadata.FrameMetadata.HasOwnAmbientLight ? 1 : 0;
+
+                CacheFile::Write(stream, &frame, 1);
+            }
+
+            for (auto const & levelImage : levels)
+            {
+                Level const level{ levelImage.Size.Width, levelImage.Size.Height };
+
+                CacheFile::Write(stream, &level, 1);
+            }
+
+            for (auto const & levelImage : levels)
+            {
+                Level const level{ levelImage.Size.Width, levelImage.Size.Height };
+
+                CacheFile::Write(stream, levelImage.Data.get(), GetLevelPixelCount(level));
+            }
+        },
+        "TextureAtlasCache",
+        MakeEntryName(atlasName));
+}
+
+std::filesystem::path TextureAtlasCache::MakeFilepath(std::string const & atlasName) const
+{
+    return mFolderPath / (atlasName + ".atlascache");
+}
+
+}
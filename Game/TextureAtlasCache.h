@@ -0,0 +1,104 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-02-09
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "TextureAtlas.h"
+
+#include <GameCore/Colors.h>
+#include <GameCore/ImageData.h>
+#include <GameCore/CacheFile.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/*
+ * A folder of binary files, one per texture atlas, containing the atlas image - together
+ * with all of its mipmap levels - and the atlas metadata, so that the atlas may be uploaded
+ * straight from the file without decoding, packing, and minifying all of its textures again.
+ *
+ * Each file is keyed by the content hash of the texture database; a file whose key or version
+ * does not match is simply ignored, and eventually overwritten with the new build of the atlas.
+ */
+class TextureAtlasCache
+{
+public:
+
+    /*
+     * An atlas found in the cache; the levels are read straight out of the
+     * file mapped in memory, hence they are only valid while this lives.
+     */
+    class CachedAtlas
+    {
+    public:
+
+        TextureAtlasMetadata const & GetMetadata() const { return mMetadata; }
+
+        size_t GetLevelCount() const { return mLevelSizes.size(); }
+        ImageSize const & GetLevelSize(size_t level) const { return mLevelSizes[level]; }
+        rgbaColor const * GetLevelData(size_t level) const { return mLevelData[level]; }
+
+    private:
+
+        friend class TextureAtlasCache;
+
+        CachedAtlas(
+            std::unique_ptr<CacheFile> file,
+            TextureAtlasMetadata metadata,
+            std::vector<ImageSize> levelSizes,
+            std::vector<rgbaColor const *> levelData)
+            : mFile(std::move(file))
+            , mMetadata(std::move(metadata))
+            , mLevelSizes(std::move(levelSizes))
+            , mLevelData(std::move(levelData))
+        {}
+
+        std::unique_ptr<CacheFile> const mFile;
+
+        TextureAtlasMetadata const mMetadata;
+        std::vector<ImageSize> const mLevelSizes;
+        std::vector<rgbaColor const *> const mLevelData;
+    };
+
+public:
+
+    explicit TextureAtlasCache(std::filesystem::path folderPath)
+        : mFolderPath(std::move(folderPath))
+    {}
+
+    /*
+     * Returns nullptr if the atlas is not in the cache, or if the file in the cache
+     * is for a different key or for a different version of the cache.
+     */
+    std::unique_ptr<CachedAtlas> TryLoad(
+        std::string const & atlasName,
+        uint64_t key) const;
+
+    /*
+     * Stores the specified levels of the atlas, the first one being the atlas image itself.
+     *
+     * Best effort, see CacheFile::Store().
+     */
+    void Store(
+        std::string const & atlasName,
+        uint64_t key,
+        TextureAtlasMetadata const & metadata,
+        std::vector<RgbaImageData> const & levels) const;
+
+private:
+
+    std::filesystem::path MakeFilepath(std::string const & atlasName) const;
+
+private:
+
+    std::filesystem::path const mFolderPath;
+};
+
+}
@@ -10,6 +10,8 @@
 #include <GameCore/GameException.h>
 #include <GameCore/Utils.h>
 
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <regex>
 
@@ -327,10 +329,42 @@ TextureDatabase TextureDatabase::Load(
         throw GameException("Texture database: couldn't match " + std::to_string(allTextureFiles.size()) + " texture files (e.g. \"" + allTextureFiles[0].Stem + "\") to texture specification file");
     }
 
+    //
+    // Calculate content hash, over the specification and the content of all frame files
+    //
+
+    std::string const rootSerialization = root.serialize();
+    uint64_t contentHash = Utils::Hash64(
+        rootSerialization.data(),
+        rootSerialization.size());
+
+    for (auto const & group : textureGroups)
+    {
+        for (auto const & frameSpecification : group.GetFrameSpecifications())
+        {
+            std::ifstream file(frameSpecification.FilePath, std::ios::in | std::ios::binary);
+            if (!file.is_open())
+            {
+                throw GameException("Texture database: cannot open file \"" + frameSpecification.FilePath.string() + "\"");
+            }
+
+            std::vector<char> const fileContent(
+                (std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>());
+
+            contentHash = Utils::Hash64(
+                fileContent.data(),
+                fileContent.size(),
+                contentHash);
+        }
+    }
+
     // Notify progress
     progressCallback(1.0f, "Loading textures...");
 
-    return TextureDatabase(std::move(textureGroups));
+    return TextureDatabase(
+        std::move(textureGroups),
+        contentHash);
 }
 
 }
\ No newline at end of file
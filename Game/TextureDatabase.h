@@ -167,13 +167,26 @@ public:
         return mGroups[static_cast<size_t>(group)].GetFrameSpecifications()[frameIndex].Metadata;
     }
 
+    /*
+     * A hash of the texture specifications and of the content of all frame files;
+     * two databases with the same hash contain the same textures.
+     */
+    uint64_t GetContentHash() const
+    {
+        return mContentHash;
+    }
+
 private:
 
-    explicit TextureDatabase(std::vector<TextureGroup> groups)
+    TextureDatabase(
+        std::vector<TextureGroup> groups,
+        uint64_t contentHash)
         : mGroups(std::move(groups))
+        , mContentHash(contentHash)
     {}
 
     std::vector<TextureGroup> mGroups;
+    uint64_t mContentHash;
 };
 
 }
@@ -243,6 +243,7 @@ void TimerBomb::OnNeighborhoodDisturbed()
 
 void TimerBomb::Upload(
     ShipId shipId,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     switch (mState)
@@ -254,20 +255,20 @@ void TimerBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::TimerBomb, mFuseStepCounter / FuseFramesPerFuseLengthCount),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             renderContext.UploadShipGenericTextureRenderSpecification(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::TimerBombFuse, mFuseFlameFrameIndex),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -277,7 +278,7 @@ void TimerBomb::Upload(
         {
             static constexpr float ShakeOffset = 0.3f;
             vec2f shakenPosition =
-                GetPosition()
+                GetInterpolatedPosition(interpolationFactor)
                 + (0 == (mDetonationLeadInShapeFrameCounter % 2)
                     ? vec2f(-ShakeOffset, 0.0f)
                     : vec2f(ShakeOffset, 0.0f));
@@ -289,7 +290,7 @@ void TimerBomb::Upload(
                 shakenPosition,
                 1.0,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -303,10 +304,10 @@ void TimerBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::TimerBombExplosion, mExplodingStepCounter),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f + static_cast<float>(mExplodingStepCounter + 1) / static_cast<float>(ExplosionStepsCount),
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -318,20 +319,20 @@ void TimerBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::TimerBomb, mFuseStepCounter / FuseFramesPerFuseLengthCount),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             renderContext.UploadShipGenericTextureRenderSpecification(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::TimerBombDefuse, mDefuseStepCounter),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -343,10 +344,10 @@ void TimerBomb::Upload(
                 shipId,
                 GetConnectedComponentId(),
                 TextureFrameId(TextureGroupType::TimerBomb, mFuseStepCounter / FuseFramesPerFuseLengthCount),
-                GetPosition(),
+                GetInterpolatedPosition(interpolationFactor),
                 1.0f,
                 mRotationBaseAxis,
-                GetRotationOffsetAxis(),
+                GetInterpolatedRotationOffsetAxis(interpolationFactor),
                 1.0f);
 
             break;
@@ -68,6 +68,7 @@ public:
 
     virtual void Upload(
         ShipId shipId,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const override;
 
 private:
@@ -49,6 +49,7 @@ void Triangles::UploadElements(
 
             renderContext.UploadShipElementTriangle(
                 shipId,
+                i,
                 GetPointAIndex(i),
                 GetPointBIndex(i),
                 GetPointCIndex(i),
@@ -57,4 +58,18 @@ void Triangles::UploadElements(
     }
 }
 
+void Triangles::UploadElementUpdates(
+    ShipId shipId,
+    Render::RenderContext & renderContext,
+    std::vector<ElementIndex> const & triangleElementIndices) const
+{
+    // Triangles may only go
+    for (ElementIndex i : triangleElementIndices)
+    {
+        assert(mIsDeletedBuffer[i]);
+
+        renderContext.RemoveShipElementTriangle(shipId, i);
+    }
+}
+
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include <cassert>
 #include <functional>
+#include <vector>
 
 namespace Physics
 {
@@ -103,6 +104,15 @@ public:
         Render::RenderContext & renderContext,
         Points const & points) const;
 
+    /*
+     * Uploads the current state of the specified triangles, as changes to the
+     * elements uploaded last time; the triangles may be specified more than once.
+     */
+    void UploadElementUpdates(
+        ShipId shipId,
+        Render::RenderContext & renderContext,
+        std::vector<ElementIndex> const & triangleElementIndices) const;
+
 public:
 
     //
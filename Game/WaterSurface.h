@@ -9,7 +9,11 @@
 
 #include <GameCore/GameMath.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
 
+#include <cassert>
+#include <cstdint>
 #include <memory>
 
 namespace Physics
@@ -37,14 +41,32 @@ public:
         float const absoluteSampleIndexF = x / Dx;
 
         // Integral part
-        int64_t absoluteSampleIndexI = FastFloorInt64(absoluteSampleIndexF);
+        int64_t const absoluteSampleIndexI = FastFloorInt64(absoluteSampleIndexF);
 
+        return SampleAt(
+            x,
+            absoluteSampleIndexI,
+            absoluteSampleIndexF - absoluteSampleIndexI);
+    }
+
+    /*
+     * Same as GetWaterHeightAt(), for the x of each of the specified positions at once.
+     */
+    void GetWaterHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const;
+
+private:
+
+    inline float SampleAt(
+        float x,
+        int64_t absoluteSampleIndexI,
+        float sampleIndexDx) const
+    {
         // Integral part - sample
         int64_t sampleIndexI = absoluteSampleIndexI % SamplesCount;
 
-        // Fractional part within sample index and the next sample index
-        float sampleIndexDx= absoluteSampleIndexF - absoluteSampleIndexI;
-
         if (x < 0.0f)
         {
             // Wrap around and anchor to the left sample
@@ -56,11 +78,9 @@ public:
         assert(sampleIndexDx >= 0.0f && sampleIndexDx <= 1.0f);
 
         return mSamples[sampleIndexI].SampleValue
-             + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
+            + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
-private:
-
     // Spatial frequencies of the wave components
     static constexpr float SpatialFrequency1 = 0.1f;
     static constexpr float SpatialFrequency2 = 0.3f;
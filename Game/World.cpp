@@ -18,7 +18,21 @@ World::World(
     std::shared_ptr<IGameEventHandler> gameEventHandler,
     GameParameters const & gameParameters,
     ResourceLoader & resourceLoader)
+    : World(
+        std::move(gameEventHandler),
+        gameParameters,
+        resourceLoader,
+        TaskThreadPool::GetDefaultParallelism())
+{
+}
+
+World::World(
+    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    GameParameters const & gameParameters,
+    ResourceLoader & resourceLoader,
+    size_t taskThreadPoolParallelism)
     : mAllShips()
+    , mAllShipGameEventBuffers()
     , mStars()
     , mClouds()
     , mWaterSurface()
@@ -27,6 +41,7 @@ World::World(
     , mCurrentSimulationTime(0.0f)
     , mCurrentVisitSequenceNumber(1u)
     , mGameEventHandler(std::move(gameEventHandler))
+    , mTaskThreadPool(taskThreadPoolParallelism)
 {
     // Initialize world pieces
     mStars.Update(gameParameters);
@@ -39,20 +54,27 @@ World::World(
 ShipId World::AddShip(
     ShipDefinition const & shipDefinition,
     MaterialDatabase const & materialDatabase,
+    ShipCache const * shipCache,
     GameParameters const & gameParameters)
 {
     ShipId shipId = static_cast<ShipId>(mAllShips.size()) + 1;
 
+    // The ship fires its events via its own buffer, so that we may
+    // update ships concurrently
+    auto shipGameEventBuffer = std::make_shared<GameEventBuffer>(mGameEventHandler);
+
     auto ship = ShipBuilder::Create(
         shipId,
         *this,
-        mGameEventHandler,
+        shipGameEventBuffer,
         shipDefinition,
         materialDatabase,
+        shipCache,
         gameParameters,
         mCurrentVisitSequenceNumber);
 
     mAllShips.push_back(std::move(ship));
+    mAllShipGameEventBuffers.push_back(std::move(shipGameEventBuffer));
 
     return shipId;
 }
@@ -69,6 +91,13 @@ size_t World::GetShipPointCount(ShipId shipId) const
     return mAllShips[shipId - 1]->GetPointCount();
 }
 
+Ship const & World::GetShip(ShipId shipId) const
+{
+    assert(shipId > 0 && shipId <= mAllShips.size());
+
+    return *(mAllShips[shipId - 1]);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Interactions
 //////////////////////////////////////////////////////////////////////////////
@@ -157,6 +186,14 @@ void World::SwirlAt(
     }
 }
 
+void World::ResetToolForceFields()
+{
+    for (auto & ship : mAllShips)
+    {
+        ship->ResetToolForceField();
+    }
+}
+
 void World::TogglePinAt(
     vec2f const & targetPos,
     GameParameters const & gameParameters)
@@ -361,7 +398,7 @@ void World::QueryNearestPointAt(
 
 void World::Update(
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
     // Update current time
     mCurrentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
@@ -379,52 +416,113 @@ void World::Update(
     mOceanFloor.Update(gameParameters);
 
     // Update all ships
-    for (auto & ship : mAllShips)
+    if (mAllShips.size() <= 1)
     {
-        ship->Update(
-            mCurrentSimulationTime,
-            mCurrentVisitSequenceNumber,
-            gameParameters,
-            renderContext);
+        for (auto & ship : mAllShips)
+        {
+            ship->Update(
+                mCurrentSimulationTime,
+                mCurrentVisitSequenceNumber,
+                gameParameters,
+                vectorFieldRenderMode);
+        }
+    }
+    else
+    {
+        //
+        // Ships are independent from each other, hence we update them concurrently;
+        // ships fire events into their own buffers, which we then publish in ship order,
+        // so that the game event handler sees the same sequence of events it would see
+        // if we updated the ships one after the other
+        //
+
+        std::vector<TaskThreadPool::Task> shipUpdateTasks;
+        shipUpdateTasks.reserve(mAllShips.size());
+
+        for (size_t s = 0; s < mAllShips.size(); ++s)
+        {
+            mAllShipGameEventBuffers[s]->StartBuffering();
+
+            shipUpdateTasks.emplace_back(
+                [this, s, &gameParameters, vectorFieldRenderMode]()
+                {
+                    mAllShips[s]->Update(
+                        mCurrentSimulationTime,
+                        mCurrentVisitSequenceNumber,
+                        gameParameters,
+                        vectorFieldRenderMode);
+                });
+        }
+
+        mTaskThreadPool.Run(shipUpdateTasks);
+
+        for (auto & shipGameEventBuffer : mAllShipGameEventBuffers)
+        {
+            shipGameEventBuffer->PublishAndStopBuffering();
+        }
+    }
+}
+
+void World::PublishShipUpdatePhaseDurations()
+{
+    for (size_t p = 0; p <= static_cast<size_t>(ShipUpdatePhase::_Last); ++p)
+    {
+        ShipUpdatePhase const phase = static_cast<ShipUpdatePhase>(p);
+
+        float totalAverageDuration = 0.0f;
+        bool hasDurations = false;
+
+        for (auto & ship : mAllShips)
+        {
+            float shipTotalDuration = 0.0f;
+            size_t shipDurationCount = 0;
+
+            ship->GetUpdateProfiler().DrainDurations(
+                phase,
+                [&](float duration)
+                {
+                    shipTotalDuration += duration;
+                    ++shipDurationCount;
+                });
+
+            if (shipDurationCount > 0)
+            {
+                totalAverageDuration += shipTotalDuration / static_cast<float>(shipDurationCount);
+                hasDurations = true;
+            }
+        }
+
+        if (hasDurations)
+        {
+            mGameEventHandler->OnShipUpdatePhaseDurationUpdated(
+                phase,
+                totalAverageDuration);
+        }
     }
 }
 
-void World::Render(
+void World::RenderUpload(
     GameParameters const & gameParameters,
+    float interpolationFactor,
     Render::RenderContext & renderContext) const
 {
     // Upload stars
     mStars.Upload(renderContext);
 
-    // Upload land and water data (before clouds and stars are rendered, as the latters
-    // need the water stencil)
+    // Upload land and water data
     UploadLandAndWater(gameParameters, renderContext);
 
-    // Render the clouds (and stars)
-    mClouds.Render(renderContext);
+    // Upload the clouds
+    mClouds.Upload(renderContext);
 
-    // Render the water now, if we want to see the ship through the water
-    if (renderContext.GetShowShipThroughSeaWater())
-    {
-        renderContext.RenderWater();
-    }
-
-    // Render all ships
+    // Upload all ships
     for (auto const & ship : mAllShips)
     {
-        ship->Render(
+        ship->RenderUpload(
             gameParameters,
+            interpolationFactor,
             renderContext);
     }
-
-    // Render the water now, if we want to see the ship *in* the water instead
-    if (!renderContext.GetShowShipThroughSeaWater())
-    {
-        renderContext.RenderWater();
-    }
-
-    // Render the ocean floor
-    renderContext.RenderLand();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
  ***************************************************************************************/
 #pragma once
 
+#include "GameEventBuffer.h"
 #include "GameParameters.h"
 #include "IGameEventHandler.h"
 #include "MaterialDatabase.h"
@@ -14,6 +15,7 @@
 #include "ShipDefinition.h"
 
 #include <GameCore/AABB.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <cstdint>
@@ -21,6 +23,8 @@
 #include <set>
 #include <vector>
 
+class ShipCache;
+
 namespace Physics
 {
 
@@ -33,20 +37,45 @@ public:
         GameParameters const & gameParameters,
         ResourceLoader & resourceLoader);
 
+    /*
+     * Same as above, with ships being built and updated by a task thread pool
+     * with the specified parallelism.
+     */
+    World(
+        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        GameParameters const & gameParameters,
+        ResourceLoader & resourceLoader,
+        size_t taskThreadPoolParallelism);
+
+    /*
+     * The ship cache is optional; when specified, the ship is taken from the cache
+     * if it's there, and stored in the cache otherwise.
+     */
     ShipId AddShip(
         ShipDefinition const & shipDefinition,
         MaterialDatabase const & materialDatabase,
+        ShipCache const * shipCache,
         GameParameters const & gameParameters);
 
     size_t GetShipCount() const;
 
     size_t GetShipPointCount(ShipId shipId) const;
 
+    Ship const & GetShip(ShipId shipId) const;
+
     inline float GetWaterHeightAt(float x) const
     {
         return mWaterSurface.GetWaterHeightAt(x);
     }
 
+    inline void GetWaterHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const
+    {
+        mWaterSurface.GetWaterHeightsAt(positions, heights, count);
+    }
+
     inline bool IsUnderwater(vec2f const & position) const
     {
         return position.y < GetWaterHeightAt(position.x);
@@ -57,11 +86,24 @@ public:
         return mOceanFloor.GetFloorHeightAt(x);
     }
 
+    inline void GetOceanFloorHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const
+    {
+        mOceanFloor.GetFloorHeightsAt(positions, heights, count);
+    }
+
     inline vec2f const & GetCurrentWindSpeed() const
     {
         return mWind.GetCurrentWindSpeed();
     }
 
+    inline TaskThreadPool & GetTaskThreadPool()
+    {
+        return mTaskThreadPool;
+    }
+
     void MoveBy(
         ShipId shipId,
         vec2f const & offset,
@@ -93,6 +135,8 @@ public:
         float strength,
         GameParameters const & gameParameters);
 
+    void ResetToolForceFields();
+
     void TogglePinAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters);
@@ -141,10 +185,25 @@ public:
 
     void Update(
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
-
-    void Render(
+        VectorFieldRenderMode vectorFieldRenderMode);
+
+    /*
+     * Publishes, for each ship update phase, the average duration of the phase
+     * in all the updates profiled since the last publish, summed up across ships.
+     */
+    void PublishShipUpdatePhaseDurations();
+
+    /*
+     * Uploads the current state of the world to the render context; the world
+     * may be updated as soon as this method returns, even while the render
+     * context is drawing what has been uploaded.
+     *
+     * Ships are uploaded at the specified fraction of the way between the
+     * state before their last update and their current state.
+     */
+    void RenderUpload(
         GameParameters const & gameParameters,
+        float interpolationFactor,
         Render::RenderContext & renderContext) const;
 
 private:
@@ -157,6 +216,7 @@ private:
 
     // Repository
     std::vector<std::unique_ptr<Ship>> mAllShips;
+    std::vector<std::shared_ptr<GameEventBuffer>> mAllShipGameEventBuffers; // Parallel to mAllShips
     Stars mStars;
     Clouds mClouds;
     WaterSurface mWaterSurface;
@@ -172,6 +232,9 @@ private:
 
     // The game event handler
     std::shared_ptr<IGameEventHandler> mGameEventHandler;
+
+    // The thread pool shared by all parallel computations in this world
+    TaskThreadPool mTaskThreadPool;
 };
 
 }
@@ -8,6 +8,7 @@
 #include "GameMath.h"
 #include "SysSpecifics.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
@@ -31,7 +32,12 @@ public:
     {
         assert(make_aligned_element_count(size) == size);
 
-        mBuffer = static_cast<TElement *>(aligned_alloc(CeilPowerOfTwo(sizeof(TElement)), size * sizeof(TElement)));
+        // Align at least to the vectorization word, and round the allocation
+        // size to the alignment as aligned_alloc requires
+        size_t const alignment = std::max(CeilPowerOfTwo(sizeof(TElement)), VectorizationWordByteSize);
+        size_t const byteSize = ((size * sizeof(TElement) + alignment - 1) / alignment) * alignment;
+
+        mBuffer = static_cast<TElement *>(aligned_alloc(alignment, byteSize));
         assert(nullptr != mBuffer);
     }
 
@@ -0,0 +1,140 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-02-09
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "CacheFile.h"
+
+#include "GameException.h"
+#include "Log.h"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace /* anonymous */ {
+
+    struct Header
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint64_t Key;
+    };
+
+    static_assert(std::is_trivially_copyable<Header>::value);
+}
+
+std::unique_ptr<CacheFile> CacheFile::TryOpen(
+    std::filesystem::path const & filepath,
+    char const (&magic)[4],
+    uint32_t version,
+    uint64_t key,
+    std::string const & cacheName,
+    std::string const & entryName)
+{
+    if (!std::filesystem::exists(filepath))
+    {
+        LogMessage(cacheName, ": no entry for ", entryName);
+        return nullptr;
+    }
+
+    std::unique_ptr<MemoryMappedFile> file;
+    try
+    {
+        file = MemoryMappedFile::Open(filepath);
+    }
+    catch (GameException const & ex)
+    {
+        LogMessage(cacheName, ": cannot map entry for ", entryName, ": ", ex.what());
+        return nullptr;
+    }
+
+    //
+    // Validate header
+    //
+
+    if (file->GetSize() < sizeof(Header))
+    {
+        LogMessage(cacheName, ": entry for ", entryName, " is truncated");
+        return nullptr;
+    }
+
+    Header header;
+    std::memcpy(&header, file->GetData(), sizeof(Header));
+
+    if (0 != std::memcmp(header.Magic, magic, sizeof(header.Magic))
+        || header.Version != version)
+    {
+        LogMessage(cacheName, ": entry for ", entryName, " is of a different version");
+        return nullptr;
+    }
+
+    if (header.Key != key)
+    {
+        LogMessage(cacheName, ": entry for ", entryName, " is stale");
+        return nullptr;
+    }
+
+    return std::unique_ptr<CacheFile>(
+        new CacheFile(
+            std::move(file),
+            sizeof(Header),
+            cacheName,
+            entryName));
+}
+
+void CacheFile::Store(
+    std::filesystem::path const & filepath,
+    char const (&magic)[4],
+    uint32_t version,
+    uint64_t key,
+    std::function<void(std::ostream &)> const & writeContent,
+    std::string const & cacheName,
+    std::string const & entryName)
+{
+    auto tempFilepath = filepath;
+    tempFilepath += ".tmp";
+
+    try
+    {
+        std::filesystem::create_directories(filepath.parent_path());
+
+        {
+            std::ofstream file(tempFilepath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                throw GameException("Cannot open file \"" + tempFilepath.string() + "\"");
+            }
+
+            Header header;
+            std::memcpy(header.Magic, magic, sizeof(header.Magic));
+            header.Version = version;
+            header.Key = key;
+
+            file.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+
+            writeContent(file);
+
+            if (!file)
+            {
+                throw GameException("Error writing file \"" + tempFilepath.string() + "\"");
+            }
+        }
+
+        std::filesystem::rename(tempFilepath, filepath);
+
+        LogMessage(cacheName, ": stored entry for ", entryName);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage(cacheName, ": cannot store entry for ", entryName, ": ", ex.what());
+
+        std::error_code ec;
+        std::filesystem::remove(tempFilepath, ec);
+    }
+}
+
+void CacheFile::LogEntryMessage(std::string const & message) const
+{
+    LogMessage(mCacheName, ": entry for ", mEntryName, " ", message);
+}
@@ -0,0 +1,116 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-02-09
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "MemoryMappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/*
+ * A binary file in an on-disk cache, beginning with a header made of a magic, a version,
+ * and a key; whatever follows the header is up to the cache.
+ *
+ * An entry is only loaded if its magic, version, and key all match; otherwise it is ignored,
+ * and eventually overwritten. Entries are written to a temporary file first, which is then
+ * renamed, so that a failure half-way never leaves behind a file that looks valid.
+ *
+ * Misses and failures are logged, as "<cache name>: ... <entry name>".
+ */
+class CacheFile
+{
+public:
+
+    /*
+     * Returns nullptr if there is no entry, or if the entry's header does not match.
+     */
+    static std::unique_ptr<CacheFile> TryOpen(
+        std::filesystem::path const & filepath,
+        char const (&magic)[4],
+        uint32_t version,
+        uint64_t key,
+        std::string const & cacheName,
+        std::string const & entryName);
+
+    /*
+     * Best effort: failures are logged and otherwise ignored, as the only
+     * consequence is that the entry will have to be built again next time.
+     */
+    static void Store(
+        std::filesystem::path const & filepath,
+        char const (&magic)[4],
+        uint32_t version,
+        uint64_t key,
+        std::function<void(std::ostream &)> const & writeContent,
+        std::string const & cacheName,
+        std::string const & entryName);
+
+    template<typename TElement>
+    static void Write(
+        std::ostream & stream,
+        TElement const * elements,
+        size_t count)
+    {
+        stream.write(
+            reinterpret_cast<char const *>(elements),
+            static_cast<std::streamsize>(count * sizeof(TElement)));
+    }
+
+    /*
+     * Returns the next count elements, straight out of the file mapped in memory;
+     * returns nullptr if the rest of the file is shorter than that.
+     */
+    template<typename TElement>
+    TElement const * Read(size_t count)
+    {
+        static_assert(sizeof(TElement) % alignof(TElement) == 0);
+
+        size_t const remainingSize = mFile->GetSize() - mPosition;
+
+        // Careful not to overflow with counts that come from a corrupted file
+        if (count > remainingSize / sizeof(TElement))
+            return nullptr;
+
+        TElement const * const elements = reinterpret_cast<TElement const *>(mFile->GetData() + mPosition);
+        mPosition += count * sizeof(TElement);
+
+        return elements;
+    }
+
+    bool IsAtEnd() const
+    {
+        return mPosition == mFile->GetSize();
+    }
+
+    /*
+     * Logs a message about the entry, e.g. "<cache name>: entry for <entry name> has an unexpected size".
+     */
+    void LogEntryMessage(std::string const & message) const;
+
+private:
+
+    CacheFile(
+        std::unique_ptr<MemoryMappedFile> file,
+        size_t position,
+        std::string const & cacheName,
+        std::string const & entryName)
+        : mFile(std::move(file))
+        , mPosition(position)
+        , mCacheName(cacheName)
+        , mEntryName(entryName)
+    {}
+
+    std::unique_ptr<MemoryMappedFile> const mFile;
+    size_t mPosition;
+
+    std::string const mCacheName;
+    std::string const mEntryName;
+};
@@ -9,6 +9,7 @@
 #include <float.h>
 #endif
 
+#include <cfloat>
 #include <limits>
 #include <xmmintrin.h>
 
@@ -28,6 +29,27 @@ inline void EnableFloatingPointFlushToZero()
     _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
 }
 
+inline bool IsFloatingPointFlushToZeroEnabled()
+{
+    return _MM_GET_FLUSH_ZERO_MODE() == _MM_FLUSH_ZERO_ON;
+}
+
+/*
+ * The floating point mode - flush-to-zero, exception masks, and rounding - is
+ * per-thread; these allow a thread to adopt the mode of another thread.
+ */
+
+inline unsigned int GetFloatingPointMode()
+{
+    // Exclude the sticky exception flags, which are status rather than mode
+    return _mm_getcsr() & ~static_cast<unsigned int>(_MM_EXCEPT_MASK);
+}
+
+inline void SetFloatingPointMode(unsigned int mode)
+{
+    _mm_setcsr(mode);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Shamelessly lifted from GTest.
 //
@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include <random>
 /*
  * The random engine for the entire game.
@@ -12,7 +13,10 @@
  * Not so random - always uses the same seed. On purpose! We want two instances
  * of the game to be identical to each other.
  *
- * Singleton.
+ * Singleton; however, code that runs concurrently - such as the update of each ship -
+ * may temporarily replace the instance returned to the current thread with an engine
+ * of its own, so that the sequence of numbers it draws does not depend on thread
+ * scheduling.
  */
 class GameRandomEngine
 {
@@ -20,11 +24,52 @@ public:
 
     static GameRandomEngine & GetInstance()
     {
+        if (nullptr != CurrentThreadInstance)
+            return *CurrentThreadInstance;
+
         static GameRandomEngine * instance = new GameRandomEngine();
 
         return *instance;
     }
 
+    /*
+     * Makes the specified engine the instance returned by GetInstance() on the
+     * current thread, for as long as this object lives.
+     */
+    class ScopedThreadInstance
+    {
+    public:
+
+        explicit ScopedThreadInstance(GameRandomEngine & engine)
+            : mPreviousInstance(CurrentThreadInstance)
+        {
+            CurrentThreadInstance = &engine;
+        }
+
+        ~ScopedThreadInstance()
+        {
+            CurrentThreadInstance = mPreviousInstance;
+        }
+
+        ScopedThreadInstance(ScopedThreadInstance const &) = delete;
+        ScopedThreadInstance & operator=(ScopedThreadInstance const &) = delete;
+
+    private:
+
+        GameRandomEngine * const mPreviousInstance;
+    };
+
+    /*
+     * Creates an engine whose sequence is different from the sequence of the
+     * singleton - and of any other engine created with a different discriminator.
+     */
+    explicit GameRandomEngine(uint32_t seedDiscriminator)
+    {
+        std::seed_seq seed_seq({ 1u, 242u, 19730528u, seedDiscriminator });
+        mRandomEngine = std::ranlux48_base(seed_seq);
+        mRandomUniformDistribution = std::uniform_real_distribution<float>(0.0f, 1.0f);
+    }
+
     /*
      * Returns a value between 0 and count - 1, included.
      */
@@ -112,4 +157,6 @@ private:
 
     std::ranlux48_base mRandomEngine;
     std::uniform_real_distribution<float> mRandomUniformDistribution;
+
+    static inline thread_local GameRandomEngine * CurrentThreadInstance = nullptr;
 };
@@ -8,6 +8,8 @@
 #include "GameException.h"
 #include "Utils.h"
 
+#include <cassert>
+
 DurationShortLongType StrToDurationShortLongType(std::string const & str)
 {
     if (Utils::CaseInsensitiveEquals(str, "Short"))
@@ -18,6 +20,34 @@ DurationShortLongType StrToDurationShortLongType(std::string const & str)
         throw GameException("Unrecognized DurationShortLongType \"" + str + "\"");
 }
 
+std::string ShipUpdatePhaseToStr(ShipUpdatePhase phase)
+{
+    switch (phase)
+    {
+        case ShipUpdatePhase::MechanicalDynamics:
+            return "Mechanical";
+        case ShipUpdatePhase::Bombs:
+            return "Bombs";
+        case ShipUpdatePhase::SpringStrains:
+            return "Strains";
+        case ShipUpdatePhase::ConnectedComponents:
+            return "Components";
+        case ShipUpdatePhase::WaterInflow:
+            return "Water Inflow";
+        case ShipUpdatePhase::WaterVelocities:
+            return "Water Velocities";
+        case ShipUpdatePhase::Electrical:
+            return "Electrical";
+        case ShipUpdatePhase::Light:
+            return "Light";
+        case ShipUpdatePhase::EphemeralParticles:
+            return "Ephemeral";
+    }
+
+    assert(false);
+    return "";
+}
+
 TextureGroupType StrToTextureGroupType(std::string const & str)
 {
     if (Utils::CaseInsensitiveEquals(str, "AirBubble"))
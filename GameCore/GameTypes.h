@@ -141,6 +141,30 @@ enum class DurationShortLongType
 
 DurationShortLongType StrToDurationShortLongType(std::string const & str);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Profiling
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * The phases of the update of a ship that we time when profiling.
+ */
+enum class ShipUpdatePhase : uint32_t
+{
+    MechanicalDynamics = 0,
+    Bombs,
+    SpringStrains,
+    ConnectedComponents,
+    WaterInflow,
+    WaterVelocities,
+    Electrical,
+    Light,
+    EphemeralParticles,
+
+    _Last = EphemeralParticles
+};
+
+std::string ShipUpdatePhaseToStr(ShipUpdatePhase phase);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Rendering
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,52 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-06
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+/*
+ * Single point of inclusion of libsimdpp, so that all code agrees on the
+ * instruction sets that we target.
+ *
+ * We always target SSSE3, and AVX/AVX2 when the compiler is told it may use them
+ * (e.g. /arch:AVX2 on MSVC, or -mavx2 on gcc).
+ */
+
+#if defined(__AVX2__)
+#define SIMDPP_ARCH_X86_AVX2
+#elif defined(__AVX__)
+#define SIMDPP_ARCH_X86_AVX
+#endif
+
+#define SIMDPP_ARCH_X86_SSSE3
+
+#include "simdpp/simd.h"
+
+/*
+ * Divides dividend by divisor, lane by lane, yielding zero in the lanes where the divisor is zero.
+ *
+ * We divide those lanes by one and zero them afterwards, rather than dividing by zero and
+ * masking the result: a division by zero would trap when floating point exceptions are enabled,
+ * as they are in builds with FLOATING_POINT_CHECKS.
+ */
+inline simdpp::float32<4> SafeDivide(
+    simdpp::float32<4> const & dividend,
+    simdpp::float32<4> const & divisor)
+{
+    simdpp::float32<4> const one = simdpp::splat(1.0f);
+    simdpp::mask_float32<4> const validMask = (divisor != 0.0f);
+    simdpp::float32<4> const safeDivisor = simdpp::blend(divisor, one, validMask);
+
+    return simdpp::bit_and(dividend / safeDivisor, validMask);
+}
+
+/*
+ * The scalar counterpart of the above, for the elements left over by whole packets.
+ */
+inline float SafeDivide(
+    float dividend,
+    float divisor)
+{
+    return divisor != 0.0f ? dividend / divisor : 0.0f;
+}
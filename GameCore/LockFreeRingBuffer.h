@@ -0,0 +1,106 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-13
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/*
+ * A fixed-capacity ring buffer that may be written by one thread and read by
+ * another thread, concurrently, without locks.
+ *
+ * Only one thread at a time may push, and only one thread at a time may pop.
+ * When the buffer is full, new elements are dropped - the producer never
+ * waits for the consumer.
+ */
+template<typename TElement, size_t Capacity>
+class LockFreeRingBuffer
+{
+    static_assert(Capacity > 0, "The capacity must be greater than zero");
+
+public:
+
+    LockFreeRingBuffer()
+        : mElements()
+        , mHead(0)
+        , mTail(0)
+    {
+    }
+
+    LockFreeRingBuffer(LockFreeRingBuffer const &) = delete;
+    LockFreeRingBuffer & operator=(LockFreeRingBuffer const &) = delete;
+
+    /*
+     * Producer side; returns false if the element could not be stored
+     * because the buffer is full.
+     */
+    bool TryPush(TElement const & element)
+    {
+        size_t const tail = mTail.load(std::memory_order_relaxed);
+        size_t const nextTail = Next(tail);
+        if (nextTail == mHead.load(std::memory_order_acquire))
+        {
+            // Full
+            return false;
+        }
+
+        mElements[tail] = element;
+        mTail.store(nextTail, std::memory_order_release);
+
+        return true;
+    }
+
+    /*
+     * Consumer side; returns false if the buffer is empty.
+     */
+    bool TryPop(TElement & element)
+    {
+        size_t const head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            // Empty
+            return false;
+        }
+
+        element = mElements[head];
+        mHead.store(Next(head), std::memory_order_release);
+
+        return true;
+    }
+
+    /*
+     * Consumer side; visits and removes all the elements currently in the buffer,
+     * in the order in which they were pushed.
+     */
+    template<typename TVisitor>
+    void Drain(TVisitor && visitor)
+    {
+        TElement element;
+        while (TryPop(element))
+        {
+            visitor(element);
+        }
+    }
+
+private:
+
+    static inline size_t Next(size_t index)
+    {
+        return (index + 1) % (Capacity + 1);
+    }
+
+private:
+
+    // One slot is always left empty, to tell a full buffer apart from an empty one
+    std::array<TElement, Capacity + 1> mElements;
+
+    // The index of the next element to pop - only written by the consumer
+    std::atomic<size_t> mHead;
+
+    // The index of the next slot to push into - only written by the producer
+    std::atomic<size_t> mTail;
+};
@@ -0,0 +1,159 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-20
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "MemoryMappedFile.h"
+
+#include "GameException.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+struct MemoryMappedFile::NativeHandles
+{
+    HANDLE File;
+    HANDLE Mapping;
+};
+
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(std::filesystem::path const & filepath)
+{
+    HANDLE file = ::CreateFileW(
+        filepath.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        NULL);
+
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        throw GameException("Cannot open file \"" + filepath.string() + "\"");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize))
+    {
+        ::CloseHandle(file);
+        throw GameException("Cannot retrieve the size of file \"" + filepath.string() + "\"");
+    }
+
+    if (0 == fileSize.QuadPart)
+    {
+        // Nothing to map
+        return std::unique_ptr<MemoryMappedFile>(
+            new MemoryMappedFile(
+                std::unique_ptr<NativeHandles>(new NativeHandles{ file, NULL }),
+                nullptr,
+                0));
+    }
+
+    HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == mapping)
+    {
+        ::CloseHandle(file);
+        throw GameException("Cannot map file \"" + filepath.string() + "\"");
+    }
+
+    void const * data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (nullptr == data)
+    {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        throw GameException("Cannot map a view of file \"" + filepath.string() + "\"");
+    }
+
+    return std::unique_ptr<MemoryMappedFile>(
+        new MemoryMappedFile(
+            std::unique_ptr<NativeHandles>(new NativeHandles{ file, mapping }),
+            static_cast<std::byte const *>(data),
+            static_cast<size_t>(fileSize.QuadPart)));
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (nullptr != mData)
+        ::UnmapViewOfFile(mData);
+
+    if (NULL != mNativeHandles->Mapping)
+        ::CloseHandle(mNativeHandles->Mapping);
+
+    ::CloseHandle(mNativeHandles->File);
+}
+
+#else
+
+struct MemoryMappedFile::NativeHandles
+{
+    int File;
+};
+
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(std::filesystem::path const & filepath)
+{
+    int const file = ::open(filepath.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw GameException("Cannot open file \"" + filepath.string() + "\"");
+    }
+
+    struct stat fileStat;
+    if (0 != ::fstat(file, &fileStat))
+    {
+        ::close(file);
+        throw GameException("Cannot retrieve the size of file \"" + filepath.string() + "\"");
+    }
+
+    if (0 == fileStat.st_size)
+    {
+        // Nothing to map
+        return std::unique_ptr<MemoryMappedFile>(
+            new MemoryMappedFile(
+                std::unique_ptr<NativeHandles>(new NativeHandles{ file }),
+                nullptr,
+                0));
+    }
+
+    void * data = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (MAP_FAILED == data)
+    {
+        ::close(file);
+        throw GameException("Cannot map file \"" + filepath.string() + "\"");
+    }
+
+    return std::unique_ptr<MemoryMappedFile>(
+        new MemoryMappedFile(
+            std::unique_ptr<NativeHandles>(new NativeHandles{ file }),
+            static_cast<std::byte const *>(data),
+            static_cast<size_t>(fileStat.st_size)));
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (nullptr != mData)
+        ::munmap(const_cast<std::byte *>(mData), mSize);
+
+    ::close(mNativeHandles->File);
+}
+
+#endif
+
+MemoryMappedFile::MemoryMappedFile(
+    std::unique_ptr<NativeHandles> nativeHandles,
+    std::byte const * data,
+    size_t size)
+    : mNativeHandles(std::move(nativeHandles))
+    , mData(data)
+    , mSize(size)
+{
+}
@@ -0,0 +1,54 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-20
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+/*
+ * A read-only view of the whole content of a file, mapped into memory;
+ * the content is paged in by the OS as it is accessed.
+ *
+ * The view is valid for as long as the instance lives.
+ */
+class MemoryMappedFile
+{
+public:
+
+    /*
+     * Throws GameException if the file cannot be opened or mapped.
+     */
+    static std::unique_ptr<MemoryMappedFile> Open(std::filesystem::path const & filepath);
+
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(MemoryMappedFile const &) = delete;
+    MemoryMappedFile & operator=(MemoryMappedFile const &) = delete;
+
+    std::byte const * GetData() const
+    {
+        return mData;
+    }
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+private:
+
+    struct NativeHandles;
+
+    MemoryMappedFile(
+        std::unique_ptr<NativeHandles> nativeHandles,
+        std::byte const * data,
+        size_t size);
+
+    std::unique_ptr<NativeHandles> const mNativeHandles;
+    std::byte const * const mData;
+    size_t const mSize;
+};
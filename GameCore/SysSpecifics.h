@@ -46,6 +46,10 @@ inline void aligned_free(void * ptr)
 // Targeting AVX-512
 static constexpr size_t VectorizationWordSize = 8;
 
+// The alignment of buffers, so that they may be accessed with aligned
+// vectorized loads and stores of a whole word of floats
+static constexpr size_t VectorizationWordByteSize = VectorizationWordSize * sizeof(float);
+
 /*
  * Rounds a number of elements up to the next multiple of the 
  * vectorization word size, to facilitate loops with vectorized code.
@@ -0,0 +1,214 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-05
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TaskThreadPool.h"
+
+#include "FloatingPoint.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+
+TaskThreadPool::TaskThreadPool()
+    : TaskThreadPool(GetDefaultParallelism())
+{
+}
+
+TaskThreadPool::TaskThreadPool(size_t parallelism)
+    : mFloatingPointMode(::GetFloatingPointMode())
+    , mThreads()
+    , mLock()
+    , mTasksAvailableSignal()
+    , mBatchCompletedSignal()
+    , mQueuedBatches()
+    , mIsStop(false)
+{
+    assert(parallelism >= 1);
+
+    // The calling thread is one of the threads doing the work
+    for (size_t t = 1; t < parallelism; ++t)
+    {
+        mThreads.emplace_back(&TaskThreadPool::ThreadLoop, this);
+    }
+
+    LogMessage("TaskThreadPool: created with parallelism=", parallelism);
+}
+
+TaskThreadPool::~TaskThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+
+        mIsStop = true;
+    }
+
+    mTasksAvailableSignal.notify_all();
+
+    for (auto & thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+size_t TaskThreadPool::GetDefaultParallelism()
+{
+    return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1));
+}
+
+void TaskThreadPool::Run(std::vector<Task> const & tasks)
+{
+    if (tasks.empty())
+        return;
+
+    if (mThreads.empty() || tasks.size() == 1)
+    {
+        // Nothing to parallelize
+        for (auto const & task : tasks)
+        {
+            task();
+        }
+
+        return;
+    }
+
+    //
+    // Queue all tasks but the first one, which we run ourselves
+    //
+
+    Batch batch(tasks, 1);
+
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+
+        mQueuedBatches.push_back(&batch);
+    }
+
+    mTasksAvailableSignal.notify_all();
+
+    // The batch and the tasks must outlive the queued tasks, hence we can't
+    // let an exception leave this function before the batch has completed
+    std::exception_ptr firstTaskException;
+    try
+    {
+        tasks[0]();
+    }
+    catch (...)
+    {
+        firstTaskException = std::current_exception();
+    }
+
+    //
+    // Run the tasks of our batch that nobody has started yet, and then
+    // wait for the ones started by other threads to complete
+    //
+
+    std::unique_lock<std::mutex> lock(mLock);
+
+    if (firstTaskException && !batch.FirstException)
+        batch.FirstException = firstTaskException;
+
+    --batch.RemainingTasks;
+
+    while (batch.RemainingTasks > 0)
+    {
+        if (batch.HasUnstartedTasks())
+        {
+            size_t const taskIndex = StartNextTask(batch);
+
+            RunTask(batch, taskIndex, lock);
+        }
+        else
+        {
+            mBatchCompletedSignal.wait(lock);
+        }
+    }
+
+    assert(std::find(mQueuedBatches.cbegin(), mQueuedBatches.cend(), &batch) == mQueuedBatches.cend());
+
+    if (batch.FirstException)
+    {
+        lock.unlock();
+
+        std::rethrow_exception(batch.FirstException);
+    }
+}
+
+void TaskThreadPool::ThreadLoop()
+{
+    // Run tasks with the same floating point mode as our creator's,
+    // i.e. with flush-to-zero and - if enabled - with exceptions
+    SetFloatingPointMode(mFloatingPointMode);
+
+    std::unique_lock<std::mutex> lock(mLock);
+
+    while (true)
+    {
+        mTasksAvailableSignal.wait(
+            lock,
+            [this]()
+            {
+                return mIsStop || !mQueuedBatches.empty();
+            });
+
+        if (mIsStop)
+            break;
+
+        Batch & batch = *(mQueuedBatches.front());
+
+        size_t const taskIndex = StartNextTask(batch);
+
+        RunTask(batch, taskIndex, lock);
+    }
+}
+
+size_t TaskThreadPool::StartNextTask(Batch & batch)
+{
+    assert(batch.HasUnstartedTasks());
+
+    size_t const taskIndex = batch.NextTask++;
+
+    if (!batch.HasUnstartedTasks())
+    {
+        // Nothing left to take from this batch
+        auto const it = std::find(mQueuedBatches.cbegin(), mQueuedBatches.cend(), &batch);
+        assert(it != mQueuedBatches.cend());
+        mQueuedBatches.erase(it);
+    }
+
+    return taskIndex;
+}
+
+void TaskThreadPool::RunTask(
+    Batch & batch,
+    size_t taskIndex,
+    std::unique_lock<std::mutex> & lock)
+{
+    // Run the task without holding the lock
+    lock.unlock();
+
+    std::exception_ptr taskException;
+    try
+    {
+        batch.Tasks[taskIndex]();
+    }
+    catch (...)
+    {
+        // Hand the exception over to the thread that is running the batch
+        taskException = std::current_exception();
+    }
+
+    lock.lock();
+
+    if (taskException && !batch.FirstException)
+        batch.FirstException = taskException;
+
+    assert(batch.RemainingTasks > 0);
+    if (--(batch.RemainingTasks) == 0)
+    {
+        // Wake up whoever is waiting for this batch; since waiters might
+        // be waiting on different batches, we wake all of them up
+        mBatchCompletedSignal.notify_all();
+    }
+}
@@ -0,0 +1,152 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-01-05
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A pool of persistent worker threads that run batches of tasks.
+ *
+ * The thread calling Run() participates in the execution of the batch, and while
+ * waiting for the batch to complete it keeps taking the batch's tasks that no
+ * thread has started yet - but never tasks of other batches, which would delay the
+ * completion of its own batch by an arbitrary amount of unrelated work. Worker
+ * threads take tasks from the batches in the order in which the batches were queued.
+ * Tasks may themselves invoke Run() without deadlocking the pool.
+ *
+ * With a parallelism of one there are no worker threads, and all tasks are simply
+ * run - in order - on the calling thread.
+ *
+ * Worker threads adopt the floating point mode that the thread creating the pool
+ * has at the time of creation, so that tasks behave the same on any thread.
+ */
+class TaskThreadPool
+{
+public:
+
+    using Task = std::function<void()>;
+
+public:
+
+    /*
+     * Creates a pool with the default parallelism.
+     */
+    TaskThreadPool();
+
+    /*
+     * Creates a pool with the specified parallelism, which includes the calling thread.
+     */
+    explicit TaskThreadPool(size_t parallelism);
+
+    ~TaskThreadPool();
+
+    TaskThreadPool(TaskThreadPool const &) = delete;
+    TaskThreadPool(TaskThreadPool &&) = delete;
+    TaskThreadPool & operator=(TaskThreadPool const &) = delete;
+    TaskThreadPool & operator=(TaskThreadPool &&) = delete;
+
+    /*
+     * Gets the parallelism of pools created without specifying one, i.e.
+     * the number of hardware threads.
+     */
+    static size_t GetDefaultParallelism();
+
+    /*
+     * Gets the number of threads - including the calling thread - that may
+     * run tasks concurrently.
+     */
+    size_t GetParallelism() const
+    {
+        return mThreads.size() + 1;
+    }
+
+    /*
+     * Gets the floating point mode that the worker threads run tasks with.
+     */
+    unsigned int GetFloatingPointMode() const
+    {
+        return mFloatingPointMode;
+    }
+
+    /*
+     * Runs all the specified tasks and returns once all of them have completed.
+     *
+     * The tasks are not guaranteed to be run in any specific order nor on any
+     * specific thread - with the exception of the first task, which is always
+     * run on the calling thread.
+     *
+     * Should any task throw, the batch is still run to completion, after which
+     * the first exception thrown by its tasks is rethrown on the calling thread.
+     */
+    void Run(std::vector<Task> const & tasks);
+
+private:
+
+    struct Batch
+    {
+        std::vector<Task> const & Tasks;
+
+        // The index of the first task that no thread has started yet
+        size_t NextTask;
+
+        // The number of tasks that have not completed yet
+        size_t RemainingTasks;
+
+        // The first exception thrown by any of the tasks of this batch
+        std::exception_ptr FirstException;
+
+        Batch(
+            std::vector<Task> const & tasks,
+            size_t nextTask)
+            : Tasks(tasks)
+            , NextTask(nextTask)
+            , RemainingTasks(tasks.size())
+            , FirstException()
+        {}
+
+        bool HasUnstartedTasks() const
+        {
+            return NextTask < Tasks.size();
+        }
+    };
+
+    void ThreadLoop();
+
+    size_t StartNextTask(Batch & batch);
+
+    void RunTask(
+        Batch & batch,
+        size_t taskIndex,
+        std::unique_lock<std::mutex> & lock);
+
+private:
+
+    // The floating point mode of the thread that created us
+    unsigned int const mFloatingPointMode;
+
+    std::vector<std::thread> mThreads;
+
+    // Protects all the members below
+    std::mutex mLock;
+
+    // Signalled when new batches are queued or when we're stopping
+    std::condition_variable mTasksAvailableSignal;
+
+    // Signalled when a batch completes
+    std::condition_variable mBatchCompletedSignal;
+
+    // The batches that have tasks that no thread has started yet
+    std::deque<Batch *> mQueuedBatches;
+
+    bool mIsStop;
+};
@@ -296,6 +296,33 @@ public:
         return std::string("#") + Byte2Hex(rgbColor.r) + Byte2Hex(rgbColor.g) + Byte2Hex(rgbColor.b);
     }
 
+    //
+    // Hashing
+    //
+
+    static constexpr uint64_t InitialHash64 = 14695981039346656037ull;
+
+    /*
+     * FNV-1a; hashes of multiple blocks may be chained by passing the hash
+     * of the previous block as the seed for the next one.
+     */
+    static uint64_t Hash64(
+        void const * data,
+        size_t size,
+        uint64_t seed = InitialHash64)
+    {
+        uint64_t hash = seed;
+
+        auto const * bytes = static_cast<unsigned char const *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint64_t>(bytes[i]);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
     //
     // Text files
     //
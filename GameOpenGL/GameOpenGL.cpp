@@ -264,47 +264,51 @@ void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
     RgbaImageData baseTexture,
     int maxDimension)
 {
-    assert(baseTexture.Size.Width == CeilPowerOfTwo(baseTexture.Size.Width));
-    assert(baseTexture.Size.Height == CeilPowerOfTwo(baseTexture.Size.Height));
+    std::vector<RgbaImageData> const levels = MakeMipmapsForPowerOfTwoTexture(
+        std::move(baseTexture),
+        maxDimension);
 
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+        UploadTextureLevel(
+            static_cast<GLint>(l),
+            levels[l].Size,
+            levels[l].Data.get());
+    }
 
-    //
-    // Upload base image
-    //
+    // Set max mipmap level
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size() - 1));
+    CheckOpenGLError();
+}
+
+std::vector<RgbaImageData> GameOpenGL::MakeMipmapsForPowerOfTwoTexture(
+    RgbaImageData baseTexture,
+    int maxDimension)
+{
+    assert(baseTexture.Size.Width == CeilPowerOfTwo(baseTexture.Size.Width));
+    assert(baseTexture.Size.Height == CeilPowerOfTwo(baseTexture.Size.Height));
 
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        GL_RGBA,
-        baseTexture.Size.Width,
-        baseTexture.Size.Height,
-        0,
-        GL_RGBA,
-        GL_UNSIGNED_BYTE,
-        baseTexture.Data.get());
+    std::vector<RgbaImageData> levels;
 
-    CheckOpenGLError();
+    ImageSize const baseTextureSize = baseTexture.Size;
+    levels.emplace_back(std::move(baseTexture));
 
 
     //
     // Create minified textures
     //
 
-    std::unique_ptr<rgbaColor const[]> readBuffer(std::move(baseTexture.Data));
-    std::unique_ptr<rgbaColor[]> writeBuffer;
-
-    GLint lastUploadedTextureLevel = 0;
     for (int divisor = 2; maxDimension / divisor >= 1; divisor *= 2)
     {
         // Calculate dimensions of new write buffer
-        int newWidth = std::max(1, baseTexture.Size.Width / divisor);
-        int newHeight = std::max(1, baseTexture.Size.Height / divisor);
+        int newWidth = std::max(1, baseTextureSize.Width / divisor);
+        int newHeight = std::max(1, baseTextureSize.Height / divisor);
 
         // Allocate new write buffer
-        writeBuffer.reset(new rgbaColor[newWidth * newHeight]);
+        std::unique_ptr<rgbaColor[]> writeBuffer(new rgbaColor[newWidth * newHeight]);
 
         // Populate write buffer
-        rgbaColor const * rp = readBuffer.get();
+        rgbaColor const * rp = levels.back().Data.get();
         rgbaColor * wp = writeBuffer.get();
         for (int h = 0; h < newHeight; ++h)
         {
@@ -328,17 +332,20 @@ void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
             }
         }
 
-        // Upload write buffer
-        ++lastUploadedTextureLevel;
-        glTexImage2D(GL_TEXTURE_2D, lastUploadedTextureLevel, GL_RGBA, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
-        CheckOpenGLError();
-
-        // Swap buffer
-        readBuffer = std::move(writeBuffer);
+        levels.emplace_back(
+            ImageSize(newWidth, newHeight),
+            std::move(writeBuffer));
     }
 
-    // Set max mipmap level
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, lastUploadedTextureLevel);
+    return levels;
+}
+
+void GameOpenGL::UploadTextureLevel(
+    GLint level,
+    ImageSize const & size,
+    rgbaColor const * data)
+{
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, size.Width, size.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
     CheckOpenGLError();
 }
 
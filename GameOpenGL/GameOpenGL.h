@@ -14,6 +14,7 @@
 #include <cassert>
 #include <cstdio>
 #include <string>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // Types
@@ -215,6 +216,20 @@ public:
         RgbaImageData baseTexture,
         int maxDimension);
 
+    /*
+     * Returns all the levels of the mipmap of the specified texture, starting with
+     * the texture itself, down to the level at which the largest frame of size
+     * maxDimension is reduced to a single pixel.
+     */
+    static std::vector<RgbaImageData> MakeMipmapsForPowerOfTwoTexture(
+        RgbaImageData baseTexture,
+        int maxDimension);
+
+    static void UploadTextureLevel(
+        GLint level,
+        ImageSize const & size,
+        rgbaColor const * data);
+
     template <GLenum TTarget>
     static GameOpenGLMappedBuffer<TTarget> MapBuffer(GLenum access)
     {
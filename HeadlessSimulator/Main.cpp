@@ -0,0 +1,264 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2019-01-12
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+//
+// Runs the simulation of a ship without any rendering, for a fixed number of steps,
+// and reports how long each phase took - including each phase of the ship update -
+// together with a checksum of the final state of the ship.
+//
+// Requires neither a display nor a GPU; needs to be run from a directory containing
+// the game's "Data" folder, as the world and the materials are loaded from there.
+//
+
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLoader.h>
+#include <Game/ShipDefinition.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#define SEPARATOR "------------------------------------------------------"
+
+static constexpr size_t DefaultFrameCount = 1000;
+
+/*
+ * Accumulates the ship update phase durations published by the world.
+ */
+class ShipUpdatePhaseDurationsCollector : public IGameEventHandler
+{
+public:
+
+    ShipUpdatePhaseDurationsCollector()
+        : mTotalDurations()
+        , mDurationCounts()
+    {
+        mTotalDurations.fill(0.0);
+        mDurationCounts.fill(0);
+    }
+
+    virtual void OnShipUpdatePhaseDurationUpdated(
+        ShipUpdatePhase phase,
+        float averageDurationMs) override
+    {
+        mTotalDurations[static_cast<size_t>(phase)] += static_cast<double>(averageDurationMs);
+        ++mDurationCounts[static_cast<size_t>(phase)];
+    }
+
+    double GetAverageDuration(ShipUpdatePhase phase) const
+    {
+        auto const count = mDurationCounts[static_cast<size_t>(phase)];
+        return count > 0
+            ? mTotalDurations[static_cast<size_t>(phase)] / static_cast<double>(count)
+            : 0.0;
+    }
+
+private:
+
+    std::array<double, static_cast<size_t>(ShipUpdatePhase::_Last) + 1> mTotalDurations;
+    std::array<size_t, static_cast<size_t>(ShipUpdatePhase::_Last) + 1> mDurationCounts;
+};
+
+void PrintUsage();
+
+uint64_t CalculateChecksum(Physics::Ship const & ship);
+
+template<typename TDuration>
+double ToMilliseconds(TDuration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    try
+    {
+        std::filesystem::path shipFilePath(argv[1]);
+        size_t frameCount = DefaultFrameCount;
+        if (argc >= 3)
+        {
+            frameCount = static_cast<size_t>(std::stoul(argv[2]));
+        }
+
+        std::cout << SEPARATOR << std::endl;
+        std::cout << "Running headless simulation:" << std::endl;
+        std::cout << "  ship file : " << shipFilePath.string() << std::endl;
+        std::cout << "  frames    : " << frameCount << std::endl;
+
+        //
+        // Load
+        //
+
+        auto const loadStartTime = std::chrono::steady_clock::now();
+
+        ResourceLoader resourceLoader;
+        MaterialDatabase materialDatabase = MaterialDatabase::Load(resourceLoader);
+        auto shipDefinition = ShipDefinition::Load(shipFilePath);
+
+        auto const loadEndTime = std::chrono::steady_clock::now();
+
+        //
+        // Build
+        //
+
+        // Events are collected and flushed as in the game, but the only ones
+        // that go anywhere are the profiling ones
+        auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+
+        ShipUpdatePhaseDurationsCollector shipUpdatePhaseDurationsCollector;
+        gameEventDispatcher->RegisterSink(&shipUpdatePhaseDurationsCollector);
+
+        GameParameters gameParameters;
+        gameParameters.DoProfileShipUpdates = true;
+
+        auto world = std::make_unique<Physics::World>(
+            gameEventDispatcher,
+            gameParameters,
+            resourceLoader);
+
+        ShipId const shipId = world->AddShip(
+            shipDefinition,
+            materialDatabase,
+            nullptr, // Always build, so that the build time is measured
+            gameParameters);
+
+        auto const buildEndTime = std::chrono::steady_clock::now();
+
+        //
+        // Simulate
+        //
+
+        std::chrono::steady_clock::duration totalSimulationDuration = std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::duration minFrameDuration = std::chrono::steady_clock::duration::max();
+        std::chrono::steady_clock::duration maxFrameDuration = std::chrono::steady_clock::duration::zero();
+
+        for (size_t f = 0; f < frameCount; ++f)
+        {
+            auto const frameStartTime = std::chrono::steady_clock::now();
+
+            world->Update(
+                gameParameters,
+                VectorFieldRenderMode::None);
+
+            gameEventDispatcher->Flush();
+
+            auto const frameDuration = std::chrono::steady_clock::now() - frameStartTime;
+            totalSimulationDuration += frameDuration;
+            minFrameDuration = std::min(minFrameDuration, frameDuration);
+            maxFrameDuration = std::max(maxFrameDuration, frameDuration);
+
+            // Collect this frame's phase durations
+            world->PublishShipUpdatePhaseDurations();
+        }
+
+        //
+        // Report
+        //
+
+        auto const & ship = world->GetShip(shipId);
+
+        std::cout << SEPARATOR << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  points          : " << ship.GetPointCount() << std::endl;
+        std::cout << "  springs         : " << ship.GetSprings().GetElementCount() << std::endl;
+        std::cout << "  triangles       : " << ship.GetTriangles().GetElementCount() << std::endl;
+        std::cout << "  load            : " << ToMilliseconds(loadEndTime - loadStartTime) << " ms" << std::endl;
+        std::cout << "  build           : " << ToMilliseconds(buildEndTime - loadEndTime) << " ms" << std::endl;
+        std::cout << "  simulation      : " << ToMilliseconds(totalSimulationDuration) << " ms" << std::endl;
+        if (frameCount > 0)
+        {
+            std::cout << "  frame (avg)     : " << ToMilliseconds(totalSimulationDuration) / static_cast<double>(frameCount) << " ms" << std::endl;
+            std::cout << "  frame (min)     : " << ToMilliseconds(minFrameDuration) << " ms" << std::endl;
+            std::cout << "  frame (max)     : " << ToMilliseconds(maxFrameDuration) << " ms" << std::endl;
+
+            for (size_t p = 0; p <= static_cast<size_t>(ShipUpdatePhase::_Last); ++p)
+            {
+                ShipUpdatePhase const phase = static_cast<ShipUpdatePhase>(p);
+
+                std::string label = "    " + ShipUpdatePhaseToStr(phase);
+                label.resize(std::max(label.size(), size_t(18)), ' ');
+
+                std::cout << label << ": " << shipUpdatePhaseDurationsCollector.GetAverageDuration(phase) << " ms" << std::endl;
+            }
+        }
+        std::cout << "  checksum        : " << std::hex << std::setw(16) << std::setfill('0') << CalculateChecksum(ship) << std::dec << std::endl;
+
+        return 0;
+    }
+    catch (std::exception & ex)
+    {
+        std::cout << "ERROR: " << ex.what() << std::endl;
+        return -1;
+    }
+}
+
+/*
+ * FNV-1a over the bits of the state of all the live elements of the ship;
+ * two runs of the same ship for the same number of frames must yield the
+ * same checksum.
+ */
+uint64_t CalculateChecksum(Physics::Ship const & ship)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    auto const hashBytes = [&hash](void const * data, size_t size)
+    {
+        auto const * bytes = static_cast<unsigned char const *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint64_t>(bytes[i]);
+            hash *= 1099511628211ull;
+        }
+    };
+
+    auto const & points = ship.GetPoints();
+    for (auto p : points)
+    {
+        if (!points.IsDeleted(p))
+        {
+            hashBytes(&p, sizeof(p));
+            hashBytes(&(points.GetPosition(p)), sizeof(vec2f));
+            hashBytes(&(points.GetVelocity(p)), sizeof(vec2f));
+
+            float const water = points.GetWater(p);
+            hashBytes(&water, sizeof(water));
+        }
+    }
+
+    auto const & springs = ship.GetSprings();
+    for (auto s : springs)
+    {
+        bool const isDeleted = springs.IsDeleted(s);
+        hashBytes(&isDeleted, sizeof(isDeleted));
+    }
+
+    return hash;
+}
+
+void PrintUsage()
+{
+    std::cout << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << " HeadlessSimulator <ship_file> [<frame_count>]" << std::endl;
+    std::cout << "   <ship_file>   : a .shp or .png ship" << std::endl;
+    std::cout << "   <frame_count> : number of simulation steps to run (default: " << DefaultFrameCount << ")" << std::endl;
+}
@@ -0,0 +1,152 @@
+#include <Game/GameEventBuffer.h>
+
+#include "gmock/gmock.h"
+
+class _MockBufferTargetHandler : public IGameEventHandler
+{
+public:
+
+    MOCK_METHOD3(OnDestroy, void(StructuralMaterial const & material, bool isUnderwater, unsigned int size));
+    MOCK_METHOD3(OnBreak, void(StructuralMaterial const & material, bool isUnderwater, unsigned int size));
+    MOCK_METHOD2(OnPinToggled, void(bool isPinned, bool isUnderwater));
+    MOCK_METHOD1(OnSinkingBegin, void(ShipId shipId));
+    MOCK_METHOD2(OnCustomProbe, void(std::string const & name, float value));
+};
+
+using namespace ::testing;
+
+using MockBufferTargetHandler = StrictMock<_MockBufferTargetHandler>;
+
+/////////////////////////////////////////////////////////////////
+
+TEST(GameEventBufferTests, ForwardsImmediately_WhenNotBuffering)
+{
+    auto handler = std::make_shared<MockBufferTargetHandler>();
+
+    GameEventBuffer buffer(handler);
+
+    EXPECT_CALL(*handler, OnSinkingBegin(7)).Times(1);
+
+    buffer.OnSinkingBegin(7);
+
+    Mock::VerifyAndClear(handler.get());
+}
+
+TEST(GameEventBufferTests, PublishesInOrder_WhenBuffering)
+{
+    auto handler = std::make_shared<MockBufferTargetHandler>();
+
+    GameEventBuffer buffer(handler);
+
+    StructuralMaterial sm(
+        "Foo",
+        1.0f,
+        1.0f,
+        1.0f,
+        vec4f::zero(),
+        false,
+        1.0f,
+        1.0f,
+        1.0f,
+        1.0f,
+        std::nullopt,
+        std::nullopt);
+
+    EXPECT_CALL(*handler, OnDestroy(_, _, _)).Times(0);
+    EXPECT_CALL(*handler, OnPinToggled(_, _)).Times(0);
+    EXPECT_CALL(*handler, OnSinkingBegin(_)).Times(0);
+
+    buffer.StartBuffering();
+
+    buffer.OnDestroy(sm, true, 3);
+    buffer.OnSinkingBegin(2);
+    buffer.OnPinToggled(false, true);
+    buffer.OnDestroy(sm, false, 1);
+
+    Mock::VerifyAndClear(handler.get());
+
+    {
+        InSequence s;
+
+        EXPECT_CALL(*handler, OnDestroy(Field(&StructuralMaterial::Name, "Foo"), true, 3)).Times(1);
+        EXPECT_CALL(*handler, OnSinkingBegin(2)).Times(1);
+        EXPECT_CALL(*handler, OnPinToggled(false, true)).Times(1);
+        EXPECT_CALL(*handler, OnDestroy(Field(&StructuralMaterial::Name, "Foo"), false, 1)).Times(1);
+    }
+
+    buffer.PublishAndStopBuffering();
+
+    Mock::VerifyAndClear(handler.get());
+
+    // Not buffering anymore
+
+    EXPECT_CALL(*handler, OnSinkingBegin(4)).Times(1);
+
+    buffer.OnSinkingBegin(4);
+
+    Mock::VerifyAndClear(handler.get());
+}
+
+TEST(GameEventBufferTests, ForwardsAggregatedEventsImmediately_WhenBuffering)
+{
+    auto handler = std::make_shared<MockBufferTargetHandler>();
+
+    GameEventBuffer buffer(handler);
+
+    StructuralMaterial sm(
+        "Foo",
+        1.0f,
+        1.0f,
+        1.0f,
+        vec4f::zero(),
+        false,
+        1.0f,
+        1.0f,
+        1.0f,
+        1.0f,
+        std::nullopt,
+        std::nullopt);
+
+    EXPECT_CALL(*handler, OnSinkingBegin(_)).Times(0);
+
+    buffer.StartBuffering();
+
+    buffer.OnSinkingBegin(2);
+
+    EXPECT_CALL(*handler, OnBreak(Field(&StructuralMaterial::Name, "Foo"), true, 3)).Times(1);
+
+    buffer.OnBreak(sm, true, 3);
+
+    Mock::VerifyAndClear(handler.get());
+
+    EXPECT_CALL(*handler, OnSinkingBegin(2)).Times(1);
+
+    buffer.PublishAndStopBuffering();
+
+    Mock::VerifyAndClear(handler.get());
+}
+
+TEST(GameEventBufferTests, BuffersCopiesOfArguments_WhenBuffering)
+{
+    auto handler = std::make_shared<MockBufferTargetHandler>();
+
+    GameEventBuffer buffer(handler);
+
+    EXPECT_CALL(*handler, OnCustomProbe(_, _)).Times(0);
+
+    buffer.StartBuffering();
+
+    {
+        std::string name("Probe With A Name Longer Than The Small String Buffer");
+        buffer.OnCustomProbe(name, 4.0f);
+        name = "Changed";
+    }
+
+    Mock::VerifyAndClear(handler.get());
+
+    EXPECT_CALL(*handler, OnCustomProbe(std::string("Probe With A Name Longer Than The Small String Buffer"), 4.0f)).Times(1);
+
+    buffer.PublishAndStopBuffering();
+
+    Mock::VerifyAndClear(handler.get());
+}
@@ -2,6 +2,10 @@
 
 #include "gmock/gmock.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 class _MockHandler : public IGameEventHandler
 {
 public:
@@ -11,6 +15,7 @@ public:
     MOCK_METHOD2(OnPinToggled, void(bool isPinned, bool isUnderwater));
     MOCK_METHOD3(OnStress, void(StructuralMaterial const & material, bool isUnderwater, unsigned int size));
     MOCK_METHOD1(OnSinkingBegin, void(ShipId shipId));
+    MOCK_METHOD3(OnLightFlicker, void(DurationShortLongType duration, bool isUnderwater, unsigned int size));
 };
 
 using namespace ::testing;
@@ -153,6 +158,169 @@ TEST(GameEventDispatcherTests, Aggregates_OnSinkingBegin_MultipleShips)
     Mock::VerifyAndClear(&handler);
 }
 
+TEST(GameEventDispatcherTests, Aggregates_OnBreak_FromMultipleThreads)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterSink(&handler);
+
+    StructuralMaterial sm1(
+        "Foo1",
+        1.0f,
+        1.0f,
+        1.0f,
+        vec4f::zero(),
+        false,
+        1.0f,
+        1.0f,
+        1.0f,
+        1.0f,
+        std::nullopt,
+        std::nullopt);
+
+    StructuralMaterial sm2(
+        "Foo2",
+        1.0f,
+        1.0f,
+        1.0f,
+        vec4f::zero(),
+        false,
+        1.0f,
+        1.0f,
+        1.0f,
+        1.0f,
+        std::nullopt,
+        std::nullopt);
+
+    sm2.Ordinal = 1;
+
+    EXPECT_CALL(handler, OnBreak(_, _, _)).Times(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&dispatcher, &sm1, &sm2]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    dispatcher.OnBreak(sm1, false, 1);
+                    dispatcher.OnBreak(sm2, true, 2);
+                }
+            });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    dispatcher.OnBreak(sm1, false, 5);
+
+    Mock::VerifyAndClear(&handler);
+
+    EXPECT_CALL(handler, OnBreak(Field(&StructuralMaterial::Name, "Foo1"), false, 4005)).Times(1);
+    EXPECT_CALL(handler, OnBreak(Field(&StructuralMaterial::Name, "Foo2"), true, 8000)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, Aggregates_OnLightFlicker_MoreThreadsOverTimeThanStagingAreas)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterSink(&handler);
+
+    // Threads give their areas back when they exit
+    for (size_t t = 0; t < 2 * GameEventDispatcher::MaxStagingAreas; ++t)
+    {
+        std::thread thread(
+            [&dispatcher]()
+            {
+                dispatcher.OnLightFlicker(DurationShortLongType::Short, false, 1);
+            });
+
+        thread.join();
+    }
+
+    EXPECT_CALL(handler, OnLightFlicker(DurationShortLongType::Short, false, 2 * GameEventDispatcher::MaxStagingAreas)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, Aggregates_OnLightFlicker_MoreConcurrentThreadsThanStagingAreas)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterSink(&handler);
+
+    size_t const threadCount = GameEventDispatcher::MaxStagingAreas + 8;
+
+    // Keep all threads alive until all of them have fired their events,
+    // so that the last ones find no free area
+    std::atomic<size_t> firedThreadCount(0);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&dispatcher, &firedThreadCount, threadCount]()
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    dispatcher.OnLightFlicker(DurationShortLongType::Long, true, 1);
+                }
+
+                ++firedThreadCount;
+                while (firedThreadCount.load() < threadCount)
+                {
+                    std::this_thread::yield();
+                }
+            });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_CALL(handler, OnLightFlicker(DurationShortLongType::Long, true, static_cast<unsigned int>(100 * threadCount))).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, Aggregates_OnLightFlicker)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterSink(&handler);
+
+    EXPECT_CALL(handler, OnLightFlicker(_, _, _)).Times(0);
+
+    dispatcher.OnLightFlicker(DurationShortLongType::Short, false, 1);
+    dispatcher.OnLightFlicker(DurationShortLongType::Long, true, 2);
+    dispatcher.OnLightFlicker(DurationShortLongType::Short, false, 3);
+
+    Mock::VerifyAndClear(&handler);
+
+    EXPECT_CALL(handler, OnLightFlicker(DurationShortLongType::Short, false, 4)).Times(1);
+    EXPECT_CALL(handler, OnLightFlicker(DurationShortLongType::Long, true, 2)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
 TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
 {
     MockHandler handler;
@@ -192,4 +360,38 @@ TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
     dispatcher.Flush();
 
     Mock::VerifyAndClear(&handler);
-}
\ No newline at end of file
+}
+
+TEST(GameEventDispatcherTests, Aggregates_OnLightFlicker_AlternatingDispatchers)
+{
+    MockHandler handler1;
+    MockHandler handler2;
+
+    GameEventDispatcher dispatcher1;
+    dispatcher1.RegisterSink(&handler1);
+
+    GameEventDispatcher dispatcher2;
+    dispatcher2.RegisterSink(&handler2);
+
+    EXPECT_CALL(handler1, OnLightFlicker(_, _, _)).Times(0);
+    EXPECT_CALL(handler2, OnLightFlicker(_, _, _)).Times(0);
+
+    // More switches than staging areas, each switch must find the thread's area again
+    for (size_t i = 0; i < 2 * GameEventDispatcher::MaxStagingAreas; ++i)
+    {
+        dispatcher1.OnLightFlicker(DurationShortLongType::Short, false, 1);
+        dispatcher2.OnLightFlicker(DurationShortLongType::Long, true, 2);
+    }
+
+    Mock::VerifyAndClear(&handler1);
+    Mock::VerifyAndClear(&handler2);
+
+    EXPECT_CALL(handler1, OnLightFlicker(DurationShortLongType::Short, false, 2 * GameEventDispatcher::MaxStagingAreas)).Times(1);
+    EXPECT_CALL(handler2, OnLightFlicker(DurationShortLongType::Long, true, 4 * GameEventDispatcher::MaxStagingAreas)).Times(1);
+
+    dispatcher1.Flush();
+    dispatcher2.Flush();
+
+    Mock::VerifyAndClear(&handler1);
+    Mock::VerifyAndClear(&handler2);
+}
@@ -1,13 +1,10 @@
 #include "Utils.h"
 
 #include <GameCore/GameTypes.h>
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/SysSpecifics.h>
 #include <GameCore/Vectors.h>
 
-// TODO: move to GameLib's LibSimdPp.h
-//#define SIMDPP_ARCH_X86_SSSE3
-#define SIMDPP_ARCH_X86_SSE2
-#include "simdpp/simd.h"
 #include "intrin.h"
 
 #include "gtest/gtest.h"
@@ -77,6 +74,24 @@ TEST(LibSimdPpTests, ReciprocalSquareRoot_WithMask)
     EXPECT_EQ(0.0f, results[5]);
 }
 
+TEST(LibSimdPpTests, SafeDivide)
+{
+    alignas(16) float const dividends[4] = { 1.0f, -3.0f, 7.0f, 5.0f };
+    alignas(16) float const divisors[4] = { 2.0f, 0.0f, -0.0f, -0.5f };
+    alignas(16) float results[4];
+
+    simdpp::store(
+        results,
+        SafeDivide(
+            simdpp::load<simdpp::float32<4>>(dividends),
+            simdpp::load<simdpp::float32<4>>(divisors)));
+
+    EXPECT_EQ(0.5f, results[0]);
+    EXPECT_EQ(0.0f, results[1]);
+    EXPECT_EQ(0.0f, results[2]);
+    EXPECT_EQ(-10.0f, results[3]);
+}
+
 TEST(LibSimdPpTests, VectorNormalization)
 {
     std::vector<vec2f> points{
@@ -0,0 +1,99 @@
+#include <GameCore/LockFreeRingBuffer.h>
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+TEST(LockFreeRingBufferTests, PopsInPushOrder)
+{
+    LockFreeRingBuffer<int, 4> rb;
+
+    int value;
+    EXPECT_FALSE(rb.TryPop(value));
+
+    EXPECT_TRUE(rb.TryPush(10));
+    EXPECT_TRUE(rb.TryPush(20));
+    EXPECT_TRUE(rb.TryPush(30));
+
+    EXPECT_TRUE(rb.TryPop(value));
+    EXPECT_EQ(10, value);
+    EXPECT_TRUE(rb.TryPop(value));
+    EXPECT_EQ(20, value);
+    EXPECT_TRUE(rb.TryPop(value));
+    EXPECT_EQ(30, value);
+
+    EXPECT_FALSE(rb.TryPop(value));
+}
+
+TEST(LockFreeRingBufferTests, DropsWhenFull)
+{
+    LockFreeRingBuffer<int, 3> rb;
+
+    EXPECT_TRUE(rb.TryPush(1));
+    EXPECT_TRUE(rb.TryPush(2));
+    EXPECT_TRUE(rb.TryPush(3));
+    EXPECT_FALSE(rb.TryPush(4));
+
+    std::vector<int> drained;
+    rb.Drain(
+        [&drained](int value)
+        {
+            drained.push_back(value);
+        });
+
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3 }), drained);
+
+    // Room again, across the wrap-around
+    EXPECT_TRUE(rb.TryPush(5));
+    EXPECT_TRUE(rb.TryPush(6));
+
+    int value;
+    EXPECT_TRUE(rb.TryPop(value));
+    EXPECT_EQ(5, value);
+    EXPECT_TRUE(rb.TryPop(value));
+    EXPECT_EQ(6, value);
+}
+
+TEST(LockFreeRingBufferTests, ConcurrentProducerAndConsumer)
+{
+    LockFreeRingBuffer<int, 16> rb;
+
+    static constexpr int Count = 100000;
+
+    std::thread producer(
+        [&rb]()
+        {
+            for (int i = 0; i < Count; ++i)
+            {
+                while (!rb.TryPush(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    // Drain everything before checking, so that the producer never
+    // outlives this test - not even when values are wrong
+    std::vector<int> values;
+    values.reserve(Count);
+    while (values.size() < static_cast<size_t>(Count))
+    {
+        int value;
+        if (rb.TryPop(value))
+        {
+            values.push_back(value);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    for (int i = 0; i < Count; ++i)
+    {
+        ASSERT_EQ(i, values[i]);
+    }
+}
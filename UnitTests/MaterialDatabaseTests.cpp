@@ -0,0 +1,180 @@
+#include <Game/MaterialDatabase.h>
+
+#include "TestShips.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*
+ * Verifies the database's lookup tables against the map lookups they replaced: a find
+ * in the map of the materials and, for structural materials only, the rope material for
+ * the color keys in the range reserved for rope endpoints.
+ */
+class MaterialDatabaseTests : public ::testing::Test
+{
+protected:
+
+    MaterialDatabaseTests()
+        : mMaterialDatabase(TestShips::LoadMaterialDatabase())
+        , mRopeMaterial(mMaterialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Rope))
+        , mRopeColorKey()
+    {
+        for (auto const & entry : mMaterialDatabase.GetStructuralMaterials())
+        {
+            if (&(entry.second) == &mRopeMaterial)
+                mRopeColorKey = entry.first;
+        }
+    }
+
+    StructuralMaterial const * FindStructuralMaterialInMap(MaterialDatabase::ColorKey const & colorKey) const
+    {
+        auto const & materialMap = mMaterialDatabase.GetStructuralMaterials();
+
+        auto srchIt = materialMap.find(colorKey);
+        if (srchIt != materialMap.end())
+        {
+            return &(srchIt->second);
+        }
+
+        if (colorKey.r == mRopeColorKey.r
+            && (colorKey.g & 0xF0) == (mRopeColorKey.g & 0xF0))
+        {
+            return &mRopeMaterial;
+        }
+
+        return nullptr;
+    }
+
+    ElectricalMaterial const * FindElectricalMaterialInMap(MaterialDatabase::ColorKey const & colorKey) const
+    {
+        auto const & materialMap = mMaterialDatabase.GetElectricalMaterials();
+
+        auto srchIt = materialMap.find(colorKey);
+        if (srchIt != materialMap.end())
+        {
+            return &(srchIt->second);
+        }
+
+        return nullptr;
+    }
+
+    void VerifyFind(MaterialDatabase::ColorKey const & colorKey) const
+    {
+        EXPECT_EQ(FindStructuralMaterialInMap(colorKey), mMaterialDatabase.FindStructuralMaterial(colorKey))
+            << "Color key " << colorKey;
+
+        EXPECT_EQ(FindElectricalMaterialInMap(colorKey), mMaterialDatabase.FindElectricalMaterial(colorKey))
+            << "Color key " << colorKey;
+    }
+
+    /*
+     * The keys around the specified one, which share its page or are in the neighboring ones.
+     */
+    static std::vector<MaterialDatabase::ColorKey> MakeNeighboringColorKeys(MaterialDatabase::ColorKey const & colorKey)
+    {
+        std::vector<MaterialDatabase::ColorKey> colorKeys;
+        for (int dr : { -1, 0, 1 })
+        {
+            for (int dg : { -1, 0, 1 })
+            {
+                for (int db : { -1, 0, 1 })
+                {
+                    colorKeys.emplace_back(
+                        static_cast<uint8_t>(colorKey.r + dr),
+                        static_cast<uint8_t>(colorKey.g + dg),
+                        static_cast<uint8_t>(colorKey.b + db));
+                }
+            }
+        }
+
+        return colorKeys;
+    }
+
+    MaterialDatabase const mMaterialDatabase;
+    StructuralMaterial const & mRopeMaterial;
+    MaterialDatabase::ColorKey mRopeColorKey;
+};
+
+TEST_F(MaterialDatabaseTests, Find_StockMaterials)
+{
+    for (auto const & entry : mMaterialDatabase.GetStructuralMaterials())
+    {
+        EXPECT_EQ(&(entry.second), mMaterialDatabase.FindStructuralMaterial(entry.first)) << "Color key " << entry.first;
+        VerifyFind(entry.first);
+    }
+
+    for (auto const & entry : mMaterialDatabase.GetElectricalMaterials())
+    {
+        EXPECT_EQ(&(entry.second), mMaterialDatabase.FindElectricalMaterial(entry.first)) << "Color key " << entry.first;
+        VerifyFind(entry.first);
+    }
+}
+
+TEST_F(MaterialDatabaseTests, Find_RopeColorRange)
+{
+    size_t ropeColorKeyCount = 0;
+
+    for (int g = 0; g < 16; ++g)
+    {
+        for (int b = 0; b < 256; ++b)
+        {
+            MaterialDatabase::ColorKey const colorKey(
+                mRopeColorKey.r,
+                static_cast<uint8_t>((mRopeColorKey.g & 0xF0) | g),
+                static_cast<uint8_t>(b));
+
+            ASSERT_NE(nullptr, mMaterialDatabase.FindStructuralMaterial(colorKey)) << "Color key " << colorKey;
+            if (&mRopeMaterial == mMaterialDatabase.FindStructuralMaterial(colorKey))
+                ++ropeColorKeyCount;
+
+            VerifyFind(colorKey);
+        }
+    }
+
+    EXPECT_NE(0u, ropeColorKeyCount);
+}
+
+TEST_F(MaterialDatabaseTests, Find_UnmappedColorKeys)
+{
+    // Around the stock materials, and around the rope color range
+    for (auto const & entry : mMaterialDatabase.GetStructuralMaterials())
+    {
+        for (auto const & colorKey : MakeNeighboringColorKeys(entry.first))
+            VerifyFind(colorKey);
+    }
+
+    for (auto const & entry : mMaterialDatabase.GetElectricalMaterials())
+    {
+        for (auto const & colorKey : MakeNeighboringColorKeys(entry.first))
+            VerifyFind(colorKey);
+    }
+
+    for (int g : { (mRopeColorKey.g & 0xF0) - 1, (mRopeColorKey.g & 0xF0) + 16 })
+    {
+        for (int b = 0; b < 256; ++b)
+        {
+            VerifyFind(
+                MaterialDatabase::ColorKey(
+                    mRopeColorKey.r,
+                    static_cast<uint8_t>(g),
+                    static_cast<uint8_t>(b)));
+        }
+    }
+
+    // Extremes, and random keys all over
+    VerifyFind(MaterialDatabase::ColorKey(0x00, 0x00, 0x00));
+    VerifyFind(MaterialDatabase::ColorKey(0xff, 0xff, 0xff));
+
+    std::mt19937 random(1);
+    for (int i = 0; i < 10000; ++i)
+    {
+        VerifyFind(
+            MaterialDatabase::ColorKey(
+                static_cast<uint8_t>(random() % 256),
+                static_cast<uint8_t>(random() % 256),
+                static_cast<uint8_t>(random() % 256)));
+    }
+}
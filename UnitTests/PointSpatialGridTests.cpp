@@ -0,0 +1,253 @@
+#include <Game/GameParameters.h>
+#include <Game/IGameEventHandler.h>
+#include <Game/ResourceLoader.h>
+#include <Game/Ship.h>
+#include <Game/ShipBuilder.h>
+#include <Game/World.h>
+
+#include <GameCore/Vectors.h>
+
+#include "TestShips.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*
+ * Verifies the grid's queries against brute-force scans of the points, after the
+ * grid has been rebuilt and after it has been updated with moved and destroyed points.
+ */
+class PointSpatialGridTests : public ::testing::Test
+{
+protected:
+
+    static constexpr float CellSize = 2.0f;
+
+    PointSpatialGridTests()
+        : mMaterialDatabase(TestShips::LoadMaterialDatabase())
+        , mGameParameters()
+        , mResourceLoader()
+        , mWorld(
+            std::make_shared<IGameEventHandler>(),
+            mGameParameters,
+            mResourceLoader,
+            1)
+        , mShip(
+            ShipBuilder::Create(
+                1,
+                mWorld,
+                std::make_shared<IGameEventHandler>(),
+                TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, false, 6),
+                mMaterialDatabase,
+                nullptr,
+                mGameParameters,
+                1u))
+        , mRandom(6)
+    {}
+
+    Physics::Points & GetPoints()
+    {
+        return mShip->GetPoints();
+    }
+
+    float RandomFloat(
+        float minValue,
+        float maxValue)
+    {
+        return minValue + static_cast<float>(mRandom() % 10001) / 10000.0f * (maxValue - minValue);
+    }
+
+    /*
+     * Checks that the grid visits each point at most once, that it visits no deleted
+     * points, that it visits all the points in the rectangle, and that it visits no
+     * points farther than one cell from the rectangle.
+     */
+    void VerifyRect(
+        Physics::PointSpatialGrid const & grid,
+        vec2f const & bottomLeft,
+        vec2f const & topRight)
+    {
+        auto const & points = GetPoints();
+
+        std::vector<ElementIndex> visitedPoints;
+        grid.VisitPointsInRect(
+            bottomLeft,
+            topRight,
+            [&](ElementIndex pointIndex)
+            {
+                visitedPoints.push_back(pointIndex);
+            });
+
+        std::sort(visitedPoints.begin(), visitedPoints.end());
+        ASSERT_TRUE(std::adjacent_find(visitedPoints.cbegin(), visitedPoints.cend()) == visitedPoints.cend());
+
+        for (auto pointIndex : visitedPoints)
+        {
+            ASSERT_LT(pointIndex, points.GetShipPointCount());
+            EXPECT_FALSE(points.IsDeleted(pointIndex)) << "Point " << pointIndex;
+
+            auto const & position = points.GetPosition(pointIndex);
+            EXPECT_GE(position.x, bottomLeft.x - CellSize * 1.001f) << "Point " << pointIndex;
+            EXPECT_GE(position.y, bottomLeft.y - CellSize * 1.001f) << "Point " << pointIndex;
+            EXPECT_LE(position.x, topRight.x + CellSize * 1.001f) << "Point " << pointIndex;
+            EXPECT_LE(position.y, topRight.y + CellSize * 1.001f) << "Point " << pointIndex;
+        }
+
+        for (auto pointIndex : points.NonEphemeralPoints())
+        {
+            auto const & position = points.GetPosition(pointIndex);
+            if (!points.IsDeleted(pointIndex)
+                && position.x >= bottomLeft.x && position.x <= topRight.x
+                && position.y >= bottomLeft.y && position.y <= topRight.y)
+            {
+                EXPECT_TRUE(std::binary_search(visitedPoints.cbegin(), visitedPoints.cend(), pointIndex)) << "Point " << pointIndex;
+            }
+        }
+    }
+
+    void Verify(Physics::PointSpatialGrid const & grid)
+    {
+        auto const & points = GetPoints();
+
+        // All points
+
+        std::vector<ElementIndex> livePoints;
+        for (auto pointIndex : points.NonEphemeralPoints())
+        {
+            if (!points.IsDeleted(pointIndex))
+                livePoints.push_back(pointIndex);
+        }
+
+        std::vector<ElementIndex> visitedPoints;
+        grid.VisitPointsInRect(
+            vec2f(-1000.0f, -1000.0f),
+            vec2f(1000.0f, 1000.0f),
+            [&](ElementIndex pointIndex)
+            {
+                visitedPoints.push_back(pointIndex);
+            });
+
+        std::sort(visitedPoints.begin(), visitedPoints.end());
+        EXPECT_EQ(livePoints, visitedPoints);
+
+        // Random rectangles, around and over the ship
+
+        for (int r = 0; r < 200; ++r)
+        {
+            vec2f const bottomLeft(RandomFloat(-60.0f, 60.0f), RandomFloat(-10.0f, 70.0f));
+            vec2f const topRight = bottomLeft + vec2f(RandomFloat(0.0f, 12.0f), RandomFloat(0.0f, 12.0f));
+
+            SCOPED_TRACE(::testing::Message() << "Rect " << bottomLeft << " - " << topRight);
+
+            ASSERT_NO_FATAL_FAILURE(VerifyRect(grid, bottomLeft, topRight));
+        }
+    }
+
+    MaterialDatabase const mMaterialDatabase;
+    GameParameters const mGameParameters;
+    ResourceLoader mResourceLoader;
+    Physics::World mWorld;
+    std::unique_ptr<Physics::Ship> mShip;
+    std::mt19937 mRandom;
+};
+
+TEST_F(PointSpatialGridTests, Rebuild)
+{
+    Physics::PointSpatialGrid grid(CellSize);
+    grid.Rebuild(GetPoints());
+
+    Verify(grid);
+}
+
+TEST_F(PointSpatialGridTests, Update_MovedPoints)
+{
+    auto & points = GetPoints();
+
+    Physics::PointSpatialGrid grid(CellSize);
+    grid.Rebuild(points);
+
+    // Move points within the grid's margin, so that the grid relinks them rather
+    // than being rebuilt
+    for (int step = 0; step < 3; ++step)
+    {
+        SCOPED_TRACE(step);
+
+        for (auto pointIndex : points.NonEphemeralPoints())
+        {
+            if (0 == mRandom() % 3)
+                points.GetPosition(pointIndex) += vec2f(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+        }
+
+        grid.Update(points);
+
+        ASSERT_NO_FATAL_FAILURE(Verify(grid));
+    }
+}
+
+TEST_F(PointSpatialGridTests, Update_DestroyedPoints)
+{
+    auto & points = GetPoints();
+
+    Physics::PointSpatialGrid grid(CellSize);
+    grid.Rebuild(points);
+
+    for (int step = 0; step < 3; ++step)
+    {
+        SCOPED_TRACE(step);
+
+        for (auto pointIndex : points.NonEphemeralPoints())
+        {
+            if (points.IsDeleted(pointIndex))
+                continue;
+
+            if (0 == mRandom() % 10)
+                points.Destroy(pointIndex, 0.0f, mGameParameters);
+            else if (0 == mRandom() % 3)
+                points.GetPosition(pointIndex) += vec2f(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+        }
+
+        grid.Update(points);
+
+        ASSERT_NO_FATAL_FAILURE(Verify(grid));
+    }
+}
+
+TEST_F(PointSpatialGridTests, Update_PointsOutOfGrid)
+{
+    auto & points = GetPoints();
+
+    Physics::PointSpatialGrid grid(CellSize);
+    grid.Rebuild(points);
+
+    // Move a few points well beyond the grid's margin, forcing a rebuild, together
+    // with other points that move and are destroyed
+    for (int step = 0; step < 3; ++step)
+    {
+        SCOPED_TRACE(step);
+
+        // Surely out of the grid, which extends a few cells above the highest point
+        ElementIndex const farPointIndex = static_cast<ElementIndex>(step);
+        ASSERT_FALSE(points.IsDeleted(farPointIndex));
+        points.GetPosition(farPointIndex) = vec2f(0.0f, 140.0f + 10.0f * static_cast<float>(step));
+
+        for (auto pointIndex : points.NonEphemeralPoints())
+        {
+            if (points.IsDeleted(pointIndex) || pointIndex < 3)
+                continue;
+
+            if (0 == mRandom() % 500)
+                points.GetPosition(pointIndex) += vec2f(RandomFloat(-30.0f, 30.0f), 20.0f);
+            else if (0 == mRandom() % 20)
+                points.Destroy(pointIndex, 0.0f, mGameParameters);
+            else if (0 == mRandom() % 3)
+                points.GetPosition(pointIndex) += vec2f(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+        }
+
+        grid.Update(points);
+
+        ASSERT_NO_FATAL_FAILURE(Verify(grid));
+    }
+}
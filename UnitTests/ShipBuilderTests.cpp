@@ -0,0 +1,266 @@
+#include <Game/GameParameters.h>
+#include <Game/IGameEventHandler.h>
+#include <Game/ResourceLoader.h>
+#include <Game/Ship.h>
+#include <Game/ShipBuilder.h>
+#include <Game/ShipCache.h>
+#include <Game/World.h>
+
+#include <GameCore/Utils.h>
+
+#include "TestFolder.h"
+#include "TestShips.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Verifies that the tiled, parallel ship builder builds exactly the same ships as
+ * the serial builder it replaced.
+ *
+ * Ships are checked against checksums of their elements recorded with the serial
+ * builder; the elements are taken from the ship cache, which stores them exactly as
+ * they come out of the builder. The checksums have to be recorded again whenever
+ * the output of the builder - or the material database - is meant to change.
+ */
+class ShipBuilderTests : public ::testing::Test
+{
+protected:
+
+    ShipBuilderTests()
+        : mMaterialDatabase(TestShips::LoadMaterialDatabase())
+        , mGameParameters()
+        , mResourceLoader()
+        , mFolder("ShipBuilder")
+    {}
+
+    /*
+     * Builds the ship in a world with the specified parallelism, and returns
+     * the elements of the ship as stored in the cache.
+     */
+    std::unique_ptr<ShipCache::CachedShip> Build(
+        ShipDefinition const & shipDefinition,
+        size_t parallelism)
+    {
+        // A cache of its own, so that the ship is built rather than loaded
+        ShipCache const shipCache(mFolder.GetPath() / std::to_string(parallelism));
+
+        Physics::World world(
+            std::make_shared<IGameEventHandler>(),
+            mGameParameters,
+            mResourceLoader,
+            parallelism);
+
+        auto const ship = ShipBuilder::Create(
+            1,
+            world,
+            std::make_shared<IGameEventHandler>(),
+            shipDefinition,
+            mMaterialDatabase,
+            &shipCache,
+            mGameParameters,
+            1u);
+
+        return shipCache.TryLoad(
+            shipDefinition.Metadata.ShipName,
+            ShipCache::CalculateKey(shipDefinition, mMaterialDatabase));
+    }
+
+    static uint64_t CalculateChecksum(ShipCache::CachedShip const & cachedShip)
+    {
+        uint64_t hash = Utils::InitialHash64;
+
+        auto const hashValue = [&hash](auto const & value)
+        {
+            hash = Utils::Hash64(&value, sizeof(value), hash);
+        };
+
+        // Field by field, as the elements have padding
+
+        hashValue(static_cast<uint64_t>(cachedShip.GetPointCount()));
+        for (size_t p = 0; p < cachedShip.GetPointCount(); ++p)
+        {
+            auto const & point = cachedShip.GetPoints()[p];
+            hashValue(point.Position.x);
+            hashValue(point.Position.y);
+            hashValue(point.TextureCoordinates.x);
+            hashValue(point.TextureCoordinates.y);
+            hashValue(point.RenderColor.x);
+            hashValue(point.RenderColor.y);
+            hashValue(point.RenderColor.z);
+            hashValue(point.RenderColor.w);
+            hashValue(point.StructuralMaterialIndex);
+            hashValue(point.ElectricalMaterialIndex);
+            hashValue(point.IsRope);
+            hashValue(point.IsLeaking);
+        }
+
+        hashValue(static_cast<uint64_t>(cachedShip.GetSpringCount()));
+        for (size_t s = 0; s < cachedShip.GetSpringCount(); ++s)
+        {
+            auto const & spring = cachedShip.GetSprings()[s];
+            hashValue(spring.PointAIndex);
+            hashValue(spring.PointBIndex);
+            hashValue(spring.SuperTrianglesCount);
+            for (uint32_t st = 0; st < spring.SuperTrianglesCount; ++st)
+                hashValue(spring.SuperTriangles[st]);
+        }
+
+        hashValue(static_cast<uint64_t>(cachedShip.GetSpringColorRangeCount()));
+        for (size_t c = 0; c < cachedShip.GetSpringColorRangeCount(); ++c)
+        {
+            hashValue(cachedShip.GetSpringColorRanges()[c].StartSpringIndex);
+            hashValue(cachedShip.GetSpringColorRanges()[c].EndSpringIndex);
+        }
+
+        hashValue(static_cast<uint64_t>(cachedShip.GetTriangleCount()));
+        for (size_t t = 0; t < cachedShip.GetTriangleCount(); ++t)
+        {
+            auto const & triangle = cachedShip.GetTriangles()[t];
+            hashValue(triangle.PointIndices[0]);
+            hashValue(triangle.PointIndices[1]);
+            hashValue(triangle.PointIndices[2]);
+            hashValue(triangle.SubSpringsCount);
+            for (uint32_t ss = 0; ss < triangle.SubSpringsCount; ++ss)
+                hashValue(triangle.SubSprings[ss]);
+        }
+
+        return hash;
+    }
+
+    void VerifyChecksum(
+        ShipDefinition const & shipDefinition,
+        uint64_t expectedChecksum)
+    {
+        for (size_t parallelism : { 1, 2, 5 })
+        {
+            SCOPED_TRACE(parallelism);
+
+            auto const cachedShip = Build(shipDefinition, parallelism);
+            ASSERT_TRUE(!!cachedShip);
+
+            EXPECT_EQ(expectedChecksum, CalculateChecksum(*cachedShip));
+        }
+    }
+
+    rgbColor GetFirstStructuralColorKey() const
+    {
+        return std::find_if(
+            mMaterialDatabase.GetStructuralMaterials().cbegin(),
+            mMaterialDatabase.GetStructuralMaterials().cend(),
+            [](auto const & entry)
+            {
+                return !entry.second.UniqueType;
+            })->first;
+    }
+
+    MaterialDatabase const mMaterialDatabase;
+    GameParameters const mGameParameters;
+    ResourceLoader mResourceLoader;
+    TestFolder const mFolder;
+};
+
+//
+// Checksums recorded with the serial builder
+//
+
+TEST_F(ShipBuilderTests, MatchesSerialBuilder_RectangularShip)
+{
+    VerifyChecksum(
+        TestShips::MakeRectangularShip(13, 7, GetFirstStructuralColorKey()),
+        0xc2feefba99ecbd27ull);
+}
+
+TEST_F(ShipBuilderTests, MatchesSerialBuilder_RandomShip_StructuralLayer)
+{
+    VerifyChecksum(
+        TestShips::MakeRandomShip(97, 61, mMaterialDatabase, false, false, 1),
+        0xb7734d8de0896bafull);
+}
+
+TEST_F(ShipBuilderTests, MatchesSerialBuilder_RandomShip_StructuralAndRopesLayers)
+{
+    VerifyChecksum(
+        TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, false, 1),
+        0xd3087e6391b24eb3ull);
+}
+
+TEST_F(ShipBuilderTests, MatchesSerialBuilder_RandomShip_AllLayers)
+{
+    VerifyChecksum(
+        TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, true, 2),
+        0xc6ebbf158a9618ffull);
+}
+
+TEST_F(ShipBuilderTests, SpringColorRanges_AreConflictFreeAndTileAllSprings)
+{
+    auto const shipDefinition = TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, true, 4);
+
+    for (size_t parallelism : { 1, 2, 5 })
+    {
+        SCOPED_TRACE(parallelism);
+
+        auto const cachedShip = Build(shipDefinition, parallelism);
+        ASSERT_TRUE(!!cachedShip);
+
+        auto const * const springs = cachedShip->GetSprings();
+        auto const * const colorRanges = cachedShip->GetSpringColorRanges();
+
+        ASSERT_NE(0u, cachedShip->GetSpringColorRangeCount());
+
+        // Ranges follow each other, from the first spring to the last one
+        ElementIndex expectedStartSpringIndex = 0;
+        for (size_t c = 0; c < cachedShip->GetSpringColorRangeCount(); ++c)
+        {
+            ASSERT_EQ(expectedStartSpringIndex, colorRanges[c].StartSpringIndex) << "Color " << c;
+            ASSERT_LE(colorRanges[c].StartSpringIndex, colorRanges[c].EndSpringIndex) << "Color " << c;
+
+            expectedStartSpringIndex = colorRanges[c].EndSpringIndex;
+        }
+
+        ASSERT_EQ(cachedShip->GetSpringCount(), static_cast<size_t>(expectedStartSpringIndex));
+
+        // No two springs of the same color share an endpoint
+        for (size_t c = 0; c < cachedShip->GetSpringColorRangeCount(); ++c)
+        {
+            std::vector<bool> isPointTaken(cachedShip->GetPointCount(), false);
+            for (ElementIndex s = colorRanges[c].StartSpringIndex; s < colorRanges[c].EndSpringIndex; ++s)
+            {
+                for (ElementIndex const p : { springs[s].PointAIndex, springs[s].PointBIndex })
+                {
+                    ASSERT_FALSE(isPointTaken[p]) << "Color " << c << ", spring " << s << ", point " << p;
+                    isPointTaken[p] = true;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ShipBuilderTests, ConnectSpringsAndTriangles_RectangularShip)
+{
+    auto const cachedShip = Build(TestShips::MakeRectangularShip(13, 7, GetFirstStructuralColorKey()), 2);
+    ASSERT_TRUE(!!cachedShip);
+
+    // Each square makes two triangles, which share the square's diagonal and hence
+    // also get the square's other diagonal - the traverse spring - as a sub spring
+    ASSERT_EQ(12u * 6u * 2u, cachedShip->GetTriangleCount());
+
+    for (size_t t = 0; t < cachedShip->GetTriangleCount(); ++t)
+    {
+        EXPECT_EQ(4u, cachedShip->GetTriangles()[t].SubSpringsCount) << "Triangle " << t;
+    }
+
+    size_t superTriangleCount = 0;
+    for (size_t s = 0; s < cachedShip->GetSpringCount(); ++s)
+    {
+        EXPECT_LE(cachedShip->GetSprings()[s].SuperTrianglesCount, 2u) << "Spring " << s;
+        superTriangleCount += cachedShip->GetSprings()[s].SuperTrianglesCount;
+    }
+
+    EXPECT_EQ(cachedShip->GetTriangleCount() * 4, superTriangleCount);
+}
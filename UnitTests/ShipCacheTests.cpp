@@ -0,0 +1,187 @@
+#include <Game/ShipCache.h>
+
+#include "TestFolder.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+class ShipCacheTests : public ::testing::Test
+{
+protected:
+
+    ShipCacheTests()
+        : mFolder("ShipCache")
+    {}
+
+    TestFolder const mFolder;
+};
+
+TEST_F(ShipCacheTests, RoundTrip)
+{
+    ShipCache shipCache(mFolder.GetPath());
+
+    std::vector<ShipCache::Point> points(2);
+    points[0].Position = vec2f(1.0f, 2.0f);
+    points[0].StructuralMaterialIndex = 4;
+    points[0].ElectricalMaterialIndex = ShipCache::NoneMaterialIndex;
+    points[0].IsRope = 0;
+    points[0].IsLeaking = 1;
+    points[1].Position = vec2f(3.0f, 4.0f);
+    points[1].StructuralMaterialIndex = 5;
+    points[1].ElectricalMaterialIndex = 2;
+    points[1].IsRope = 1;
+    points[1].IsLeaking = 0;
+
+    std::vector<ShipCache::Spring> springs(1);
+    springs[0].PointAIndex = 0;
+    springs[0].PointBIndex = 1;
+    springs[0].SuperTrianglesCount = 1;
+    springs[0].SuperTriangles = { 0, NoneElementIndex };
+
+    std::vector<Physics::Springs::ColorRange> springColorRanges;
+    springColorRanges.emplace_back(0, 1);
+
+    std::vector<ShipCache::Triangle> triangles(1);
+    triangles[0].PointIndices = { 0, 1, 0 };
+    triangles[0].SubSpringsCount = 1;
+    triangles[0].SubSprings = { 0, NoneElementIndex, NoneElementIndex, NoneElementIndex };
+
+    shipCache.Store("Foo", 0x1234, points, springs, springColorRanges, triangles);
+
+    auto const cachedShip = shipCache.TryLoad("Foo", 0x1234);
+    ASSERT_TRUE(!!cachedShip);
+
+    ASSERT_EQ(2u, cachedShip->GetPointCount());
+    EXPECT_EQ(vec2f(1.0f, 2.0f), cachedShip->GetPoints()[0].Position);
+    EXPECT_EQ(4u, cachedShip->GetPoints()[0].StructuralMaterialIndex);
+    EXPECT_EQ(ShipCache::NoneMaterialIndex, cachedShip->GetPoints()[0].ElectricalMaterialIndex);
+    EXPECT_EQ(1, cachedShip->GetPoints()[0].IsLeaking);
+    EXPECT_EQ(vec2f(3.0f, 4.0f), cachedShip->GetPoints()[1].Position);
+    EXPECT_EQ(2u, cachedShip->GetPoints()[1].ElectricalMaterialIndex);
+    EXPECT_EQ(1, cachedShip->GetPoints()[1].IsRope);
+
+    ASSERT_EQ(1u, cachedShip->GetSpringCount());
+    EXPECT_EQ(1u, cachedShip->GetSprings()[0].PointBIndex);
+    EXPECT_EQ(1u, cachedShip->GetSprings()[0].SuperTrianglesCount);
+
+    ASSERT_EQ(1u, cachedShip->GetSpringColorRangeCount());
+    EXPECT_EQ(1u, cachedShip->GetSpringColorRanges()[0].EndSpringIndex);
+
+    ASSERT_EQ(1u, cachedShip->GetTriangleCount());
+    EXPECT_EQ(1u, cachedShip->GetTriangles()[0].PointIndices[1]);
+    EXPECT_EQ(1u, cachedShip->GetTriangles()[0].SubSpringsCount);
+}
+
+TEST_F(ShipCacheTests, ChecksConsistency)
+{
+    ShipCache shipCache(mFolder.GetPath());
+
+    std::vector<ShipCache::Point> points(2);
+    points[0].StructuralMaterialIndex = 4;
+    points[0].ElectricalMaterialIndex = ShipCache::NoneMaterialIndex;
+    points[1].StructuralMaterialIndex = 5;
+    points[1].ElectricalMaterialIndex = 2;
+
+    std::vector<ShipCache::Spring> springs(1);
+    springs[0].PointAIndex = 0;
+    springs[0].PointBIndex = 1;
+    springs[0].SuperTrianglesCount = 1;
+    springs[0].SuperTriangles = { 0, NoneElementIndex };
+
+    std::vector<Physics::Springs::ColorRange> springColorRanges;
+    springColorRanges.emplace_back(0, 1);
+
+    std::vector<ShipCache::Triangle> triangles(1);
+    triangles[0].PointIndices = { 0, 1, 0 };
+    triangles[0].SubSpringsCount = 1;
+    triangles[0].SubSprings = { 0, NoneElementIndex, NoneElementIndex, NoneElementIndex };
+
+    auto const storeAndCheck = [&](size_t structuralMaterialCount, size_t electricalMaterialCount)
+    {
+        shipCache.Store("Foo", 0x1234, points, springs, springColorRanges, triangles);
+
+        auto const cachedShip = shipCache.TryLoad("Foo", 0x1234);
+        EXPECT_TRUE(!!cachedShip);
+
+        return !!cachedShip && cachedShip->IsConsistent(structuralMaterialCount, electricalMaterialCount);
+    };
+
+    EXPECT_TRUE(storeAndCheck(6, 3));
+
+    // Materials
+    EXPECT_FALSE(storeAndCheck(5, 3));
+    EXPECT_FALSE(storeAndCheck(6, 2));
+
+    // Spring endpoints
+    springs[0].PointBIndex = 2;
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    springs[0].PointBIndex = 1;
+
+    // Super triangles
+    springs[0].SuperTrianglesCount = 3;
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    springs[0].SuperTrianglesCount = 2;
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    springs[0].SuperTrianglesCount = 1;
+
+    // Color ranges
+    springColorRanges[0].EndSpringIndex = 2;
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    springColorRanges.clear();
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    springColorRanges.emplace_back(0, 1);
+
+    // Triangle vertices
+    triangles[0].PointIndices = { 0, 1, 2 };
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    triangles[0].PointIndices = { 0, 1, 0 };
+
+    // Sub springs
+    triangles[0].SubSpringsCount = 5;
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    triangles[0].SubSpringsCount = 2;
+    EXPECT_FALSE(storeAndCheck(6, 3));
+    triangles[0].SubSpringsCount = 1;
+
+    EXPECT_TRUE(storeAndCheck(6, 3));
+}
+
+TEST_F(ShipCacheTests, Misses_OnUnknownShip)
+{
+    ShipCache shipCache(mFolder.GetPath());
+
+    EXPECT_FALSE(!!shipCache.TryLoad("Foo", 0x1234));
+}
+
+TEST_F(ShipCacheTests, Misses_OnKeyMismatch)
+{
+    ShipCache shipCache(mFolder.GetPath());
+
+    std::vector<ShipCache::Point> points(1);
+
+    shipCache.Store("Foo", 0x1234, points, {}, {}, {});
+
+    EXPECT_TRUE(!!shipCache.TryLoad("Foo", 0x1234));
+    EXPECT_FALSE(!!shipCache.TryLoad("Foo", 0x4321));
+    EXPECT_FALSE(!!shipCache.TryLoad("Bar", 0x1234));
+}
+
+TEST_F(ShipCacheTests, Overwrites_OnStore)
+{
+    ShipCache shipCache(mFolder.GetPath());
+
+    std::vector<ShipCache::Point> points(1);
+
+    shipCache.Store("Foo", 0x1234, points, {}, {}, {});
+
+    points.resize(3);
+
+    shipCache.Store("Foo", 0x4321, points, {}, {}, {});
+
+    EXPECT_FALSE(!!shipCache.TryLoad("Foo", 0x1234));
+
+    auto const cachedShip = shipCache.TryLoad("Foo", 0x4321);
+    ASSERT_TRUE(!!cachedShip);
+    EXPECT_EQ(3u, cachedShip->GetPointCount());
+}
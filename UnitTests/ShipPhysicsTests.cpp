@@ -0,0 +1,668 @@
+#include <Game/GameParameters.h>
+#include <Game/IGameEventHandler.h>
+#include <Game/ResourceLoader.h>
+#include <Game/Ship.h>
+#include <Game/ShipBuilder.h>
+#include <Game/World.h>
+
+#include <GameCore/Vectors.h>
+
+#include "TestShips.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+/*
+ * Verifies that the different implementations of the ship's dynamics agree with each other.
+ *
+ * Ships are built in worlds of their own, so that each ship gets the parallelism of its world.
+ */
+class ShipPhysicsTests : public ::testing::Test
+{
+protected:
+
+    //
+    // Forces are sums of spring forces which may cancel out each other, and so are
+    // displacements; hence we compare vectors within four ULPs - as EXPECT_FLOAT_EQ -
+    // of their largest component, rather than of each component
+    //
+
+    static constexpr float MaxUlps = 4.0f;
+
+    ShipPhysicsTests()
+        : mMaterialDatabase(TestShips::LoadMaterialDatabase())
+        , mGameParameters()
+        , mResourceLoader()
+    {}
+
+    std::unique_ptr<Physics::World> MakeWorld(size_t parallelism)
+    {
+        return std::make_unique<Physics::World>(
+            std::make_shared<IGameEventHandler>(),
+            mGameParameters,
+            mResourceLoader,
+            parallelism);
+    }
+
+    std::unique_ptr<Physics::Ship> MakeShip(
+        Physics::World & world,
+        ShipDefinition const & shipDefinition) const
+    {
+        return ShipBuilder::Create(
+            1,
+            world,
+            std::make_shared<IGameEventHandler>(),
+            shipDefinition,
+            mMaterialDatabase,
+            nullptr,
+            mGameParameters,
+            1u);
+    }
+
+    /*
+     * Moves the ship's points off their rest positions and gives them velocities, the
+     * same way for the same seed; forces are zeroed.
+     */
+    static void Shake(
+        Physics::Ship & ship,
+        std::uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        auto const randomComponent =
+            [&random](float magnitude)
+            {
+                return (static_cast<float>(random() % 2001) / 1000.0f - 1.0f) * magnitude;
+            };
+
+        auto & points = ship.GetPoints();
+        for (auto pointIndex : points)
+        {
+            if (pointIndex < points.GetShipPointCount())
+            {
+                points.GetPosition(pointIndex) += vec2f(randomComponent(0.2f), randomComponent(0.2f));
+                points.GetVelocity(pointIndex) = vec2f(randomComponent(5.0f), randomComponent(5.0f));
+            }
+
+            points.GetForce(pointIndex) = vec2f::zero();
+        }
+    }
+
+    static std::vector<vec2f> GetForces(Physics::Ship const & ship)
+    {
+        auto const & points = ship.GetPoints();
+
+        std::vector<vec2f> forces;
+        for (auto pointIndex : points)
+        {
+            forces.push_back(points.GetForce(pointIndex));
+        }
+
+        return forces;
+    }
+
+    static void ExpectVectorsEqual(
+        std::vector<vec2f> const & expected,
+        std::vector<vec2f> const & actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+
+        float scale = 0.0f;
+        for (auto const & v : expected)
+        {
+            scale = std::max(scale, std::max(std::abs(v.x), std::abs(v.y)));
+        }
+
+        float const tolerance = MaxUlps * std::numeric_limits<float>::epsilon() * scale;
+
+        for (size_t p = 0; p < expected.size(); ++p)
+        {
+            EXPECT_NEAR(expected[p].x, actual[p].x, tolerance) << "Point " << p;
+            EXPECT_NEAR(expected[p].y, actual[p].y, tolerance) << "Point " << p;
+        }
+    }
+
+    /*
+     * Destroys random springs and - more rarely - random points, the same way on ships
+     * that are in the same state, given random engines in the same state.
+     */
+    void DestroyRandomElements(
+        Physics::Ship & ship,
+        std::mt19937 & random,
+        size_t springCount,
+        size_t pointCount) const
+    {
+        auto & points = ship.GetPoints();
+        auto & springs = ship.GetSprings();
+
+        for (size_t i = 0; i < springCount; ++i)
+        {
+            ElementIndex const springIndex = static_cast<ElementIndex>(random() % springs.GetElementCount());
+            if (!springs.IsDeleted(springIndex))
+            {
+                springs.Destroy(
+                    springIndex,
+                    Physics::Springs::DestroyOptions::DoNotFireBreakEvent
+                    | Physics::Springs::DestroyOptions::DestroyOnlyConnectedTriangle,
+                    0.0f,
+                    mGameParameters,
+                    points);
+            }
+        }
+
+        for (size_t i = 0; i < pointCount; ++i)
+        {
+            ElementIndex const pointIndex = static_cast<ElementIndex>(random() % points.GetShipPointCount());
+            if (!points.IsDeleted(pointIndex))
+            {
+                points.Destroy(pointIndex, 0.0f, mGameParameters);
+            }
+        }
+    }
+
+    /*
+     * Checks that the two ships partition their live points in the same connected
+     * components - whatever their IDs - and that the components have the same sizes;
+     * the components of the actual ship that have no live points must be empty.
+     */
+    static void ExpectSameConnectedComponents(
+        Physics::Ship const & expectedShip,
+        Physics::Ship const & actualShip)
+    {
+        auto const & expectedPoints = expectedShip.GetPoints();
+        auto const & actualPoints = actualShip.GetPoints();
+
+        std::map<ConnectedComponentId, ConnectedComponentId> actualToExpected;
+        std::map<ConnectedComponentId, ConnectedComponentId> expectedToActual;
+
+        for (auto pointIndex : expectedPoints.NonEphemeralPoints())
+        {
+            ASSERT_EQ(expectedPoints.IsDeleted(pointIndex), actualPoints.IsDeleted(pointIndex)) << "Point " << pointIndex;
+            if (expectedPoints.IsDeleted(pointIndex))
+                continue;
+
+            auto const expectedId = expectedPoints.GetConnectedComponentId(pointIndex);
+            auto const actualId = actualPoints.GetConnectedComponentId(pointIndex);
+
+            ASSERT_EQ(expectedId, actualToExpected.emplace(actualId, expectedId).first->second) << "Point " << pointIndex;
+            ASSERT_EQ(actualId, expectedToActual.emplace(expectedId, actualId).first->second) << "Point " << pointIndex;
+        }
+
+        auto const & expectedSizes = expectedShip.GetConnectedComponentSizes();
+        auto const & actualSizes = actualShip.GetConnectedComponentSizes();
+
+        EXPECT_EQ(expectedSizes.size(), actualToExpected.size());
+
+        for (size_t c = 0; c < actualSizes.size(); ++c)
+        {
+            ConnectedComponentId const actualId = static_cast<ConnectedComponentId>(c + 1);
+
+            auto const it = actualToExpected.find(actualId);
+            if (it != actualToExpected.end())
+            {
+                ASSERT_LE(it->second, expectedSizes.size());
+                EXPECT_EQ(expectedSizes[it->second - 1], actualSizes[c]) << "Component " << actualId;
+            }
+            else
+            {
+                EXPECT_EQ(0u, actualSizes[c]) << "Component " << actualId;
+            }
+        }
+    }
+
+    /*
+     * Destroys the same elements on two ships built from the same definition, updating
+     * the connected components of one incrementally, and detecting those of the other
+     * from scratch, after each step.
+     */
+    void VerifyConnectedComponentUpdates(
+        ShipDefinition const & shipDefinition,
+        size_t stepCount,
+        size_t springsPerStep,
+        size_t pointsPerStep,
+        std::uint32_t seed)
+    {
+        auto world = MakeWorld(1);
+        auto incrementalShip = MakeShip(*world, shipDefinition);
+        auto detectedShip = MakeShip(*world, shipDefinition);
+
+        std::mt19937 incrementalRandom(seed);
+        std::mt19937 detectedRandom(seed);
+
+        for (size_t step = 0; step < stepCount; ++step)
+        {
+            SCOPED_TRACE(step);
+
+            DestroyRandomElements(*incrementalShip, incrementalRandom, springsPerStep, pointsPerStep);
+            DestroyRandomElements(*detectedShip, detectedRandom, springsPerStep, pointsPerStep);
+
+            incrementalShip->UpdateConnectedComponents();
+            detectedShip->DetectConnectedComponents();
+
+            ASSERT_NO_FATAL_FAILURE(ExpectSameConnectedComponents(*detectedShip, *incrementalShip));
+        }
+    }
+
+    /*
+     * Finds which electrical elements are powered by visiting the whole electrical graph
+     * from each dry generator; wet generators conduct as any other element.
+     */
+    static std::vector<bool> CalculatePoweredElectricalElements(Physics::Ship const & ship)
+    {
+        auto const & points = ship.GetPoints();
+        auto const & electricalElements = ship.GetElectricalElements();
+
+        std::vector<bool> isPowered(electricalElements.GetElementCount(), false);
+        std::vector<ElementIndex> elementsToVisit;
+
+        for (auto generatorIndex : electricalElements.Generators())
+        {
+            if (!electricalElements.IsDeleted(generatorIndex)
+                && !points.IsWet(electricalElements.GetPointIndex(generatorIndex), 0.3f)
+                && !isPowered[generatorIndex])
+            {
+                isPowered[generatorIndex] = true;
+                elementsToVisit.push_back(generatorIndex);
+
+                while (!elementsToVisit.empty())
+                {
+                    auto const e = elementsToVisit.back();
+                    elementsToVisit.pop_back();
+
+                    for (auto connectedElementIndex : electricalElements.GetConnectedElectricalElements(e))
+                    {
+                        if (!isPowered[connectedElementIndex])
+                        {
+                            isPowered[connectedElementIndex] = true;
+                            elementsToVisit.push_back(connectedElementIndex);
+                        }
+                    }
+                }
+            }
+        }
+
+        return isPowered;
+    }
+
+    MaterialDatabase const mMaterialDatabase;
+    GameParameters const mGameParameters;
+    ResourceLoader mResourceLoader;
+};
+
+TEST_F(ShipPhysicsTests, UpdateSpringForces_ParallelMatchesSerial)
+{
+    auto const shipDefinition = TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, true, 5);
+
+    auto serialWorld = MakeWorld(1);
+    auto serialShip = MakeShip(*serialWorld, shipDefinition);
+
+    auto parallelWorld = MakeWorld(4);
+    auto parallelShip = MakeShip(*parallelWorld, shipDefinition);
+
+    // Make sure that some colors are split among tasks - of at least 512 springs each - at
+    // boundaries that need not be aligned
+    auto const & colorRanges = parallelShip->GetSprings().GetColorRanges();
+    ASSERT_TRUE(std::any_of(
+        colorRanges.cbegin(),
+        colorRanges.cend(),
+        [](auto const & colorRange)
+        {
+            return colorRange.EndSpringIndex - colorRange.StartSpringIndex >= 2u * 512u;
+        }));
+
+    Shake(*serialShip, 42);
+    Shake(*parallelShip, 42);
+
+    serialShip->UpdateSpringForces(mGameParameters);
+    parallelShip->UpdateSpringForces(mGameParameters);
+
+    ExpectVectorsEqual(GetForces(*serialShip), GetForces(*parallelShip));
+}
+
+TEST_F(ShipPhysicsTests, UpdateSpringForces_VectorizedMatchesNaive)
+{
+    auto const shipDefinition = TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, true, 5);
+
+    auto world = MakeWorld(1);
+    auto ship = MakeShip(*world, shipDefinition);
+
+    auto & points = ship->GetPoints();
+    auto const & springs = ship->GetSprings();
+
+    ElementCount const springCount = springs.GetElementCount();
+
+    // Make sure that the last spring is left over by whole packets
+    ASSERT_NE(0u, springCount % 4);
+
+    Shake(*ship, 7);
+
+    //
+    // Collapse a few springs - within whole packets, and left over by them - whose
+    // endpoints are not shared with the other collapsed springs
+    //
+
+    std::vector<ElementIndex> zeroLengthSprings;
+    std::vector<bool> isPointTaken(points.GetElementCount(), false);
+    for (ElementIndex const s : { ElementIndex(0), ElementIndex(1), ElementIndex(6), springCount / 2, springCount - 1 })
+    {
+        ElementIndex const pointAIndex = springs.GetPointAIndex(s);
+        ElementIndex const pointBIndex = springs.GetPointBIndex(s);
+        if (!isPointTaken[pointAIndex] && !isPointTaken[pointBIndex])
+        {
+            points.GetPosition(pointBIndex) = points.GetPosition(pointAIndex);
+            isPointTaken[pointAIndex] = true;
+            isPointTaken[pointBIndex] = true;
+
+            zeroLengthSprings.push_back(s);
+        }
+    }
+
+    ASSERT_GE(zeroLengthSprings.size(), 3u);
+    ASSERT_EQ(springCount - 1, zeroLengthSprings.back());
+
+    ship->UpdateSpringGeometry();
+
+    for (ElementIndex const s : zeroLengthSprings)
+    {
+        EXPECT_EQ(0.0f, springs.GetLength(s)) << "Spring " << s;
+        EXPECT_EQ(vec2f::zero(), springs.GetDirection(s)) << "Spring " << s;
+    }
+
+    //
+    // Compare over ranges that start and end anywhere within packets
+    //
+
+    std::vector<std::pair<ElementIndex, ElementIndex>> const springRanges{
+        { 0, springCount },
+        { 1, springCount },
+        { 0, springCount - 2 },
+        { 3, springCount - 5 },
+        { 2, 5 },
+        { 6, 7 },
+        { 5, 5 }
+    };
+
+    for (auto const & [startSpringIndex, endSpringIndex] : springRanges)
+    {
+        SCOPED_TRACE(::testing::Message() << "Springs [" << startSpringIndex << ", " << endSpringIndex << ")");
+
+        for (auto pointIndex : points)
+        {
+            points.GetForce(pointIndex) = vec2f::zero();
+        }
+
+        ship->UpdateSpringForces_Naive(startSpringIndex, endSpringIndex);
+
+        auto const expectedForces = GetForces(*ship);
+
+        for (auto pointIndex : points)
+        {
+            points.GetForce(pointIndex) = vec2f::zero();
+        }
+
+        ship->UpdateSpringForces_Vectorized(startSpringIndex, endSpringIndex);
+
+        ExpectVectorsEqual(expectedForces, GetForces(*ship));
+    }
+}
+
+TEST_F(ShipPhysicsTests, IntegrateAndResetPointForces_MatchesScalar)
+{
+    auto const shipDefinition = TestShips::MakeRandomShip(97, 61, mMaterialDatabase, true, true, 5);
+
+    auto world = MakeWorld(1);
+    auto ship = MakeShip(*world, shipDefinition);
+
+    auto & points = ship->GetPoints();
+
+    // Make sure that some of the ship's points share their packet with ephemeral particles
+    ASSERT_NE(0u, (points.GetShipPointCount() * 2) % 8);
+
+    Shake(*ship, 11);
+    ship->UpdateSpringForces(mGameParameters);
+
+    //
+    // Integrate with scalars
+    //
+
+    float const dt = mGameParameters.MechanicalSimulationStepTimeDuration<float>();
+
+    float const globalDampCoefficient = std::pow(
+        GameParameters::GlobalDamp,
+        12.0f / mGameParameters.NumMechanicalDynamicsIterations<float>());
+
+    float const * const integrationFactorBuffer = points.GetIntegrationFactorBufferAsFloat();
+
+    std::vector<vec2f> expectedPositions;
+    std::vector<vec2f> expectedVelocities;
+    for (auto pointIndex : points)
+    {
+        vec2f const deltaPos(
+            points.GetVelocity(pointIndex).x * dt + points.GetForce(pointIndex).x * integrationFactorBuffer[pointIndex * 2],
+            points.GetVelocity(pointIndex).y * dt + points.GetForce(pointIndex).y * integrationFactorBuffer[pointIndex * 2 + 1]);
+
+        expectedPositions.push_back(points.GetPosition(pointIndex) + deltaPos);
+        expectedVelocities.push_back(deltaPos * globalDampCoefficient / dt);
+    }
+
+    //
+    // Integrate with packets
+    //
+
+    ship->IntegrateAndResetPointForces(mGameParameters);
+
+    std::vector<vec2f> actualPositions;
+    std::vector<vec2f> actualVelocities;
+    for (auto pointIndex : points)
+    {
+        actualPositions.push_back(points.GetPosition(pointIndex));
+        actualVelocities.push_back(points.GetVelocity(pointIndex));
+
+        EXPECT_EQ(vec2f::zero(), points.GetForce(pointIndex)) << "Point " << pointIndex;
+    }
+
+    ExpectVectorsEqual(expectedPositions, actualPositions);
+    ExpectVectorsEqual(expectedVelocities, actualVelocities);
+}
+
+TEST_F(ShipPhysicsTests, UpdateConnectedComponents_MatchesDetection_SmallComponents)
+{
+    // Many small components, held together by ropes
+    auto const shipDefinition = TestShips::MakeRandomShip(41, 29, mMaterialDatabase, true, false, 8);
+
+    VerifyConnectedComponentUpdates(shipDefinition, 60, 25, 2, 8);
+}
+
+TEST_F(ShipPhysicsTests, UpdateConnectedComponents_MatchesDetection_LargeComponent)
+{
+    // A single component larger than an incremental search may visit, so that
+    // searches give up on open regions
+    auto const & structuralColorKey = std::find_if(
+        mMaterialDatabase.GetStructuralMaterials().cbegin(),
+        mMaterialDatabase.GetStructuralMaterials().cend(),
+        [](auto const & entry)
+        {
+            return !entry.second.UniqueType;
+        })->first;
+
+    auto const shipDefinition = TestShips::MakeRectangularShip(80, 40, structuralColorKey);
+
+    VerifyConnectedComponentUpdates(shipDefinition, 40, 120, 5, 9);
+}
+
+TEST_F(ShipPhysicsTests, UpdateElectricalConnectivity_MatchesWholeGraphVisit)
+{
+    auto const findElectricalColorKey =
+        [this](ElectricalMaterial::ElectricalElementType electricalType)
+        {
+            return std::find_if(
+                mMaterialDatabase.GetElectricalMaterials().cbegin(),
+                mMaterialDatabase.GetElectricalMaterials().cend(),
+                [electricalType](auto const & entry)
+                {
+                    return electricalType == entry.second.ElectricalType
+                        && !entry.second.IsSelfPowered;
+                })->first;
+        };
+
+    auto const generatorColorKey = findElectricalColorKey(ElectricalMaterial::ElectricalElementType::Generator);
+    auto const cableColorKey = findElectricalColorKey(ElectricalMaterial::ElectricalElementType::Cable);
+    auto const lampColorKey = findElectricalColorKey(ElectricalMaterial::ElectricalElementType::Lamp);
+
+    auto const & structuralColorKey = std::find_if(
+        mMaterialDatabase.GetStructuralMaterials().cbegin(),
+        mMaterialDatabase.GetStructuralMaterials().cend(),
+        [](auto const & entry)
+        {
+            return !entry.second.UniqueType;
+        })->first;
+
+    //
+    // Three lines, each with a generator at its start and lamps along it, linked by
+    // cables into a single component
+    //
+
+    int constexpr Width = 32;
+    int constexpr Height = 9;
+
+    auto structuralLayerImage = TestShips::MakeEmptyImage(Width, Height);
+    auto electricalLayerImage = TestShips::MakeEmptyImage(Width, Height);
+    for (int x = 0; x < Width; ++x)
+    {
+        for (int y = 0; y < Height; ++y)
+        {
+            TestShips::SetPixel(structuralLayerImage, x, y, structuralColorKey);
+        }
+    }
+
+    for (int y : { 1, 4, 7 })
+    {
+        TestShips::SetPixel(electricalLayerImage, 0, y, generatorColorKey);
+        for (int x = 1; x < Width; ++x)
+        {
+            TestShips::SetPixel(electricalLayerImage, x, y, (0 == x % 8 || Width - 1 == x) ? lampColorKey : cableColorKey);
+        }
+    }
+
+    for (int y : { 2, 3 })
+        TestShips::SetPixel(electricalLayerImage, 12, y, cableColorKey);
+
+    for (int y : { 5, 6 })
+        TestShips::SetPixel(electricalLayerImage, 20, y, cableColorKey);
+
+    auto world = MakeWorld(1);
+    auto ship = MakeShip(
+        *world,
+        TestShips::MakeShipDefinition(
+            std::move(structuralLayerImage),
+            std::nullopt,
+            std::move(electricalLayerImage)));
+
+    auto & points = ship->GetPoints();
+    auto & electricalElements = ship->GetElectricalElements();
+
+    std::mt19937 random(10);
+    VisitSequenceNumber visitSequenceNumber = 1;
+
+    size_t poweredLampCount = 0;
+    size_t unpoweredLampCount = 0;
+
+    auto const verify =
+        [&]()
+        {
+            electricalElements.UpdateConnectivity(visitSequenceNumber++, points);
+
+            auto const expectedIsPowered = CalculatePoweredElectricalElements(*ship);
+
+            for (auto e : electricalElements)
+            {
+                if (electricalElements.IsDeleted(e))
+                    continue;
+
+                EXPECT_EQ(expectedIsPowered[e], electricalElements.IsPowered(e)) << "Element " << e;
+
+                if (ElectricalMaterial::ElectricalElementType::Lamp == electricalElements.GetType(e))
+                {
+                    if (electricalElements.IsPowered(e))
+                        ++poweredLampCount;
+                    else
+                        ++unpoweredLampCount;
+                }
+            }
+        };
+
+    ASSERT_NO_FATAL_FAILURE(verify());
+
+    //
+    // Remove a conductor at each step - either a cable or a connection - flooding and
+    // drying generators now and then
+    //
+
+    for (int step = 0; step < 30; ++step)
+    {
+        SCOPED_TRACE(step);
+
+        std::vector<ElementIndex> liveCables;
+        for (auto e : electricalElements)
+        {
+            if (!electricalElements.IsDeleted(e)
+                && ElectricalMaterial::ElectricalElementType::Cable == electricalElements.GetType(e))
+            {
+                liveCables.push_back(e);
+            }
+        }
+
+        ASSERT_FALSE(liveCables.empty());
+        auto const cableIndex = liveCables[random() % liveCables.size()];
+        auto const cablePointIndex = electricalElements.GetPointIndex(cableIndex);
+
+        if (0 == step % 2)
+        {
+            points.Destroy(cablePointIndex, 0.0f, mGameParameters);
+        }
+        else
+        {
+            // Destroy the springs between the cable and its first connected element
+            auto const & connectedElements = electricalElements.GetConnectedElectricalElements(cableIndex);
+            if (!connectedElements.empty())
+            {
+                auto const connectedPointIndex = electricalElements.GetPointIndex(*connectedElements.begin());
+                for (auto springIndex : points.GetConnectedSprings(cablePointIndex))
+                {
+                    if (connectedPointIndex == ship->GetSprings().GetOtherEndpointIndex(springIndex, cablePointIndex))
+                    {
+                        ship->GetSprings().Destroy(
+                            springIndex,
+                            Physics::Springs::DestroyOptions::DoNotFireBreakEvent
+                            | Physics::Springs::DestroyOptions::DestroyOnlyConnectedTriangle,
+                            0.0f,
+                            mGameParameters,
+                            points);
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (0 == step % 5)
+        {
+            auto const generatorIndex = electricalElements.Generators()[random() % electricalElements.Generators().size()];
+            auto & water = points.GetWater(electricalElements.GetPointIndex(generatorIndex));
+            water = (water > 0.3f) ? 0.0f : 1.0f;
+        }
+
+        ASSERT_NO_FATAL_FAILURE(verify());
+    }
+
+    EXPECT_NE(0u, poweredLampCount);
+    EXPECT_NE(0u, unpoweredLampCount);
+}
@@ -0,0 +1,249 @@
+#include <GameCore/FloatingPoint.h>
+#include <GameCore/TaskThreadPool.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(TaskThreadPoolTests, RunsAllTasks_SingleThread)
+{
+    TaskThreadPool pool(1);
+
+    EXPECT_EQ(1u, pool.GetParallelism());
+
+    std::vector<int> results(10, 0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        tasks.emplace_back(
+            [&results, t]()
+            {
+                results[t] = static_cast<int>(t) + 1;
+            });
+    }
+
+    pool.Run(tasks);
+
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        EXPECT_EQ(static_cast<int>(t) + 1, results[t]);
+    }
+}
+
+TEST(TaskThreadPoolTests, RunsAllTasks_MultipleThreads)
+{
+    TaskThreadPool pool(4);
+
+    EXPECT_EQ(4u, pool.GetParallelism());
+
+    std::vector<int> results(100, 0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        tasks.emplace_back(
+            [&results, t]()
+            {
+                results[t] = static_cast<int>(t) + 1;
+            });
+    }
+
+    for (int run = 0; run < 50; ++run)
+    {
+        pool.Run(tasks);
+    }
+
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        EXPECT_EQ(static_cast<int>(t) + 1, results[t]);
+    }
+}
+
+TEST(TaskThreadPoolTests, RunsNestedBatches)
+{
+    TaskThreadPool pool(3);
+
+    std::atomic<int> counter(0);
+
+    std::vector<TaskThreadPool::Task> innerTasks;
+    for (int t = 0; t < 5; ++t)
+    {
+        innerTasks.emplace_back(
+            [&counter]()
+            {
+                ++counter;
+            });
+    }
+
+    std::vector<TaskThreadPool::Task> outerTasks;
+    for (int t = 0; t < 4; ++t)
+    {
+        outerTasks.emplace_back(
+            [&pool, &innerTasks]()
+            {
+                pool.Run(innerTasks);
+            });
+    }
+
+    pool.Run(outerTasks);
+
+    EXPECT_EQ(20, counter.load());
+}
+
+TEST(TaskThreadPoolTests, WaitingThreadsOnlyRunTasksOfTheirOwnBatch)
+{
+    TaskThreadPool pool(4);
+
+    // The outer task - if any - that the current thread is running
+    static thread_local int currentOuterTask = -1;
+
+    std::atomic<int> foreignTaskCount(0);
+    std::atomic<int> counter(0);
+
+    std::vector<std::vector<TaskThreadPool::Task>> innerTasks(4);
+    for (int o = 0; o < 4; ++o)
+    {
+        for (int t = 0; t < 8; ++t)
+        {
+            innerTasks[o].emplace_back(
+                [&foreignTaskCount, &counter, o]()
+                {
+                    if (currentOuterTask != -1 && currentOuterTask != o)
+                        ++foreignTaskCount;
+
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    ++counter;
+                });
+        }
+    }
+
+    std::vector<TaskThreadPool::Task> outerTasks;
+    for (int o = 0; o < 4; ++o)
+    {
+        outerTasks.emplace_back(
+            [&pool, &innerTasks, o]()
+            {
+                currentOuterTask = o;
+                pool.Run(innerTasks[o]);
+                currentOuterTask = -1;
+            });
+    }
+
+    pool.Run(outerTasks);
+
+    EXPECT_EQ(32, counter.load());
+    EXPECT_EQ(0, foreignTaskCount.load());
+}
+
+TEST(TaskThreadPoolTests, RethrowsExceptionOfFirstTask_AfterBatchCompletes)
+{
+    TaskThreadPool pool(4);
+
+    std::atomic<int> counter(0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    tasks.emplace_back(
+        []()
+        {
+            throw std::runtime_error("First task");
+        });
+    for (int t = 1; t < 20; ++t)
+    {
+        tasks.emplace_back(
+            [&counter]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++counter;
+            });
+    }
+
+    EXPECT_THROW(
+        pool.Run(tasks),
+        std::runtime_error);
+
+    EXPECT_EQ(19, counter.load());
+
+    // The pool is still usable
+    pool.Run(std::vector<TaskThreadPool::Task>(tasks.cbegin() + 1, tasks.cend()));
+
+    EXPECT_EQ(38, counter.load());
+}
+
+TEST(TaskThreadPoolTests, RethrowsExceptionOfQueuedTask_AfterBatchCompletes)
+{
+    TaskThreadPool pool(4);
+
+    std::atomic<int> counter(0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (int t = 0; t < 20; ++t)
+    {
+        tasks.emplace_back(
+            [&counter, t]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++counter;
+
+                if (t == 10)
+                    throw std::runtime_error("Queued task");
+            });
+    }
+
+    EXPECT_THROW(
+        pool.Run(tasks),
+        std::runtime_error);
+
+    EXPECT_EQ(20, counter.load());
+}
+
+TEST(TaskThreadPoolTests, RunsTasksWithCreatorFloatingPointMode)
+{
+    unsigned int const originalFloatingPointMode = GetFloatingPointMode();
+
+    EnableFloatingPointFlushToZero();
+
+    {
+        TaskThreadPool pool(4);
+
+        std::vector<int> isFlushToZeroEnabled(20, 0);
+        std::vector<std::thread::id> threadIds(isFlushToZeroEnabled.size());
+
+        std::vector<TaskThreadPool::Task> tasks;
+        for (size_t t = 0; t < isFlushToZeroEnabled.size(); ++t)
+        {
+            tasks.emplace_back(
+                [&isFlushToZeroEnabled, &threadIds, t]()
+                {
+                    isFlushToZeroEnabled[t] = IsFloatingPointFlushToZeroEnabled() ? 1 : 0;
+                    threadIds[t] = std::this_thread::get_id();
+
+                    // Give the worker threads a chance to take tasks
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                });
+        }
+
+        pool.Run(tasks);
+
+        for (size_t t = 0; t < isFlushToZeroEnabled.size(); ++t)
+        {
+            EXPECT_EQ(1, isFlushToZeroEnabled[t]);
+        }
+
+        // Make sure the worker threads did take part
+        EXPECT_TRUE(std::any_of(
+            threadIds.cbegin(),
+            threadIds.cend(),
+            [](std::thread::id const & threadId)
+            {
+                return threadId != std::this_thread::get_id();
+            }));
+    }
+
+    SetFloatingPointMode(originalFloatingPointMode);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/*
+ * A scratch folder for tests that need to touch the file system; the folder
+ * lives under the system temp folder and is wiped both at construction and
+ * at destruction.
+ */
+class TestFolder
+{
+public:
+
+    explicit TestFolder(std::string const & name)
+        : mPath(std::filesystem::temp_directory_path() / "FloatingSandboxUnitTests" / name)
+    {
+        std::filesystem::remove_all(mPath);
+    }
+
+    ~TestFolder()
+    {
+        std::filesystem::remove_all(mPath);
+    }
+
+    TestFolder(TestFolder const &) = delete;
+    TestFolder & operator=(TestFolder const &) = delete;
+
+    std::filesystem::path const & GetPath() const
+    {
+        return mPath;
+    }
+
+private:
+
+    std::filesystem::path const mPath;
+};
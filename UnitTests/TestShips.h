@@ -0,0 +1,227 @@
+#pragma once
+
+#include <Game/MaterialDatabase.h>
+#include <Game/ShipDefinition.h>
+
+#include <GameCore/Colors.h>
+#include <GameCore/ImageData.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+/*
+ * Makes ships out of in-memory images, for tests that need ships to work on.
+ *
+ * Materials come from the game's material database, which is copied into the
+ * "Data" folder next to the tests.
+ */
+class TestShips
+{
+public:
+
+    static MaterialDatabase LoadMaterialDatabase()
+    {
+        return MaterialDatabase::Load(std::filesystem::path("Data"));
+    }
+
+    static RgbImageData MakeEmptyImage(
+        int width,
+        int height)
+    {
+        std::unique_ptr<rgbColor[]> data(new rgbColor[static_cast<size_t>(width) * static_cast<size_t>(height)]);
+        std::fill(
+            data.get(),
+            data.get() + static_cast<size_t>(width) * static_cast<size_t>(height),
+            BackgroundColorKey);
+
+        return RgbImageData(width, height, std::move(data));
+    }
+
+    /*
+     * Sets the pixel at the specified ship coordinates, i.e. with y growing upwards.
+     */
+    static void SetPixel(
+        RgbImageData & image,
+        int x,
+        int y,
+        rgbColor const & color)
+    {
+        image.Data[x + (image.Size.Height - y - 1) * image.Size.Width] = color;
+    }
+
+    /*
+     * Makes a ship whose structure is a (width x height) rectangle of the specified material.
+     */
+    static ShipDefinition MakeRectangularShip(
+        int width,
+        int height,
+        rgbColor const & structuralColorKey)
+    {
+        auto structuralLayerImage = MakeEmptyImage(width, height);
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                SetPixel(structuralLayerImage, x, y, structuralColorKey);
+            }
+        }
+
+        return MakeShipDefinition(
+            std::move(structuralLayerImage),
+            std::nullopt,
+            std::nullopt);
+    }
+
+    /*
+     * Makes a ship out of a random mix of all the (non-unique) structural materials,
+     * with holes and, optionally, with ropes - both in the structural and in the ropes
+     * layer - and with a dedicated electrical layer; the same seed makes the same ship
+     * on any platform.
+     */
+    static ShipDefinition MakeRandomShip(
+        int width,
+        int height,
+        MaterialDatabase const & materialDatabase,
+        bool withRopes,
+        bool withElectricalLayer,
+        std::uint32_t seed)
+    {
+        std::mt19937 random(seed);
+
+        auto const randomIndex =
+            [&random](size_t count)
+            {
+                return static_cast<size_t>(random() % count);
+            };
+
+        std::vector<rgbColor> structuralColorKeys;
+        rgbColor ropeColorKey;
+        for (auto const & entry : materialDatabase.GetStructuralMaterials())
+        {
+            if (!entry.second.UniqueType)
+                structuralColorKeys.push_back(entry.first);
+            else if (StructuralMaterial::MaterialUniqueType::Rope == *(entry.second.UniqueType))
+                ropeColorKey = entry.first;
+        }
+
+        std::vector<rgbColor> electricalColorKeys;
+        for (auto const & entry : materialDatabase.GetElectricalMaterials())
+        {
+            electricalColorKeys.push_back(entry.first);
+        }
+
+        // Structure: a mix of materials with holes, and a few empty bands splitting
+        // the structure into separate pieces
+
+        auto structuralLayerImage = MakeEmptyImage(width, height);
+        std::vector<std::pair<int, int>> structuralPoints;
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                if (randomIndex(5) != 0
+                    && (x % 23) != 11
+                    && (y % 17) != 8)
+                {
+                    SetPixel(structuralLayerImage, x, y, structuralColorKeys[randomIndex(structuralColorKeys.size())]);
+                    structuralPoints.emplace_back(x, y);
+                }
+            }
+        }
+
+        std::optional<RgbImageData> ropesLayerImage;
+        if (withRopes)
+        {
+            // Pixels that may not become rope endpoints anymore
+            std::vector<bool> isTaken(static_cast<size_t>(width) * static_cast<size_t>(height), false);
+
+            auto const takeRandomPixel =
+                [&]() -> std::pair<int, int>
+                {
+                    while (true)
+                    {
+                        int const x = static_cast<int>(randomIndex(static_cast<size_t>(width)));
+                        int const y = static_cast<int>(randomIndex(static_cast<size_t>(height)));
+                        if (!isTaken[x + y * width])
+                        {
+                            isTaken[x + y * width] = true;
+                            return { x, y };
+                        }
+                    }
+                };
+
+            // Ropes in the structural layer, with the endpoints' colors in the range reserved for ropes
+            for (uint8_t r = 0; r < 8; ++r)
+            {
+                rgbColor const ropeEndpointColorKey(
+                    ropeColorKey.r,
+                    static_cast<uint8_t>((ropeColorKey.g & 0xF0) | r),
+                    static_cast<uint8_t>(ropeColorKey.b ^ (0x80 | r)));
+
+                for (int e = 0; e < 2; ++e)
+                {
+                    auto const [x, y] = takeRandomPixel();
+                    SetPixel(structuralLayerImage, x, y, ropeEndpointColorKey);
+                }
+            }
+
+            // Ropes in the ropes layer, starting either at structural points or in mid-air
+            ropesLayerImage.emplace(MakeEmptyImage(width, height));
+            for (uint8_t r = 0; r < 8; ++r)
+            {
+                rgbColor const ropeEndpointColorKey(0x10, static_cast<uint8_t>(0x20 + r), 0x30);
+
+                for (int e = 0; e < 2; ++e)
+                {
+                    auto const [x, y] = takeRandomPixel();
+                    SetPixel(*ropesLayerImage, x, y, ropeEndpointColorKey);
+                }
+            }
+        }
+
+        // Electrical elements, on structural points
+
+        std::optional<RgbImageData> electricalLayerImage;
+        if (withElectricalLayer)
+        {
+            electricalLayerImage.emplace(MakeEmptyImage(width, height));
+            for (auto const & [x, y] : structuralPoints)
+            {
+                if (randomIndex(10) == 0)
+                    SetPixel(*electricalLayerImage, x, y, electricalColorKeys[randomIndex(electricalColorKeys.size())]);
+            }
+        }
+
+        return MakeShipDefinition(
+            std::move(structuralLayerImage),
+            std::move(ropesLayerImage),
+            std::move(electricalLayerImage));
+    }
+
+    static ShipDefinition MakeShipDefinition(
+        RgbImageData structuralLayerImage,
+        std::optional<RgbImageData> ropesLayerImage,
+        std::optional<RgbImageData> electricalLayerImage)
+    {
+        ImageSize const textureSize = structuralLayerImage.Size;
+        std::unique_ptr<rgbaColor[]> textureData(new rgbaColor[static_cast<size_t>(textureSize.Width) * static_cast<size_t>(textureSize.Height)]);
+
+        return ShipDefinition(
+            std::move(structuralLayerImage),
+            std::move(ropesLayerImage),
+            std::move(electricalLayerImage),
+            RgbaImageData(textureSize, std::move(textureData)),
+            ShipDefinition::TextureOriginType::StructuralImage,
+            ShipMetadata("Test"));
+    }
+
+private:
+
+    static constexpr rgbColor BackgroundColorKey = rgbColor(0xff, 0xff, 0xff);
+};
@@ -0,0 +1,172 @@
+#include <Game/TextureAtlasCache.h>
+
+#include "TestFolder.h"
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+class TextureAtlasCacheTests : public ::testing::Test
+{
+protected:
+
+    TextureAtlasCacheTests()
+        : mFolder("TextureAtlasCache")
+    {}
+
+    static TextureAtlasMetadata MakeMetadata()
+    {
+        std::vector<TextureAtlasFrameMetadata> frames;
+
+        frames.emplace_back(
+            vec2f(0.0f, 0.0f),
+            vec2f(0.5f, 1.0f),
+            0,
+            0,
+            TextureFrameMetadata(ImageSize(2, 2), 10.0f, 20.0f, false, 5.0f, 10.0f, TextureFrameId(TextureGroupType::Cloud, 0)));
+
+        frames.emplace_back(
+            vec2f(0.5f, 0.0f),
+            vec2f(1.0f, 1.0f),
+            2,
+            0,
+            TextureFrameMetadata(ImageSize(2, 2), 1.0f, 2.0f, true, 0.5f, 1.0f, TextureFrameId(TextureGroupType::Cloud, 1)));
+
+        return TextureAtlasMetadata(frames);
+    }
+
+    static std::vector<RgbaImageData> MakeLevels()
+    {
+        std::vector<RgbaImageData> levels;
+
+        std::unique_ptr<rgbaColor[]> level0(new rgbaColor[4 * 2]);
+        for (size_t i = 0; i < 4 * 2; ++i)
+            level0[i] = rgbaColor(static_cast<uint8_t>(i), 1, 2, 3);
+        levels.emplace_back(ImageSize(4, 2), std::move(level0));
+
+        std::unique_ptr<rgbaColor[]> level1(new rgbaColor[2 * 1]);
+        level1[0] = rgbaColor(10, 11, 12, 13);
+        level1[1] = rgbaColor(20, 21, 22, 23);
+        levels.emplace_back(ImageSize(2, 1), std::move(level1));
+
+        return levels;
+    }
+
+    std::filesystem::path GetEntryFilePath(std::string const & atlasName) const
+    {
+        return mFolder.GetPath() / (atlasName + ".atlascache");
+    }
+
+    TestFolder const mFolder;
+};
+
+TEST_F(TextureAtlasCacheTests, RoundTrip)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    textureAtlasCache.Store("Foo", 0x1234, MakeMetadata(), MakeLevels());
+
+    auto const cachedAtlas = textureAtlasCache.TryLoad("Foo", 0x1234);
+    ASSERT_TRUE(!!cachedAtlas);
+
+    ASSERT_EQ(2u, cachedAtlas->GetMetadata().GetFrameMetadata().size());
+
+    auto const & frame1 = cachedAtlas->GetMetadata().GetFrameMetadata(TextureGroupType::Cloud, 1);
+    EXPECT_EQ(vec2f(0.5f, 0.0f), frame1.TextureCoordinatesBottomLeft);
+    EXPECT_EQ(vec2f(1.0f, 1.0f), frame1.TextureCoordinatesTopRight);
+    EXPECT_EQ(2, frame1.FrameLeftX);
+    EXPECT_EQ(0, frame1.FrameBottomY);
+    EXPECT_EQ(ImageSize(2, 2), frame1.FrameMetadata.Size);
+    EXPECT_EQ(1.0f, frame1.FrameMetadata.WorldWidth);
+    EXPECT_EQ(2.0f, frame1.FrameMetadata.WorldHeight);
+    EXPECT_TRUE(frame1.FrameMetadata.HasOwnAmbientLight);
+    EXPECT_EQ(0.5f, frame1.FrameMetadata.AnchorWorldX);
+    EXPECT_EQ(1.0f, frame1.FrameMetadata.AnchorWorldY);
+    EXPECT_EQ(TextureFrameId(TextureGroupType::Cloud, 1), frame1.FrameMetadata.FrameId);
+
+    EXPECT_FALSE(cachedAtlas->GetMetadata().GetFrameMetadata(TextureGroupType::Cloud, 0).FrameMetadata.HasOwnAmbientLight);
+
+    ASSERT_EQ(2u, cachedAtlas->GetLevelCount());
+    EXPECT_EQ(ImageSize(4, 2), cachedAtlas->GetLevelSize(0));
+    EXPECT_EQ(rgbaColor(7, 1, 2, 3), cachedAtlas->GetLevelData(0)[7]);
+    EXPECT_EQ(ImageSize(2, 1), cachedAtlas->GetLevelSize(1));
+    EXPECT_EQ(rgbaColor(20, 21, 22, 23), cachedAtlas->GetLevelData(1)[1]);
+}
+
+TEST_F(TextureAtlasCacheTests, Misses_OnUnknownAtlas)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Foo", 0x1234));
+}
+
+TEST_F(TextureAtlasCacheTests, Misses_OnKeyMismatch)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    textureAtlasCache.Store("Foo", 0x1234, MakeMetadata(), MakeLevels());
+
+    EXPECT_TRUE(!!textureAtlasCache.TryLoad("Foo", 0x1234));
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Foo", 0x4321));
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Bar", 0x1234));
+}
+
+TEST_F(TextureAtlasCacheTests, Misses_OnFileShorterThanHeader)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    textureAtlasCache.Store("Foo", 0x1234, MakeMetadata(), MakeLevels());
+
+    std::filesystem::resize_file(GetEntryFilePath("Foo"), 6);
+
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Foo", 0x1234));
+}
+
+TEST_F(TextureAtlasCacheTests, Misses_OnTruncatedLevelData)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    textureAtlasCache.Store("Foo", 0x1234, MakeMetadata(), MakeLevels());
+
+    auto const fileSize = std::filesystem::file_size(GetEntryFilePath("Foo"));
+    std::filesystem::resize_file(GetEntryFilePath("Foo"), fileSize - 1);
+
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Foo", 0x1234));
+}
+
+TEST_F(TextureAtlasCacheTests, Misses_OnExtraTrailingData)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    textureAtlasCache.Store("Foo", 0x1234, MakeMetadata(), MakeLevels());
+
+    {
+        std::ofstream file(GetEntryFilePath("Foo"), std::ios::binary | std::ios::app);
+        file.put(0);
+    }
+
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Foo", 0x1234));
+}
+
+TEST_F(TextureAtlasCacheTests, Misses_OnBadMagic)
+{
+    TextureAtlasCache textureAtlasCache(mFolder.GetPath());
+
+    textureAtlasCache.Store("Foo", 0x1234, MakeMetadata(), MakeLevels());
+
+    {
+        std::fstream file(GetEntryFilePath("Foo"), std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(0);
+        file.write("XXXX", 4);
+    }
+
+    EXPECT_FALSE(!!textureAtlasCache.TryLoad("Foo", 0x1234));
+}
+
+}
@@ -0,0 +1,95 @@
+#include <Game/Physics.h>
+
+#include <Game/GameParameters.h>
+#include <Game/ResourceLoader.h>
+
+#include <GameCore/GameMath.h>
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Physics;
+
+namespace /* anonymous */ {
+
+    /*
+     * Makes x's sweeping a few periods on both sides of zero, both on and between the
+     * sample boundaries; the count is not a multiple of four, so that the batch samplers'
+     * scalar tail is exercised too.
+     */
+    std::vector<vec2f> MakeSweepPositions(
+        float period,
+        size_t samplesCount)
+    {
+        float const dx = period / static_cast<float>(samplesCount);
+        int64_t const sweepSamples = 3 * static_cast<int64_t>(samplesCount);
+
+        std::vector<vec2f> positions;
+
+        // On the sample boundaries
+        for (int64_t s = -sweepSamples; s <= sweepSamples; ++s)
+        {
+            positions.emplace_back(static_cast<float>(s) * dx, 0.0f);
+        }
+
+        // Between the sample boundaries
+        for (float x = -static_cast<float>(sweepSamples) * dx; x <= static_cast<float>(sweepSamples) * dx; x += dx / 3.3f)
+        {
+            positions.emplace_back(x, 0.0f);
+        }
+
+        // Right around zero
+        positions.emplace_back(-0.0f, 0.0f);
+        positions.emplace_back(-0.00001f, 0.0f);
+        positions.emplace_back(0.00001f, 0.0f);
+
+        if (positions.size() % 4 == 0)
+            positions.emplace_back(dx / 2.0f, 0.0f);
+
+        return positions;
+    }
+}
+
+TEST(WorldHeightsTests, WaterHeights_BatchMatchesScalar)
+{
+    GameParameters gameParameters;
+    gameParameters.WaveHeight = 2.5f;
+
+    Wind wind(nullptr);
+
+    WaterSurface waterSurface;
+    waterSurface.Update(12.34f, wind, gameParameters);
+
+    // Period of the water surface
+    auto const positions = MakeSweepPositions(20.0f * Pi<float>, waterSurface.GetSamplesCount());
+
+    std::vector<float> heights(positions.size());
+    waterSurface.GetWaterHeightsAt(positions.data(), heights.data(), positions.size());
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(waterSurface.GetWaterHeightAt(positions[i].x), heights[i]) << "x=" << positions[i].x;
+    }
+}
+
+TEST(WorldHeightsTests, FloorHeights_BatchMatchesScalar)
+{
+    GameParameters gameParameters;
+
+    ResourceLoader resourceLoader;
+
+    OceanFloor oceanFloor(resourceLoader);
+    oceanFloor.Update(gameParameters);
+
+    // Period of the ocean floor
+    auto const positions = MakeSweepPositions(2000.0f * Pi<float>, oceanFloor.GetSamplesCount());
+
+    std::vector<float> heights(positions.size());
+    oceanFloor.GetFloorHeightsAt(positions.data(), heights.data(), positions.size());
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(oceanFloor.GetFloorHeightAt(positions[i].x), heights[i]) << "x=" << positions[i].x;
+    }
+}